@@ -1,78 +1,44 @@
 #version 410 core
 
+// One source, several programs. The variant is picked with a define injected
+// after the #version line (see src/rendering/shader_cache.cpp):
+//   VARIANT_TEXTURED       - texture colour (character models)
+//   VARIANT_TEXT           - glyph coverage from the red channel, colour from the vertex
+//   VARIANT_DICE           - dice texture thresholded to white face / black pips
+//   VARIANT_COLOR_OVERRIDE - flat uColorOverride, vertex alpha
+//   (none)                 - vertex colour
+
 in vec4 fragColor;
 in vec2 fragTexCoord;
 
 out vec4 outColor;
 
+#if defined(VARIANT_TEXTURED) || defined(VARIANT_TEXT) || defined(VARIANT_DICE)
 uniform sampler2D uTexture;
-uniform bool uUseTexture;
-uniform bool uDiceTextureMode;
+#endif
+
+#if defined(VARIANT_COLOR_OVERRIDE)
 uniform vec3 uColorOverride;
-uniform bool uUseColorOverride;
+#endif
 
 void main()
 {
-    if (uUseTexture)
-    {
-        vec4 texColor = texture(uTexture, fragTexCoord);
-
-        if (uDiceTextureMode)
-        {
-            // Convert colored background (red) to white, keep black pips
-            float avgColor = (texColor.r + texColor.g + texColor.b) / 3.0;
-            float maxChannel = max(max(texColor.r, texColor.g), texColor.b);
-            if (avgColor < 0.2 && maxChannel < 0.3)
-            {
-                outColor = vec4(0.0, 0.0, 0.0, 1.0);
-            }
-            else
-            {
-                outColor = vec4(1.0, 1.0, 1.0, 1.0);
-            }
-        }
-        else
-        {
-            // Use texture color directly with alpha channel
-            // For RGBA textures, use all channels including alpha for transparency
-            // For RGB textures, alpha will be 1.0 (fully opaque)
-            // For GL_RED textures (fonts), use red channel as alpha and vertex color for RGB
-            // GL_RED texture: r has value, g and b are 0, a may be 1.0 or undefined
-            // With texture swizzle, all channels (r, g, b, a) should be the same (red channel value)
-            // Check if texture is GL_RED font texture (all channels are similar, r has value)
-            bool isLikelyFont = (abs(texColor.r - texColor.g) < 0.01) && 
-                                (abs(texColor.g - texColor.b) < 0.01) && 
-                                (abs(texColor.b - texColor.a) < 0.01) && 
-                                (texColor.r > 0.01);
-            
-            if (isLikelyFont)
-            {
-                // GL_RED font texture with swizzle - use vertex color (fragColor) for RGB, red channel as alpha
-                // This ensures text uses the color we specify (white) instead of texture color
-                // The alpha channel from texture determines transparency
-                outColor = vec4(fragColor.rgb, texColor.r);
-            }
-            else
-            {
-                // RGB or RGBA texture - use texture color with alpha
-                // For RGBA textures, alpha channel will be used for transparency
-                // This will properly handle transparency for Panel.png
-                // Use texture color directly - OpenGL will handle alpha correctly
-                outColor = texColor;
-            }
-        }
-    }
-    else
-    {
-        // Use vertex color with alpha, or override if specified
-        if (uUseColorOverride)
-        {
-            outColor = vec4(uColorOverride, fragColor.a);
-        }
-        else
-        {
-        outColor = fragColor;
-        }
-    }
+#if defined(VARIANT_TEXT)
+    // GL_RED glyph texture - red channel is coverage, vertex colour is the text colour
+    outColor = vec4(fragColor.rgb, fragColor.a * texture(uTexture, fragTexCoord).r);
+#elif defined(VARIANT_DICE)
+    // Convert colored background (red) to white, keep black pips
+    vec4 texColor = texture(uTexture, fragTexCoord);
+    float avgColor = (texColor.r + texColor.g + texColor.b) / 3.0;
+    float maxChannel = max(max(texColor.r, texColor.g), texColor.b);
+    float isPip = float(avgColor < 0.2 && maxChannel < 0.3);
+    outColor = vec4(vec3(1.0 - isPip), 1.0);
+#elif defined(VARIANT_TEXTURED)
+    // RGB or RGBA texture - alpha is used for transparency
+    outColor = texture(uTexture, fragTexCoord);
+#elif defined(VARIANT_COLOR_OVERRIDE)
+    outColor = vec4(uColorOverride, fragColor.a);
+#else
+    outColor = fragColor;
+#endif
 }
-
@@ -0,0 +1,45 @@
+#include "fixed_timestep.h"
+
+#include <algorithm>
+
+namespace core
+{
+    void set_tick_rate(FixedTimestep& timestep, double tick_rate)
+    {
+        // Keep the rate in a sane range - below 10 Hz the dice physics tunnels
+        // through the ground, above 1 kHz we only burn CPU
+        timestep.tick_rate = std::clamp(tick_rate, 10.0, 1000.0);
+        timestep.step = 1.0 / timestep.tick_rate;
+        timestep.accumulator = 0.0;
+    }
+
+    int accumulate(FixedTimestep& timestep, double frame_time)
+    {
+        // A long hitch must not turn into one giant simulation step (or hundreds of small ones)
+        frame_time = std::clamp(frame_time, 0.0, timestep.max_frame_time);
+        timestep.accumulator += frame_time;
+
+        int ticks = static_cast<int>(timestep.accumulator / timestep.step);
+        if (ticks > timestep.max_ticks_per_frame)
+        {
+            // Simulation can't keep up - run what we can and drop the rest so the
+            // game slows down instead of freezing
+            ticks = timestep.max_ticks_per_frame;
+            timestep.accumulator = static_cast<double>(ticks) * timestep.step;
+        }
+
+        timestep.accumulator -= static_cast<double>(ticks) * timestep.step;
+        timestep.tick_count += static_cast<std::uint64_t>(ticks);
+        return ticks;
+    }
+
+    float get_step(const FixedTimestep& timestep)
+    {
+        return static_cast<float>(timestep.step);
+    }
+
+    float get_interpolation_alpha(const FixedTimestep& timestep)
+    {
+        return static_cast<float>(std::clamp(timestep.accumulator / timestep.step, 0.0, 1.0));
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace core
+{
+    // Fixed-step simulation clock. The frame loop feeds in the real elapsed time,
+    // runs however many whole ticks have accumulated and hands the leftover
+    // fraction of a tick to the renderer for interpolation.
+    struct FixedTimestep
+    {
+        double tick_rate = 60.0;          // Simulation ticks per second
+        double step = 1.0 / 60.0;         // Seconds per tick (1 / tick_rate)
+        double accumulator = 0.0;         // Real time not yet simulated
+        double max_frame_time = 0.25;     // Clamp for hitches (debugger, window drag, loading)
+        int max_ticks_per_frame = 8;      // Drop time instead of spiralling when the sim can't keep up
+        std::uint64_t tick_count = 0;     // Total ticks simulated so far
+    };
+
+    void set_tick_rate(FixedTimestep& timestep, double tick_rate);
+
+    // Adds real frame time and returns how many simulation ticks to run this frame
+    int accumulate(FixedTimestep& timestep, double frame_time);
+
+    float get_step(const FixedTimestep& timestep);
+
+    // 0..1 - how far the renderer is between the previous and the current tick
+    float get_interpolation_alpha(const FixedTimestep& timestep);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace core
+{
+    // A key going down or up, stamped with glfwGetTime() when GLFW delivered it
+    struct KeyEvent
+    {
+        double time = 0.0;
+        int key = 0;
+        bool down = false;
+    };
+
+    // Lock-free single-producer / single-consumer ring of key events.
+    //
+    // The window's key callback pushes during poll_events() on the main thread,
+    // the simulation drains it at the start of each tick. Unlike sampling key
+    // state once a tick, a tap that begins and ends between two ticks is not
+    // lost, and every edge keeps the time it really happened.
+    class KeyEventQueue
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 256;
+
+        // Producer side - false (and the event is dropped) when the queue is full
+        bool push(const KeyEvent& event)
+        {
+            const std::uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) == CAPACITY)
+            {
+                return false;
+            }
+            m_events[head & INDEX_MASK] = event;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side - the oldest event or nullptr if there is none; pop() discards it
+        const KeyEvent* front() const
+        {
+            const std::uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return &m_events[tail & INDEX_MASK];
+        }
+
+        void pop()
+        {
+            m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+        static constexpr std::uint32_t INDEX_MASK = CAPACITY - 1;
+
+        std::array<KeyEvent, CAPACITY> m_events{};
+
+        // Each counter is only written by one thread - keep them on separate cache lines
+        alignas(64) std::atomic<std::uint32_t> m_head{0};
+        alignas(64) std::atomic<std::uint32_t> m_tail{0};
+    };
+}
@@ -0,0 +1,75 @@
+#include "random.h"
+
+#include <chrono>
+
+namespace core
+{
+    namespace
+    {
+        std::uint64_t splitmix64(std::uint64_t& state)
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        thread_local RandomStreams* t_thread_streams = nullptr;
+
+        RandomStreams& streams()
+        {
+            static RandomStreams instance;
+            return t_thread_streams ? *t_thread_streams : instance;
+        }
+    }
+
+    void seed_random_streams(std::uint64_t seed)
+    {
+        seed_random_streams(streams(), seed);
+    }
+
+    void seed_random_streams(RandomStreams& state, std::uint64_t seed)
+    {
+        state.seed = seed;
+
+        // splitmix64 spreads nearby seeds (0, 1, 2...) into unrelated engine states
+        std::uint64_t mix = seed;
+        for (std::mt19937& engine : state.engines)
+        {
+            const std::uint64_t value = splitmix64(mix);
+            std::seed_seq sequence{static_cast<std::uint32_t>(value), static_cast<std::uint32_t>(value >> 32)};
+            engine.seed(sequence);
+        }
+        state.seeded = true;
+    }
+
+    std::uint64_t get_random_seed()
+    {
+        return streams().seed;
+    }
+
+    std::uint64_t make_random_seed()
+    {
+        std::random_device device;
+        const std::uint64_t entropy = (static_cast<std::uint64_t>(device()) << 32) | device();
+        const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        std::uint64_t mix = entropy ^ now;
+        return splitmix64(mix);
+    }
+
+    std::mt19937& random_stream(RandomStream stream)
+    {
+        RandomStreams& state = streams();
+        if (!state.seeded)
+        {
+            // Nobody picked a seed (tools, tests) - behave like before and be random
+            seed_random_streams(state, make_random_seed());
+        }
+        return state.engines[static_cast<std::size_t>(stream)];
+    }
+
+    void set_thread_random_streams(RandomStreams* streams)
+    {
+        t_thread_streams = streams;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace core
+{
+    // One engine per subsystem, all derived from a single seed, so a game can be
+    // reproduced exactly from that seed plus its recorded input. Each subsystem
+    // draws from its own stream - adding a roll in one never shifts the others.
+    enum class RandomStream
+    {
+        Player,
+        Dice,
+        MapEvents,    // Portal / bonus tiles
+        Ai,           // AI roll delays and minigame timing
+        TileMemory,
+        Pattern,
+        Math,
+        Reaction,
+        Count
+    };
+
+    struct RandomStreams
+    {
+        std::uint64_t seed = 0;
+        std::array<std::mt19937, static_cast<std::size_t>(RandomStream::Count)> engines{};
+        bool seeded = false;
+    };
+
+    void seed_random_streams(RandomStreams& streams, std::uint64_t seed);
+
+    // Reseeds the process-wide streams. Only call while the simulation is not running.
+    void seed_random_streams(std::uint64_t seed);
+    std::uint64_t get_random_seed();
+
+    // Non-deterministic seed for a fresh game (random_device mixed with the clock)
+    std::uint64_t make_random_seed();
+
+    // Streams are only ever used from the simulation thread, unless a thread
+    // installs its own set below
+    std::mt19937& random_stream(RandomStream stream);
+
+    // Routes random_stream() on the calling thread to streams (nullptr goes back to
+    // the process-wide set). Lets a server run independent games on a worker pool.
+    void set_thread_random_streams(RandomStreams* streams);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace core
+{
+    // Lock-free single-producer / single-consumer triple buffer.
+    //
+    // The producer always owns one slot to write into, the consumer always owns
+    // one slot to read from, and the third slot is the hand-off between them.
+    // publish() swaps the producer's slot with the hand-off slot, acquire_latest()
+    // swaps the consumer's slot with it if something new was published. Neither
+    // side ever blocks and the consumer only ever sees the newest complete value;
+    // older ones that were never read are simply overwritten.
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        // Producer side
+        T& write_buffer() { return m_buffers[m_write_index]; }
+
+        void publish()
+        {
+            const std::uint8_t previous = m_shared.exchange(
+                static_cast<std::uint8_t>(m_write_index | FRESH_BIT), std::memory_order_acq_rel);
+            m_write_index = previous & INDEX_MASK;
+        }
+
+        // Consumer side - returns true if a newer value was picked up
+        bool acquire_latest()
+        {
+            if ((m_shared.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+            {
+                return false;
+            }
+            const std::uint8_t previous = m_shared.exchange(m_read_index, std::memory_order_acq_rel);
+            m_read_index = previous & INDEX_MASK;
+            return true;
+        }
+
+        const T& read_buffer() const { return m_buffers[m_read_index]; }
+
+    private:
+        static constexpr std::uint8_t INDEX_MASK = 0x3;
+        static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+        std::array<T, 3> m_buffers{};
+
+        // Each index is only touched by one thread - keep them on separate cache lines
+        alignas(64) std::uint8_t m_write_index = 0;
+        alignas(64) std::atomic<std::uint8_t> m_shared{1};
+        alignas(64) std::uint8_t m_read_index = 2;
+    };
+}
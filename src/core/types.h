@@ -36,17 +36,17 @@ struct Vertex
     glm::vec2 texcoord = glm::vec2(0.0f, 0.0f); // Texture coordinates (optional, default to 0,0)
 };
 
+struct Bounds
+{
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+};
+
 struct Mesh
 {
     GLuint vao = 0;
     GLuint vbo = 0;
     GLuint ebo = 0;
     GLsizei index_count = 0;
+    Bounds bounds;  // Object-space AABB of the vertices, filled by create_mesh
 };
-
-struct Bounds
-{
-    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
-    glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
-};
-
@@ -1,5 +1,7 @@
 #include "window.h"
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -9,6 +11,14 @@ namespace core
     {
         Window* g_window_instance = nullptr;
         std::function<void(double, double)> g_scroll_callback;
+        std::function<void(const KeyEvent&)> g_key_event_callback;
+
+        // Key state is mirrored from GLFW key events so it can be read from the
+        // simulation thread (glfwGetKey is main-thread only)
+        std::array<std::atomic<bool>, GLFW_KEY_LAST + 1> g_key_down{};
+        // The same edges in order with their time, so no tap between two ticks is lost
+        KeyEventQueue g_key_events;
+        std::atomic<bool> g_key_events_dropped{false};
 
         void framebuffer_size_callback(GLFWwindow* window, int width, int height)
         {
@@ -16,6 +26,32 @@ namespace core
             glViewport(0, 0, width, height);
         }
 
+        void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+        {
+            (void)window;
+            (void)scancode;
+            (void)mods;
+            if (key < 0 || key > GLFW_KEY_LAST)
+            {
+                return;
+            }
+            if (action != GLFW_PRESS && action != GLFW_RELEASE)
+            {
+                return;  // Auto-repeat is not an edge
+            }
+            const bool down = action == GLFW_PRESS;
+            g_key_down[key].store(down, std::memory_order_relaxed);
+            const KeyEvent event{glfwGetTime(), key, down};
+            if (!g_key_events.push(event))
+            {
+                g_key_events_dropped.store(true, std::memory_order_release);
+            }
+            if (g_key_event_callback)
+            {
+                g_key_event_callback(event);
+            }
+        }
+
         void scroll_callback_wrapper(GLFWwindow* window, double x_offset, double y_offset)
         {
             (void)window;
@@ -26,11 +62,28 @@ namespace core
         }
     }
 
-    Window::Window(int width, int height, const char* title)
+    Window::Window(int width, int height, const char* title, WindowMode mode)
+        : m_mode(mode)
+        , m_offscreen_width(width)
+        , m_offscreen_height(height)
     {
+        const bool offscreen = mode == WindowMode::Offscreen;
+        bool null_platform = false;
         if (!glfwInit())
         {
-            throw std::runtime_error("Failed to initialize GLFW");
+            // No display server (CI / build machines): GLFW's null platform can
+            // still create an OSMesa context, which is all offscreen rendering needs
+            if (!offscreen)
+            {
+                throw std::runtime_error("Failed to initialize GLFW");
+            }
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+            if (!glfwInit())
+            {
+                throw std::runtime_error("Failed to initialize GLFW (no display and no null platform)");
+            }
+            null_platform = true;
+            std::cout << "No display available, using OSMesa for offscreen rendering" << std::endl;
         }
 
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -39,6 +92,15 @@ namespace core
 #if defined(__APPLE__)
         glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
 #endif
+        if (offscreen)
+        {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            glfwWindowHint(GLFW_FOCUSED, GLFW_FALSE);
+        }
+        if (null_platform)
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        }
 
         m_window = glfwCreateWindow(width, height, title, nullptr, nullptr);
         if (!m_window)
@@ -50,7 +112,9 @@ namespace core
         glfwMakeContextCurrent(m_window);
         glfwSetFramebufferSizeCallback(m_window, framebuffer_size_callback);
         glfwSetScrollCallback(m_window, scroll_callback_wrapper);
-        glfwSwapInterval(1);
+        glfwSetKeyCallback(m_window, key_callback);
+        // Offscreen frames are never presented, so never wait for a display refresh
+        glfwSwapInterval(offscreen ? 0 : 1);
 
         if (gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)) == 0)
         {
@@ -59,6 +123,12 @@ namespace core
             throw std::runtime_error("Failed to initialize GLAD");
         }
 
+        if (offscreen)
+        {
+            g_window_instance = this;
+            return;
+        }
+
         // Ensure window is visible and focused (especially important on macOS)
         glfwShowWindow(m_window);
         glfwFocusWindow(m_window);
@@ -105,9 +175,34 @@ namespace core
         glfwSwapBuffers(m_window);
     }
 
+    void Window::set_vsync(bool enabled)
+    {
+        glfwSwapInterval(enabled ? 1 : 0);
+    }
+
     bool Window::is_key_pressed(int key) const
     {
-        return glfwGetKey(m_window, key) == GLFW_PRESS;
+        // Safe to call from any thread - updated by key_callback during poll_events()
+        if (key < 0 || key > GLFW_KEY_LAST)
+        {
+            return false;
+        }
+        return g_key_down[key].load(std::memory_order_relaxed);
+    }
+
+    const KeyEvent* Window::peek_key_event() const
+    {
+        return g_key_events.front();
+    }
+
+    void Window::pop_key_event()
+    {
+        g_key_events.pop();
+    }
+
+    bool Window::take_key_events_dropped()
+    {
+        return g_key_events_dropped.exchange(false, std::memory_order_acq_rel);
     }
 
     void Window::close()
@@ -117,6 +212,12 @@ namespace core
 
     void Window::get_framebuffer_size(int* width, int* height) const
     {
+        if (m_mode == WindowMode::Offscreen)
+        {
+            *width = m_offscreen_width;
+            *height = m_offscreen_height;
+            return;
+        }
         glfwGetFramebufferSize(m_window, width, height);
     }
 
@@ -132,5 +233,10 @@ namespace core
     {
         g_scroll_callback = callback;
     }
+
+    void Window::set_key_event_callback(std::function<void(const KeyEvent&)> callback)
+    {
+        g_key_event_callback = callback;
+    }
 }
 
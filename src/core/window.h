@@ -1,33 +1,60 @@
 #pragma once
 
+#include "key_events.h"
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <functional>
 
 namespace core
 {
+    enum class WindowMode
+    {
+        Visible,
+        // Hidden window whose context renders into an offscreen target of the
+        // requested size. Falls back to GLFW's null platform with an OSMesa
+        // context (e.g. Mesa llvmpipe) when no display is available.
+        Offscreen
+    };
+
     class Window
     {
     public:
-        Window(int width, int height, const char* title);
+        Window(int width, int height, const char* title, WindowMode mode = WindowMode::Visible);
         ~Window();
         
         bool should_close() const;
         void poll_events();
         void swap_buffers();
+        void set_vsync(bool enabled);
         
         GLFWwindow* get_handle() { return m_window; }
+        bool is_offscreen() const { return m_mode == WindowMode::Offscreen; }
         
         bool is_key_pressed(int key) const;
+        // Key presses and releases in the order they happened, stamped with
+        // glfwGetTime(). One consumer only (the simulation); nullptr when empty.
+        const KeyEvent* peek_key_event() const;
+        void pop_key_event();
+        // True once after the queue overflowed and events were dropped; the
+        // consumer should fall back to is_key_pressed for the current state
+        bool take_key_events_dropped();
         void close();
         
+        // Offscreen windows report the size they were created with, which is the
+        // size of the render target the caller binds, not the hidden window's
         void get_framebuffer_size(int* width, int* height) const;
         float get_aspect_ratio() const;
         
         void set_scroll_callback(std::function<void(double, double)> callback);
+        // Also sees every key event, on the main thread during poll_events()
+        void set_key_event_callback(std::function<void(const KeyEvent&)> callback);
 
     private:
         GLFWwindow* m_window = nullptr;
+        WindowMode m_mode = WindowMode::Visible;
+        int m_offscreen_width = 0;
+        int m_offscreen_height = 0;
     };
 }
 
@@ -1,5 +1,6 @@
 #include "game_loop.h"
 
+#include "../core/random.h"
 #include "../core/window.h"
 #include "../game/map/map_manager.h"
 #include "../game/player/player.h"
@@ -10,12 +11,13 @@
 #include "../game/minigame/math_minigame.h"
 #include "../game/minigame/pattern_minigame.h"
 #include "../rendering/animation_player.h"
+#include "render_interpolation.h"
+#include "save_state.h"
+#include "state_hash.h"
 
 #include <GLFW/glfw3.h>
 #include <algorithm>
-#include <sstream>
 #include <random>
-#include <chrono>
 #include <iostream>
 
 namespace game
@@ -40,8 +42,181 @@ namespace game
     {
     }
 
+    void GameLoop::set_input_replay(const InputLog* log)
+    {
+        m_replay = log;
+        m_replay_edge = 0;
+        m_replay_turn = 0;
+        m_replay_diverged = false;
+        m_input.reset();
+    }
+
+    void GameLoop::set_autosave(const std::filesystem::path& path)
+    {
+        m_autosave_path = path;
+        m_autosave_timer = 0.0f;
+        m_autosave_player = -1;  // Forces a save on the next tick
+    }
+
+    void GameLoop::update_autosave(float delta_time)
+    {
+        if (m_autosave_path.empty())
+        {
+            return;
+        }
+
+        // Saves describe the state at the end of the previous tick
+        m_autosave_timer += delta_time;
+        const bool changed = m_game_state.current_player_index != m_autosave_player ||
+                             m_game_state.menu_state.is_active != m_autosave_menu ||
+                             m_game_state.win_state.is_active != m_autosave_win;
+        if (!changed && m_autosave_timer < AUTOSAVE_INTERVAL)
+        {
+            return;
+        }
+
+        save_game_state(m_game_state, m_autosave_buffer);
+        if (!write_save_file(m_autosave_path, m_autosave_buffer))
+        {
+            std::cerr << "Warning: Autosave to " << m_autosave_path << " failed\n";
+        }
+        m_autosave_timer = 0.0f;
+        m_autosave_player = m_game_state.current_player_index;
+        m_autosave_menu = m_game_state.menu_state.is_active;
+        m_autosave_win = m_game_state.win_state.is_active;
+    }
+
+    void GameLoop::track_turn_hash()
+    {
+        // Like autosave, this sees the state at the end of the previous tick
+        const int player = m_game_state.current_player_index;
+        if (player == m_hash_player)
+        {
+            return;
+        }
+        m_hash_player = player;
+        const std::uint64_t hash = hash_turn_state(m_game_state.players.data(), m_game_state.num_players, player);
+
+        if (m_recording)
+        {
+            m_recording->turn_hashes.push_back({m_tick, hash});
+        }
+        if (!m_replay || m_replay_diverged || m_replay_turn >= m_replay->turn_hashes.size())
+        {
+            return;
+        }
+        const TurnHash& expected = m_replay->turn_hashes[m_replay_turn++];
+        if (expected.tick != m_tick || expected.hash != hash)
+        {
+            m_replay_diverged = true;
+            std::cerr << "Warning: Replay diverged at turn " << m_replay_turn << " (tick " << m_tick
+                      << "): recorded hash " << std::hex << expected.hash << " at tick " << std::dec << expected.tick
+                      << ", replayed " << std::hex << hash << std::dec << '\n';
+        }
+    }
+
+    float GameLoop::get_key_lag(int key) const
+    {
+        if (key < 0 || key > GLFW_KEY_LAST)
+        {
+            return 0.0f;
+        }
+        return static_cast<float>(m_key_lag_us[static_cast<std::size_t>(key)]) * 1e-6f;
+    }
+
+    void GameLoop::apply_key_edge(int key, bool down, std::uint32_t lag_us)
+    {
+        m_input.set_key(key, down);
+        m_key_lag_us[static_cast<std::size_t>(key)] = lag_us;
+        if (m_recording)
+        {
+            m_recording->edges.push_back({m_tick, key, down, lag_us});
+        }
+    }
+
+    void GameLoop::sample_input()
+    {
+        m_input.begin_tick();
+        read_key_edges();
+        m_input.end_tick_sampling();
+    }
+
+    void GameLoop::read_key_edges()
+    {
+        if (m_replay)
+        {
+            const std::vector<InputEdge>& edges = m_replay->edges;
+            while (m_replay_edge < edges.size() && edges[m_replay_edge].tick <= m_tick)
+            {
+                const InputEdge& edge = edges[m_replay_edge++];
+                if (edge.key >= 0 && edge.key <= GLFW_KEY_LAST)
+                {
+                    m_input.set_key(edge.key, edge.down);
+                    m_key_lag_us[static_cast<std::size_t>(edge.key)] = edge.lag_us;
+                }
+            }
+            return;
+        }
+
+        if (m_window.take_key_events_dropped())
+        {
+            // The queue overflowed, so its edges no longer add up - start over from the key state
+            while (m_window.peek_key_event())
+            {
+                m_window.pop_key_event();
+            }
+            for (int key = 0; key <= GLFW_KEY_LAST; ++key)
+            {
+                const bool down = m_window.is_key_pressed(key);
+                if (down != m_input.is_down(key))
+                {
+                    apply_key_edge(key, down, 0);
+                }
+            }
+            return;
+        }
+
+        // Lags are whole microseconds and capped, so recordings replay exactly
+        constexpr double MAX_KEY_LAG = 0.25;
+        while (const core::KeyEvent* event = m_window.peek_key_event())
+        {
+            if (event->key < 0 || event->key > GLFW_KEY_LAST)
+            {
+                m_window.pop_key_event();
+                continue;
+            }
+            if (m_input_time >= 0.0 && event->time > m_input_time)
+            {
+                break;  // Happened after this tick; a later one picks it up
+            }
+            if (m_input.has_edge(event->key))
+            {
+                // Second edge of a key in one tick (a tap shorter than a tick):
+                // leave it for the next tick so the handlers see the press
+                break;
+            }
+            const double lag = m_input_time >= 0.0 ? std::min(m_input_time - event->time, MAX_KEY_LAG) : 0.0;
+            const bool down = event->down;
+            const int key = event->key;
+            m_window.pop_key_event();
+            if (down != m_input.is_down(key))
+            {
+                apply_key_edge(key, down, static_cast<std::uint32_t>(lag * 1e6 + 0.5));
+            }
+        }
+    }
+
     void GameLoop::update(float delta_time)
     {
+        // Everything below reads input through m_input, never the window directly
+        sample_input();
+        ++m_tick;
+        update_autosave(delta_time);
+        track_turn_hash();
+
+        // Remember where everything was before this tick so the renderer can blend
+        store_previous_transforms(m_game_state);
+
         handle_input(delta_time);
         
         // Don't update game if menu or win screen is active
@@ -63,45 +238,23 @@ namespace game
         using namespace game::map;
 
         // Handle menu input
-        // Static variables for menu key debouncing (shared across menu active/inactive)
-        static bool menu_up_was_pressed = false;
-        static bool menu_down_was_pressed = false;
-        static bool menu_left_was_pressed = false;
-        static bool menu_right_was_pressed = false;
-        static bool menu_enter_was_pressed = false;
-        static bool menu_space_was_pressed = false;
-        static bool menu_was_active = false;
-        
+        // Only presses count, so keys still held from the previous screen (e.g.
+        // Space from the win screen) do nothing until released and pressed again
         if (m_game_state.menu_state.is_active)
         {
-            // Reset key states if menu just became active (to prevent key carryover from previous screen)
-            if (!menu_was_active)
-            {
-                // When menu just became active, mark all currently pressed keys as "already pressed"
-                // This forces user to release and press again, preventing key carryover
-                // This is especially important for Space key from win screen
-                menu_up_was_pressed = m_window.is_key_pressed(GLFW_KEY_UP) || m_window.is_key_pressed(GLFW_KEY_W);
-                menu_down_was_pressed = m_window.is_key_pressed(GLFW_KEY_DOWN) || m_window.is_key_pressed(GLFW_KEY_S);
-                menu_left_was_pressed = m_window.is_key_pressed(GLFW_KEY_LEFT) || m_window.is_key_pressed(GLFW_KEY_A);
-                menu_right_was_pressed = m_window.is_key_pressed(GLFW_KEY_RIGHT) || m_window.is_key_pressed(GLFW_KEY_D);
-                menu_enter_was_pressed = m_window.is_key_pressed(GLFW_KEY_ENTER);
-                menu_space_was_pressed = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            }
-            menu_was_active = true;
-            
-            const bool up_pressed = m_window.is_key_pressed(GLFW_KEY_UP) || m_window.is_key_pressed(GLFW_KEY_W);
-            const bool down_pressed = m_window.is_key_pressed(GLFW_KEY_DOWN) || m_window.is_key_pressed(GLFW_KEY_S);
-            const bool left_pressed = m_window.is_key_pressed(GLFW_KEY_LEFT) || m_window.is_key_pressed(GLFW_KEY_A);
-            const bool right_pressed = m_window.is_key_pressed(GLFW_KEY_RIGHT) || m_window.is_key_pressed(GLFW_KEY_D);
-            const bool enter_pressed = m_window.is_key_pressed(GLFW_KEY_ENTER);
-            const bool space_pressed = m_window.is_key_pressed(GLFW_KEY_SPACE);
+            const bool up_pressed = m_input.was_pressed(GLFW_KEY_UP) || m_input.was_pressed(GLFW_KEY_W);
+            const bool down_pressed = m_input.was_pressed(GLFW_KEY_DOWN) || m_input.was_pressed(GLFW_KEY_S);
+            const bool left_pressed = m_input.was_pressed(GLFW_KEY_LEFT) || m_input.was_pressed(GLFW_KEY_A);
+            const bool right_pressed = m_input.was_pressed(GLFW_KEY_RIGHT) || m_input.was_pressed(GLFW_KEY_D);
+            const bool enter_pressed = m_input.was_pressed(GLFW_KEY_ENTER);
+            const bool space_pressed = m_input.was_pressed(GLFW_KEY_SPACE);
             
             // Navigate menu options (only between Players and AI, not Start button)
-            if (up_pressed && !menu_up_was_pressed)
+            if (up_pressed)
             {
                 m_game_state.menu_state.selected_option = (m_game_state.menu_state.selected_option - 1 + 2) % 2;
             }
-            if (down_pressed && !menu_down_was_pressed)
+            if (down_pressed)
             {
                 m_game_state.menu_state.selected_option = (m_game_state.menu_state.selected_option + 1) % 2;
             }
@@ -110,12 +263,12 @@ namespace game
             if (m_game_state.menu_state.selected_option == 0)
             {
                 // Number of players
-                if (left_pressed && !menu_left_was_pressed)
+                if (left_pressed)
                 {
                     // Minimum 2 players (ห้ามต่ำกว่า 2)
                     m_game_state.menu_state.num_players = std::max(2, m_game_state.menu_state.num_players - 1);
                 }
-                if (right_pressed && !menu_right_was_pressed)
+                if (right_pressed)
                 {
                     m_game_state.menu_state.num_players = std::min(4, m_game_state.menu_state.num_players + 1);
                 }
@@ -123,8 +276,7 @@ namespace game
             else if (m_game_state.menu_state.selected_option == 1)
             {
                 // AI toggle
-                if ((left_pressed && !menu_left_was_pressed) || (right_pressed && !menu_right_was_pressed) || 
-                    (enter_pressed && !menu_enter_was_pressed))
+                if (left_pressed || right_pressed || enter_pressed)
                 {
                     m_game_state.menu_state.use_ai = !m_game_state.menu_state.use_ai;
                 }
@@ -132,8 +284,7 @@ namespace game
             
              // Start game with Space (regardless of selected option)
              // Enter can also start game if not on AI option (Enter on AI option toggles AI)
-             // Only start if Space was just pressed (not held down from previous screen)
-             if ((space_pressed && !menu_space_was_pressed) || (enter_pressed && !menu_enter_was_pressed && m_game_state.menu_state.selected_option == 0))
+             if (space_pressed || (enter_pressed && m_game_state.menu_state.selected_option == 0))
              {
                  // Set number of players from menu
                  m_game_state.num_players = m_game_state.menu_state.num_players;
@@ -143,8 +294,7 @@ namespace game
                  for (int i = 0; i < m_game_state.num_players; ++i)
                  {
                      game::player::warp_to_tile(m_game_state.players[i], 0);
-                     m_game_state.players[i].steps_remaining = 0;
-                     m_game_state.players[i].is_stepping = false;
+                     game::player::stop_walking(m_game_state.players[i]);
                      m_game_state.last_processed_tiles[i] = 0;
                      // Set AI flag: if use_ai is true, player 1 (index 0) is human, others are AI
                      // Or if use_ai is true and num_players > 1, make player 1 (index 1) AI
@@ -159,20 +309,8 @@ namespace game
                  m_game_state.menu_state.start_game = true;
              }
             
-            menu_up_was_pressed = up_pressed;
-            menu_down_was_pressed = down_pressed;
-            menu_left_was_pressed = left_pressed;
-            menu_right_was_pressed = right_pressed;
-            menu_enter_was_pressed = enter_pressed;
-            menu_space_was_pressed = space_pressed;
-            
             return;
         }
-        else
-        {
-            // Mark menu as inactive when not active
-            menu_was_active = false;
-        }
 
         // Handle win screen input - return to menu with Space
         if (m_game_state.win_state.is_active && m_game_state.win_state.show_animation)
@@ -180,9 +318,7 @@ namespace game
             // Update animation timer (needed for animation even though game logic doesn't update)
             m_game_state.win_state.animation_timer += delta_time;
             
-            const bool space_pressed = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            const bool space_just_pressed = space_pressed && !m_game_state.win_state.previous_space_state;
-            if (space_just_pressed)
+            if (m_input.was_pressed(GLFW_KEY_SPACE))
             {
                 // Return to main menu
                 m_game_state.win_state.is_active = false;
@@ -192,8 +328,7 @@ namespace game
                  for (int i = 0; i < m_game_state.num_players; ++i)
                  {
                      game::player::warp_to_tile(m_game_state.players[i], 0);
-                     m_game_state.players[i].steps_remaining = 0;
-                     m_game_state.players[i].is_stepping = false;
+                     game::player::stop_walking(m_game_state.players[i]);
                  }
                  m_game_state.current_player_index = 0;
                 m_game_state.last_processed_tile = 0;
@@ -217,18 +352,6 @@ namespace game
                 m_game_state.dice_state.roll_timer = 0.0f;
                 m_game_state.dice_display_timer = 0.0f;
                 
-                // Reset all key states
-                m_game_state.tile_memory_previous_keys.fill(false);
-                m_game_state.tile_memory_backspace_was_down = false;
-                m_game_state.tile_memory_enter_was_down = false;
-                m_game_state.precision_space_was_down = false;
-                m_game_state.reaction_backspace_was_down = false;
-                m_game_state.reaction_enter_was_down = false;
-                m_game_state.math_backspace_was_down = false;
-                m_game_state.math_enter_was_down = false;
-                m_game_state.math_digit_previous.fill(false);
-                m_game_state.pattern_previous_keys.fill(false);
-                
                 // Reset result flags
                 m_game_state.precision_result_applied = false;
                 m_game_state.tile_memory_result_applied = false;
@@ -238,13 +361,8 @@ namespace game
                 m_game_state.minigame_message.clear();
                 m_game_state.minigame_message_timer = 0.0f;
             }
-            m_game_state.win_state.previous_space_state = space_pressed;
             return;
         }
-        else if (!m_game_state.win_state.is_active)
-        {
-            m_game_state.win_state.previous_space_state = false;
-        }
 
         auto& current_player = get_current_player(m_game_state);
         
@@ -255,20 +373,14 @@ namespace game
             return;  // AI handles its own input, skip human input handling
         }
         
-        const bool space_pressed = m_window.is_key_pressed(GLFW_KEY_SPACE);
-        const bool space_just_pressed = space_pressed && !current_player.previous_space_state;
+        const bool space_just_pressed = m_input.was_pressed(GLFW_KEY_SPACE);
         
         // Handle minigame title screen - wait for Space to start
         if (m_game_state.minigame_state.status == game::minigame::PrecisionTimingStatus::ShowingTitle)
         {
             if (space_just_pressed)
             {
-                m_game_state.minigame_state.status = game::minigame::PrecisionTimingStatus::Running;
-                m_game_state.minigame_state.title_timer = m_game_state.minigame_state.title_duration; // Skip title timer
-                m_game_state.minigame_state.display_text = "Press SPACE to stop at 4.99!"; // Clear title/bonus text
-                // Reset precision_space_was_down to prevent the Space key used to start the game
-                // from being counted as stopping the timer
-                m_game_state.precision_space_was_down = true; // Mark Space as already pressed
+                game::minigame::skip_title(m_game_state.minigame_state, get_key_lag(GLFW_KEY_SPACE));
             }
             return;
         }
@@ -276,12 +388,8 @@ namespace game
         {
             if (space_just_pressed)
             {
-                // The state is already initialized by start(), we just need to transition to the first round
-                // We'll manually trigger the advance() logic that would normally happen after title_duration
-                // This will call start_round internally
-                m_game_state.tile_memory_state.title_timer = m_game_state.tile_memory_state.title_duration; // Skip title timer
-                // Reset key states to prevent multiple inputs
-                m_game_state.tile_memory_previous_keys.fill(false);
+                // advance() starts the first round once the title timer has run out
+                game::minigame::tile_memory::skip_title(m_game_state.tile_memory_state);
                 // Let advance() handle the transition - it will check title_timer >= title_duration
             }
             return;
@@ -291,15 +399,7 @@ namespace game
             if (space_just_pressed)
             {
                 // Start game immediately when Space is pressed - skip InitialMessage phase
-                m_game_state.reaction_state.phase = game::minigame::ReactionState::Phase::PlayerTurn;
-                m_game_state.reaction_state.timer = 0.0f;
-                m_game_state.reaction_state.title_timer = m_game_state.reaction_state.title_duration; // Skip title timer
-                m_game_state.reaction_state.player_attempts = 0;
-                m_game_state.reaction_state.input_buffer.clear();
-                // Set display text for player input
-                std::ostringstream ss;
-                ss << "Guess " << (m_game_state.reaction_state.player_attempts + 1) << "/" << m_game_state.reaction_state.max_attempts << " : input _\n(space)";
-                m_game_state.reaction_state.display_text = ss.str();
+                game::minigame::skip_title(m_game_state.reaction_state);
             }
             return;
         }
@@ -307,10 +407,7 @@ namespace game
         {
             if (space_just_pressed)
             {
-                m_game_state.math_state.phase = game::minigame::MathQuizState::Phase::ShowingQuestion;
-                m_game_state.math_state.timer = 0.0f;
-                m_game_state.math_state.title_timer = m_game_state.math_state.title_duration; // Skip title timer
-                m_game_state.math_state.display_text.clear(); // Clear title/bonus text
+                game::minigame::skip_title(m_game_state.math_state);
             }
             return;
         }
@@ -318,18 +415,7 @@ namespace game
         {
             if (space_just_pressed)
             {
-                m_game_state.pattern_state.phase = game::minigame::PatternMatchingState::Phase::ShowingPattern;
-                m_game_state.pattern_state.show_timer = 0.0f;
-                m_game_state.pattern_state.title_timer = m_game_state.pattern_state.title_duration; // Skip title timer
-                // Generate pattern text using key letters (W S A D) that match the input keys
-                std::ostringstream oss;
-                for (int i = 0; i < 4; ++i)
-                {
-                    const char* dirs[] = {"", "W", "S", "A", "D"};
-                    oss << dirs[m_game_state.pattern_state.pattern[i]];
-                    if (i < 3) oss << " ";
-                }
-                m_game_state.pattern_state.display_text = oss.str(); // Set pattern text, clears title/bonus
+                game::minigame::skip_title(m_game_state.pattern_state);
             }
             return;
         }
@@ -388,168 +474,40 @@ namespace game
         // Handle precision timing input
         if (precision_running)
         {
-            const bool space_down = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            const bool space_just_pressed_for_minigame = space_down && !m_game_state.precision_space_was_down;
-            m_game_state.precision_space_was_down = space_down;
-
-            if (space_just_pressed_for_minigame)
+            if (m_input.was_pressed(GLFW_KEY_SPACE))
             {
-                game::minigame::stop_timing(m_game_state.minigame_state);
+                game::minigame::stop_timing(m_game_state.minigame_state, get_key_lag(GLFW_KEY_SPACE));
             }
             else if (game::minigame::has_expired(m_game_state.minigame_state))
             {
                 game::minigame::stop_timing(m_game_state.minigame_state);
             }
         }
-        else
-        {
-            m_game_state.precision_space_was_down = false;
-        }
 
-        // Handle tile memory input (uses buffer with Enter/Space to submit)
-        static game::minigame::tile_memory::Phase previous_tile_memory_phase = game::minigame::tile_memory::Phase::Inactive;
-        static float tile_memory_key_cooldown[9] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
-        const float KEY_COOLDOWN_TIME = 0.15f; // 150ms cooldown to prevent key repeat
-        
-        if (tile_memory_running)
+        const bool submit_pressed = m_input.was_pressed(GLFW_KEY_SPACE) || m_input.was_pressed(GLFW_KEY_ENTER) ||
+                                    m_input.was_pressed(GLFW_KEY_KP_ENTER);
+
+        // Handle tile memory input (uses buffer with Enter/Space to submit). Keys
+        // held since the sequence was shown are not presses, so they add nothing.
+        if (tile_memory_running && m_game_state.tile_memory_state.phase == game::minigame::tile_memory::Phase::WaitingInput)
         {
-            const auto current_phase = m_game_state.tile_memory_state.phase;
-            
-            // Check if phase just changed to WaitingInput - reset key states immediately
-            if (current_phase == game::minigame::tile_memory::Phase::WaitingInput && 
-                previous_tile_memory_phase != game::minigame::tile_memory::Phase::WaitingInput)
+            for (int key_index = 0; key_index < 9; ++key_index)
             {
-                // Phase just changed to WaitingInput
-                // Mark all currently pressed keys as "already pressed" to force release before accepting input
-                // This prevents keys held from previous phase from triggering actions
-                for (int key_index = 0; key_index < 9; ++key_index)
+                if (m_input.was_pressed(GLFW_KEY_1 + key_index))
                 {
-                    const int glfw_key = GLFW_KEY_1 + key_index;
-                    // Set to true if key is currently pressed - user must release and press again
-                    m_game_state.tile_memory_previous_keys[key_index] = m_window.is_key_pressed(glfw_key);
-                    // Reset cooldown when phase changes
-                    tile_memory_key_cooldown[key_index] = 0.0f;
+                    game::minigame::tile_memory::add_digit(m_game_state.tile_memory_state, static_cast<char>('1' + key_index));
                 }
-                // Same for backspace and enter/space - mark as pressed if currently down
-                m_game_state.tile_memory_backspace_was_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-                m_game_state.tile_memory_enter_was_down = m_window.is_key_pressed(GLFW_KEY_SPACE) || 
-                                                          m_window.is_key_pressed(GLFW_KEY_ENTER) ||
-                                                          m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
             }
-            
-            previous_tile_memory_phase = current_phase;
-            
-            // Only accept input when in WaitingInput phase
-            if (current_phase == game::minigame::tile_memory::Phase::WaitingInput)
-            {
-                // Update cooldown timers
-                for (int key_index = 0; key_index < 9; ++key_index)
-                {
-                    if (tile_memory_key_cooldown[key_index] > 0.0f)
-                    {
-                        tile_memory_key_cooldown[key_index] -= delta_time;
-                        if (tile_memory_key_cooldown[key_index] < 0.0f)
-                        {
-                            tile_memory_key_cooldown[key_index] = 0.0f;
-                        }
-                    }
-                }
-                
-                // Handle digit input (1-9)
-                // Use strict edge detection with cooldown: only trigger when key transitions from released to pressed
-                // AND cooldown has expired to prevent key repeat
-                bool processed_digit_this_frame = false;
-                
-                // First pass: detect rising edges and process ONE key press
-                for (int key_index = 0; key_index < 9; ++key_index)
-                {
-                    if (processed_digit_this_frame)
-                        break; // Only process one key per frame
-                        
-                    const int glfw_key = GLFW_KEY_1 + key_index;
-                    const bool key_down_now = m_window.is_key_pressed(glfw_key);
-                    const bool key_down_before = m_game_state.tile_memory_previous_keys[key_index];
-                    const bool cooldown_expired = tile_memory_key_cooldown[key_index] <= 0.0f;
-                    
-                    // Strict rising edge detection with cooldown: 
-                    // 1. Key was NOT pressed before (key_down_before == false) - ensures key was released
-                    // 2. Key IS pressed now (key_down_now == true) - detects new press
-                    // 3. Cooldown has expired - prevents rapid key repeat
-                    if (key_down_now && !key_down_before && cooldown_expired)
-                    {
-                        // Add digit only once per key press
-                        game::minigame::tile_memory::add_digit(m_game_state.tile_memory_state, static_cast<char>('1' + key_index));
-                        // Mark as processed to prevent processing other keys in same frame
-                        processed_digit_this_frame = true;
-                        // Set cooldown to prevent immediate repeat
-                        tile_memory_key_cooldown[key_index] = KEY_COOLDOWN_TIME;
-                        // Immediately mark this key as pressed to prevent repeat in same frame
-                        m_game_state.tile_memory_previous_keys[key_index] = true;
-                    }
-                }
-                
-                // Second pass: update ALL key states AFTER processing
-                // This is critical - we must update states for all keys to track their current state
-                for (int key_index = 0; key_index < 9; ++key_index)
-                {
-                    const int glfw_key = GLFW_KEY_1 + key_index;
-                    const bool key_down_now = m_window.is_key_pressed(glfw_key);
-                    
-                    // Update state - if key is released, reset cooldown
-                    if (!key_down_now)
-                    {
-                        // Key is released - reset cooldown and update state
-                        tile_memory_key_cooldown[key_index] = 0.0f;
-                        m_game_state.tile_memory_previous_keys[key_index] = false;
-                    }
-                    else if (!processed_digit_this_frame || !m_game_state.tile_memory_previous_keys[key_index])
-                    {
-                        // Update state for keys that weren't just processed
-                        m_game_state.tile_memory_previous_keys[key_index] = key_down_now;
-                    }
-                }
 
-                // Handle Backspace
-                const bool backspace_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-                if (backspace_down && !m_game_state.tile_memory_backspace_was_down)
-                {
-                    game::minigame::tile_memory::remove_digit(m_game_state.tile_memory_state);
-                }
-                m_game_state.tile_memory_backspace_was_down = backspace_down;
-
-                // Handle Enter/Space to submit
-                // Only submit if buffer is not empty to prevent accidental submission
-                const bool space_down = m_window.is_key_pressed(GLFW_KEY_SPACE);
-                const bool enter_down = m_window.is_key_pressed(GLFW_KEY_ENTER) ||
-                                        m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
-                if ((space_down || enter_down) && !m_game_state.tile_memory_enter_was_down)
-                {
-                    // Only submit if buffer has content
-                    if (!m_game_state.tile_memory_state.input_buffer.empty())
-                    {
-                        game::minigame::tile_memory::submit_buffer(m_game_state.tile_memory_state);
-                    }
-                }
-                m_game_state.tile_memory_enter_was_down = space_down || enter_down;
-            }
-            else
+            if (m_input.was_pressed(GLFW_KEY_BACKSPACE))
             {
-                // Reset all key states when not in WaitingInput phase to prevent key repeat
-                m_game_state.tile_memory_previous_keys.fill(false);
-                m_game_state.tile_memory_backspace_was_down = false;
-                m_game_state.tile_memory_enter_was_down = false;
+                game::minigame::tile_memory::remove_digit(m_game_state.tile_memory_state);
             }
-        }
-        else
-        {
-            previous_tile_memory_phase = game::minigame::tile_memory::Phase::Inactive;
-            m_game_state.tile_memory_previous_keys.fill(false);
-            m_game_state.tile_memory_backspace_was_down = false;
-            m_game_state.tile_memory_enter_was_down = false;
-            // Reset cooldowns when game is not running
-            for (int key_index = 0; key_index < 9; ++key_index)
+
+            // Only submit if buffer has content to prevent accidental submission
+            if (submit_pressed && !m_game_state.tile_memory_state.input_buffer.empty())
             {
-                tile_memory_key_cooldown[key_index] = 0.0f;
+                game::minigame::tile_memory::submit_buffer(m_game_state.tile_memory_state);
             }
         }
 
@@ -559,43 +517,21 @@ namespace game
             // Handle digit input (1-9)
             for (int digit = 1; digit <= 9; ++digit)
             {
-                const int key = GLFW_KEY_0 + digit;
-                const bool key_down = m_window.is_key_pressed(key);
-                const bool key_just_pressed = key_down && !m_game_state.tile_memory_previous_keys[digit];
-                if (key_just_pressed)
+                if (m_input.was_pressed(GLFW_KEY_0 + digit))
                 {
                     game::minigame::add_digit(m_game_state.reaction_state, static_cast<char>('0' + digit));
                 }
-                m_game_state.tile_memory_previous_keys[digit] = key_down;
             }
 
-            // Handle Backspace
-            const bool backspace_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-            if (backspace_down && !m_game_state.reaction_backspace_was_down)
+            if (m_input.was_pressed(GLFW_KEY_BACKSPACE))
             {
                 game::minigame::remove_digit(m_game_state.reaction_state);
             }
-            m_game_state.reaction_backspace_was_down = backspace_down;
 
-            // Handle Enter/Space to submit
-            const bool space_down = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            const bool enter_down = m_window.is_key_pressed(GLFW_KEY_ENTER) ||
-                                    m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
-            if ((space_down || enter_down) && !m_game_state.reaction_enter_was_down)
+            if (submit_pressed)
             {
                 game::minigame::submit_buffer(m_game_state.reaction_state);
             }
-            m_game_state.reaction_enter_was_down = space_down || enter_down;
-        }
-        else
-        {
-            // Reset key states when game is not running
-            for (int digit = 1; digit <= 9; ++digit)
-            {
-                m_game_state.tile_memory_previous_keys[digit] = false;
-            }
-            m_game_state.reaction_backspace_was_down = false;
-            m_game_state.reaction_enter_was_down = false;
         }
 
         // Handle math game input (multi-digit)
@@ -603,157 +539,101 @@ namespace game
         {
             for (int digit = 0; digit <= 9; ++digit)
             {
-                const int key = GLFW_KEY_0 + digit;
-                const bool key_down = m_window.is_key_pressed(key);
-                const bool key_just_pressed = key_down && !m_game_state.math_digit_previous[digit];
-                if (key_just_pressed && m_game_state.math_state.input_buffer.size() < 3)
+                if (m_input.was_pressed(GLFW_KEY_0 + digit) && m_game_state.math_state.input_buffer.size() < 3)
                 {
                     game::minigame::add_digit(m_game_state.math_state, static_cast<char>('0' + digit));
                 }
-                m_game_state.math_digit_previous[digit] = key_down;
             }
 
-            const bool delete_down = m_window.is_key_pressed(GLFW_KEY_DELETE);
-            const bool backspace_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-            if ((delete_down || backspace_down) && !m_game_state.math_backspace_was_down)
+            if (m_input.was_pressed(GLFW_KEY_DELETE) || m_input.was_pressed(GLFW_KEY_BACKSPACE))
             {
                 game::minigame::remove_digit(m_game_state.math_state);
             }
-            m_game_state.math_backspace_was_down = delete_down || backspace_down;
 
-            const bool space_down = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            const bool enter_down = m_window.is_key_pressed(GLFW_KEY_ENTER) ||
-                                    m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
-            if ((space_down || enter_down) && !m_game_state.math_enter_was_down)
+            if (submit_pressed)
             {
                 game::minigame::submit_buffer(m_game_state.math_state);
             }
-            m_game_state.math_enter_was_down = space_down || enter_down;
-        }
-        else
-        {
-            // Reset key states when game is not running
-            m_game_state.math_digit_previous.fill(false);
-            m_game_state.math_backspace_was_down = false;
-            m_game_state.math_enter_was_down = false;
         }
 
         // Handle pattern game input
         if (pattern_running)
         {
             // Handle character input (W, S, A, D)
-            const bool w_down = m_window.is_key_pressed(GLFW_KEY_W);
-            const bool s_down = m_window.is_key_pressed(GLFW_KEY_S);
-            const bool a_down = m_window.is_key_pressed(GLFW_KEY_A);
-            const bool d_down = m_window.is_key_pressed(GLFW_KEY_D);
-
-            if (w_down && !m_game_state.pattern_previous_keys[0])
+            if (m_input.was_pressed(GLFW_KEY_W))
             {
                 game::minigame::add_char_input(m_game_state.pattern_state, 'W');
             }
-            if (s_down && !m_game_state.pattern_previous_keys[1])
+            if (m_input.was_pressed(GLFW_KEY_S))
             {
                 game::minigame::add_char_input(m_game_state.pattern_state, 'S');
             }
-            if (a_down && !m_game_state.pattern_previous_keys[2])
+            if (m_input.was_pressed(GLFW_KEY_A))
             {
                 game::minigame::add_char_input(m_game_state.pattern_state, 'A');
             }
-            if (d_down && !m_game_state.pattern_previous_keys[3])
+            if (m_input.was_pressed(GLFW_KEY_D))
             {
                 game::minigame::add_char_input(m_game_state.pattern_state, 'D');
             }
 
-            m_game_state.pattern_previous_keys[0] = w_down;
-            m_game_state.pattern_previous_keys[1] = s_down;
-            m_game_state.pattern_previous_keys[2] = a_down;
-            m_game_state.pattern_previous_keys[3] = d_down;
-
             // Handle Backspace to delete
-            const bool backspace_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-            if (backspace_down && !m_game_state.pattern_previous_keys[4])
+            if (m_input.was_pressed(GLFW_KEY_BACKSPACE))
             {
                 game::minigame::delete_char(m_game_state.pattern_state);
             }
-            m_game_state.pattern_previous_keys[4] = backspace_down;
 
-            // Handle Enter/Space to submit
-            const bool enter_down = m_window.is_key_pressed(GLFW_KEY_ENTER) || 
-                                    m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
-            const bool space_down = m_window.is_key_pressed(GLFW_KEY_SPACE);
-            if ((enter_down || space_down) && !m_game_state.pattern_previous_keys[5])
+            if (submit_pressed)
             {
                 game::minigame::submit_answer(m_game_state.pattern_state);
             }
-            m_game_state.pattern_previous_keys[5] = (enter_down || space_down);
         }
 
         // Handle volume controls (+/-)
-        const bool plus_key_down = m_window.is_key_pressed(GLFW_KEY_EQUAL) || 
-                                   m_window.is_key_pressed(GLFW_KEY_KP_ADD);
-        const bool minus_key_down = m_window.is_key_pressed(GLFW_KEY_MINUS) || 
-                                    m_window.is_key_pressed(GLFW_KEY_KP_SUBTRACT);
-        
-        static bool plus_was_pressed = false;
-        static bool minus_was_pressed = false;
-        
-        if (plus_key_down && !plus_was_pressed)
+        if (m_input.was_pressed(GLFW_KEY_EQUAL) || m_input.was_pressed(GLFW_KEY_KP_ADD))
         {
             m_game_state.audio_manager.increase_volume(0.1f);
             std::cout << "Volume: " << (int)(m_game_state.audio_manager.get_master_volume() * 100) << "%" << std::endl;
         }
-        if (minus_key_down && !minus_was_pressed)
+        if (m_input.was_pressed(GLFW_KEY_MINUS) || m_input.was_pressed(GLFW_KEY_KP_SUBTRACT))
         {
             m_game_state.audio_manager.decrease_volume(0.1f);
             std::cout << "Volume: " << (int)(m_game_state.audio_manager.get_master_volume() * 100) << "%" << std::endl;
         }
-        plus_was_pressed = plus_key_down;
-        minus_was_pressed = minus_key_down;
         
         // Handle debug warp input
-        const bool t_key_down = m_window.is_key_pressed(GLFW_KEY_T);
-        if (t_key_down && !m_game_state.debug_warp_state.prev_toggle && !minigame_running)
+        if (m_input.was_pressed(GLFW_KEY_T) && !minigame_running)
         {
             m_game_state.debug_warp_state.active = !m_game_state.debug_warp_state.active;
             if (!m_game_state.debug_warp_state.active)
             {
                 m_game_state.debug_warp_state.buffer.clear();
-                m_game_state.debug_warp_state.digit_previous.fill(false);
             }
         }
-        m_game_state.debug_warp_state.prev_toggle = t_key_down;
 
         if (m_game_state.debug_warp_state.active && minigame_running)
         {
             m_game_state.debug_warp_state.active = false;
             m_game_state.debug_warp_state.buffer.clear();
-            m_game_state.debug_warp_state.digit_previous.fill(false);
         }
 
         if (m_game_state.debug_warp_state.active)
         {
             for (int digit = 0; digit <= 9; ++digit)
             {
-                const int key = GLFW_KEY_0 + digit;
-                const bool key_down = m_window.is_key_pressed(key);
-                const bool key_just_pressed = key_down && !m_game_state.debug_warp_state.digit_previous[digit];
-                if (key_just_pressed && m_game_state.debug_warp_state.buffer.size() < 3)
+                if (m_input.was_pressed(GLFW_KEY_0 + digit) && m_game_state.debug_warp_state.buffer.size() < 3)
                 {
                     m_game_state.debug_warp_state.buffer.push_back(static_cast<char>('0' + digit));
                 }
-                m_game_state.debug_warp_state.digit_previous[digit] = key_down;
             }
 
-            const bool backspace_down = m_window.is_key_pressed(GLFW_KEY_BACKSPACE);
-            if (backspace_down && !m_game_state.debug_warp_state.prev_backspace && !m_game_state.debug_warp_state.buffer.empty())
+            if (m_input.was_pressed(GLFW_KEY_BACKSPACE) && !m_game_state.debug_warp_state.buffer.empty())
             {
                 m_game_state.debug_warp_state.buffer.pop_back();
             }
-            m_game_state.debug_warp_state.prev_backspace = backspace_down;
 
-            const bool enter_down = m_window.is_key_pressed(GLFW_KEY_ENTER) ||
-                                    m_window.is_key_pressed(GLFW_KEY_KP_ENTER);
-            if (enter_down && !m_game_state.debug_warp_state.prev_enter && !m_game_state.debug_warp_state.buffer.empty())
+            const bool enter_pressed = m_input.was_pressed(GLFW_KEY_ENTER) || m_input.was_pressed(GLFW_KEY_KP_ENTER);
+            if (enter_pressed && !m_game_state.debug_warp_state.buffer.empty())
             {
                 try
                 {
@@ -769,9 +649,7 @@ namespace game
                     m_game_state.last_processed_tiles[m_game_state.current_player_index] = -1;
                     
                     // Ensure player is stopped so tile activity can be checked
-                    warped_player.is_stepping = false;
-                    warped_player.steps_remaining = 0;
-                    warped_player.previous_space_state = false;
+                    game::player::stop_walking(warped_player);
 
                     m_game_state.dice_state.is_rolling = false;
                     m_game_state.dice_state.is_falling = false;
@@ -796,7 +674,6 @@ namespace game
                     m_game_state.math_result_applied = false;
                     m_game_state.pattern_result_applied = false;
                     m_game_state.precision_result_display_timer = 5.0f;
-                    m_game_state.tile_memory_previous_keys.fill(false);
                     m_game_state.minigame_message.clear();
                     m_game_state.minigame_message_timer = 0.0f;
 
@@ -805,7 +682,6 @@ namespace game
                     m_game_state.debug_warp_state.notification_timer = 0.0f;
                     m_game_state.debug_warp_state.buffer.clear();
                     m_game_state.debug_warp_state.active = false;
-                    m_game_state.debug_warp_state.digit_previous.fill(false);
                 }
                 catch (const std::exception&)
                 {
@@ -813,24 +689,14 @@ namespace game
                     m_game_state.debug_warp_state.notification_timer = 3.0f;
                     m_game_state.debug_warp_state.buffer.clear();
                     m_game_state.debug_warp_state.active = false;
-                    m_game_state.debug_warp_state.digit_previous.fill(false);
                 }
             }
-            m_game_state.debug_warp_state.prev_enter = enter_down;
-        }
-        else
-        {
-            m_game_state.debug_warp_state.digit_previous.fill(false);
-            m_game_state.debug_warp_state.prev_backspace = false;
-            m_game_state.debug_warp_state.prev_enter = false;
         }
 
         if (m_game_state.debug_warp_state.notification_timer > 0.0f)
         {
             m_game_state.debug_warp_state.notification_timer = std::max(0.0f, m_game_state.debug_warp_state.notification_timer - delta_time);
         }
-
-        current_player.previous_space_state = space_pressed;
     }
 
     void GameLoop::handle_ai_input(float delta_time)
@@ -854,51 +720,27 @@ namespace game
         // Handle minigame title screens - AI skips them immediately
         if (m_game_state.minigame_state.status == game::minigame::PrecisionTimingStatus::ShowingTitle)
         {
-            m_game_state.minigame_state.status = game::minigame::PrecisionTimingStatus::Running;
-            m_game_state.minigame_state.title_timer = m_game_state.minigame_state.title_duration;
-            m_game_state.minigame_state.display_text = "Press SPACE to stop at 4.99!";
-            m_game_state.precision_space_was_down = true;
+            game::minigame::skip_title(m_game_state.minigame_state);
             return;
         }
         else if (m_game_state.tile_memory_state.phase == game::minigame::tile_memory::Phase::ShowingTitle)
         {
-            m_game_state.tile_memory_state.title_timer = m_game_state.tile_memory_state.title_duration;
-            m_game_state.tile_memory_previous_keys.fill(false);
+            game::minigame::tile_memory::skip_title(m_game_state.tile_memory_state);
             return;
         }
         else if (m_game_state.reaction_state.phase == game::minigame::ReactionState::Phase::ShowingTitle)
         {
-            m_game_state.reaction_state.phase = game::minigame::ReactionState::Phase::PlayerTurn;
-            m_game_state.reaction_state.timer = 0.0f;
-            m_game_state.reaction_state.title_timer = m_game_state.reaction_state.title_duration;
-            m_game_state.reaction_state.player_attempts = 0;
-            m_game_state.reaction_state.input_buffer.clear();
-            std::ostringstream ss;
-            ss << "Guess " << (m_game_state.reaction_state.player_attempts + 1) << "/" << m_game_state.reaction_state.max_attempts << " : input _\n(space)";
-            m_game_state.reaction_state.display_text = ss.str();
+            game::minigame::skip_title(m_game_state.reaction_state);
             return;
         }
         else if (m_game_state.math_state.phase == game::minigame::MathQuizState::Phase::ShowingTitle)
         {
-            m_game_state.math_state.phase = game::minigame::MathQuizState::Phase::ShowingQuestion;
-            m_game_state.math_state.timer = 0.0f;
-            m_game_state.math_state.title_timer = m_game_state.math_state.title_duration;
-            m_game_state.math_state.display_text.clear();
+            game::minigame::skip_title(m_game_state.math_state);
             return;
         }
         else if (m_game_state.pattern_state.phase == game::minigame::PatternMatchingState::Phase::ShowingTitle)
         {
-            m_game_state.pattern_state.phase = game::minigame::PatternMatchingState::Phase::ShowingPattern;
-            m_game_state.pattern_state.show_timer = 0.0f;
-            m_game_state.pattern_state.title_timer = m_game_state.pattern_state.title_duration;
-            std::ostringstream oss;
-            for (int i = 0; i < 4; ++i)
-            {
-                const char* dirs[] = {"", "W", "S", "A", "D"};
-                oss << dirs[m_game_state.pattern_state.pattern[i]];
-                if (i < 3) oss << " ";
-            }
-            m_game_state.pattern_state.display_text = oss.str();
+            game::minigame::skip_title(m_game_state.pattern_state);
             return;
         }
         
@@ -909,7 +751,7 @@ namespace game
             if (m_game_state.minigame_state.timer >= 4.5f && m_game_state.minigame_state.timer <= 5.5f)
             {
                 // Try to stop close to 4.99 (with some randomness for realism)
-                static std::mt19937 rng(static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count()));
+                std::mt19937& rng = core::random_stream(core::RandomStream::Ai);
                 std::uniform_real_distribution<float> dist(4.8f, 5.2f);
                 if (m_game_state.minigame_state.timer >= dist(rng))
                 {
@@ -1034,7 +876,7 @@ namespace game
             ai_action_timer += delta_time;
             
             // Wait 0.5-1.5 seconds before rolling (randomized for realism)
-            static std::mt19937 rng(static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count()));
+            std::mt19937& rng = core::random_stream(core::RandomStream::Ai);
             static std::uniform_real_distribution<float> delay_dist(0.5f, 1.5f);
             static float target_delay = delay_dist(rng);
             
@@ -1226,8 +1068,7 @@ namespace game
                     
                     // Simple logic: After using ladder, force turn to end
                     // Reset steps and mark turn as finished
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                     current_player.last_dice_result = 0;  // Prevent rolling again
                     m_game_state.dice_state.result = 0;  // Clear dice result
                     m_game_state.dice_state.is_displaying = false;
@@ -1238,88 +1079,47 @@ namespace game
                               << ", turn_finished=" << m_game_state.turn_finished << std::endl;
                 }
 
-                // Only check tile activity if ladder/snake was NOT used
+                // Only run the tile effect if ladder/snake was NOT used
                 // This prevents conflicts (e.g., ladder and slide on same tile)
-                bool tile_activity_triggered = false;
-                if (!ladder_used && !snake_used)
+                game::map::TileEffectResult tile_effect;
+                const bool tile_memory_active_check = game::minigame::tile_memory::is_active(m_game_state.tile_memory_state);
+                if (!ladder_used && !snake_used && !minigame_running && !tile_memory_active_check)
                 {
-                    const bool tile_memory_active_check = game::minigame::tile_memory::is_active(m_game_state.tile_memory_state);
-                    tile_activity_triggered = game::map::check_tile_activity(current_tile,
-                                              last_processed_tile_for_player,
-                                              minigame_running,
-                                              tile_memory_active_check,
-                                              current_player,
-                                              m_game_state.minigame_state,
-                                              m_game_state.tile_memory_state,
-                                              m_game_state.reaction_state,
-                                              m_game_state.math_state,
-                                              m_game_state.pattern_state,
-                                              m_game_state.minigame_message,
-                                              m_game_state.minigame_message_timer,
-                                              m_game_state.tile_memory_previous_keys,
-                                              m_game_state.precision_space_was_down);
+                    game::map::TileEffectContext effect_context{current_player,
+                                                                m_game_state.minigame_state,
+                                                                m_game_state.tile_memory_state,
+                                                                m_game_state.reaction_state,
+                                                                m_game_state.math_state,
+                                                                m_game_state.pattern_state,
+                                                                m_game_state.minigame_message,
+                                                                m_game_state.minigame_message_timer};
+                    tile_effect = game::map::run_tile_effect(current_tile, effect_context);
                 }
-                
-                // Check all tile activities and handle them appropriately
-                if (tile_activity_triggered)
+
+                // Effects that move the player (walk back, slide, bonus) or start a
+                // minigame are already under way; skips and warps end the turn here
+                if (tile_effect.applied && tile_effect.ends_turn)
                 {
-                    const game::map::ActivityKind tile_activity = game::map::classify_activity_tile(current_tile);
-                    
-                    if (tile_activity == game::map::ActivityKind::SkipTurn || 
-                        tile_activity == game::map::ActivityKind::Trap)
-                    {
-                        // Skip Turn / Trap: Force turn to end immediately
-                        current_player.steps_remaining = 0;
-                        current_player.is_stepping = false;
-                        current_player.last_dice_result = 0;  // Prevent rolling again
-                        m_game_state.dice_state.result = 0;  // Clear dice result
-                        m_game_state.dice_state.is_displaying = false;
-                        m_game_state.turn_finished = true;  // Force turn to end
-                        std::cout << "[DEBUG] " << (tile_activity == game::map::ActivityKind::SkipTurn ? "Skip Turn" : "Trap") 
-                                  << " triggered! Ending turn for player " 
-                                  << (m_game_state.current_player_index + 1) << std::endl;
-                    }
-                    else if (tile_activity == game::map::ActivityKind::Portal)
+                    if (tile_effect.warped)
                     {
-                        // Portal: Update last_processed_tile after warp
+                        // Portal / warp: Update last_processed_tile after warp
                         const int new_tile = get_current_tile(current_player);
                         last_processed_tile_for_player = new_tile;
                         m_game_state.last_processed_tile = new_tile;
-                        // Portal also ends turn (like ladder/snake)
-                        current_player.steps_remaining = 0;
-                        current_player.is_stepping = false;
-                        current_player.last_dice_result = 0;
-                        m_game_state.dice_state.result = 0;
-                        m_game_state.dice_state.is_displaying = false;
-                        m_game_state.turn_finished = true;
-                        std::cout << "[DEBUG] Portal triggered! Warped to tile " << new_tile 
-                                  << ", ending turn for player " << (m_game_state.current_player_index + 1) << std::endl;
-                    }
-                    else if (tile_activity == game::map::ActivityKind::WalkBackward)
-                    {
-                        // WalkBackward: Already handled in check_tile_activity (steps are added)
-                        // Just log it
-                        std::cout << "[DEBUG] WalkBackward triggered! Player " 
-                                  << (m_game_state.current_player_index + 1) 
-                                  << " will walk backward 3 steps" << std::endl;
                     }
-                    else if (tile_activity == game::map::ActivityKind::Slide)
-                    {
-                        // Slide: Already handled in check_tile_activity (steps_remaining += 1)
-                        // Just log it
-                        std::cout << "[DEBUG] Slide triggered! Player " 
-                                  << (m_game_state.current_player_index + 1) 
-                                  << " got +1 step" << std::endl;
-                    }
-                    else if (tile_activity == game::map::ActivityKind::Bonus)
-                    {
-                        // Bonus: Already handled in check_tile_activity (steps_remaining += bonus_steps)
-                        // Just log it
-                        std::cout << "[DEBUG] Bonus triggered! Player " 
-                                  << (m_game_state.current_player_index + 1) 
-                                  << " got bonus steps" << std::endl;
-                    }
-                    // Note: Minigames are already handled in check_tile_activity
+                    game::player::stop_walking(current_player);
+                    current_player.last_dice_result = 0;  // Prevent rolling again
+                    m_game_state.dice_state.result = 0;  // Clear dice result
+                    m_game_state.dice_state.is_displaying = false;
+                    m_game_state.turn_finished = true;  // Force turn to end
+                    std::cout << "[DEBUG] Tile effect on tile " << current_tile << " ends the turn for player "
+                              << (m_game_state.current_player_index + 1) << std::endl;
+                }
+                else if (tile_effect.applied)
+                {
+                    std::cout << "[DEBUG] Tile effect on tile " << current_tile << " for player "
+                              << (m_game_state.current_player_index + 1) << ": "
+                              << m_game_state.minigame_message << std::endl;
                 }
             }
             else
@@ -1516,12 +1316,11 @@ namespace game
                 if (game::minigame::is_success(m_game_state.minigame_state))
                 {
                     const int bonus = game::minigame::get_bonus_steps(m_game_state.minigame_state);
-                    current_player.steps_remaining += bonus;
+                    game::player::add_steps(current_player, bonus);
                 }
                 else if (game::minigame::is_failure(m_game_state.minigame_state))
                 {
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                 }
             }
 
@@ -1547,12 +1346,11 @@ namespace game
                 if (game::minigame::tile_memory::is_success(m_game_state.tile_memory_state))
                 {
                     const int bonus = game::minigame::tile_memory::get_bonus_steps(m_game_state.tile_memory_state);
-                    current_player.steps_remaining += bonus;
+                    game::player::add_steps(current_player, bonus);
                 }
                 else
                 {
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                 }
             }
         }
@@ -1571,12 +1369,11 @@ namespace game
                 if (game::minigame::is_success(m_game_state.reaction_state))
                 {
                     const int bonus = game::minigame::get_bonus_steps(m_game_state.reaction_state);
-                    current_player.steps_remaining += bonus;
+                    game::player::add_steps(current_player, bonus);
                 }
                 else
                 {
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                 }
             }
         }
@@ -1595,12 +1392,11 @@ namespace game
                 if (game::minigame::is_success(m_game_state.math_state))
                 {
                     const int bonus = game::minigame::get_bonus_steps(m_game_state.math_state);
-                    current_player.steps_remaining += bonus;
+                    game::player::add_steps(current_player, bonus);
                 }
                 else
                 {
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                 }
             }
         }
@@ -1619,12 +1415,11 @@ namespace game
                 if (game::minigame::is_success(m_game_state.pattern_state))
                 {
                     const int bonus = game::minigame::get_bonus_steps(m_game_state.pattern_state);
-                    current_player.steps_remaining += bonus;
+                    game::player::add_steps(current_player, bonus);
                 }
                 else
                 {
-                    current_player.steps_remaining = 0;
-                    current_player.is_stepping = false;
+                    game::player::stop_walking(current_player);
                 }
             }
         }
@@ -1,9 +1,18 @@
 #pragma once
 
 #include "game_state.h"
+#include "input_log.h"
+#include "input_snapshot.h"
 #include "../core/window.h"
 #include "../core/camera.h"
 
+#include <GLFW/glfw3.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
 namespace game
 {
     class GameLoop
@@ -12,10 +21,43 @@ namespace game
         GameLoop(core::Window& window, core::Camera& camera, GameState& game_state, RenderState& render_state);
         ~GameLoop() = default;
 
+        // Advances the simulation by one fixed tick (see core::FixedTimestep)
         void update(float delta_time);
         void render(const core::Camera& camera);
 
+        // Wall-clock time (glfwGetTime) the next update() stands for. Key events up
+        // to it are applied at that tick and remember how long before it they
+        // happened; left unset, every queued event is applied with no lag.
+        void set_input_time(double time) { m_input_time = time; }
+
+        // Appends every key edge seen at the start of a tick to log (nullptr stops recording)
+        void set_input_recording(InputLog* log) { m_recording = log; }
+        // Takes keys from log instead of the window (nullptr returns to live input).
+        // Replays start from tick 0, so set this before the first update().
+        void set_input_replay(const InputLog* log);
+        // Ticks simulated so far; a replay is finished once this reaches its tick_count
+        std::uint64_t get_tick() const { return m_tick; }
+        // Turns of the current replay whose state hash was compared, and whether one
+        // differed from the recording (the first mismatch is also logged)
+        std::size_t get_replay_turns_checked() const { return m_replay_turn; }
+        bool has_replay_diverged() const { return m_replay_diverged; }
+        // Saves the game (see save_state.h) to path whenever the turn passes, a menu or
+        // the win screen opens or closes, and at least every AUTOSAVE_INTERVAL seconds
+        void set_autosave(const std::filesystem::path& path);
+
+        static constexpr float AUTOSAVE_INTERVAL = 5.0f;
+
     private:
+        // Latches this tick's key state from the window's key events or the replay log
+        void sample_input();
+        void read_key_edges();
+        void apply_key_edge(int key, bool down, std::uint32_t lag_us);
+        void update_autosave(float delta_time);
+        // Records or checks the state hash each time the turn passes
+        void track_turn_hash();
+        // Seconds between key's last press or release and the time of the tick that saw it
+        float get_key_lag(int key) const;
+
         void handle_input(float delta_time);
         void handle_ai_input(float delta_time);
         void update_game_logic(float delta_time);
@@ -29,6 +71,25 @@ namespace game
         // They are currently passed as parameters to render() instead
         [[maybe_unused]] core::Camera& m_camera;
         [[maybe_unused]] RenderState& m_render_state;
+
+        // Keys for the current tick, so every handler in a tick sees the same input
+        InputSnapshot m_input;
+        std::array<std::uint32_t, GLFW_KEY_LAST + 1> m_key_lag_us{};
+        double m_input_time = -1.0;  // < 0 = not set, see set_input_time
+        std::uint64_t m_tick = 0;
+        InputLog* m_recording = nullptr;
+        const InputLog* m_replay = nullptr;
+        std::size_t m_replay_edge = 0;  // Next edge of m_replay to apply
+        std::size_t m_replay_turn = 0;  // Next turn hash of m_replay to compare
+        bool m_replay_diverged = false;
+        int m_hash_player = -1;  // Player whose turn the last hash was taken on
+
+        std::filesystem::path m_autosave_path;  // Empty = autosave off
+        std::vector<unsigned char> m_autosave_buffer;  // Reused so saving never allocates after the first time
+        float m_autosave_timer = 0.0f;
+        int m_autosave_player = -1;
+        bool m_autosave_menu = false;
+        bool m_autosave_win = false;
     };
 }
 
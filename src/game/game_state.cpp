@@ -29,7 +29,7 @@ namespace game
         // Initialize all players (will be activated based on num_players from menu)
         for (int i = 0; i < 4; ++i)
         {
-            initialize(state.players[i], tile_center_world(0), state.player_ground_y, state.player_radius);
+            initialize(state.players[i], tile_center_world(0), state.player_ground_y, state.player_radius, i);
         }
         state.current_player_index = 0;
         state.num_players = 2;  // Default to 2 players (minimum), will be updated from menu
@@ -55,7 +55,7 @@ namespace game
         // Shutdown audio system
         state.audio_manager.shutdown();
         
-        destroy_mesh(state.map_data.mesh);
+        game::map::destroy_map(state.map_data);
         destroy_mesh(state.sphere_mesh);
         if (state.has_dice_texture)
         {
@@ -7,6 +7,8 @@
 #include "../rendering/gltf_loader.h"
 #include "../rendering/obj_loader.h"
 #include "../rendering/animation_player.h"
+#include "../rendering/shader_cache.h"
+#include "../rendering/ui_batch.h"
 #include "../core/audio_manager.h"
 #include "map/map_manager.h"
 #include "player/player.h"
@@ -28,14 +30,20 @@ namespace game
     {
         bool active = false;
         std::string buffer;
-        std::array<bool, 10> digit_previous{};
-        bool prev_toggle = false;
-        bool prev_enter = false;
-        bool prev_backspace = false;
         float notification_timer = 0.0f;
         std::string notification;
     };
 
+    // Transforms from the previous simulation tick. The renderer blends them with
+    // the current tick so motion stays smooth at any tick rate.
+    struct RenderInterpolation
+    {
+        std::array<glm::vec3, 4> previous_player_positions{};
+        glm::vec3 previous_dice_position{};
+        glm::vec3 previous_dice_rotation{};
+        bool previous_dice_visible = false;
+    };
+
     struct GameState
     {
         // Map
@@ -85,18 +93,8 @@ namespace game
         game::minigame::MathQuizState math_state;
         game::minigame::PatternMatchingState pattern_state;
 
-        // Minigame input tracking
-        bool precision_space_was_down = false;
-        std::array<bool, 10> tile_memory_previous_keys{};  // 0-9 for digit keys
-        bool tile_memory_backspace_was_down = false;
-        bool tile_memory_enter_was_down = false;
-        std::array<bool, 6> pattern_previous_keys{};  // W, S, A, D, Backspace, Enter/Space
+        // Minigame input (key presses come from GameLoop's InputSnapshot)
         std::string reaction_input_buffer;  // Buffer for number guessing input
-        bool reaction_backspace_was_down = false;
-        bool reaction_enter_was_down = false;
-        std::array<bool, 10> math_digit_previous{};  // 0-9 for digit keys in math quiz
-        bool math_backspace_was_down = false;
-        bool math_enter_was_down = false;
 
         // Game state tracking
         int last_processed_tile = 0;
@@ -129,20 +127,20 @@ namespace game
         // Audio
         core::audio::AudioManager audio_manager;
 
+        // Render interpolation between fixed simulation ticks
+        RenderInterpolation interpolation;
+
         // Timing
         float last_time = 0.0f;
     };
 
     struct RenderState
     {
-        GLuint program = 0;
-        GLint mvp_location = -1;
-        GLint use_texture_location = -1;
-        GLint texture_location = -1;
-        GLint dice_texture_mode_location = -1;
-        GLint color_override_location = -1;
-        GLint use_color_override_location = -1;
+        ShaderCache shaders;  // One program per ShaderVariant - draws pick the one they need
         TextRenderer text_renderer{};
+        // UI draw code only holds a const RenderState; like the shader cache's
+        // draw-time state this is GL-thread only
+        mutable UiBatch ui_batch;
     };
 
     void initialize_game_state(GameState& state, const std::filesystem::path& executable_dir);
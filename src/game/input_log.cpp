@@ -0,0 +1,146 @@
+#include "input_log.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace game
+{
+    namespace
+    {
+        constexpr const char* INPUT_LOG_MAGIC = "snakes-ladder-input";
+        constexpr std::size_t MIN_EDGE_LINE = 6;  // "0 0 0\n"
+        constexpr std::size_t MIN_TURN_LINE = 4;  // "0 0\n"
+
+        // Throws unless count lines of at least line_size bytes fit in what is
+        // left of the file, so a corrupt count never sizes an allocation
+        void check_count(std::ifstream& file, const std::filesystem::path& path, std::size_t count,
+                         std::size_t line_size, const char* what)
+        {
+            std::error_code error;
+            const std::uintmax_t size = std::filesystem::file_size(path, error);
+            const std::streamoff at = file.tellg();
+            if (error || at < 0 || static_cast<std::uintmax_t>(at) > size ||
+                count > (size - static_cast<std::uintmax_t>(at)) / line_size)
+            {
+                throw std::runtime_error("Malformed input log (" + std::to_string(count) + " " + what +
+                                         " cannot fit in the file): " + path.string());
+            }
+        }
+    }
+
+    void save_input_log(const std::filesystem::path& path, const InputLog& log)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open input log for writing: " + path.string());
+        }
+
+        file << INPUT_LOG_MAGIC << ' ' << INPUT_LOG_VERSION << '\n';
+        file << "seed " << log.seed << '\n';
+        file << "tick_rate " << std::setprecision(std::numeric_limits<double>::max_digits10) << log.tick_rate << '\n';
+        file << "ticks " << log.tick_count << '\n';
+        file << "edges " << log.edges.size() << '\n';
+        // One edge per line: tick, GLFW key code, 1 = pressed / 0 = released, lag in microseconds
+        for (const InputEdge& edge : log.edges)
+        {
+            file << edge.tick << ' ' << edge.key << ' ' << (edge.down ? 1 : 0) << ' ' << edge.lag_us << '\n';
+        }
+        file << "turns " << log.turn_hashes.size() << '\n';
+        // One turn per line: tick, state hash in hex
+        for (const TurnHash& turn : log.turn_hashes)
+        {
+            file << turn.tick << ' ' << std::hex << turn.hash << std::dec << '\n';
+        }
+
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write input log: " + path.string());
+        }
+    }
+
+    InputLog load_input_log(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open input log: " + path.string());
+        }
+
+        const auto expect = [&file, &path](const char* label) {
+            std::string word;
+            if (!(file >> word) || word != label)
+            {
+                throw std::runtime_error("Malformed input log (expected '" + std::string(label) + "'): " + path.string());
+            }
+        };
+
+        InputLog log;
+        int version = 0;
+        expect(INPUT_LOG_MAGIC);
+        file >> version;
+        if (version < 1 || version > INPUT_LOG_VERSION)
+        {
+            throw std::runtime_error("Unsupported input log version " + std::to_string(version) + ": " + path.string());
+        }
+
+        std::size_t edge_count = 0;
+        expect("seed");
+        file >> log.seed;
+        expect("tick_rate");
+        file >> log.tick_rate;
+        expect("ticks");
+        file >> log.tick_count;
+        expect("edges");
+        file >> edge_count;
+        if (!file)
+        {
+            throw std::runtime_error("Malformed input log header: " + path.string());
+        }
+
+        check_count(file, path, edge_count, MIN_EDGE_LINE, "edges");
+        log.edges.reserve(edge_count);
+        for (std::size_t i = 0; i < edge_count; ++i)
+        {
+            InputEdge edge;
+            int down = 0;
+            if (!(file >> edge.tick >> edge.key >> down) || (version >= 3 && !(file >> edge.lag_us)))
+            {
+                throw std::runtime_error("Input log truncated after " + std::to_string(i) + " edges: " + path.string());
+            }
+            edge.down = down != 0;
+            if (!log.edges.empty() && edge.tick < log.edges.back().tick)
+            {
+                throw std::runtime_error("Input log edges out of order: " + path.string());
+            }
+            log.edges.push_back(edge);
+        }
+
+        if (version < 2)
+        {
+            return log;  // Recorded before turn hashes; replays without the desync check
+        }
+        std::size_t turn_count = 0;
+        expect("turns");
+        if (!(file >> turn_count))
+        {
+            throw std::runtime_error("Malformed input log (bad turn count): " + path.string());
+        }
+        check_count(file, path, turn_count, MIN_TURN_LINE, "turns");
+        log.turn_hashes.reserve(turn_count);
+        for (std::size_t i = 0; i < turn_count; ++i)
+        {
+            TurnHash turn;
+            if (!(file >> turn.tick >> std::hex >> turn.hash >> std::dec))
+            {
+                throw std::runtime_error("Input log truncated after " + std::to_string(i) + " turns: " + path.string());
+            }
+            log.turn_hashes.push_back(turn);
+        }
+        return log;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace game
+{
+    // 2 added turn hashes, 3 edge lags; older logs still load
+    constexpr int INPUT_LOG_VERSION = 3;
+
+    // A key going down or up, seen at the start of simulation tick `tick`.
+    // lag_us is how long before that tick's time it really happened (whole
+    // microseconds, so a replay computes exactly what the recording did).
+    struct InputEdge
+    {
+        std::uint64_t tick = 0;
+        int key = 0;  // GLFW key code
+        bool down = false;
+        std::uint32_t lag_us = 0;
+    };
+
+    // State hash (see state_hash.h) seen at tick `tick`, right after the turn passed
+    struct TurnHash
+    {
+        std::uint64_t tick = 0;
+        std::uint64_t hash = 0;
+    };
+
+    // Everything needed to replay a game tick for tick: the RNG seed, the tick
+    // rate it was simulated at and every key edge in tick order. Written by
+    // --record=FILE, read back by --replay=FILE. The turn hashes let a replay
+    // report the first turn where it stopped matching the recording.
+    struct InputLog
+    {
+        std::uint64_t seed = 0;
+        double tick_rate = 60.0;
+        std::uint64_t tick_count = 0;  // Ticks simulated while recording
+        std::vector<InputEdge> edges;
+        std::vector<TurnHash> turn_hashes;
+    };
+
+    // Plain text so logs attached to bug reports can be read and trimmed by hand.
+    // Both throw std::runtime_error on I/O or format errors.
+    void save_input_log(const std::filesystem::path& path, const InputLog& log);
+    InputLog load_input_log(const std::filesystem::path& path);
+}
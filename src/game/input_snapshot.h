@@ -0,0 +1,50 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <bitset>
+#include <cstddef>
+
+namespace game
+{
+    // Every key's state for one simulation tick, plus the keys that went down or
+    // up since the tick before. Edges are worked out for all keys at once with
+    // a couple of word-wide bitset operations, so game code never keeps "was it
+    // down last time" flags of its own: a key held over from another screen or
+    // another player's turn is simply never pressed.
+    class InputSnapshot
+    {
+    public:
+        using Keys = std::bitset<GLFW_KEY_LAST + 1>;
+
+        // Starts a tick; keys stay as they were until set_key changes them
+        void begin_tick() { m_previous = m_down; }
+        void set_key(int key, bool down)
+        {
+            if (is_valid(key))
+            {
+                m_down.set(static_cast<std::size_t>(key), down);
+            }
+        }
+        // True if key already changed this tick (a tick sees at most one edge per key)
+        bool has_edge(int key) const { return is_valid(key) && m_down[key] != m_previous[key]; }
+        // Computes the tick's edges once every key is set
+        void end_tick_sampling()
+        {
+            m_pressed = m_down & ~m_previous;
+            m_released = m_previous & ~m_down;
+        }
+        void reset() { *this = InputSnapshot{}; }
+
+        bool is_down(int key) const { return is_valid(key) && m_down[key]; }
+        bool was_pressed(int key) const { return is_valid(key) && m_pressed[key]; }
+        bool was_released(int key) const { return is_valid(key) && m_released[key]; }
+
+    private:
+        static bool is_valid(int key) { return key >= 0 && key <= GLFW_KEY_LAST; }
+
+        Keys m_down;
+        Keys m_previous;  // m_down at the end of the previous tick
+        Keys m_pressed;
+        Keys m_released;
+    };
+}
@@ -0,0 +1,463 @@
+#include "batch_games.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+// The kernel is built twice on x86 with GCC or Clang: for the baseline ISA and
+// for AVX2, picked at run time
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SNL_BATCH_AVX2 1
+#define SNL_BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define SNL_BATCH_AVX2 0
+#if defined(_MSC_VER)
+#define SNL_BATCH_INLINE __forceinline
+#else
+#define SNL_BATCH_INLINE inline
+#endif
+#endif
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr int BLOCK = 256;                 // Games per inner loop, sized to stay in L1
+        constexpr std::uint32_t DRAW_RANGE = 1u << 24;  // Draws are 24-bit
+        constexpr std::uint32_t DRAWS_PER_TURN = 1 + MAX_LANDING_CHAIN;  // The roll, then one per landing
+
+        std::uint64_t splitmix64(std::uint64_t& state)
+        {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        SNL_BATCH_INLINE std::uint32_t mix32(std::uint32_t x)
+        {
+            x ^= x >> 16;
+            x *= 0x7feb352du;
+            x ^= x >> 15;
+            x *= 0x846ca68bu;
+            x ^= x >> 16;
+            return x;
+        }
+
+        // 24-bit draw number counter of a game. A stateless hash rather than
+        // per-game xoshiro or Philox streams: any draw can be made from the key
+        // alone, which is what gives two boards common dice. 32-bit multiplies
+        // are vpmulld in the AVX2 build (one per lane of eight); the baseline
+        // SSE2 build has no 32-bit lane multiply and emulates it.
+        SNL_BATCH_INLINE std::uint32_t draw(std::uint32_t key_low, std::uint32_t key_high, std::uint32_t flip, std::uint32_t counter)
+        {
+            return (mix32(mix32(key_low ^ counter) ^ key_high) >> 8) ^ flip;
+        }
+    }
+
+    BatchTileTable make_batch_tile_table(const BoardModel& board, const RuleVariant& rules)
+    {
+        BatchTileTable table;
+        const int n = board.tile_count;
+        const int final_tile = n - 1;
+        table.tile_count = n;
+        table.destination.resize(n);
+        table.bonus_span.assign(n, 0);
+        table.threshold.assign(n, 0);
+        table.chains.assign(n, 0);
+        table.portal.assign(n, 0);
+        table.next_snake.assign(n, n);
+        table.rules = rules;
+        table.landing_passes = 1;
+
+        const double success = std::clamp(static_cast<double>(board.minigame_success), 0.0, 1.0);
+        for (int tile = 0; tile < n; ++tile)
+        {
+            table.destination[tile] = tile;
+            if (tile == final_tile)
+            {
+                continue;
+            }
+            if (board.link_end[tile] >= 0)
+            {
+                table.destination[tile] = board.link_end[tile];
+                table.threshold[tile] = DRAW_RANGE;
+                continue;
+            }
+
+            const TileLanding& landing = board.landings[tile];
+            switch (landing.kind)
+            {
+            case TileLanding::Kind::Walk:
+                table.destination[tile] = std::max(0, tile + landing.steps);
+                table.bonus_span[tile] = landing.span;
+                table.threshold[tile] = DRAW_RANGE;
+                table.chains[tile] = ~0u;
+                break;
+            case TileLanding::Kind::Warp:
+                table.destination[tile] = landing.target;
+                table.threshold[tile] = DRAW_RANGE;
+                break;
+            case TileLanding::Kind::Portal:
+                table.portal[tile] = ~0u;
+                table.threshold[tile] = DRAW_RANGE;
+                break;
+            case TileLanding::Kind::Minigame:
+                table.destination[tile] = tile + minigame_bonus_steps(landing.minigame);
+                table.threshold[tile] = static_cast<std::uint32_t>(std::lround(success * DRAW_RANGE));
+                table.chains[tile] = ~0u;
+                break;
+            default:
+                // Skip turn and trap only end the turn, as in the game
+                break;
+            }
+        }
+
+        // First snake head after each tile, for snakes_on_pass
+        for (int tile = n - 2; tile >= 0; --tile)
+        {
+            const int after = tile + 1;
+            const bool snake = after < final_tile && board.link_end[after] >= 0 && board.link_end[after] < after;
+            table.next_snake[tile] = snake ? after : table.next_snake[after];
+        }
+
+        // Longest chain of landings from any tile, in passes: passes[t] after
+        // round r is the most a landing on t can take within r passes
+        std::vector<int> passes(n, 0);
+        std::vector<int> within(n, 0);
+        for (int round = 1; round <= MAX_LANDING_CHAIN; ++round)
+        {
+            for (int tile = 0; tile < final_tile; ++tile)
+            {
+                int longest = 0;
+                if (table.chains[tile] != 0 && table.threshold[tile] != 0)
+                {
+                    const int first = table.portal[tile] != 0 ? 0 : table.destination[tile];
+                    const int last = table.portal[tile] != 0 ? final_tile - 1
+                                                             : table.destination[tile] + std::max(0, table.bonus_span[tile] - 1);
+                    for (int next = first; next <= std::min(last, final_tile - 1); ++next)
+                    {
+                        longest = std::max(longest, passes[next]);
+                    }
+                }
+                within[tile] = 1 + longest;
+            }
+            passes.swap(within);
+        }
+        table.landing_passes = *std::max_element(passes.begin(), passes.end());
+        return table;
+    }
+
+    void reset_batch_games(BatchGames& games, int count, int players, std::uint64_t seed,
+                           std::uint64_t first_game, bool antithetic)
+    {
+        games.count = std::max(0, count);
+        games.players = std::clamp(players, 2, 4);
+        games.tiles.assign(static_cast<std::size_t>(games.count) * games.players, 0);
+        games.seat.assign(games.count, 0);
+        games.turns.assign(games.count, 0);
+        games.winner.assign(games.count, -1);
+        games.id.resize(games.count);
+        games.key_low.resize(games.count);
+        games.key_high.resize(games.count);
+        games.flip.resize(games.count);
+
+        for (int game = 0; game < games.count; ++game)
+        {
+            const std::uint64_t index = first_game + static_cast<std::uint64_t>(game);
+            std::uint64_t state = seed ^ ((antithetic ? index / 2 : index) * 0xd1b54a32d192ed03ULL);
+            const std::uint64_t key = splitmix64(state);
+            games.id[game] = static_cast<std::uint32_t>(game);
+            games.key_low[game] = static_cast<std::uint32_t>(key);
+            games.key_high[game] = static_cast<std::uint32_t>(key >> 32);
+            games.flip[game] = antithetic && index % 2 == 1 ? DRAW_RANGE - 1 : 0;
+        }
+    }
+
+    namespace
+    {
+        // All-ones if condition holds, else zero. Lane state is kept as such
+        // masks and combined with &, | and select instead of && and ?:, so the
+        // lane loops have no control flow for the vectoriser to give up on.
+        SNL_BATCH_INLINE std::uint32_t mask_if(bool condition)
+        {
+            return 0u - static_cast<std::uint32_t>(condition);
+        }
+
+        SNL_BATCH_INLINE std::int32_t select(std::uint32_t mask, std::int32_t if_set, std::int32_t if_clear)
+        {
+            return static_cast<std::int32_t>((static_cast<std::uint32_t>(if_set) & mask) |
+                                             (static_cast<std::uint32_t>(if_clear) & ~mask));
+        }
+
+        // One turn for every running game under Rules (a RulePolicy). Rules
+        // that are off compile away, so the standard rules run the same loops
+        // as before the variants existed. Always inlined into the per-ISA
+        // entry points below, which is what lets them vectorise it differently.
+        template <typename Rules>
+        SNL_BATCH_INLINE int advance_games(BatchGames& games, const BatchTileTable& table)
+        {
+            const std::int32_t final_tile = table.tile_count - 1;
+            const std::uint32_t other_tiles = static_cast<std::uint32_t>(table.tile_count - 1);
+            const std::int32_t players = games.players;
+            const std::int32_t* destination = table.destination.data();
+            const std::int32_t* bonus_span = table.bonus_span.data();
+            const std::uint32_t* threshold = table.threshold.data();
+            const std::uint32_t* chains = table.chains.data();
+            const std::uint32_t* portal = table.portal.data();
+            const std::int32_t* next_snake = table.next_snake.data();
+
+            alignas(64) std::int32_t tile[BLOCK];
+            alignas(64) std::uint32_t live[BLOCK];
+            alignas(64) std::uint32_t again[BLOCK];   // Rolled a 6 (six_again only)
+            alignas(64) std::uint32_t rotate[BLOCK];  // The turn passes to the next seat
+            int running = 0;
+            for (int block = 0; block < games.count; block += BLOCK)
+            {
+                const int lanes = std::min(BLOCK, games.count - block);
+                // Row r holds the tile of the seat r places after the one to move
+                std::int32_t* rows = games.tiles.data() + block;
+                const std::size_t row_stride = static_cast<std::size_t>(games.count);
+                std::int32_t* mover_tile = rows;
+                std::int32_t* seat = games.seat.data() + block;
+                std::uint32_t* turns = games.turns.data() + block;
+                std::int32_t* winner = games.winner.data() + block;
+                const std::uint32_t* key_low = games.key_low.data() + block;
+                const std::uint32_t* key_high = games.key_high.data() + block;
+                const std::uint32_t* flip = games.flip.data() + block;
+
+                // Roll and walk
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    const std::uint32_t playing = mask_if(winner[lane] < 0);
+                    const std::int32_t start = mover_tile[lane];
+                    const std::uint32_t counter = turns[lane] * DRAWS_PER_TURN;
+                    const std::uint32_t rolled = draw(key_low[lane], key_high[lane], flip[lane], counter);
+                    const std::int32_t roll = 1 + static_cast<std::int32_t>((rolled * 6u) >> 24);
+                    const std::int32_t reached = start + roll;
+                    const std::uint32_t overshoots = mask_if(reached > final_tile);
+                    std::int32_t walked_to = std::min(reached, final_tile);  // Furthest tile walked forward
+                    std::int32_t moved = walked_to;
+                    std::uint32_t lands = ~0u;
+                    if constexpr (Rules::finish == FinishRule::Exact)
+                    {
+                        walked_to = select(overshoots, start, walked_to);
+                        moved = walked_to;
+                        lands = ~overshoots;
+                    }
+                    else if constexpr (Rules::finish == FinishRule::Bounce)
+                    {
+                        moved = select(overshoots, 2 * final_tile - reached, reached);
+                    }
+                    if constexpr (Rules::snakes_on_pass)
+                    {
+                        // Only the first snake passed counts; its tail ends the turn.
+                        // No snake ahead reads the final tile's harmless entry.
+                        const std::int32_t passed = std::min(next_snake[start], final_tile);
+                        const std::uint32_t bitten = mask_if(passed < walked_to);
+                        moved = select(bitten, destination[passed], moved);
+                        lands &= ~bitten;
+                    }
+                    if constexpr (Rules::six_again)
+                    {
+                        again[lane] = mask_if(roll == 6);
+                    }
+                    tile[lane] = moved;
+                    live[lane] = playing & lands & mask_if(moved < final_tile);
+                }
+
+                // Resolve landings, one chained landing per pass. The table
+                // knows how long a chain can get on its board, so every block
+                // runs the same number of passes.
+                for (int depth = 0; depth < table.landing_passes; ++depth)
+                {
+                    for (int lane = 0; lane < lanes; ++lane)
+                    {
+                        const std::int32_t at = tile[lane];
+                        const std::uint32_t counter = turns[lane] * DRAWS_PER_TURN + 1 + static_cast<std::uint32_t>(depth);
+                        const std::uint32_t landing = draw(key_low[lane], key_high[lane], flip[lane], counter);
+                        const std::uint32_t moves = live[lane] & mask_if(landing < threshold[at]);
+
+                        const std::int32_t walked = destination[at] + static_cast<std::int32_t>((landing * static_cast<std::uint32_t>(bonus_span[at])) >> 24);
+                        std::int32_t warped = static_cast<std::int32_t>((landing * other_tiles) >> 24);
+                        warped += static_cast<std::int32_t>(warped >= at);  // Never back onto the portal
+                        const std::int32_t next = std::min(select(portal[at], warped, walked), final_tile);
+
+                        tile[lane] = select(moves, next, at);
+                        live[lane] = moves & chains[at] & mask_if(next < final_tile);
+                    }
+                }
+
+                // Finish the turn. A game whose seat changes rotates its rows
+                // by one, so the next mover's tile is always row 0.
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    const std::uint32_t playing = mask_if(winner[lane] < 0);
+                    const std::uint32_t won = playing & mask_if(tile[lane] >= final_tile);
+                    std::uint32_t passes_turn = playing & ~won;
+                    if constexpr (Rules::six_again)
+                    {
+                        passes_turn &= ~again[lane];
+                    }
+                    const std::int32_t next_seat = select(mask_if(seat[lane] + 1 == players), 0, seat[lane] + 1);
+
+                    mover_tile[lane] = select(playing, tile[lane], mover_tile[lane]);
+                    turns[lane] += playing & 1u;
+                    winner[lane] = select(won, seat[lane], winner[lane]);
+                    seat[lane] = select(passes_turn, next_seat, seat[lane]);
+                    rotate[lane] = passes_turn;
+                    running += static_cast<int>(playing & ~won & 1u);
+                }
+                for (int row = 0; row + 1 < players; ++row)
+                {
+                    std::int32_t* current = rows + row * row_stride;
+                    const std::int32_t* after = current + row_stride;
+                    for (int lane = 0; lane < lanes; ++lane)
+                    {
+                        current[lane] = select(rotate[lane], after[lane], current[lane]);
+                    }
+                }
+                // ... and the mover's new tile goes to the last row
+                std::int32_t* last = rows + (players - 1) * row_stride;
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    last[lane] = select(rotate[lane], tile[lane], last[lane]);
+                }
+            }
+            return running;
+        }
+
+        using AdvanceFunction = int (*)(BatchGames&, const BatchTileTable&);
+
+        template <typename Rules>
+        int advance_games_generic(BatchGames& games, const BatchTileTable& table)
+        {
+            return advance_games<Rules>(games, table);
+        }
+
+        template <std::size_t... Index>
+        constexpr std::array<AdvanceFunction, RULE_VARIANT_COUNT> make_generic_table(std::index_sequence<Index...>)
+        {
+            return {&advance_games_generic<RulePolicyAt<static_cast<int>(Index)>>...};
+        }
+
+#if SNL_BATCH_AVX2
+        // AVX2 has 8-lane 32-bit multiplies for the dice hash and gathers for
+        // the tile table lookups, which the x86-64 baseline (SSE2) has neither of.
+        // GCC's generic tuning splits gathers into scalar loads; tune=haswell
+        // keeps them as vpgatherdd.
+        template <typename Rules>
+        __attribute__((target("avx2"))) int advance_games_avx2(BatchGames& games, const BatchTileTable& table)
+        {
+            return advance_games<Rules>(games, table);
+        }
+
+        template <std::size_t... Index>
+        constexpr std::array<AdvanceFunction, RULE_VARIANT_COUNT> make_avx2_table(std::index_sequence<Index...>)
+        {
+            return {&advance_games_avx2<RulePolicyAt<static_cast<int>(Index)>>...};
+        }
+#endif
+
+        // advance_games for every variant, by rule_variant_index
+        constexpr std::array<AdvanceFunction, RULE_VARIANT_COUNT> GENERIC_BY_RULES =
+            make_generic_table(std::make_index_sequence<RULE_VARIANT_COUNT>());
+#if SNL_BATCH_AVX2
+        constexpr std::array<AdvanceFunction, RULE_VARIANT_COUNT> AVX2_BY_RULES =
+            make_avx2_table(std::make_index_sequence<RULE_VARIANT_COUNT>());
+#endif
+
+        std::atomic<bool> g_force_generic{false};
+
+        bool use_avx2()
+        {
+#if SNL_BATCH_AVX2
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported && !g_force_generic.load(std::memory_order_relaxed);
+#else
+            return false;
+#endif
+        }
+    }
+
+    int advance_batch_games(BatchGames& games, const BatchTileTable& table)
+    {
+        const int variant = rule_variant_index(table.rules);
+#if SNL_BATCH_AVX2
+        if (use_avx2())
+        {
+            return AVX2_BY_RULES[variant](games, table);
+        }
+#endif
+        return GENERIC_BY_RULES[variant](games, table);
+    }
+
+    void force_generic_batch_kernel(bool generic)
+    {
+        g_force_generic.store(generic, std::memory_order_relaxed);
+    }
+
+    const char* get_batch_kernel_name()
+    {
+        return use_avx2() ? "avx2" : "generic";
+    }
+
+    std::int32_t get_batch_tile(const BatchGames& games, int game, int seat)
+    {
+        const int row = (seat - games.seat[game] + games.players) % games.players;
+        return games.tiles[static_cast<std::size_t>(row) * games.count + game];
+    }
+
+    void compact_batch_games(BatchGames& games, BatchTally& tally, BatchOutcomes* outcomes)
+    {
+        int kept = 0;
+        for (int game = 0; game < games.count; ++game)
+        {
+            if (games.winner[game] >= 0)
+            {
+                ++tally.games;
+                tally.turns += games.turns[game];
+                ++tally.wins[games.winner[game]];
+                if (outcomes)
+                {
+                    outcomes->turns[games.id[game]] = games.turns[game];
+                    outcomes->winner[games.id[game]] = static_cast<std::int8_t>(games.winner[game]);
+                }
+                continue;
+            }
+            if (kept != game)
+            {
+                for (int seat = 0; seat < games.players; ++seat)
+                {
+                    games.tiles[static_cast<std::size_t>(seat) * games.count + kept] =
+                        games.tiles[static_cast<std::size_t>(seat) * games.count + game];
+                }
+                games.seat[kept] = games.seat[game];
+                games.turns[kept] = games.turns[game];
+                games.winner[kept] = games.winner[game];
+                games.id[kept] = games.id[game];
+                games.key_low[kept] = games.key_low[game];
+                games.key_high[kept] = games.key_high[game];
+                games.flip[kept] = games.flip[game];
+            }
+            ++kept;
+        }
+
+        // Seat-major tiles: close the gaps between the seats' rows
+        for (int seat = 1; seat < games.players; ++seat)
+        {
+            std::copy_n(games.tiles.begin() + static_cast<std::ptrdiff_t>(seat) * games.count, kept,
+                        games.tiles.begin() + static_cast<std::ptrdiff_t>(seat) * kept);
+        }
+        games.count = kept;
+        games.tiles.resize(static_cast<std::size_t>(kept) * games.players);
+        games.seat.resize(kept);
+        games.turns.resize(kept);
+        games.winner.resize(kept);
+        games.id.resize(kept);
+        games.key_low.resize(kept);
+        games.key_high.resize(kept);
+        games.flip.resize(kept);
+    }
+}
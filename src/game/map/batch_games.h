@@ -0,0 +1,99 @@
+#pragma once
+
+#include "board_model.h"
+#include "rule_variants.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Many independent games advanced in lockstep for balancing runs. Games are
+// stored as structure-of-arrays and every call moves each running game by one
+// turn with the same straight-line code per game: one table lookup per landing
+// instead of running the tile effect programs, and dice hashed from (game,
+// turn, landing) instead of the shared mt19937 streams. Flags are 0 / ~0 masks
+// and the landing loop always runs table.landing_passes passes, so the lane
+// loops have no branches and GCC vectorises them (-fopt-info-vec); tile table
+// lookups become gathers in the AVX2 build.
+//
+// Because a draw depends only on the game's key and where the game is in its
+// turn, two boards reset with the same seed see the same dice on every turn
+// (common random numbers), and an antithetic game sees the mirrored dice of
+// its partner (a 1 where the partner rolled a 6).
+//
+// The rules are enumerate_turn's (minigames won with a fixed chance, landings
+// chained at most MAX_LANDING_CHAIN times), so batch results can be checked
+// against build_finish_table and compute_win_odds. House-rule variants
+// (rule_variants.h) come from the tile table; each one has its own
+// instantiation of the kernel.
+namespace game::map
+{
+    // Per tile: what a landing does. Tiles that end the turn have threshold 0.
+    struct BatchTileTable
+    {
+        int tile_count = 0;
+        std::vector<std::int32_t> destination;  // Where a landing that goes ahead moves to
+        std::vector<std::int32_t> bonus_span;   // Extra 0..span-1 tiles drawn on top (bonus rolls)
+        std::vector<std::uint32_t> threshold;   // Goes ahead if a 24-bit draw is below this
+        std::vector<std::uint32_t> chains;      // All ones: the new tile's landing is resolved too
+        std::vector<std::uint32_t> portal;      // All ones: goes to any other tile instead
+        std::vector<std::int32_t> next_snake;   // First snake head after the tile, tile_count if none
+        int landing_passes = 1;                 // Longest landing chain on the board, at most MAX_LANDING_CHAIN
+        RuleVariant rules;
+    };
+
+    BatchTileTable make_batch_tile_table(const BoardModel& board, const RuleVariant& rules = {});
+
+    struct BatchGames
+    {
+        int count = 0;
+        int players = 2;
+        std::vector<std::int32_t> tiles;      // tiles[row * count + game], row 0 = seat to move (see get_batch_tile)
+        std::vector<std::int32_t> seat;       // Seat to move
+        std::vector<std::uint32_t> turns;     // Turns taken, all seats together
+        std::vector<std::int32_t> winner;     // -1 while running
+        std::vector<std::uint32_t> id;        // Index given at reset, kept through compaction
+        std::vector<std::uint32_t> key_low;   // Dice key
+        std::vector<std::uint32_t> key_high;
+        std::vector<std::uint32_t> flip;      // Mirrors every draw of antithetic games
+    };
+
+    // Results of games taken out of a batch
+    struct BatchTally
+    {
+        std::uint64_t games = 0;
+        std::uint64_t turns = 0;
+        std::array<std::uint64_t, 4> wins{};
+    };
+
+    // Where games finished, by id
+    struct BatchOutcomes
+    {
+        std::vector<std::uint32_t> turns;
+        std::vector<std::int8_t> winner;  // -1 if given up before anyone won
+    };
+
+    // count games of players seats (2-4), everyone on tile 0, seat 0 to move.
+    // Game i gets the dice of game first_game + i of the seed's sequence, so a
+    // run split over several batches plays the same games. With antithetic,
+    // games come in pairs (even first_game) where the second mirrors the first.
+    void reset_batch_games(BatchGames& games, int count, int players, std::uint64_t seed,
+                           std::uint64_t first_game = 0, bool antithetic = false);
+
+    // One turn for every running game; returns how many are still running
+    int advance_batch_games(BatchGames& games, const BatchTileTable& table);
+
+    // Tile of seat in game. Rows rotate with the turn, so the seat to move is
+    // always row 0 and the kernel never gathers by seat.
+    std::int32_t get_batch_tile(const BatchGames& games, int game, int seat);
+
+    // advance_batch_games runs an AVX2 build of the kernel where the CPU has
+    // it; generic = true forces the baseline build (to compare the two)
+    void force_generic_batch_kernel(bool generic);
+    const char* get_batch_kernel_name();  // "avx2" or "generic"
+
+    // Adds the finished games to tally (and outcomes, if given, sized for every
+    // id) and packs the running ones to the front, so the long tail of slow
+    // games does not keep dragging finished lanes through every call
+    void compact_batch_games(BatchGames& games, BatchTally& tally, BatchOutcomes* outcomes = nullptr);
+}
@@ -1,5 +1,7 @@
 #include "board.h"
 
+#include "tile_effects.h"
+
 #include <algorithm>
 #include <array>
 
@@ -36,6 +38,65 @@ namespace game::map
         {
             return std::find(tiles.begin(), tiles.end(), tile_index) != tiles.end();
         }
+
+        ActivityKind classify_default_tile(int tile_index)
+        {
+            // Check minigame tiles first (highest priority)
+            if (matches_tile(tile_index, MEMORY_MINIGAME_TILES))
+            {
+                return ActivityKind::MemoryGame;
+            }
+            if (matches_tile(tile_index, PRECISION_MINIGAME_TILES))
+            {
+                return ActivityKind::MiniGame;
+            }
+            if (matches_tile(tile_index, REACTION_MINIGAME_TILES))
+            {
+                return ActivityKind::ReactionGame;
+            }
+            if (matches_tile(tile_index, MATH_MINIGAME_TILES))
+            {
+                return ActivityKind::MathGame;
+            }
+            if (matches_tile(tile_index, PATTERN_MINIGAME_TILES))
+            {
+                return ActivityKind::PatternGame;
+            }
+            if (matches_tile(tile_index, SKIP_TURN_TILES))
+            {
+                return ActivityKind::SkipTurn;
+            }
+            if (matches_tile(tile_index, WALK_BACKWARD_TILES))
+            {
+                return ActivityKind::WalkBackward;
+            }
+
+            // Then check special activity tiles (hardcoded to avoid conflicts)
+            if (matches_tile(tile_index, PORTAL_TILES))
+            {
+                return ActivityKind::Portal;
+            }
+            if (matches_tile(tile_index, SLIDE_TILES))
+            {
+                return ActivityKind::Slide;
+            }
+            if (matches_tile(tile_index, TRAP_TILES))
+            {
+                return ActivityKind::Trap;
+            }
+            if (matches_tile(tile_index, BONUS_TILES))
+            {
+                return ActivityKind::Bonus;
+            }
+
+            return ActivityKind::None;
+        }
+
+        BoardDefinition& active_board_storage()
+        {
+            static BoardDefinition board = default_board_definition();
+            return board;
+        }
     }
 
     glm::vec3 tile_center_world(int tile_index, float height_offset)
@@ -54,63 +115,36 @@ namespace game::map
         return {x, height_offset, z};
     }
 
-    ActivityKind classify_activity_tile(int tile_index)
+    BoardDefinition default_board_definition()
     {
-        const int last_tile = BOARD_COLUMNS * BOARD_ROWS - 1;
-        if (tile_index <= 0 || tile_index >= last_tile)
+        BoardDefinition board;
+        board.links.assign(BOARD_LINKS.begin(), BOARD_LINKS.end());
+        for (int tile = 1; tile < BOARD_COLUMNS * BOARD_ROWS - 1; ++tile)
         {
-            return ActivityKind::None;
+            board.activities[tile] = classify_default_tile(tile);
         }
+        return board;
+    }
 
-        // Check minigame tiles first (highest priority)
-        if (matches_tile(tile_index, MEMORY_MINIGAME_TILES))
-        {
-            return ActivityKind::MemoryGame;
-        }
-        if (matches_tile(tile_index, PRECISION_MINIGAME_TILES))
-        {
-            return ActivityKind::MiniGame;
-        }
-        if (matches_tile(tile_index, REACTION_MINIGAME_TILES))
-        {
-            return ActivityKind::ReactionGame;
-        }
-        if (matches_tile(tile_index, MATH_MINIGAME_TILES))
-        {
-            return ActivityKind::MathGame;
-        }
-        if (matches_tile(tile_index, PATTERN_MINIGAME_TILES))
-        {
-            return ActivityKind::PatternGame;
-        }
-        if (matches_tile(tile_index, SKIP_TURN_TILES))
-        {
-            return ActivityKind::SkipTurn;
-        }
-        if (matches_tile(tile_index, WALK_BACKWARD_TILES))
-        {
-            return ActivityKind::WalkBackward;
-        }
+    const BoardDefinition& active_board()
+    {
+        return active_board_storage();
+    }
 
-        // Then check special activity tiles (hardcoded to avoid conflicts)
-        if (matches_tile(tile_index, PORTAL_TILES))
-        {
-            return ActivityKind::Portal;
-        }
-        if (matches_tile(tile_index, SLIDE_TILES))
-        {
-            return ActivityKind::Slide;
-        }
-        if (matches_tile(tile_index, TRAP_TILES))
-        {
-            return ActivityKind::Trap;
-        }
-        if (matches_tile(tile_index, BONUS_TILES))
+    void set_active_board(const BoardDefinition& board)
+    {
+        active_board_storage() = board;
+        reload_active_tile_effects();
+    }
+
+    ActivityKind classify_activity_tile(int tile_index)
+    {
+        const int last_tile = BOARD_COLUMNS * BOARD_ROWS - 1;
+        if (tile_index <= 0 || tile_index >= last_tile)
         {
-            return ActivityKind::Bonus;
+            return ActivityKind::None;
         }
-
-        return ActivityKind::None;
+        return active_board().activities[tile_index];
     }
 
     bool check_wall_collision(const glm::vec3& position, float radius)
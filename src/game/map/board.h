@@ -3,6 +3,8 @@
 #include <array>
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <string>
+#include <vector>
 
 namespace game::map
 {
@@ -60,6 +62,29 @@ namespace game::map
         WalkBackward
     };
 
+    // A tile's own effect in the tile effect language (tile_effects.h), run
+    // instead of whatever its activity does
+    struct TileEffectSource
+    {
+        int tile = 0;
+        std::string program;
+    };
+
+    // Links and activity tiles of a board. The game starts on the built-in layout
+    // (BOARD_LINKS and the activity arrays in board.cpp); --board=FILE swaps in
+    // another one before anything reads it.
+    struct BoardDefinition
+    {
+        std::vector<BoardLink> links;
+        std::array<ActivityKind, BOARD_COLUMNS * BOARD_ROWS> activities{};
+        std::vector<TileEffectSource> effects;
+    };
+
+    BoardDefinition default_board_definition();
+    const BoardDefinition& active_board();
+    // Not synchronised - call before the map is built or any rules run
+    void set_active_board(const BoardDefinition& board);
+
     glm::vec3 tile_center_world(int tile_index, float height_offset = 0.0f);
     ActivityKind classify_activity_tile(int tile_index);
     bool check_wall_collision(const glm::vec3& position, float radius);
@@ -0,0 +1,752 @@
+#include "board_analysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace game::map
+{
+    namespace
+    {
+        double& band_at(BoardAnalysis& analysis, int row, int column)
+        {
+            const int width = analysis.lower + analysis.upper + 1;
+            return analysis.band[static_cast<std::size_t>(row) * width + (column - row + analysis.lower)];
+        }
+
+        double band_at(const BoardAnalysis& analysis, int row, int column)
+        {
+            const int width = analysis.lower + analysis.upper + 1;
+            return analysis.band[static_cast<std::size_t>(row) * width + (column - row + analysis.lower)];
+        }
+
+        // Doolittle LU in place; L's unit diagonal is implied
+        void factor_band(BoardAnalysis& analysis)
+        {
+            const int n = analysis.size;
+            for (int k = 0; k < n; ++k)
+            {
+                const double pivot = band_at(analysis, k, k);
+                if (std::abs(pivot) < 1e-300)
+                {
+                    throw std::runtime_error("Board analysis: singular move matrix at tile " + std::to_string(k));
+                }
+                const int last_row = std::min(n - 1, k + analysis.lower);
+                const int last_column = std::min(n - 1, k + analysis.upper);
+                for (int i = k + 1; i <= last_row; ++i)
+                {
+                    double& factor = band_at(analysis, i, k);
+                    if (factor == 0.0)
+                    {
+                        continue;
+                    }
+                    factor /= pivot;
+                    for (int j = k + 1; j <= last_column; ++j)
+                    {
+                        band_at(analysis, i, j) -= factor * band_at(analysis, k, j);
+                    }
+                }
+            }
+        }
+
+        // M x = b, b passed in x
+        void solve_band(const BoardAnalysis& analysis, std::vector<double>& x)
+        {
+            const int n = analysis.size;
+            for (int i = 0; i < n; ++i)
+            {
+                double sum = x[i];
+                for (int j = std::max(0, i - analysis.lower); j < i; ++j)
+                {
+                    sum -= band_at(analysis, i, j) * x[j];
+                }
+                x[i] = sum;
+            }
+            for (int i = n - 1; i >= 0; --i)
+            {
+                double sum = x[i];
+                const int last_column = std::min(n - 1, i + analysis.upper);
+                for (int j = i + 1; j <= last_column; ++j)
+                {
+                    sum -= band_at(analysis, i, j) * x[j];
+                }
+                x[i] = sum / band_at(analysis, i, i);
+            }
+        }
+
+        // M^T x = b: U^T y = b forward, then L^T x = y backward
+        void solve_band_transposed(const BoardAnalysis& analysis, std::vector<double>& x)
+        {
+            const int n = analysis.size;
+            for (int i = 0; i < n; ++i)
+            {
+                double sum = x[i];
+                for (int j = std::max(0, i - analysis.upper); j < i; ++j)
+                {
+                    sum -= band_at(analysis, j, i) * x[j];
+                }
+                x[i] = sum / band_at(analysis, i, i);
+            }
+            for (int i = n - 1; i >= 0; --i)
+            {
+                double sum = x[i];
+                const int last_row = std::min(n - 1, i + analysis.lower);
+                for (int j = i + 1; j <= last_row; ++j)
+                {
+                    sum -= band_at(analysis, j, i) * x[j];
+                }
+                x[i] = sum;
+            }
+        }
+
+        void to_dense(const SparseVector& sparse, int size, std::vector<double>& out)
+        {
+            out.assign(size, sparse.all);
+            for (std::size_t i = 0; i < sparse.index.size(); ++i)
+            {
+                out[sparse.index[i]] += sparse.value[i];
+            }
+        }
+
+        double dot(const SparseVector& sparse, const std::vector<double>& dense, double dense_sum)
+        {
+            double sum = sparse.all * dense_sum;
+            for (std::size_t i = 0; i < sparse.index.size(); ++i)
+            {
+                sum += sparse.value[i] * dense[sparse.index[i]];
+            }
+            return sum;
+        }
+
+        double sum_of(const std::vector<double>& values)
+        {
+            return std::accumulate(values.begin(), values.end(), 0.0);
+        }
+
+        void sort_and_merge(std::vector<std::pair<int, double>>& entries, SparseVector& out)
+        {
+            std::sort(entries.begin(), entries.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            out.index.clear();
+            out.value.clear();
+            for (const auto& [index, value] : entries)
+            {
+                if (!out.index.empty() && out.index.back() == index)
+                {
+                    out.value.back() += value;
+                }
+                else
+                {
+                    out.index.push_back(index);
+                    out.value.push_back(value);
+                }
+            }
+        }
+
+        // Row `row` of A = I - Q over the unfinished tiles
+        SparseVector row_of_a(const BoardModel& board, int row, std::vector<TurnOutcome>& outcomes)
+        {
+            const int size = board.tile_count - 1;
+            const double portal_share = 1.0 / static_cast<double>(board.tile_count - 1);
+            std::vector<std::pair<int, double>> entries{{row, 1.0}};
+            SparseVector result;
+
+            outcomes.clear();
+            enumerate_turn(board, row, outcomes);
+            for (const TurnOutcome& outcome : outcomes)
+            {
+                int target = outcome.tile;
+                if (outcome.exit == TurnExit::Link)
+                {
+                    target = board.link_end[outcome.tile];
+                }
+                else if (outcome.exit == TurnExit::Portal)
+                {
+                    // Every other tile: a share off all of them, given back on the portal
+                    result.all -= outcome.probability * portal_share;
+                    entries.emplace_back(outcome.tile, outcome.probability * portal_share);
+                    continue;
+                }
+                if (target < size)
+                {
+                    entries.emplace_back(target, -outcome.probability);
+                }
+            }
+            sort_and_merge(entries, result);
+            return result;
+        }
+
+        // a - b, or false if they are the same row
+        bool subtract(const SparseVector& a, const SparseVector& b, SparseVector& out)
+        {
+            std::vector<std::pair<int, double>> entries;
+            entries.reserve(a.index.size() + b.index.size());
+            for (std::size_t i = 0; i < a.index.size(); ++i)
+            {
+                entries.emplace_back(a.index[i], a.value[i]);
+            }
+            for (std::size_t i = 0; i < b.index.size(); ++i)
+            {
+                entries.emplace_back(b.index[i], -b.value[i]);
+            }
+            sort_and_merge(entries, out);
+            out.all = a.all - b.all;
+
+            constexpr double EPSILON = 1e-15;
+            bool changed = std::abs(out.all) > EPSILON;
+            for (double value : out.value)
+            {
+                changed = changed || std::abs(value) > EPSILON;
+            }
+            return changed;
+        }
+
+        // Dot product over the stored entries, `all` counted as one more entry.
+        // Not the dot product of the dense vectors, but linear, which is all the
+        // edit's basis needs.
+        double sparse_dot(const SparseVector& a, const SparseVector& b)
+        {
+            double sum = a.all * b.all;
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < a.index.size() && j < b.index.size())
+            {
+                if (a.index[i] < b.index[j])
+                {
+                    ++i;
+                }
+                else if (b.index[j] < a.index[i])
+                {
+                    ++j;
+                }
+                else
+                {
+                    sum += a.value[i++] * b.value[j++];
+                }
+            }
+            return sum;
+        }
+
+        // a += factor * b
+        void add_scaled(SparseVector& a, const SparseVector& b, double factor)
+        {
+            std::vector<std::pair<int, double>> entries;
+            entries.reserve(a.index.size() + b.index.size());
+            for (std::size_t i = 0; i < a.index.size(); ++i)
+            {
+                entries.emplace_back(a.index[i], a.value[i]);
+            }
+            for (std::size_t i = 0; i < b.index.size(); ++i)
+            {
+                entries.emplace_back(b.index[i], factor * b.value[i]);
+            }
+            sort_and_merge(entries, a);
+            a.all += factor * b.all;
+        }
+
+        void scale(SparseVector& a, double factor)
+        {
+            for (double& value : a.value)
+            {
+                value *= factor;
+            }
+            a.all *= factor;
+        }
+
+        // Gauss-Jordan with partial pivoting on an n x n row-major matrix
+        void invert_dense(std::vector<double>& matrix, int n)
+        {
+            std::vector<double> inverse(static_cast<std::size_t>(n) * n, 0.0);
+            for (int i = 0; i < n; ++i)
+            {
+                inverse[static_cast<std::size_t>(i) * n + i] = 1.0;
+            }
+            for (int column = 0; column < n; ++column)
+            {
+                int pivot_row = column;
+                for (int row = column + 1; row < n; ++row)
+                {
+                    if (std::abs(matrix[static_cast<std::size_t>(row) * n + column]) >
+                        std::abs(matrix[static_cast<std::size_t>(pivot_row) * n + column]))
+                    {
+                        pivot_row = row;
+                    }
+                }
+                const double pivot = matrix[static_cast<std::size_t>(pivot_row) * n + column];
+                if (std::abs(pivot) < 1e-300)
+                {
+                    throw std::runtime_error("Board analysis: singular capacitance matrix");
+                }
+                if (pivot_row != column)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        std::swap(matrix[static_cast<std::size_t>(pivot_row) * n + j], matrix[static_cast<std::size_t>(column) * n + j]);
+                        std::swap(inverse[static_cast<std::size_t>(pivot_row) * n + j], inverse[static_cast<std::size_t>(column) * n + j]);
+                    }
+                }
+                for (int j = 0; j < n; ++j)
+                {
+                    matrix[static_cast<std::size_t>(column) * n + j] /= pivot;
+                    inverse[static_cast<std::size_t>(column) * n + j] /= pivot;
+                }
+                for (int row = 0; row < n; ++row)
+                {
+                    const double factor = matrix[static_cast<std::size_t>(row) * n + column];
+                    if (row == column || factor == 0.0)
+                    {
+                        continue;
+                    }
+                    for (int j = 0; j < n; ++j)
+                    {
+                        matrix[static_cast<std::size_t>(row) * n + j] -= factor * matrix[static_cast<std::size_t>(column) * n + j];
+                        inverse[static_cast<std::size_t>(row) * n + j] -= factor * inverse[static_cast<std::size_t>(column) * n + j];
+                    }
+                }
+            }
+            matrix.swap(inverse);
+        }
+
+        // Solves for the terms from `first` on and grows the capacitance inverse by
+        // blocks: with C = [C0 B; D E] and S = E - D C0^-1 B,
+        //   C^-1 = [C0^-1 + P S^-1 Q, -P S^-1; -S^-1 Q, S^-1],  P = C0^-1 B, Q = D C0^-1
+        void add_terms(BoardAnalysis& analysis, int first)
+        {
+            const int total = static_cast<int>(analysis.u.size());
+            const int added = total - first;
+            if (added <= 0)
+            {
+                return;
+            }
+
+            // M^-1 u and M^-T v of the new terms only; entries of C against older
+            // terms come from the new side, as v_a . M^-1 u_b = (M^-T v_a) . u_b
+            std::vector<std::vector<double>> z(added);
+            std::vector<std::vector<double>> w(added);
+            std::vector<double> z_sums(added);
+            std::vector<double> w_sums(added);
+            for (int k = 0; k < added; ++k)
+            {
+                to_dense(analysis.u[first + k], analysis.size, z[k]);
+                solve_band(analysis, z[k]);
+                z_sums[k] = sum_of(z[k]);
+                to_dense(analysis.v[first + k], analysis.size, w[k]);
+                solve_band_transposed(analysis, w[k]);
+                w_sums[k] = sum_of(w[k]);
+            }
+
+            // Entry (a, b) of C = I - V^T M^-1 U, with a or b a new term
+            const auto capacitance = [&](int a, int b) {
+                const double solved = b >= first ? dot(analysis.v[a], z[b - first], z_sums[b - first])
+                                                 : dot(analysis.u[b], w[a - first], w_sums[a - first]);
+                return (a == b ? 1.0 : 0.0) - solved;
+            };
+
+            const std::vector<double>& old_inverse = analysis.capacitance_inverse;
+            std::vector<double> p(static_cast<std::size_t>(first) * added, 0.0);  // first x added
+            std::vector<double> q(static_cast<std::size_t>(added) * first, 0.0);  // added x first
+            {
+                std::vector<double> b(static_cast<std::size_t>(first) * added);
+                std::vector<double> d(static_cast<std::size_t>(added) * first);
+                for (int i = 0; i < first; ++i)
+                {
+                    for (int j = 0; j < added; ++j)
+                    {
+                        b[static_cast<std::size_t>(i) * added + j] = capacitance(i, first + j);
+                        d[static_cast<std::size_t>(j) * first + i] = capacitance(first + j, i);
+                    }
+                }
+                for (int i = 0; i < first; ++i)
+                {
+                    for (int k = 0; k < first; ++k)
+                    {
+                        const double inverse_ik = old_inverse[static_cast<std::size_t>(i) * first + k];
+                        for (int j = 0; j < added; ++j)
+                        {
+                            p[static_cast<std::size_t>(i) * added + j] += inverse_ik * b[static_cast<std::size_t>(k) * added + j];
+                            q[static_cast<std::size_t>(j) * first + k] += d[static_cast<std::size_t>(j) * first + i] * inverse_ik;
+                        }
+                    }
+                }
+                // S = E - D P
+                std::vector<double> s(static_cast<std::size_t>(added) * added);
+                for (int i = 0; i < added; ++i)
+                {
+                    for (int j = 0; j < added; ++j)
+                    {
+                        double value = capacitance(first + i, first + j);
+                        for (int k = 0; k < first; ++k)
+                        {
+                            value -= d[static_cast<std::size_t>(i) * first + k] * p[static_cast<std::size_t>(k) * added + j];
+                        }
+                        s[static_cast<std::size_t>(i) * added + j] = value;
+                    }
+                }
+                invert_dense(s, added);
+
+                // P S^-1 and S^-1 Q
+                std::vector<double> ps(static_cast<std::size_t>(first) * added, 0.0);
+                std::vector<double> sq(static_cast<std::size_t>(added) * first, 0.0);
+                for (int i = 0; i < first; ++i)
+                {
+                    for (int k = 0; k < added; ++k)
+                    {
+                        const double p_ik = p[static_cast<std::size_t>(i) * added + k];
+                        for (int j = 0; j < added; ++j)
+                        {
+                            ps[static_cast<std::size_t>(i) * added + j] += p_ik * s[static_cast<std::size_t>(k) * added + j];
+                        }
+                    }
+                }
+                for (int i = 0; i < added; ++i)
+                {
+                    for (int k = 0; k < added; ++k)
+                    {
+                        const double s_ik = s[static_cast<std::size_t>(i) * added + k];
+                        for (int j = 0; j < first; ++j)
+                        {
+                            sq[static_cast<std::size_t>(i) * first + j] += s_ik * q[static_cast<std::size_t>(k) * first + j];
+                        }
+                    }
+                }
+
+                std::vector<double> inverse(static_cast<std::size_t>(total) * total);
+                for (int i = 0; i < first; ++i)
+                {
+                    for (int j = 0; j < first; ++j)
+                    {
+                        double value = old_inverse[static_cast<std::size_t>(i) * first + j];
+                        for (int k = 0; k < added; ++k)
+                        {
+                            value += ps[static_cast<std::size_t>(i) * added + k] * q[static_cast<std::size_t>(k) * first + j];
+                        }
+                        inverse[static_cast<std::size_t>(i) * total + j] = value;
+                    }
+                    for (int j = 0; j < added; ++j)
+                    {
+                        inverse[static_cast<std::size_t>(i) * total + first + j] = -ps[static_cast<std::size_t>(i) * added + j];
+                    }
+                }
+                for (int i = 0; i < added; ++i)
+                {
+                    for (int j = 0; j < first; ++j)
+                    {
+                        inverse[static_cast<std::size_t>(first + i) * total + j] = -sq[static_cast<std::size_t>(i) * first + j];
+                    }
+                    for (int j = 0; j < added; ++j)
+                    {
+                        inverse[static_cast<std::size_t>(first + i) * total + first + j] = s[static_cast<std::size_t>(i) * added + j];
+                    }
+                }
+                analysis.capacitance_inverse.swap(inverse);
+            }
+        }
+
+        // Woodbury, with y = M^-1 1 and g = M^-T e0:
+        //   t = y + M^-1 U x,   x = C^-1 V^T y
+        //   v = g + M^-T V h,   h = C^-T (M^-1 U)^T e0 = C^-T U^T g
+        // Two banded solves regardless of rank
+        void update_results(BoardAnalysis& analysis)
+        {
+            const int rank = static_cast<int>(analysis.u.size());
+            const int size = analysis.size;
+            const std::vector<double>& y = analysis.m_solve_ones;
+            const std::vector<double>& g = analysis.mt_solve_start;
+            const double y_sum = sum_of(y);
+            const double g_sum = sum_of(g);
+
+            std::vector<double> vty(rank);
+            std::vector<double> utg(rank);
+            for (int k = 0; k < rank; ++k)
+            {
+                vty[k] = dot(analysis.v[k], y, y_sum);
+                utg[k] = dot(analysis.u[k], g, g_sum);
+            }
+            std::vector<double> x(rank, 0.0);
+            std::vector<double> h(rank, 0.0);
+            for (int i = 0; i < rank; ++i)
+            {
+                for (int j = 0; j < rank; ++j)
+                {
+                    const double inverse_ij = analysis.capacitance_inverse[static_cast<std::size_t>(i) * rank + j];
+                    x[i] += inverse_ij * vty[j];
+                    h[j] += inverse_ij * utg[i];
+                }
+            }
+
+            std::vector<double> turns_correction(size, 0.0);
+            std::vector<double> visits_correction(size, 0.0);
+            for (int k = 0; k < rank; ++k)
+            {
+                const SparseVector& u = analysis.u[k];
+                const SparseVector& v = analysis.v[k];
+                for (std::size_t i = 0; i < u.index.size(); ++i)
+                {
+                    turns_correction[u.index[i]] += u.value[i] * x[k];
+                }
+                if (u.all != 0.0)
+                {
+                    for (double& value : turns_correction)
+                    {
+                        value += u.all * x[k];
+                    }
+                }
+                for (std::size_t i = 0; i < v.index.size(); ++i)
+                {
+                    visits_correction[v.index[i]] += v.value[i] * h[k];
+                }
+                if (v.all != 0.0)
+                {
+                    for (double& value : visits_correction)
+                    {
+                        value += v.all * h[k];
+                    }
+                }
+            }
+            solve_band(analysis, turns_correction);
+            solve_band_transposed(analysis, visits_correction);
+
+            analysis.expected_turns.assign(analysis.board.tile_count, 0.0);
+            analysis.visits.assign(analysis.board.tile_count, 0.0);
+            for (int i = 0; i < size; ++i)
+            {
+                analysis.expected_turns[i] = y[i] + turns_correction[i];
+                analysis.visits[i] = g[i] + visits_correction[i];
+            }
+        }
+
+        // Folds the rows that differ between before and analysis.board into new
+        // terms. touched are the tiles whose landing behaviour changed.
+        void apply_edit(BoardAnalysis& analysis, const BoardModel& before, const std::vector<int>& touched)
+        {
+            if (static_cast<int>(analysis.u.size()) > analysis.base_rank + MAX_EDIT_RANK)
+            {
+                const BoardModel board = analysis.board;
+                analyze_board(analysis, board);
+                return;
+            }
+
+            // Only rows that can land on a touched tile can change
+            std::vector<int> rows;
+            const int reach_forward = turn_reach_forward(analysis.board);
+            const int reach_backward = turn_reach_backward(analysis.board);
+            for (int tile : touched)
+            {
+                const int first = std::max(0, tile - reach_forward);
+                const int last = std::min(analysis.size - 1, tile + reach_backward);
+                for (int row = first; row <= last; ++row)
+                {
+                    rows.push_back(row);
+                }
+            }
+            std::sort(rows.begin(), rows.end());
+            rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+            // The changed rows all differ by how a landing on the touched tiles
+            // continues, so their differences span only a few directions: keep an
+            // orthonormal basis of them and add one term per basis vector
+            //   A + sum_r e_r d_r^T = A + sum_j (sum_r c_rj e_r) q_j^T
+            std::vector<int> changed_rows;
+            std::vector<SparseVector> basis;
+            std::vector<std::vector<double>> coefficients;  // [row][basis vector]
+            std::vector<TurnOutcome> outcomes;
+            SparseVector difference;
+            for (int row : rows)
+            {
+                const SparseVector old_row = row_of_a(before, row, outcomes);
+                const SparseVector new_row = row_of_a(analysis.board, row, outcomes);
+                if (!subtract(new_row, old_row, difference))
+                {
+                    continue;
+                }
+                const double norm = std::sqrt(sparse_dot(difference, difference));
+                std::vector<double> row_coefficients;
+                for (const SparseVector& q : basis)
+                {
+                    const double projection = sparse_dot(difference, q);
+                    add_scaled(difference, q, -projection);
+                    row_coefficients.push_back(projection);
+                }
+                const double residual = std::sqrt(sparse_dot(difference, difference));
+                if (residual > 1e-12 * norm)
+                {
+                    scale(difference, 1.0 / residual);
+                    basis.push_back(difference);
+                    row_coefficients.push_back(residual);
+                }
+                changed_rows.push_back(row);
+                coefficients.push_back(std::move(row_coefficients));
+            }
+
+            // A + e_r q^T = M - U V^T with v = -q
+            const int first_new = static_cast<int>(analysis.u.size());
+            for (std::size_t j = 0; j < basis.size(); ++j)
+            {
+                SparseVector u;
+                for (std::size_t i = 0; i < changed_rows.size(); ++i)
+                {
+                    if (j < coefficients[i].size() && coefficients[i][j] != 0.0)
+                    {
+                        u.index.push_back(changed_rows[i]);
+                        u.value.push_back(coefficients[i][j]);
+                    }
+                }
+                scale(basis[j], -1.0);
+                analysis.u.push_back(std::move(u));
+                analysis.v.push_back(std::move(basis[j]));
+            }
+
+            add_terms(analysis, first_new);
+            update_results(analysis);
+        }
+
+        bool is_link_tile(const BoardAnalysis& analysis, int tile)
+        {
+            return tile > 0 && tile < analysis.board.tile_count - 1;
+        }
+    }
+
+    void analyze_board(BoardAnalysis& analysis, const BoardModel& board)
+    {
+        analysis.board = board;
+        analysis.size = board.tile_count - 1;
+        const int size = analysis.size;
+        const double portal_share = 1.0 / static_cast<double>(board.tile_count - 1);
+
+        // Split every row into short-range entries (M) and the low-rank parts
+        std::vector<std::vector<std::pair<int, double>>> local(size);
+        std::vector<std::vector<std::pair<int, double>>> link_rows(board.tile_count);
+        std::vector<std::pair<int, double>> portal_rows;
+        std::vector<TurnOutcome> outcomes;
+        for (int row = 0; row < size; ++row)
+        {
+            local[row].emplace_back(row, 1.0);
+            outcomes.clear();
+            enumerate_turn(board, row, outcomes);
+            for (const TurnOutcome& outcome : outcomes)
+            {
+                switch (outcome.exit)
+                {
+                case TurnExit::Stop:
+                    if (outcome.tile < size)
+                    {
+                        local[row].emplace_back(outcome.tile, -outcome.probability);
+                    }
+                    break;
+                case TurnExit::Link:
+                {
+                    const int end = board.link_end[outcome.tile];
+                    if (end >= size)
+                    {
+                        break;
+                    }
+                    if (std::abs(end - row) <= MAX_BAND_LINK)
+                    {
+                        local[row].emplace_back(end, -outcome.probability);
+                    }
+                    else
+                    {
+                        link_rows[outcome.tile].emplace_back(row, outcome.probability);
+                    }
+                    break;
+                }
+                case TurnExit::Portal:
+                    local[row].emplace_back(outcome.tile, outcome.probability * portal_share);
+                    portal_rows.emplace_back(row, outcome.probability * portal_share);
+                    break;
+                }
+            }
+        }
+
+        analysis.lower = 0;
+        analysis.upper = 0;
+        for (int row = 0; row < size; ++row)
+        {
+            for (const auto& [column, value] : local[row])
+            {
+                analysis.lower = std::max(analysis.lower, row - column);
+                analysis.upper = std::max(analysis.upper, column - row);
+            }
+        }
+        analysis.band.assign(static_cast<std::size_t>(size) * (analysis.lower + analysis.upper + 1), 0.0);
+        for (int row = 0; row < size; ++row)
+        {
+            for (const auto& [column, value] : local[row])
+            {
+                band_at(analysis, row, column) += value;
+            }
+        }
+        factor_band(analysis);
+
+        // One term per long link: landings on its start (u) move to its end (v)
+        analysis.u.clear();
+        analysis.v.clear();
+        analysis.capacitance_inverse.clear();
+        for (int start = 0; start < board.tile_count; ++start)
+        {
+            if (link_rows[start].empty())
+            {
+                continue;
+            }
+            SparseVector u;
+            sort_and_merge(link_rows[start], u);
+            SparseVector v;
+            v.index.push_back(board.link_end[start]);
+            v.value.push_back(1.0);
+            analysis.u.push_back(std::move(u));
+            analysis.v.push_back(std::move(v));
+        }
+        if (!portal_rows.empty())
+        {
+            SparseVector u;
+            sort_and_merge(portal_rows, u);
+            SparseVector v;
+            v.all = 1.0;
+            analysis.u.push_back(std::move(u));
+            analysis.v.push_back(std::move(v));
+        }
+        add_terms(analysis, 0);
+        analysis.base_rank = static_cast<int>(analysis.u.size());
+
+        analysis.m_solve_ones.assign(size, 1.0);
+        solve_band(analysis, analysis.m_solve_ones);
+        analysis.mt_solve_start.assign(size, 0.0);
+        analysis.mt_solve_start[0] = 1.0;
+        solve_band_transposed(analysis, analysis.mt_solve_start);
+
+        update_results(analysis);
+    }
+
+    bool set_link(BoardAnalysis& analysis, int start, int end)
+    {
+        if (!is_link_tile(analysis, start) || end >= analysis.board.tile_count)
+        {
+            return false;
+        }
+        const BoardModel before = analysis.board;
+        analysis.board.link_end[start] = end < 0 ? -1 : end;
+        apply_edit(analysis, before, {start});
+        return true;
+    }
+
+    bool move_link(BoardAnalysis& analysis, int from_start, int to_start, int to_end)
+    {
+        if (!is_link_tile(analysis, from_start) || analysis.board.link_end[from_start] < 0 ||
+            !is_link_tile(analysis, to_start) || to_end < 0 || to_end >= analysis.board.tile_count)
+        {
+            return false;
+        }
+        const BoardModel before = analysis.board;
+        analysis.board.link_end[from_start] = -1;
+        analysis.board.link_end[to_start] = to_end;
+        apply_edit(analysis, before, {from_start, to_start});
+        return true;
+    }
+
+    double expected_game_turns(const BoardAnalysis& analysis)
+    {
+        return analysis.expected_turns.empty() ? 0.0 : analysis.expected_turns[0];
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "board_model.h"
+
+#include <vector>
+
+// Expected game length and tile-visit heatmap of a board, kept up to date while
+// a designer edits its links.
+//
+// A turn is an absorbing Markov chain over the tiles, so with A = I - Q over the
+// unfinished tiles, expected turns from every tile solve A t = 1 and expected
+// visits from the start solve A^T v = e0. A is split as M - U V^T:
+//   M      short-range moves (rolls, slides, bonuses, backward walks, links up to
+//          MAX_BAND_LINK tiles long), which only couple nearby tiles - a banded
+//          LU, factored once per rebuild
+//   U V^T  one term per longer link (landings on its start, redirected to its
+//          end), one for portals, and one per row edited since the rebuild
+// and solved with the Woodbury identity. An edit only rebuilds the rows that can
+// land on the tiles it touched and folds them in as new terms - two banded solves
+// per changed row and a block update of the small capacitance inverse.
+namespace game::map
+{
+    // value[i] at index[i], plus `all` on every unfinished tile
+    struct SparseVector
+    {
+        std::vector<int> index;
+        std::vector<double> value;
+        double all = 0.0;
+    };
+
+    struct BoardAnalysis
+    {
+        BoardModel board;
+
+        // Banded LU of M without pivoting (M is diagonally dominant)
+        int size = 0;   // Unfinished tiles
+        int lower = 0;  // Band widths below / above the diagonal
+        int upper = 0;
+        std::vector<double> band;  // size x (lower + upper + 1), row-major
+
+        std::vector<SparseVector> u;  // Low-rank terms, U V^T
+        std::vector<SparseVector> v;
+        std::vector<double> capacitance_inverse;  // (I - V^T M^-1 U)^-1, row-major
+        int base_rank = 0;                        // Terms present right after the rebuild
+
+        std::vector<double> m_solve_ones;   // M^-1 1
+        std::vector<double> mt_solve_start; // M^-T e0
+
+        // Results, tile_count entries each (the final tile reads 0)
+        std::vector<double> expected_turns;  // Expected turns to finish from each tile
+        std::vector<double> visits;          // Expected turns started on each tile in a game from tile 0
+    };
+
+    // Links spanning more tiles than this go into U V^T rather than the band
+    constexpr int MAX_BAND_LINK = 64;
+    // Edits past this many extra terms trigger a rebuild instead
+    constexpr int MAX_EDIT_RANK = 256;
+
+    // Factors the board from scratch and fills the results
+    void analyze_board(BoardAnalysis& analysis, const BoardModel& board);
+
+    // Sets the link starting on start to lead to end (end < 0 removes it).
+    // Returns false, leaving the board alone, for a start or end off the board.
+    bool set_link(BoardAnalysis& analysis, int start, int end);
+    // Moves the link on from_start so it starts on to_start and leads to to_end
+    bool move_link(BoardAnalysis& analysis, int from_start, int to_start, int to_end);
+
+    // Expected turns for one player to finish from the start tile
+    double expected_game_turns(const BoardAnalysis& analysis);
+}
@@ -0,0 +1,232 @@
+#include "board_compare.h"
+
+#include "batch_games.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr int METRICS = 5;  // Turns per game, then each seat's win rate
+
+        // Running sums for one metric. Per game for A and B on their own, per
+        // sample (pair) for the difference.
+        struct Moments
+        {
+            double sum_a = 0.0;
+            double sum_b = 0.0;
+            double squares_a = 0.0;
+            double squares_b = 0.0;
+            double sum_difference = 0.0;
+            double squares_difference = 0.0;
+        };
+
+        struct Sums
+        {
+            std::uint64_t samples = 0;
+            std::uint64_t unfinished = 0;
+            std::array<Moments, METRICS> metrics{};
+        };
+
+        double sample_variance(double sum, double squares, double count)
+        {
+            if (count < 2.0)
+            {
+                return 0.0;
+            }
+            return std::max(0.0, (squares - sum * sum / count) / (count - 1.0));
+        }
+
+        // Plays count games of the seed's sequence from first_game on one board
+        BatchOutcomes play_games(const BatchTileTable& table, int count, const CompareOptions& options,
+                                 std::uint64_t first_game)
+        {
+            BatchOutcomes outcomes;
+            outcomes.turns.assign(count, 0);
+            outcomes.winner.assign(count, -1);
+
+            BatchGames games;
+            BatchTally tally;
+            reset_batch_games(games, count, options.players, options.seed, first_game, options.antithetic);
+            for (int turn = 0; turn < options.max_turns && games.count > 0; ++turn)
+            {
+                const int running = advance_batch_games(games, table);
+                if (running * 2 < games.count)
+                {
+                    compact_batch_games(games, tally, &outcomes);
+                }
+            }
+            compact_batch_games(games, tally, &outcomes);
+            for (int game = 0; game < games.count; ++game)
+            {
+                outcomes.turns[games.id[game]] = games.turns[game];
+            }
+            return outcomes;
+        }
+
+        // Samples [first, first + count) of the round
+        void play_samples(const BatchTileTable& a, const BatchTileTable& b, const CompareOptions& options,
+                          std::uint64_t first, int count, Sums& sums)
+        {
+            const int per_sample = options.antithetic ? 2 : 1;
+            const std::uint64_t first_game = first * per_sample;
+            const BatchOutcomes played_a = play_games(a, count * per_sample, options, first_game);
+            const BatchOutcomes played_b = play_games(b, count * per_sample, options, first_game);
+
+            for (int sample = 0; sample < count; ++sample)
+            {
+                std::array<double, METRICS> difference{};
+                for (int game = sample * per_sample; game < (sample + 1) * per_sample; ++game)
+                {
+                    std::array<double, METRICS> value_a{};
+                    std::array<double, METRICS> value_b{};
+                    value_a[0] = played_a.turns[game];
+                    value_b[0] = played_b.turns[game];
+                    if (played_a.winner[game] >= 0)
+                    {
+                        value_a[1 + played_a.winner[game]] = 1.0;
+                    }
+                    if (played_b.winner[game] >= 0)
+                    {
+                        value_b[1 + played_b.winner[game]] = 1.0;
+                    }
+                    sums.unfinished += (played_a.winner[game] < 0 ? 1 : 0) + (played_b.winner[game] < 0 ? 1 : 0);
+
+                    for (int metric = 0; metric < METRICS; ++metric)
+                    {
+                        Moments& moments = sums.metrics[metric];
+                        moments.sum_a += value_a[metric];
+                        moments.sum_b += value_b[metric];
+                        moments.squares_a += value_a[metric] * value_a[metric];
+                        moments.squares_b += value_b[metric] * value_b[metric];
+                        difference[metric] += (value_b[metric] - value_a[metric]) / per_sample;
+                    }
+                }
+                for (int metric = 0; metric < METRICS; ++metric)
+                {
+                    sums.metrics[metric].sum_difference += difference[metric];
+                    sums.metrics[metric].squares_difference += difference[metric] * difference[metric];
+                }
+                ++sums.samples;
+            }
+        }
+
+        Effect make_effect(const Moments& moments, std::uint64_t samples, int per_sample, double z)
+        {
+            const double n = static_cast<double>(samples);
+            const double games = n * per_sample;
+            Effect effect;
+            if (samples == 0)
+            {
+                return effect;
+            }
+            effect.a = moments.sum_a / games;
+            effect.b = moments.sum_b / games;
+            effect.difference = moments.sum_difference / n;
+
+            const double variance_a = sample_variance(moments.sum_a, moments.squares_a, games);
+            const double variance_b = sample_variance(moments.sum_b, moments.squares_b, games);
+            const double variance_difference = sample_variance(moments.sum_difference, moments.squares_difference, n);
+            effect.half_width = z * std::sqrt(variance_difference / n);
+            effect.effect_size = variance_a > 0.0 ? effect.difference / std::sqrt(variance_a) : 0.0;
+
+            // Independent runs of the same size estimate the difference with
+            // variance (var_a + var_b) / games
+            const double independent = (variance_a + variance_b) / per_sample;
+            effect.variance_ratio = variance_difference > 0.0 ? independent / variance_difference
+                                                              : std::numeric_limits<double>::infinity();
+            return effect;
+        }
+
+        void fill_result(const Sums& sums, const CompareOptions& options, CompareResult& result)
+        {
+            const int per_sample = options.antithetic ? 2 : 1;
+            result.pairs = sums.samples;
+            result.unfinished = sums.unfinished;
+            result.turns = make_effect(sums.metrics[0], sums.samples, per_sample, options.z);
+            result.converged = result.turns.half_width <= options.turns_precision;
+            for (int seat = 0; seat < 4; ++seat)
+            {
+                result.wins[seat] = make_effect(sums.metrics[1 + seat], sums.samples, per_sample, options.z);
+                if (seat < result.players)
+                {
+                    result.converged = result.converged && result.wins[seat].half_width <= options.win_precision;
+                }
+            }
+        }
+    }
+
+    CompareResult compare_boards(const BoardModel& a, const BoardModel& b, const CompareOptions& options,
+                                 const std::function<void(const CompareResult&)>& progress)
+    {
+        CompareOptions run = options;
+        run.players = std::clamp(options.players, 2, 4);
+        run.round_pairs = std::max(1, options.round_pairs);
+        run.max_turns = std::max(1, options.max_turns);
+        const int threads = options.threads > 0 ? options.threads
+                                                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        const BatchTileTable table_a = make_batch_tile_table(a, options.rules_a);
+        const BatchTileTable table_b = make_batch_tile_table(b, options.rules_b);
+
+        CompareResult result;
+        result.players = run.players;
+        Sums total;
+        while (total.samples < run.max_pairs)
+        {
+            const int round = static_cast<int>(
+                std::min<std::uint64_t>(static_cast<std::uint64_t>(run.round_pairs), run.max_pairs - total.samples));
+            const int workers_used = std::min(threads, round);
+            std::vector<Sums> sums(workers_used);
+            std::vector<std::thread> workers;
+            workers.reserve(workers_used);
+            for (int index = 0; index < workers_used; ++index)
+            {
+                const int share = round / workers_used;
+                const int extra = round % workers_used;
+                const std::uint64_t first = total.samples + static_cast<std::uint64_t>(index * share + std::min(index, extra));
+                const int count = share + (index < extra ? 1 : 0);
+                workers.emplace_back([&, index, first, count]() {
+                    play_samples(table_a, table_b, run, first, count, sums[index]);
+                });
+            }
+            for (std::thread& worker : workers)
+            {
+                worker.join();
+            }
+
+            for (const Sums& part : sums)
+            {
+                total.samples += part.samples;
+                total.unfinished += part.unfinished;
+                for (int metric = 0; metric < METRICS; ++metric)
+                {
+                    Moments& into = total.metrics[metric];
+                    const Moments& from = part.metrics[metric];
+                    into.sum_a += from.sum_a;
+                    into.sum_b += from.sum_b;
+                    into.squares_a += from.squares_a;
+                    into.squares_b += from.squares_b;
+                    into.sum_difference += from.sum_difference;
+                    into.squares_difference += from.squares_difference;
+                }
+            }
+
+            fill_result(total, run, result);
+            if (progress)
+            {
+                progress(result);
+            }
+            if (result.converged)
+            {
+                break;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "board_model.h"
+#include "rule_variants.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+// A/B comparison of two boards (or the same board under different rules) by
+// simulation with the batch kernel. Both variants play the same games: game i
+// gets the same dice on every turn in A and B (common random numbers), and
+// games come in antithetic pairs whose dice mirror each other. The
+// differences B - A are measured per pair, so the noise the two variants
+// share cancels, and the run stops as soon as every confidence interval is
+// tight enough.
+namespace game::map
+{
+    struct CompareOptions
+    {
+        int players = 2;
+        int threads = 0;                       // 0 = one per core
+        int round_pairs = 1 << 16;             // Pairs played between stopping checks
+        std::uint64_t max_pairs = 1ull << 24;
+        double turns_precision = 0.25;         // Stop once the turns-per-game interval is +- this
+        double win_precision = 0.005;          // ... and every seat's win-rate interval is +- this
+        double z = 1.96;                       // Interval half-width in standard errors (95%)
+        bool antithetic = true;
+        int max_turns = 100000;                // Games still going after this count as nobody winning
+        std::uint64_t seed = 1;
+        RuleVariant rules_a;                   // House rules each side plays by
+        RuleVariant rules_b;
+    };
+
+    struct Effect
+    {
+        double a = 0.0;
+        double b = 0.0;
+        double difference = 0.0;   // b - a
+        double half_width = 0.0;   // Confidence interval of difference is +- this
+        double effect_size = 0.0;  // difference / standard deviation of one A game
+        double variance_ratio = 0.0;  // How many times more games independent runs would need;
+                                      // infinity if the paired difference never varies
+    };
+
+    struct CompareResult
+    {
+        std::uint64_t pairs = 0;  // Samples; a pair is two games on each board (one with antithetic off)
+        bool converged = false;   // Stopped on precision rather than max_pairs
+        int players = 2;
+        Effect turns;             // Turns per game, all seats together
+        std::array<Effect, 4> wins{};
+        std::uint64_t unfinished = 0;
+    };
+
+    // progress gets the result so far after every round
+    CompareResult compare_boards(const BoardModel& a, const BoardModel& b, const CompareOptions& options,
+                                 const std::function<void(const CompareResult&)>& progress = {});
+}
@@ -0,0 +1,262 @@
+#include "board_file.h"
+
+#include "tile_effects.h"
+
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr const char* BOARD_FILE_MAGIC = "snakes-ladder-board";
+        constexpr int TILE_COUNT = BOARD_COLUMNS * BOARD_ROWS;
+
+        struct ActivityName
+        {
+            ActivityKind kind;
+            const char* name;
+        };
+
+        constexpr ActivityName ACTIVITY_NAMES[] = {
+            {ActivityKind::Bonus, "bonus"},
+            {ActivityKind::Slide, "slide"},
+            {ActivityKind::Portal, "portal"},
+            {ActivityKind::Trap, "trap"},
+            {ActivityKind::MiniGame, "precision"},
+            {ActivityKind::MemoryGame, "memory"},
+            {ActivityKind::ReactionGame, "reaction"},
+            {ActivityKind::MathGame, "math"},
+            {ActivityKind::PatternGame, "pattern"},
+            {ActivityKind::SkipTurn, "skip-turn"},
+            {ActivityKind::WalkBackward, "walk-backward"},
+        };
+
+        const char* activity_name(ActivityKind kind)
+        {
+            for (const ActivityName& entry : ACTIVITY_NAMES)
+            {
+                if (entry.kind == kind)
+                {
+                    return entry.name;
+                }
+            }
+            return "none";
+        }
+
+        bool parse_activity(const std::string& name, ActivityKind& kind)
+        {
+            for (const ActivityName& entry : ACTIVITY_NAMES)
+            {
+                if (name == entry.name)
+                {
+                    kind = entry.kind;
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    void write_board_definition(std::ostream& file, const BoardDefinition& board)
+    {
+        file << BOARD_FILE_MAGIC << ' ' << BOARD_FILE_VERSION << '\n';
+        file << "links " << board.links.size() << '\n';
+        for (const BoardLink& link : board.links)
+        {
+            file << link.start << ' ' << link.end << ' '
+                 << link.color.x << ' ' << link.color.y << ' ' << link.color.z << '\n';
+        }
+
+        int activity_count = 0;
+        for (ActivityKind kind : board.activities)
+        {
+            activity_count += kind != ActivityKind::None ? 1 : 0;
+        }
+        file << "activities " << activity_count << '\n';
+        for (int tile = 0; tile < TILE_COUNT; ++tile)
+        {
+            if (board.activities[tile] != ActivityKind::None)
+            {
+                file << tile << ' ' << activity_name(board.activities[tile]) << '\n';
+            }
+        }
+
+        file << "effects " << board.effects.size() << '\n';
+        for (const TileEffectSource& effect : board.effects)
+        {
+            file << effect.tile << ' ' << effect.program << '\n';
+        }
+    }
+
+    void save_board_definition(const std::filesystem::path& path, const BoardDefinition& board)
+    {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open board file for writing: " + path.string());
+        }
+        write_board_definition(file, board);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write board file: " + path.string());
+        }
+    }
+
+    BoardDefinition read_board_definition(std::istream& file, const std::string& source)
+    {
+        const auto fail = [&source](const std::string& message) {
+            throw std::runtime_error("Malformed board file (" + message + "): " + source);
+        };
+        const auto expect = [&file, &fail](const char* label) {
+            std::string word;
+            if (!(file >> word) || word != label)
+            {
+                fail("expected '" + std::string(label) + "'");
+            }
+        };
+
+        BoardDefinition board;
+        int version = 0;
+        expect(BOARD_FILE_MAGIC);
+        file >> version;
+        if (version < 1 || version > BOARD_FILE_VERSION)
+        {
+            throw std::runtime_error("Unsupported board file version " + std::to_string(version) + ": " + source);
+        }
+
+        std::size_t link_count = 0;
+        expect("links");
+        file >> link_count;
+        if (!file || link_count > static_cast<std::size_t>(TILE_COUNT))
+        {
+            fail("link count");
+        }
+        board.links.resize(link_count);
+        for (BoardLink& link : board.links)
+        {
+            if (!(file >> link.start >> link.end >> link.color.x >> link.color.y >> link.color.z))
+            {
+                fail("truncated links");
+            }
+            link.is_ladder = link.end > link.start;
+        }
+
+        std::size_t activity_count = 0;
+        expect("activities");
+        file >> activity_count;
+        if (!file || activity_count > static_cast<std::size_t>(TILE_COUNT))
+        {
+            fail("activity count");
+        }
+        for (std::size_t i = 0; i < activity_count; ++i)
+        {
+            int tile = 0;
+            std::string name;
+            if (!(file >> tile >> name))
+            {
+                fail("truncated activities");
+            }
+            ActivityKind kind = ActivityKind::None;
+            if (tile < 0 || tile >= TILE_COUNT || !parse_activity(name, kind))
+            {
+                fail("activity " + std::to_string(tile) + " " + name);
+            }
+            board.activities[tile] = kind;
+        }
+
+        if (version >= 2)
+        {
+            std::size_t effect_count = 0;
+            expect("effects");
+            file >> effect_count;
+            if (!file || effect_count > static_cast<std::size_t>(TILE_COUNT))
+            {
+                fail("effect count");
+            }
+            board.effects.resize(effect_count);
+            for (TileEffectSource& effect : board.effects)
+            {
+                if (!(file >> effect.tile >> std::ws) || !std::getline(file, effect.program))
+                {
+                    fail("truncated effects");
+                }
+            }
+        }
+
+        const std::string problem = validate_board_definition(board);
+        if (!problem.empty())
+        {
+            fail(problem);
+        }
+        return board;
+    }
+
+    BoardDefinition load_board_definition(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to open board file: " + path.string());
+        }
+        return read_board_definition(file, path.string());
+    }
+
+    std::string validate_board_definition(const BoardDefinition& board)
+    {
+        const int final_tile = TILE_COUNT - 1;
+        std::array<bool, TILE_COUNT> link_start{};
+        for (const BoardLink& link : board.links)
+        {
+            if (link.start <= 0 || link.start >= final_tile || link.end < 0 || link.end >= final_tile ||
+                link.end == link.start)
+            {
+                return "link " + std::to_string(link.start) + " -> " + std::to_string(link.end) + " is off the board";
+            }
+            if (link_start[link.start])
+            {
+                return "two links start on tile " + std::to_string(link.start);
+            }
+            link_start[link.start] = true;
+        }
+        for (const BoardLink& link : board.links)
+        {
+            if (link_start[link.end])
+            {
+                return "link " + std::to_string(link.start) + " ends on another link's start";
+            }
+        }
+        for (int tile = 0; tile < TILE_COUNT; ++tile)
+        {
+            if (board.activities[tile] == ActivityKind::None)
+            {
+                continue;
+            }
+            if (tile == 0 || tile == final_tile || link_start[tile])
+            {
+                return "activity on tile " + std::to_string(tile);
+            }
+        }
+        std::array<bool, TILE_COUNT> has_effect{};
+        for (const TileEffectSource& effect : board.effects)
+        {
+            if (effect.tile <= 0 || effect.tile >= final_tile || link_start[effect.tile] || has_effect[effect.tile])
+            {
+                return "effect on tile " + std::to_string(effect.tile);
+            }
+            has_effect[effect.tile] = true;
+            try
+            {
+                TileEffects scratch;
+                compile_effect_program(scratch, effect.program);
+            }
+            catch (const std::exception& e)
+            {
+                return e.what();
+            }
+        }
+        return {};
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "board.h"
+
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+
+// Board layouts as text files, for --board=FILE and snl_board_optimizer:
+//   snakes-ladder-board 2
+//   links N                  then N lines: start end r g b
+//   activities N             then N lines: tile name (bonus, portal, memory, ...)
+//   effects N                then N lines: tile program (version 2, see tile_effects.h)
+// Tiles are 0-based indices, as in BOARD_LINKS. A link ending above its start
+// is a ladder. A tile with an effect runs its program instead of its activity's.
+namespace game::map
+{
+    constexpr int BOARD_FILE_VERSION = 2;
+
+    void save_board_definition(const std::filesystem::path& path, const BoardDefinition& board);
+    // Throws std::runtime_error on unreadable or inconsistent files
+    BoardDefinition load_board_definition(const std::filesystem::path& path);
+
+    // The same format on a stream (snl_sweep ships boards to its workers this
+    // way); source names the stream in error messages
+    void write_board_definition(std::ostream& out, const BoardDefinition& board);
+    BoardDefinition read_board_definition(std::istream& in, const std::string& source);
+
+    // Empty if board is playable, otherwise what is wrong with it: links off
+    // the board or onto the final tile, two links on one tile, a link ending on
+    // another's start, an activity or effect on a link start or the first / last
+    // tile, or an effect that does not compile
+    std::string validate_board_definition(const BoardDefinition& board);
+}
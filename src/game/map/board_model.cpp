@@ -0,0 +1,307 @@
+#include "board_model.h"
+
+#include "tile_effects.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace game::map
+{
+    namespace
+    {
+        void add_landing(const BoardModel& board, int tile, double probability, int depth, std::vector<TurnOutcome>& out)
+        {
+            const int final_tile = board.tile_count - 1;
+            if (tile >= final_tile)
+            {
+                out.push_back({TurnExit::Stop, final_tile, probability});  // Overshooting counts as reaching the end
+                return;
+            }
+            if (depth >= MAX_LANDING_CHAIN)
+            {
+                out.push_back({TurnExit::Stop, tile, probability});
+                return;
+            }
+            if (board.link_end[tile] >= 0)
+            {
+                out.push_back({TurnExit::Link, tile, probability});
+                return;
+            }
+
+            const TileLanding& landing = board.landings[tile];
+            switch (landing.kind)
+            {
+            case TileLanding::Kind::Walk:
+            {
+                const int first = std::max(0, tile + landing.steps);
+                for (int extra = 0; extra < landing.span; ++extra)
+                {
+                    add_landing(board, first + extra, probability / landing.span, depth + 1, out);
+                }
+                break;
+            }
+            case TileLanding::Kind::Warp:
+                out.push_back({TurnExit::Stop, landing.target, probability});
+                break;
+            case TileLanding::Kind::Portal:
+                out.push_back({TurnExit::Portal, tile, probability});
+                break;
+            case TileLanding::Kind::Minigame:
+            {
+                const double success = std::clamp(static_cast<double>(board.minigame_success), 0.0, 1.0);
+                add_landing(board, tile + minigame_bonus_steps(landing.minigame), probability * success, depth + 1, out);
+                out.push_back({TurnExit::Stop, tile, probability * (1.0 - success)});
+                break;
+            }
+            default:
+                // Skip turn and trap only end the turn; nothing else moves the player
+                out.push_back({TurnExit::Stop, tile, probability});
+                break;
+            }
+        }
+
+        // The landing tile's program plays as, the way run_tile_effect runs it.
+        // False if it is none of TileLanding's shapes.
+        bool read_landing(const TileEffects& effects, int tile, TileLanding& landing)
+        {
+            landing = TileLanding{};
+            int forward = 0;   // add_steps adds up
+            int backward = 0;  // step_backward replaces
+            int moves_back = 0;
+            int rolls = 0;
+            int endings = 0;   // warp, random-warp, skip and minigame each decide the turn
+            for (const EffectInstruction* at = &effects.code[effects.entry[tile]]; at->op != EffectOp::End; ++at)
+            {
+                switch (at->op)
+                {
+                case EffectOp::Move:
+                    if (at->value >= 0)
+                    {
+                        forward += at->value;
+                    }
+                    else
+                    {
+                        backward = -at->value;
+                        ++moves_back;
+                    }
+                    break;
+                case EffectOp::BonusRoll:
+                    forward += at->small;
+                    landing.span = at->value - at->small + 1;
+                    ++rolls;
+                    break;
+                case EffectOp::Warp:
+                    landing.kind = TileLanding::Kind::Warp;
+                    landing.target = at->value;
+                    ++endings;
+                    break;
+                case EffectOp::RandomWarp:
+                    landing.kind = TileLanding::Kind::Portal;
+                    ++endings;
+                    break;
+                case EffectOp::Skip:
+                    ++endings;
+                    break;
+                case EffectOp::Minigame:
+                    landing.kind = TileLanding::Kind::Minigame;
+                    landing.minigame = static_cast<ActivityKind>(at->small);
+                    ++endings;
+                    break;
+                default:
+                    break;  // say only shows text
+                }
+            }
+
+            const bool walks_on = forward > 0 || rolls > 0;
+            if (endings > 0)
+            {
+                return endings == 1 && !walks_on && moves_back == 0;
+            }
+            if (moves_back > 0)
+            {
+                landing.kind = TileLanding::Kind::Walk;
+                landing.steps = -backward;
+                return moves_back == 1 && !walks_on;
+            }
+            if (rolls > 1)
+            {
+                return false;  // A sum of rolls is not uniform
+            }
+            if (forward > 0 || landing.span > 1)
+            {
+                landing.kind = TileLanding::Kind::Walk;
+                landing.steps = forward;
+            }
+            return true;
+        }
+    }
+
+    int minigame_bonus_steps(ActivityKind kind)
+    {
+        switch (kind)
+        {
+        case ActivityKind::MiniGame:
+            return 6;
+        case ActivityKind::MemoryGame:
+            return 4;
+        case ActivityKind::ReactionGame:
+            return 3;
+        case ActivityKind::MathGame:
+            return 4;
+        case ActivityKind::PatternGame:
+            return 5;
+        default:
+            return 0;
+        }
+    }
+
+    BoardModel make_board_model(float minigame_success)
+    {
+        return make_board_model(active_board(), minigame_success);
+    }
+
+    BoardModel make_board_model(const BoardDefinition& definition, float minigame_success)
+    {
+        BoardModel board;
+        board.tile_count = BOARD_COLUMNS * BOARD_ROWS;
+        board.link_end.assign(board.tile_count, -1);
+        board.landings.assign(board.tile_count, TileLanding{});
+        board.minigame_success = minigame_success;
+        for (const auto& link : definition.links)
+        {
+            board.link_end[link.start] = link.end;
+        }
+
+        // Activities run the same programs as board file effects
+        const TileEffects effects = compile_tile_effects(definition);
+        for (int tile = 1; tile < board.tile_count - 1; ++tile)
+        {
+            if (!read_landing(effects, tile, board.landings[tile]))
+            {
+                board.landings[tile] = TileLanding{};
+                if (board.link_end[tile] < 0)
+                {
+                    board.unmodelled_tiles.push_back(tile);
+                }
+            }
+        }
+        return board;
+    }
+
+    void warn_unmodelled_effects(const BoardModel& board, const std::string& board_name)
+    {
+        if (board.unmodelled_tiles.empty())
+        {
+            return;
+        }
+
+        std::cerr << "Warning: " << board_name << ": the odds treat the effect on tile";
+        const char* separator = board.unmodelled_tiles.size() > 1 ? "s " : " ";
+        for (int tile : board.unmodelled_tiles)
+        {
+            std::cerr << separator << tile;
+            separator = ", ";
+        }
+        std::cerr << " as ending the turn\n";
+    }
+
+    BoardModel repeat_board_model(const BoardModel& board, int copies)
+    {
+        // Each copy's finish becomes the next copy's start
+        const int stride = board.tile_count - 1;
+        BoardModel repeated;
+        repeated.tile_count = stride * std::max(1, copies) + 1;
+        repeated.link_end.assign(repeated.tile_count, -1);
+        repeated.landings.assign(repeated.tile_count, TileLanding{});
+        repeated.minigame_success = board.minigame_success;
+        for (int copy = 0; copy < std::max(1, copies); ++copy)
+        {
+            const int offset = copy * stride;
+            for (int tile = 1; tile < stride; ++tile)
+            {
+                TileLanding landing = board.landings[tile];
+                landing.target += landing.kind == TileLanding::Kind::Warp ? offset : 0;
+                repeated.landings[offset + tile] = landing;
+                if (board.link_end[tile] >= 0)
+                {
+                    repeated.link_end[offset + tile] = offset + board.link_end[tile];
+                }
+            }
+            for (int tile : board.unmodelled_tiles)
+            {
+                repeated.unmodelled_tiles.push_back(offset + tile);
+            }
+        }
+        return repeated;
+    }
+
+    int turn_reach_forward(const BoardModel& board)
+    {
+        int longest = 0;
+        for (const TileLanding& landing : board.landings)
+        {
+            if (landing.kind == TileLanding::Kind::Walk)
+            {
+                longest = std::max(longest, landing.steps + landing.span - 1);
+            }
+            else if (landing.kind == TileLanding::Kind::Minigame)
+            {
+                longest = std::max(longest, minigame_bonus_steps(landing.minigame));
+            }
+        }
+        return 6 + MAX_LANDING_CHAIN * longest;
+    }
+
+    int turn_reach_backward(const BoardModel& board)
+    {
+        int longest = 0;
+        for (const TileLanding& landing : board.landings)
+        {
+            if (landing.kind == TileLanding::Kind::Walk)
+            {
+                longest = std::max(longest, -landing.steps);
+            }
+        }
+        return MAX_LANDING_CHAIN * longest;
+    }
+
+    void enumerate_turn(const BoardModel& board, int tile, std::vector<TurnOutcome>& out)
+    {
+        for (int roll = 1; roll <= 6; ++roll)
+        {
+            add_landing(board, tile + roll, 1.0 / 6.0, 0, out);
+        }
+    }
+
+    std::vector<std::vector<TurnOutcome>> build_turn_chain(const BoardModel& board)
+    {
+        std::vector<std::vector<TurnOutcome>> chain(board.tile_count);
+        std::vector<TurnOutcome> outcomes;
+        for (int tile = 0; tile < board.tile_count - 1; ++tile)
+        {
+            outcomes.clear();
+            enumerate_turn(board, tile, outcomes);
+            std::vector<TurnOutcome>& row = chain[tile];
+            for (TurnOutcome outcome : outcomes)
+            {
+                if (outcome.exit == TurnExit::Link)
+                {
+                    outcome.exit = TurnExit::Stop;
+                    outcome.tile = board.link_end[outcome.tile];
+                }
+                const auto same = std::find_if(row.begin(), row.end(), [&outcome](const TurnOutcome& existing) {
+                    return existing.exit == outcome.exit && existing.tile == outcome.tile;
+                });
+                if (same != row.end())
+                {
+                    same->probability += outcome.probability;
+                }
+                else
+                {
+                    row.push_back(outcome);
+                }
+            }
+        }
+        return chain;
+    }
+}
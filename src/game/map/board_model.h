@@ -0,0 +1,90 @@
+#pragma once
+
+#include "board.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The board's rules as plain data - size, links and landing per tile - so
+// analysis code can edit a layout and walk the same landing rules the game uses.
+namespace game::map
+{
+    // What landing on a tile does, read from its effect program (tile_effects.h):
+    // the activity's built-in one or the board file's own
+    struct TileLanding
+    {
+        enum class Kind : std::uint8_t
+        {
+            Stop,     // The turn ends here - nothing, skip turn, trap
+            Walk,     // Walk to tile + steps (not below 0) plus 0..span-1 more, then land again
+            Warp,     // Go to target and end the turn
+            Portal,   // Go to any other tile with equal chance and end the turn
+            Minigame  // Won with minigame_success: walk minigame_bonus_steps on and land again
+        };
+
+        Kind kind = Kind::Stop;
+        int steps = 0;
+        int span = 1;
+        int target = 0;
+        ActivityKind minigame = ActivityKind::None;
+    };
+
+    struct BoardModel
+    {
+        int tile_count = 0;                  // Last tile is the finish
+        std::vector<int> link_end;           // Where a ladder / snake starting here leads, -1 if none
+        std::vector<TileLanding> landings;   // Ignored on tiles with a link
+        std::vector<int> unmodelled_tiles;   // Effects the model cannot play; they land as Stop
+        float minigame_success = 0.5f;       // Chance any minigame is won, for every player
+    };
+
+    // Bonus steps a won minigame awards (see the minigame modules), 0 for other tiles
+    int minigame_bonus_steps(ActivityKind kind);
+
+    // The board the game is played on (active_board()). Board file effects are
+    // read into landings where they are a single move / bonus-roll walk, warp,
+    // random-warp, skip or minigame (say is ignored); any other program is
+    // listed in unmodelled_tiles.
+    BoardModel make_board_model(float minigame_success = 0.5f);
+    BoardModel make_board_model(const BoardDefinition& definition, float minigame_success);
+
+    // Prints a warning naming board's unmodelled_tiles, if it has any - for
+    // tools to call once per board they load
+    void warn_unmodelled_effects(const BoardModel& board, const std::string& board_name);
+
+    // copies boards end to end, links and landings shifted along with them -
+    // a quick way to get large boards for benchmarking analysis code
+    BoardModel repeat_board_model(const BoardModel& board, int copies);
+
+    enum class TurnExit
+    {
+        Stop,    // Turn ends on tile (tile_count - 1 = finished)
+        Link,    // Landed on the link starting on tile
+        Portal   // Landed on portal tile, goes to any other tile with equal chance
+    };
+
+    struct TurnOutcome
+    {
+        TurnExit exit = TurnExit::Stop;
+        int tile = 0;
+        double probability = 0.0;
+    };
+
+    constexpr int MAX_LANDING_CHAIN = 8;
+
+    // Longest distance a single turn on board can carry a player forward / backward
+    // before it exits (a 6, then its longest walks chained up to the chain limit)
+    int turn_reach_forward(const BoardModel& board);
+    int turn_reach_backward(const BoardModel& board);
+
+    // Every way one turn from tile can end: roll 1-6, walk, then resolve landings
+    // in snl_server's order - finish, link, activity - chaining at most
+    // MAX_LANDING_CHAIN times. Appends to out; the same exit may appear twice.
+    void enumerate_turn(const BoardModel& board, int tile, std::vector<TurnOutcome>& out);
+
+    // enumerate_turn for every tile with links followed and repeats merged, so
+    // each row holds Stop exits on distinct tiles plus the Portal exits. The
+    // final tile's row is empty.
+    std::vector<std::vector<TurnOutcome>> build_turn_chain(const BoardModel& board);
+}
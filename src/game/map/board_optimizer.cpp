@@ -0,0 +1,348 @@
+#include "board_optimizer.h"
+
+#include "board_model.h"
+#include "win_odds.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr int TILE_COUNT = BOARD_COLUMNS * BOARD_ROWS;
+        constexpr int FINAL_TILE = TILE_COUNT - 1;
+        constexpr int PROGRESS_INTERVAL = 100;  // Iterations between progress reports per thread
+        constexpr int MUTATION_ATTEMPTS = 16;
+
+        double relative_miss(double value, double goal)
+        {
+            if (goal <= 0.0)
+            {
+                return 0.0;
+            }
+            const double miss = (value - goal) / goal;
+            return miss * miss;
+        }
+
+        // Where one player starting on tile 0 is after turns turns (final tile = finished)
+        std::vector<double> position_after(const std::vector<std::vector<TurnOutcome>>& chain, int turns)
+        {
+            std::vector<double> current(TILE_COUNT, 0.0);
+            std::vector<double> next(TILE_COUNT, 0.0);
+            current[0] = 1.0;
+            const double portal_share = 1.0 / static_cast<double>(TILE_COUNT - 1);
+            for (int turn = 0; turn < turns; ++turn)
+            {
+                std::fill(next.begin(), next.end(), 0.0);
+                next[FINAL_TILE] = current[FINAL_TILE];
+                double spread = 0.0;  // Portal mass going to every tile
+                for (int tile = 0; tile < FINAL_TILE; ++tile)
+                {
+                    for (const TurnOutcome& outcome : chain[tile])
+                    {
+                        const double mass = current[tile] * outcome.probability;
+                        if (outcome.exit == TurnExit::Portal)
+                        {
+                            spread += mass * portal_share;
+                            next[outcome.tile] -= mass * portal_share;  // Never back onto the portal
+                        }
+                        else
+                        {
+                            next[outcome.tile] += mass;
+                        }
+                    }
+                }
+                for (double& mass : next)
+                {
+                    mass += spread;
+                }
+                current.swap(next);
+            }
+            return current;
+        }
+
+        // Two players at positions drawn from `positions` (seat 0 to move, ties
+        // to seat 0): chance the one on the lower tile wins, given neither has
+        // finished and they are on different tiles
+        double comeback_rate(const FinishTable& table, const std::vector<double>& positions)
+        {
+            double total = 0.0;
+            double squares = 0.0;
+            for (int tile = 0; tile < FINAL_TILE; ++tile)
+            {
+                total += positions[tile];
+                squares += positions[tile] * positions[tile];
+            }
+            const double apart = total * total - squares;
+            if (apart <= 0.0)
+            {
+                return 0.0;
+            }
+
+            // Seat 0 behind on a, seat 1 on b > a: seat 0 wins on turn k if it
+            // finishes then and seat 1 is still going after k - 1 turns. Seat 1
+            // behind on b < a wins on turn k if seat 0 is still going after k.
+            std::vector<double> ahead_before(TILE_COUNT + 1, 0.0);  // Suffix sums of p(b) S_b(k - 1)
+            std::vector<double> ahead_after(TILE_COUNT + 1, 0.0);   // Suffix sums of p(a) S_a(k)
+            double wins = 0.0;
+            for (int k = 1; k <= table.turns; ++k)
+            {
+                ahead_before[FINAL_TILE] = 0.0;
+                ahead_after[FINAL_TILE] = 0.0;
+                for (int tile = FINAL_TILE - 1; tile >= 0; --tile)
+                {
+                    ahead_before[tile] = ahead_before[tile + 1] + positions[tile] * survival_after(table, tile, k - 1);
+                    ahead_after[tile] = ahead_after[tile + 1] + positions[tile] * survival_after(table, tile, k);
+                }
+                for (int tile = 0; tile < FINAL_TILE; ++tile)
+                {
+                    const double finishes = positions[tile] *
+                                            (survival_after(table, tile, k - 1) - survival_after(table, tile, k));
+                    wins += finishes * (ahead_before[tile + 1] + ahead_after[tile + 1]);
+                }
+            }
+            return wins / apart;
+        }
+
+        bool holds_link_start(const BoardDefinition& board, int tile)
+        {
+            return std::any_of(board.links.begin(), board.links.end(),
+                               [tile](const BoardLink& link) { return link.start == tile; });
+        }
+
+        bool holds_link_end(const BoardDefinition& board, int tile)
+        {
+            return std::any_of(board.links.begin(), board.links.end(),
+                               [tile](const BoardLink& link) { return link.end == tile; });
+        }
+
+        int random_tile(std::mt19937_64& rng, int first, int last)
+        {
+            return std::uniform_int_distribution<int>(first, last)(rng);
+        }
+
+        // A new end for link that keeps it a ladder / snake, -1 if none found
+        int pick_link_end(const BoardDefinition& board, const BoardLink& link, int start, std::mt19937_64& rng)
+        {
+            const int first = link.is_ladder ? start + 1 : 0;
+            const int last = link.is_ladder ? FINAL_TILE - 1 : start - 1;
+            if (first > last)
+            {
+                return -1;
+            }
+            for (int attempt = 0; attempt < MUTATION_ATTEMPTS; ++attempt)
+            {
+                const int end = random_tile(rng, first, last);
+                if (!holds_link_start(board, end))
+                {
+                    return end;
+                }
+            }
+            return -1;
+        }
+
+        // A tile that can take a link start or an activity
+        int pick_free_tile(const BoardDefinition& board, std::mt19937_64& rng)
+        {
+            for (int attempt = 0; attempt < MUTATION_ATTEMPTS; ++attempt)
+            {
+                const int tile = random_tile(rng, 1, FINAL_TILE - 1);
+                if (board.activities[tile] == ActivityKind::None && !holds_link_start(board, tile) &&
+                    !holds_link_end(board, tile))
+                {
+                    return tile;
+                }
+            }
+            return -1;
+        }
+
+        int pick_activity_tile(const BoardDefinition& board, std::mt19937_64& rng)
+        {
+            for (int attempt = 0; attempt < MUTATION_ATTEMPTS; ++attempt)
+            {
+                const int tile = random_tile(rng, 1, FINAL_TILE - 1);
+                if (board.activities[tile] != ActivityKind::None)
+                {
+                    return tile;
+                }
+            }
+            return -1;
+        }
+
+        // One random change that keeps the board valid and the piece counts fixed
+        bool mutate(BoardDefinition& board, std::mt19937_64& rng)
+        {
+            const int move = random_tile(rng, 0, 3);
+            switch (move)
+            {
+            case 0:  // Move a link somewhere else
+            case 1:  // Re-aim a link
+            {
+                if (board.links.empty())
+                {
+                    return false;
+                }
+                BoardLink& link = board.links[random_tile(rng, 0, static_cast<int>(board.links.size()) - 1)];
+                const int start = move == 0 ? pick_free_tile(board, rng) : link.start;
+                const int end = start < 0 ? -1 : pick_link_end(board, link, start, rng);
+                if (end < 0)
+                {
+                    return false;
+                }
+                link.start = start;
+                link.end = end;
+                return true;
+            }
+            case 2:  // Move an activity to an empty tile
+            {
+                const int from = pick_activity_tile(board, rng);
+                const int to = pick_free_tile(board, rng);
+                if (from < 0 || to < 0)
+                {
+                    return false;
+                }
+                std::swap(board.activities[from], board.activities[to]);
+                return true;
+            }
+            default:  // Swap two different activities
+            {
+                const int a = pick_activity_tile(board, rng);
+                const int b = pick_activity_tile(board, rng);
+                if (a < 0 || b < 0 || board.activities[a] == board.activities[b])
+                {
+                    return false;
+                }
+                std::swap(board.activities[a], board.activities[b]);
+                return true;
+            }
+            }
+        }
+    }
+
+    LayoutScore score_layout(const BoardDefinition& board, const LayoutGoals& goals)
+    {
+        const BoardModel model = make_board_model(board, goals.minigame_success);
+        WinOddsModel odds_model;
+        odds_model.minigame_success = goals.minigame_success;
+        const FinishTable table = build_finish_table(model, odds_model);
+
+        // E[T] = sum P(T > k), E[T^2] = sum (2k + 1) P(T > k)
+        LayoutScore score;
+        double second_moment = 0.0;
+        for (int k = 0; k <= table.turns; ++k)
+        {
+            const double still_going = survival_after(table, 0, k);
+            score.mean_turns += still_going;
+            second_moment += (2.0 * k + 1.0) * still_going;
+        }
+        score.stddev_turns = std::sqrt(std::max(0.0, second_moment - score.mean_turns * score.mean_turns));
+
+        const int players = std::clamp(goals.players, 2, 4);
+        const std::array<float, 4> odds = compute_win_odds(table, {0, 0, 0, 0}, players, 0);
+        const auto [lowest, highest] = std::minmax_element(odds.begin(), odds.begin() + players);
+        score.seat_gap = *highest - *lowest;
+
+        const int half_time = std::max(1, static_cast<int>(std::lround(score.mean_turns * 0.5)));
+        score.comeback_rate = comeback_rate(table, position_after(build_turn_chain(model), half_time));
+
+        // A 10-point seat gap costs as much as missing a goal by 100%
+        const double seat_miss = score.seat_gap / 0.1;
+        score.cost = relative_miss(score.mean_turns, goals.mean_turns) +
+                     relative_miss(score.stddev_turns, goals.stddev_turns) +
+                     relative_miss(score.comeback_rate, goals.comeback_rate) +
+                     goals.seat_weight * seat_miss * seat_miss;
+        return score;
+    }
+
+    AnnealResult optimize_layout(const BoardDefinition& start, const LayoutGoals& goals, const AnnealOptions& options,
+                                 const std::function<void(std::uint64_t, std::uint64_t, double)>& progress)
+    {
+        const int threads = options.threads > 0 ? options.threads
+                                                : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int iterations = std::max(1, options.iterations);
+        const std::uint64_t total = static_cast<std::uint64_t>(iterations) * static_cast<std::uint64_t>(threads);
+
+        std::vector<AnnealResult> results(threads);
+        std::atomic<std::uint64_t> finished{0};
+        std::mutex progress_mutex;
+        double best_cost = score_layout(start, goals).cost;
+
+        const auto run_chain = [&](int index) {
+            std::mt19937_64 rng(options.seed + static_cast<std::uint64_t>(index) * 0x9e3779b97f4a7c15ULL);
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+            BoardDefinition current = start;
+            LayoutScore current_score = score_layout(current, goals);
+            AnnealResult& best = results[index];
+            best.board = current;
+            best.score = current_score;
+            best.evaluated = 1;
+
+            const double cooling = std::log(options.end_temperature / options.start_temperature);
+            int reported = 0;
+            for (int iteration = 0; iteration < iterations; ++iteration)
+            {
+                const double temperature = options.start_temperature *
+                                           std::exp(cooling * iteration / std::max(1, iterations - 1));
+                BoardDefinition candidate = current;
+                if (mutate(candidate, rng))
+                {
+                    const LayoutScore candidate_score = score_layout(candidate, goals);
+                    ++best.evaluated;
+                    const double change = candidate_score.cost - current_score.cost;
+                    if (change <= 0.0 || unit(rng) < std::exp(-change / temperature))
+                    {
+                        current = std::move(candidate);
+                        current_score = candidate_score;
+                        if (current_score.cost < best.score.cost)
+                        {
+                            best.board = current;
+                            best.score = current_score;
+                        }
+                    }
+                }
+
+                if ((iteration + 1) % PROGRESS_INTERVAL == 0 || iteration + 1 == iterations)
+                {
+                    const int done = iteration + 1 - reported;
+                    reported = iteration + 1;
+                    const std::uint64_t so_far = finished.fetch_add(done) + done;
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    best_cost = std::min(best_cost, best.score.cost);
+                    if (progress)
+                    {
+                        progress(so_far, total, best_cost);
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int index = 0; index < threads; ++index)
+        {
+            workers.emplace_back(run_chain, index);
+        }
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        AnnealResult result = *std::min_element(results.begin(), results.end(),
+                                                [](const AnnealResult& a, const AnnealResult& b) {
+                                                    return a.score.cost < b.score.cost;
+                                                });
+        result.evaluated = 0;
+        for (const AnnealResult& chain : results)
+        {
+            result.evaluated += chain.evaluated;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "board.h"
+
+#include <cstdint>
+#include <functional>
+
+// Searches snake / ladder placements and activity tiles for a board that meets
+// design goals. Every candidate is scored exactly from its finish-time
+// distribution (build_finish_table), not by simulation, and one simulated
+// annealing chain runs per thread from the same starting board.
+namespace game::map
+{
+    struct LayoutGoals
+    {
+        double mean_turns = 40.0;     // Expected turns for one player to finish; 0 ignores it
+        double stddev_turns = 20.0;   // Spread of that; 0 ignores it
+        double comeback_rate = 0.35;  // Chance the player behind at half time wins; 0 ignores it
+        double seat_weight = 1.0;     // Weight of the first-to-last seat win gap
+        int players = 2;              // Seats the fairness and comeback figures assume
+        float minigame_success = 0.5f;
+    };
+
+    struct LayoutScore
+    {
+        double mean_turns = 0.0;
+        double stddev_turns = 0.0;
+        double comeback_rate = 0.0;  // Two players, positions after half the mean turns each
+        double seat_gap = 0.0;       // Best seat's win chance minus the worst's, all from tile 0
+        double cost = 0.0;           // Squared relative misses against the goals, lower is better
+    };
+
+    LayoutScore score_layout(const BoardDefinition& board, const LayoutGoals& goals);
+
+    struct AnnealOptions
+    {
+        int iterations = 4000;  // Per thread
+        int threads = 0;        // 0 = one per core
+        std::uint64_t seed = 1;
+        double start_temperature = 0.05;
+        double end_temperature = 0.0005;
+    };
+
+    struct AnnealResult
+    {
+        BoardDefinition board;
+        LayoutScore score;
+        std::uint64_t evaluated = 0;
+    };
+
+    // Keeps start's number of ladders, snakes and each activity kind. progress,
+    // if set, is called from the worker threads with (finished iterations,
+    // total iterations, best cost so far).
+    AnnealResult optimize_layout(const BoardDefinition& start, const LayoutGoals& goals, const AnnealOptions& options,
+                                 const std::function<void(std::uint64_t, std::uint64_t, double)>& progress = {});
+}
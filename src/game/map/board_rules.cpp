@@ -0,0 +1,187 @@
+#include "board_rules.h"
+
+#include "../../core/random.h"
+#include "tile_effects.h"
+#include "../minigame/qte_minigame.h"
+#include "../minigame/tile_memory_minigame.h"
+#include "../minigame/reaction_minigame.h"
+#include "../minigame/math_minigame.h"
+#include "../minigame/pattern_minigame.h"
+
+#include <random>
+#include <utility>
+
+namespace game::map
+{
+    bool check_and_apply_ladder(player::PlayerState& player_state, int current_tile, int& last_processed_tile)
+    {
+        for (const auto& link : active_board().links)
+        {
+            if (link.is_ladder && link.start == current_tile)
+            {
+                // Found a ladder - warp player to the end tile
+                player::warp_to_tile(player_state, link.end);
+                last_processed_tile = link.end;
+                // Stop player movement after using ladder - don't continue walking
+                player::stop_walking(player_state);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool check_and_apply_snake(player::PlayerState& player_state, int current_tile, int& last_processed_tile)
+    {
+        for (const auto& link : active_board().links)
+        {
+            if (!link.is_ladder && link.start == current_tile)
+            {
+                // Found a snake - warp player to the end tile (going backward)
+                player::warp_to_tile(player_state, link.end);
+                last_processed_tile = link.end;
+                // Stop player movement after using snake - don't continue walking
+                player::stop_walking(player_state);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    namespace
+    {
+        // State of one program run
+        struct EffectRun
+        {
+            TileEffectContext& context;
+            const TileEffects& effects;
+            TileEffectResult result;
+            int tile = 0;
+            int last_value = 0;  // Replaces {} in say texts
+        };
+
+        using EffectHandler = void (*)(const EffectInstruction&, EffectRun&);
+
+        void run_end(const EffectInstruction&, EffectRun&)
+        {
+        }
+
+        void run_move(const EffectInstruction& instruction, EffectRun& run)
+        {
+            if (instruction.value >= 0)
+            {
+                player::add_steps(run.context.player, instruction.value);
+            }
+            else
+            {
+                player::step_backward(run.context.player, -instruction.value);
+            }
+        }
+
+        void warp(EffectRun& run, int tile)
+        {
+            player::warp_to_tile(run.context.player, tile);
+            player::stop_walking(run.context.player);
+            run.result.ends_turn = true;
+            run.result.warped = true;
+            run.last_value = tile + 1;
+        }
+
+        void run_warp(const EffectInstruction& instruction, EffectRun& run)
+        {
+            warp(run, instruction.value);
+        }
+
+        void run_random_warp(const EffectInstruction&, EffectRun& run)
+        {
+            // Any tile but this one (0-99)
+            std::mt19937& rng = core::random_stream(core::RandomStream::MapEvents);
+            const int final_tile = BOARD_COLUMNS * BOARD_ROWS - 1;
+            std::uniform_int_distribution<int> dist(0, final_tile);
+            int random_tile = dist(rng);
+            while (random_tile == run.tile && final_tile > 0)
+            {
+                random_tile = dist(rng);
+            }
+            warp(run, random_tile);
+        }
+
+        void run_skip(const EffectInstruction&, EffectRun& run)
+        {
+            player::skip_turn(run.context.player);
+            run.result.ends_turn = true;
+        }
+
+        void run_minigame(const EffectInstruction& instruction, EffectRun& run)
+        {
+            TileEffectContext& context = run.context;
+            const ActivityKind kind = static_cast<ActivityKind>(instruction.small);
+            switch (kind)
+            {
+            case ActivityKind::MiniGame:
+                game::minigame::start_precision_timing(context.precision);
+                break;
+            case ActivityKind::MemoryGame:
+                game::minigame::tile_memory::start(context.tile_memory);
+                break;
+            case ActivityKind::ReactionGame:
+                game::minigame::start_reaction(context.reaction);
+                break;
+            case ActivityKind::MathGame:
+                game::minigame::start_math_quiz(context.math);
+                break;
+            case ActivityKind::PatternGame:
+                game::minigame::start_pattern_matching(context.pattern);
+                break;
+            default:
+                return;
+            }
+            // The minigame's own text shows unless a say follows
+            context.message.clear();
+            context.message_timer = 0.0f;
+            run.result.minigame = kind;
+        }
+
+        void run_bonus_roll(const EffectInstruction& instruction, EffectRun& run)
+        {
+            std::mt19937& rng = core::random_stream(core::RandomStream::MapEvents);
+            std::uniform_int_distribution<int> dist(instruction.small, instruction.value);
+            run.last_value = dist(rng);
+            player::add_steps(run.context.player, run.last_value);
+        }
+
+        void run_say(const EffectInstruction& instruction, EffectRun& run)
+        {
+            std::string text = run.effects.strings[instruction.value];
+            const std::size_t slot = text.find("{}");
+            if (slot != std::string::npos)
+            {
+                text.replace(slot, 2, std::to_string(run.last_value));
+            }
+            run.context.message = std::move(text);
+            // Minigame titles stay up until the minigame takes over
+            run.context.message_timer = run.result.minigame == ActivityKind::None ? 2.0f : 0.0f;
+        }
+
+        // Indexed by EffectOp
+        constexpr std::array<EffectHandler, EFFECT_OP_COUNT> EFFECT_HANDLERS = {
+            &run_end, &run_move, &run_warp, &run_random_warp, &run_skip, &run_minigame, &run_bonus_roll, &run_say,
+        };
+    }
+
+    TileEffectResult run_tile_effect(int tile, TileEffectContext& context)
+    {
+        const TileEffects& effects = active_tile_effects();
+        EffectRun run{context, effects, {}, tile, 0};
+        if (tile <= 0 || tile >= static_cast<int>(effects.entry.size()) || effects.entry[tile] == 0)
+        {
+            return run.result;
+        }
+
+        run.result.applied = true;
+        for (const EffectInstruction* at = &effects.code[effects.entry[tile]]; at->op != EffectOp::End; ++at)
+        {
+            EFFECT_HANDLERS[static_cast<int>(at->op)](*at, run);
+        }
+        return run.result;
+    }
+}
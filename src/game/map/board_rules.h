@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "../player/player.h"
+#include "board.h"
+
+// Turn rules for landing on a tile: ladders, snakes and tile activities.
+// No rendering dependencies - shared by the game and snl_server.
+
+// Forward declarations
+namespace game::minigame
+{
+    struct PrecisionTimingState;
+    struct ReactionState;
+    struct MathQuizState;
+    struct PatternMatchingState;
+}
+
+namespace game::minigame::tile_memory
+{
+    struct TileMemoryState;
+}
+
+namespace game::map
+{
+    // Check if player is on a ladder tile and warp them if needed
+    // Returns true if player was warped, false otherwise
+    bool check_and_apply_ladder(player::PlayerState& player_state, int current_tile, int& last_processed_tile);
+
+    // Check if player is on a snake tile and warp them if needed (going backward)
+    // Returns true if player was warped, false otherwise
+    bool check_and_apply_snake(player::PlayerState& player_state, int current_tile, int& last_processed_tile);
+
+    // Everything a tile effect can touch
+    struct TileEffectContext
+    {
+        player::PlayerState& player;
+        game::minigame::PrecisionTimingState& precision;
+        game::minigame::tile_memory::TileMemoryState& tile_memory;
+        game::minigame::ReactionState& reaction;
+        game::minigame::MathQuizState& math;
+        game::minigame::PatternMatchingState& pattern;
+        std::string& message;
+        float& message_timer;
+    };
+
+    struct TileEffectResult
+    {
+        bool applied = false;    // The tile had an effect
+        bool ends_turn = false;  // Skip, warp or random warp ran
+        bool warped = false;     // The player is on a new tile
+        ActivityKind minigame = ActivityKind::None;  // Minigame started, if any
+    };
+
+    // Runs the active board's effect for tile (active_tile_effects): one
+    // table dispatch per instruction instead of a comparison per activity
+    TileEffectResult run_tile_effect(int tile, TileEffectContext& context);
+}
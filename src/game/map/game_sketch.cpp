@@ -0,0 +1,119 @@
+#include "game_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr std::uint32_t EXACT_LIMIT = 1024;  // Lengths below this get a bucket each
+        constexpr int EXACT_BITS = 10;
+        constexpr int SUB_BITS = 5;                  // 32 buckets per doubling above
+    }
+
+    int length_bucket(std::uint32_t turns)
+    {
+        if (turns < EXACT_LIMIT)
+        {
+            return static_cast<int>(turns);
+        }
+        int exponent = EXACT_BITS;
+        while (exponent < 31 && (turns >> (exponent + 1)) != 0)
+        {
+            ++exponent;
+        }
+        const std::uint32_t sub = (turns >> (exponent - SUB_BITS)) & ((1u << SUB_BITS) - 1);
+        return static_cast<int>(EXACT_LIMIT) + ((exponent - EXACT_BITS) << SUB_BITS) + static_cast<int>(sub);
+    }
+
+    std::uint32_t bucket_floor(int bucket)
+    {
+        if (bucket < static_cast<int>(EXACT_LIMIT))
+        {
+            return static_cast<std::uint32_t>(std::max(0, bucket));
+        }
+        const int above = bucket - static_cast<int>(EXACT_LIMIT);
+        const int exponent = EXACT_BITS + (above >> SUB_BITS);
+        const std::uint32_t sub = static_cast<std::uint32_t>(above) & ((1u << SUB_BITS) - 1);
+        return (1u << exponent) | (sub << (exponent - SUB_BITS));
+    }
+
+    void record_game(GameSketch& sketch, std::uint32_t turns, int winner)
+    {
+        ++sketch.games;
+        if (winner >= 0 && winner < 4)
+        {
+            ++sketch.wins[winner];
+        }
+        else
+        {
+            ++sketch.unfinished;
+        }
+        sketch.turns += turns;
+        sketch.turns_squared += static_cast<std::uint64_t>(turns) * turns;
+
+        const std::size_t bucket = static_cast<std::size_t>(length_bucket(turns));
+        if (bucket >= sketch.histogram.size())
+        {
+            sketch.histogram.resize(bucket + 1, 0);
+        }
+        ++sketch.histogram[bucket];
+    }
+
+    void merge_sketch(GameSketch& into, const GameSketch& from)
+    {
+        into.games += from.games;
+        into.unfinished += from.unfinished;
+        for (int seat = 0; seat < 4; ++seat)
+        {
+            into.wins[seat] += from.wins[seat];
+        }
+        into.turns += from.turns;
+        into.turns_squared += from.turns_squared;
+        if (from.histogram.size() > into.histogram.size())
+        {
+            into.histogram.resize(from.histogram.size(), 0);
+        }
+        for (std::size_t bucket = 0; bucket < from.histogram.size(); ++bucket)
+        {
+            into.histogram[bucket] += from.histogram[bucket];
+        }
+    }
+
+    double mean_turns(const GameSketch& sketch)
+    {
+        return sketch.games > 0 ? static_cast<double>(sketch.turns) / static_cast<double>(sketch.games) : 0.0;
+    }
+
+    double stddev_turns(const GameSketch& sketch)
+    {
+        if (sketch.games < 2)
+        {
+            return 0.0;
+        }
+        const double n = static_cast<double>(sketch.games);
+        const double mean = static_cast<double>(sketch.turns) / n;
+        const double variance = (static_cast<double>(sketch.turns_squared) - n * mean * mean) / (n - 1.0);
+        return std::sqrt(std::max(0.0, variance));
+    }
+
+    std::uint32_t turns_quantile(const GameSketch& sketch, double q)
+    {
+        if (sketch.games == 0)
+        {
+            return 0;
+        }
+        const double wanted = std::clamp(q, 0.0, 1.0) * static_cast<double>(sketch.games);
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < sketch.histogram.size(); ++bucket)
+        {
+            seen += sketch.histogram[bucket];
+            if (static_cast<double>(seen) >= wanted && sketch.histogram[bucket] > 0)
+            {
+                return bucket_floor(static_cast<int>(bucket));
+            }
+        }
+        return bucket_floor(static_cast<int>(sketch.histogram.size()) - 1);
+    }
+}
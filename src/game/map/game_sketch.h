@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Summary of many simulated games that merges by addition: win counts, turn
+// sums and a histogram of game length, exact below 1024 turns and in 32 steps
+// per doubling above (within 3%). Merging is exact and order-independent, so
+// results split across threads, processes or machines add up to the same
+// sketch as one run.
+namespace game::map
+{
+    struct GameSketch
+    {
+        std::uint64_t games = 0;
+        std::uint64_t unfinished = 0;          // Given up before anyone won
+        std::array<std::uint64_t, 4> wins{};
+        std::uint64_t turns = 0;               // Sum of turns per game
+        std::uint64_t turns_squared = 0;
+        std::vector<std::uint64_t> histogram;  // By length_bucket, grown as needed
+    };
+
+    int length_bucket(std::uint32_t turns);
+    std::uint32_t bucket_floor(int bucket);  // Shortest game length in bucket
+
+    // winner -1 = unfinished
+    void record_game(GameSketch& sketch, std::uint32_t turns, int winner);
+    void merge_sketch(GameSketch& into, const GameSketch& from);
+
+    double mean_turns(const GameSketch& sketch);
+    double stddev_turns(const GameSketch& sketch);
+    // Game length at quantile q (0-1), the floor of its bucket
+    std::uint32_t turns_quantile(const GameSketch& sketch, double q);
+}
@@ -0,0 +1,916 @@
+#include "game_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr char STORE_MAGIC[8] = {'S', 'N', 'L', 'G', 'A', 'M', 'E', 'S'};
+        constexpr char STORE_END_MAGIC[8] = {'S', 'N', 'L', 'G', 'E', 'N', 'D', '1'};
+        constexpr std::uint32_t STORE_VERSION = 2;  // 2: run-length, bit-packed and transition chunks
+        constexpr std::size_t HEADER_SIZE = 12;   // Magic, version
+        constexpr std::size_t TRAILER_SIZE = 20;  // Footer offset, footer size, magic
+        constexpr std::size_t CHUNK_ENTRY_SIZE = 33;
+        constexpr std::size_t STRIPE_ENTRY_SIZE = 20 + CHUNK_ENTRY_SIZE * STORE_COLUMN_COUNT;
+        constexpr int MAX_PACKED_WIDTH = 56;  // A value plus its bit offset fits one 8-byte load
+        constexpr int MAX_TRANSITION_STRIDE = 4;
+        constexpr int MAX_SUCCESSORS = 15;    // Rank 15 is the escape
+        // Transition code table entries that are not tiles. The fast decoder
+        // takes escapes by rank, and only ORs every entry to find invalid ones.
+        constexpr std::uint16_t TRANSITION_ESCAPE = 0;
+        constexpr std::uint16_t TRANSITION_INVALID = 256;
+
+        void put_u32(std::vector<std::uint8_t>& out, std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void put_u64(std::vector<std::uint8_t>& out, std::uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        std::uint32_t get_u32(const std::uint8_t* data)
+        {
+            std::uint32_t value = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                value |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        std::uint64_t get_u64(const std::uint8_t* data)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        void put_varint(std::vector<std::uint8_t>& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        std::uint64_t get_varint(const std::uint8_t*& at, const std::uint8_t* end)
+        {
+            std::uint64_t value = 0;
+            int shift = 0;
+            for (;;)
+            {
+                if (at == end || shift > 63)
+                {
+                    throw std::runtime_error("Game store chunk is truncated");
+                }
+                const std::uint8_t byte = *at++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (byte < 0x80)
+                {
+                    return value;
+                }
+                shift += 7;
+            }
+        }
+
+        int bit_width(std::uint64_t value)
+        {
+            int width = 0;
+            while (value > 0)
+            {
+                ++width;
+                value >>= 1;
+            }
+            return width;
+        }
+
+        std::vector<std::uint8_t> encode_varints(const std::vector<std::uint64_t>& values, bool delta)
+        {
+            std::vector<std::uint8_t> out;
+            out.reserve(values.size() + 16);
+            std::uint64_t previous = 0;
+            for (const std::uint64_t value : values)
+            {
+                put_varint(out, delta ? zigzag(static_cast<std::int64_t>(value - previous)) : value);
+                previous = value;
+            }
+            return out;
+        }
+
+        std::vector<std::uint8_t> encode_run_length(const std::vector<std::uint64_t>& values)
+        {
+            std::vector<std::uint8_t> out;
+            std::uint64_t previous = 0;
+            std::size_t i = 0;
+            while (i < values.size())
+            {
+                const std::uint64_t delta = values[i] - previous;
+                std::size_t run = 1;
+                while (i + run < values.size() && values[i + run] - values[i + run - 1] == delta)
+                {
+                    ++run;
+                }
+                put_varint(out, zigzag(static_cast<std::int64_t>(delta)));
+                put_varint(out, run);
+                i += run;
+                previous = values[i - 1];
+            }
+            return out;
+        }
+
+        std::vector<std::uint8_t> encode_bit_packed(const std::vector<std::uint64_t>& values, std::uint64_t min, int width)
+        {
+            std::vector<std::uint8_t> out;
+            out.reserve(1 + (values.size() * static_cast<std::size_t>(width) + 7) / 8);
+            out.push_back(static_cast<std::uint8_t>(width));
+            std::uint64_t bits = 0;
+            int pending = 0;
+            for (const std::uint64_t value : values)
+            {
+                bits |= (value - min) << pending;
+                pending += width;
+                while (pending >= 8)
+                {
+                    out.push_back(static_cast<std::uint8_t>(bits));
+                    bits >>= 8;
+                    pending -= 8;
+                }
+            }
+            if (pending > 0)
+            {
+                out.push_back(static_cast<std::uint8_t>(bits));
+            }
+            return out;
+        }
+
+        // A transition code for one chunk and stride: the chunk header with the
+        // successor lists, each (context, value)'s rank, and how many values
+        // it has to escape
+        struct TransitionCode
+        {
+            std::size_t tiles = 0;
+            std::vector<std::uint8_t> header;
+            std::vector<std::uint8_t> rank;  // tiles x tiles
+            std::uint64_t escapes = 0;
+
+            std::size_t size(std::size_t values) const { return header.size() + (values + 1) / 2 + escapes; }
+        };
+
+        // Values must be below 256. Each value's context is the value stride
+        // places back (0 before the first stride values); its code is its rank
+        // among the context's most common successors in this chunk.
+        TransitionCode make_transition_code(const std::vector<std::uint64_t>& values, int stride, int last)
+        {
+            TransitionCode code;
+            code.tiles = static_cast<std::size_t>(last) + 1;
+            const std::size_t tiles = code.tiles;
+            std::vector<std::uint32_t> counts(tiles * tiles, 0);
+            std::array<std::uint8_t, MAX_TRANSITION_STRIDE> history{};
+            int slot = 0;
+            for (const std::uint64_t value : values)
+            {
+                ++counts[history[slot] * tiles + value];
+                history[slot] = static_cast<std::uint8_t>(value);
+                slot = slot + 1 == stride ? 0 : slot + 1;
+            }
+
+            code.header = {static_cast<std::uint8_t>(stride), static_cast<std::uint8_t>(last)};
+            code.rank.assign(tiles * tiles, MAX_SUCCESSORS);
+            code.escapes = values.size();
+            std::vector<std::pair<std::uint32_t, int>> successors;
+            for (std::size_t context = 0; context < tiles; ++context)
+            {
+                successors.clear();
+                for (std::size_t tile = 0; tile < tiles; ++tile)
+                {
+                    if (counts[context * tiles + tile] > 0)
+                    {
+                        // Most common first, ties by tile
+                        successors.emplace_back(~counts[context * tiles + tile], static_cast<int>(tile));
+                    }
+                }
+                const std::size_t kept = std::min<std::size_t>(successors.size(), MAX_SUCCESSORS);
+                std::partial_sort(successors.begin(), successors.begin() + static_cast<std::ptrdiff_t>(kept),
+                                  successors.end());
+                code.header.push_back(static_cast<std::uint8_t>(kept));
+                for (std::size_t k = 0; k < kept; ++k)
+                {
+                    const std::size_t tile = static_cast<std::size_t>(successors[k].second);
+                    code.header.push_back(static_cast<std::uint8_t>(tile));
+                    code.rank[context * tiles + tile] = static_cast<std::uint8_t>(k);
+                    code.escapes -= counts[context * tiles + tile];
+                }
+            }
+            return code;
+        }
+
+        std::vector<std::uint8_t> encode_transitions(const std::vector<std::uint64_t>& values, const TransitionCode& code)
+        {
+            const int stride = code.header[0];
+            std::vector<std::uint8_t> out = code.header;
+            out.reserve(code.size(values.size()));
+            out.resize(code.header.size() + (values.size() + 1) / 2, 0);
+            std::uint8_t* ranks = out.data() + code.header.size();
+            std::array<std::uint8_t, MAX_TRANSITION_STRIDE> history{};
+            int slot = 0;
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                const std::uint8_t rank = code.rank[history[slot] * code.tiles + values[i]];
+                ranks[i / 2] |= static_cast<std::uint8_t>(rank << ((i & 1) * 4));
+                history[slot] = static_cast<std::uint8_t>(values[i]);
+                slot = slot + 1 == stride ? 0 : slot + 1;
+            }
+            // Escaped values go after all the ranks
+            slot = 0;
+            history = {};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                if (code.rank[history[slot] * code.tiles + values[i]] == MAX_SUCCESSORS)
+                {
+                    out.push_back(static_cast<std::uint8_t>(values[i]));
+                }
+                history[slot] = static_cast<std::uint8_t>(values[i]);
+                slot = slot + 1 == stride ? 0 : slot + 1;
+            }
+            return out;
+        }
+
+        // Encodes values in whichever encoding is smallest; sets chunk.encoding
+        // (chunk.min and chunk.max must be set). Varints decode a byte at a
+        // time, at under half the speed of bit-packing, so they have to be an
+        // eighth smaller to be picked.
+        std::vector<std::uint8_t> encode(StoreColumn column, const std::vector<std::uint64_t>& values, StoreChunk& chunk)
+        {
+            std::vector<std::uint8_t> best;
+            std::size_t best_cost = 0;
+            bool have_best = false;
+            const auto offer = [&](StoreEncoding encoding, std::vector<std::uint8_t> bytes) {
+                const bool varint = encoding == StoreEncoding::Varint || encoding == StoreEncoding::DeltaVarint;
+                const std::size_t cost = bytes.size() + (varint ? bytes.size() / 8 : 0);
+                if (!have_best || cost < best_cost)
+                {
+                    best = std::move(bytes);
+                    best_cost = cost;
+                    chunk.encoding = encoding;
+                    have_best = true;
+                }
+            };
+
+            const int width = bit_width(chunk.max - chunk.min);
+            if (column == StoreColumn::Trace && chunk.max < 256)
+            {
+                offer(StoreEncoding::Bytes, std::vector<std::uint8_t>(values.begin(), values.end()));
+                // Sizing a stride only takes its transition counts; encode the best
+                TransitionCode best_code;
+                for (int stride = 1; stride <= MAX_TRANSITION_STRIDE; ++stride)
+                {
+                    TransitionCode code = make_transition_code(values, stride, static_cast<int>(chunk.max));
+                    if (stride == 1 || code.size(values.size()) < best_code.size(values.size()))
+                    {
+                        best_code = std::move(code);
+                    }
+                }
+                if (best_code.size(values.size()) < values.size())
+                {
+                    offer(StoreEncoding::Transition, encode_transitions(values, best_code));
+                }
+            }
+            else
+            {
+                const bool delta = column == StoreColumn::Seed || column == StoreColumn::Game;
+                offer(delta ? StoreEncoding::DeltaVarint : StoreEncoding::Varint, encode_varints(values, delta));
+                offer(StoreEncoding::RunLength, encode_run_length(values));
+            }
+            if (width <= MAX_PACKED_WIDTH)
+            {
+                offer(StoreEncoding::BitPacked, encode_bit_packed(values, chunk.min, width));
+            }
+            return best;
+        }
+
+        unsigned get_nibble(const std::uint8_t* data, std::uint64_t index)
+        {
+            return static_cast<unsigned>(data[index >> 1] >> ((index & 1) << 2)) & 0x0F;
+        }
+
+        // Decodes count (a multiple of 2 * Stride) transition-coded values from
+        // rank nibble at (even) on, taking escaped values from escape on (the
+        // caller makes sure there are count of them left). history holds the
+        // last Stride values, oldest first; it stays in registers, and with the
+        // escapes in their own stream the only branch is the loop, so each of
+        // the Stride chains costs a table load and a select per value.
+        // Returns false on a rank the chunk has no successor for.
+        template <int Stride>
+        bool decode_transitions_unchecked(const std::uint8_t* ranks, std::uint64_t at, const std::uint8_t*& escape,
+                                          const std::uint16_t* codes, std::uint8_t* history, std::uint8_t* out,
+                                          std::size_t count)
+        {
+            std::array<unsigned, Stride> last{};
+            for (int k = 0; k < Stride; ++k)
+            {
+                last[k] = history[k];
+            }
+            const std::uint8_t* next_escape = escape;
+            const std::uint8_t* rank_bytes = ranks + at / 2;
+            unsigned seen = 0;
+            for (std::size_t i = 0; i < count; i += 2 * Stride)
+            {
+                for (int k = 0; k < 2 * Stride; ++k)
+                {
+                    // Where the next escape is depends on the ranks alone, so
+                    // it is worked out off the dependency chains
+                    const unsigned rank = (rank_bytes[(i + k) / 2] >> ((k & 1) * 4)) & 0x0F;
+                    const unsigned escaped = rank == MAX_SUCCESSORS;
+                    // An invalid entry (256) must not index past the table before the check
+                    const unsigned code = codes[(last[k % Stride] & 0xFF) * 16 + rank];
+                    seen |= code;
+                    last[k % Stride] = escaped ? *next_escape : code;
+                    next_escape += escaped;
+                    out[i + k] = static_cast<std::uint8_t>(last[k % Stride]);
+                }
+            }
+            for (int k = 0; k < Stride; ++k)
+            {
+                history[k] = static_cast<std::uint8_t>(last[k]);
+            }
+            escape = next_escape;
+            return (seen & TRANSITION_INVALID) == 0;
+        }
+
+        std::vector<std::uint8_t> encode_footer(const std::vector<StoreStripe>& stripes)
+        {
+            std::vector<std::uint8_t> out;
+            put_u32(out, static_cast<std::uint32_t>(stripes.size()));
+            for (const StoreStripe& stripe : stripes)
+            {
+                put_u64(out, stripe.first_row);
+                put_u32(out, stripe.rows);
+                put_u64(out, stripe.trace_values);
+                for (const StoreChunk& chunk : stripe.chunks)
+                {
+                    put_u64(out, chunk.offset);
+                    put_u64(out, chunk.size);
+                    out.push_back(static_cast<std::uint8_t>(chunk.encoding));
+                    put_u64(out, chunk.min);
+                    put_u64(out, chunk.max);
+                }
+            }
+            return out;
+        }
+
+        // footer[0..size) holds the stripes; chunks must lie inside [HEADER_SIZE, data_end)
+        std::vector<StoreStripe> decode_footer(const std::uint8_t* footer, std::size_t size, std::uint64_t data_end,
+                                               const std::filesystem::path& path)
+        {
+            const auto fail = [&path](const std::string& message) {
+                throw std::runtime_error("Malformed game store (" + message + "): " + path.string());
+            };
+            if (size < 4)
+            {
+                fail("footer");
+            }
+            const std::uint32_t count = get_u32(footer);
+            if ((size - 4) / STRIPE_ENTRY_SIZE < count)
+            {
+                fail("stripe count");
+            }
+
+            std::vector<StoreStripe> stripes(count);
+            const std::uint8_t* at = footer + 4;
+            for (StoreStripe& stripe : stripes)
+            {
+                stripe.first_row = get_u64(at);
+                stripe.rows = get_u32(at + 8);
+                stripe.trace_values = get_u64(at + 12);
+                at += 20;
+                for (StoreChunk& chunk : stripe.chunks)
+                {
+                    chunk.offset = get_u64(at);
+                    chunk.size = get_u64(at + 8);
+                    chunk.encoding = static_cast<StoreEncoding>(at[16]);
+                    chunk.min = get_u64(at + 17);
+                    chunk.max = get_u64(at + 25);
+                    at += CHUNK_ENTRY_SIZE;
+                    if (chunk.offset < HEADER_SIZE || chunk.offset > data_end || chunk.size > data_end - chunk.offset ||
+                        chunk.encoding > StoreEncoding::Transition)
+                    {
+                        fail("chunk out of range");
+                    }
+                }
+            }
+            return stripes;
+        }
+
+        void write_at(std::fstream& file, std::uint64_t offset, const void* data, std::size_t size)
+        {
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        }
+    }
+
+    GameStoreWriter::GameStoreWriter(const std::filesystem::path& path, bool append, std::uint32_t stripe_rows)
+        : m_path(path), m_stripe_rows(std::max<std::uint32_t>(1, stripe_rows))
+    {
+        std::error_code error;
+        const std::uintmax_t existing = std::filesystem::file_size(path, error);
+        if (append && !error && existing > 0)
+        {
+            m_file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+            if (!m_file || existing < HEADER_SIZE + TRAILER_SIZE)
+            {
+                throw std::runtime_error("Failed to open game store for appending: " + path.string());
+            }
+            std::uint8_t trailer[TRAILER_SIZE];
+            m_file.seekg(static_cast<std::streamoff>(existing - TRAILER_SIZE));
+            m_file.read(reinterpret_cast<char*>(trailer), TRAILER_SIZE);
+            const std::uint64_t footer_offset = get_u64(trailer);
+            const std::uint32_t footer_size = get_u32(trailer + 8);
+            if (!m_file || std::memcmp(trailer + 12, STORE_END_MAGIC, sizeof(STORE_END_MAGIC)) != 0 ||
+                footer_offset < HEADER_SIZE || footer_offset + footer_size + TRAILER_SIZE != existing)
+            {
+                throw std::runtime_error("Not a game store, or not closed cleanly: " + path.string());
+            }
+
+            std::vector<std::uint8_t> footer(footer_size);
+            m_file.seekg(static_cast<std::streamoff>(footer_offset));
+            m_file.read(reinterpret_cast<char*>(footer.data()), static_cast<std::streamsize>(footer.size()));
+            m_stripes = decode_footer(footer.data(), footer.size(), footer_offset, path);
+            for (const StoreStripe& stripe : m_stripes)
+            {
+                m_rows += stripe.rows;
+            }
+            m_end = footer_offset;  // New stripes go over the old footer
+
+            // New stripes may use encodings older readers do not know
+            std::vector<std::uint8_t> version;
+            put_u32(version, STORE_VERSION);
+            write_at(m_file, sizeof(STORE_MAGIC), version.data(), version.size());
+        }
+        else
+        {
+            m_file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!m_file)
+            {
+                throw std::runtime_error("Failed to open game store for writing: " + path.string());
+            }
+            std::vector<std::uint8_t> header(STORE_MAGIC, STORE_MAGIC + sizeof(STORE_MAGIC));
+            put_u32(header, STORE_VERSION);
+            write_at(m_file, 0, header.data(), header.size());
+            m_end = HEADER_SIZE;
+        }
+    }
+
+    GameStoreWriter::~GameStoreWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Warning: " << e.what() << '\n';
+        }
+    }
+
+    void GameStoreWriter::add_game(std::uint64_t seed, std::uint64_t game, std::uint32_t turns, int winner,
+                                   const std::int32_t* trace, std::size_t trace_size)
+    {
+        m_pending[static_cast<int>(StoreColumn::Seed)].push_back(seed);
+        m_pending[static_cast<int>(StoreColumn::Game)].push_back(game);
+        m_pending[static_cast<int>(StoreColumn::Turns)].push_back(turns);
+        m_pending[static_cast<int>(StoreColumn::Winner)].push_back(winner >= 0 ? static_cast<std::uint64_t>(winner) + 1 : 0);
+        std::vector<std::uint64_t>& tiles = m_pending[static_cast<int>(StoreColumn::Trace)];
+        for (std::size_t i = 0; i < trace_size; ++i)
+        {
+            tiles.push_back(static_cast<std::uint64_t>(std::max(0, trace[i])));
+        }
+        m_open = true;
+        if (m_pending[0].size() >= m_stripe_rows)
+        {
+            flush_stripe();
+        }
+    }
+
+    void GameStoreWriter::copy_stripes(const GameStoreReader& reader)
+    {
+        flush_stripe();
+        for (const StoreStripe& source : reader.stripes())
+        {
+            StoreStripe stripe = source;
+            stripe.first_row = m_rows;
+            for (StoreChunk& chunk : stripe.chunks)
+            {
+                write_at(m_file, m_end, reader.chunk_data(chunk), static_cast<std::size_t>(chunk.size));
+                chunk.offset = m_end;
+                m_end += chunk.size;
+            }
+            m_rows += stripe.rows;
+            m_stripes.push_back(stripe);
+        }
+        m_open = true;
+        if (!m_file)
+        {
+            throw std::runtime_error("Failed to write game store: " + m_path.string());
+        }
+    }
+
+    void GameStoreWriter::flush_stripe()
+    {
+        const std::size_t rows = m_pending[0].size();
+        if (rows == 0)
+        {
+            return;
+        }
+
+        StoreStripe stripe;
+        stripe.first_row = m_rows;
+        stripe.rows = static_cast<std::uint32_t>(rows);
+        stripe.trace_values = m_pending[static_cast<int>(StoreColumn::Trace)].size();
+        for (int column = 0; column < STORE_COLUMN_COUNT; ++column)
+        {
+            std::vector<std::uint64_t>& values = m_pending[column];
+            StoreChunk& chunk = stripe.chunks[column];
+            if (!values.empty())
+            {
+                const auto [low, high] = std::minmax_element(values.begin(), values.end());
+                chunk.min = *low;
+                chunk.max = *high;
+            }
+            const std::vector<std::uint8_t> bytes = encode(static_cast<StoreColumn>(column), values, chunk);
+            write_at(m_file, m_end, bytes.data(), bytes.size());
+            chunk.offset = m_end;
+            chunk.size = bytes.size();
+            m_end += bytes.size();
+            values.clear();
+        }
+        m_rows += rows;
+        m_stripes.push_back(stripe);
+        if (!m_file)
+        {
+            throw std::runtime_error("Failed to write game store: " + m_path.string());
+        }
+    }
+
+    void GameStoreWriter::write_footer()
+    {
+        std::vector<std::uint8_t> footer = encode_footer(m_stripes);
+        const std::uint32_t footer_size = static_cast<std::uint32_t>(footer.size());
+        put_u64(footer, m_end);
+        put_u32(footer, footer_size);
+        footer.insert(footer.end(), STORE_END_MAGIC, STORE_END_MAGIC + sizeof(STORE_END_MAGIC));
+        write_at(m_file, m_end, footer.data(), footer.size());
+        m_file.flush();
+        if (!m_file)
+        {
+            throw std::runtime_error("Failed to write game store: " + m_path.string());
+        }
+        // Appends only ever add stripes, so the footer never shrinks and
+        // there is nothing left over to truncate
+    }
+
+    void GameStoreWriter::close()
+    {
+        if (!m_open)
+        {
+            return;
+        }
+        flush_stripe();
+        write_footer();
+        m_open = false;
+    }
+
+    GameStoreReader::GameStoreReader(const std::filesystem::path& path)
+        : m_file(path)
+    {
+        const std::uint8_t* data = m_file.data();
+        const std::size_t size = m_file.size();
+        if (size < HEADER_SIZE + TRAILER_SIZE || std::memcmp(data, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a game store: " + path.string());
+        }
+        if (get_u32(data + 8) > STORE_VERSION)
+        {
+            throw std::runtime_error("Unsupported game store version " + std::to_string(get_u32(data + 8)) + ": " +
+                                     path.string());
+        }
+
+        const std::uint8_t* trailer = data + size - TRAILER_SIZE;
+        const std::uint64_t footer_offset = get_u64(trailer);
+        const std::uint32_t footer_size = get_u32(trailer + 8);
+        if (std::memcmp(trailer + 12, STORE_END_MAGIC, sizeof(STORE_END_MAGIC)) != 0 ||
+            footer_offset < HEADER_SIZE || footer_offset + footer_size + TRAILER_SIZE != size)
+        {
+            throw std::runtime_error("Game store has no footer (not closed cleanly?): " + path.string());
+        }
+        m_stripes = decode_footer(data + footer_offset, footer_size, footer_offset, path);
+    }
+
+    std::uint64_t GameStoreReader::rows() const
+    {
+        return m_stripes.empty() ? 0 : m_stripes.back().first_row + m_stripes.back().rows;
+    }
+
+    void GameStoreReader::read_column(std::size_t stripe, StoreColumn column, std::vector<std::uint64_t>& out) const
+    {
+        StoreColumnCursor cursor(*this, stripe, column);
+        const StoreStripe& entry = m_stripes[stripe];
+        out.resize(column == StoreColumn::Trace ? static_cast<std::size_t>(entry.trace_values) : entry.rows);
+        std::size_t done = 0;
+        while (done < out.size())
+        {
+            done += cursor.next(out.data() + done, out.size() - done);
+        }
+    }
+
+    StoreColumnCursor::StoreColumnCursor(const GameStoreReader& reader, std::size_t stripe, StoreColumn column)
+    {
+        const StoreStripe& entry = reader.stripes().at(stripe);
+        const StoreChunk& chunk = entry.chunks[static_cast<int>(column)];
+        m_at = reader.chunk_data(chunk);
+        m_end = m_at + chunk.size;
+        m_encoding = chunk.encoding;
+        m_left = column == StoreColumn::Trace ? entry.trace_values : entry.rows;
+        m_min = chunk.min;
+        const auto fail = []() { throw std::runtime_error("Game store chunk has the wrong length"); };
+        switch (m_encoding)
+        {
+        case StoreEncoding::Bytes:
+            if (chunk.size != m_left)
+            {
+                fail();
+            }
+            break;
+        case StoreEncoding::BitPacked:
+            if (chunk.size < 1 || m_at[0] > MAX_PACKED_WIDTH)
+            {
+                fail();
+            }
+            m_width = m_at[0];
+            ++m_at;
+            if (static_cast<std::uint64_t>(m_end - m_at) != (m_left * static_cast<std::uint64_t>(m_width) + 7) / 8)
+            {
+                fail();
+            }
+            break;
+        case StoreEncoding::Transition:
+        {
+            if (chunk.size < 2 || m_at[0] < 1 || m_at[0] > MAX_TRANSITION_STRIDE)
+            {
+                fail();
+            }
+            m_stride = m_at[0];
+            const int last = m_at[1];
+            m_at += 2;
+            m_codes.assign(256 * 16, TRANSITION_INVALID);
+            for (int tile = 0; tile < 256; ++tile)
+            {
+                m_codes[tile * 16 + MAX_SUCCESSORS] = TRANSITION_ESCAPE;
+            }
+            for (int tile = 0; tile <= last; ++tile)
+            {
+                if (m_at == m_end || *m_at > MAX_SUCCESSORS || m_end - m_at <= *m_at)
+                {
+                    fail();
+                }
+                const int successors = *m_at++;
+                for (int rank = 0; rank < successors; ++rank)
+                {
+                    m_codes[tile * 16 + rank] = *m_at++;
+                }
+            }
+            const std::uint64_t rank_bytes = (m_left + 1) / 2;
+            if (static_cast<std::uint64_t>(m_end - m_at) < rank_bytes)
+            {
+                fail();
+            }
+            m_escape = m_at + rank_bytes;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    bool StoreColumnCursor::has_byte_values() const
+    {
+        return m_encoding == StoreEncoding::Bytes || m_encoding == StoreEncoding::Transition;
+    }
+
+    std::size_t StoreColumnCursor::next_bytes(const std::uint8_t*& values, std::size_t capacity)
+    {
+        if (!has_byte_values())
+        {
+            throw std::runtime_error("Game store chunk does not hold byte values");
+        }
+        if (m_encoding == StoreEncoding::Bytes)
+        {
+            const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(capacity, m_left));
+            m_left -= count;
+            values = m_at;
+            m_at += count;
+            return count;
+        }
+
+        const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>({capacity, m_left, BYTE_BLOCK}));
+        m_buffer.resize(BYTE_BLOCK);
+        m_left -= count;
+        values = m_buffer.data();
+        return decode_transitions(m_buffer.data(), count);
+    }
+
+    std::size_t StoreColumnCursor::decode_transitions(std::uint8_t* out, std::size_t count)
+    {
+        // Whole rounds of stride values go through the fast decoder while
+        // there are enough escapes left for every value to be one
+        std::size_t done = 0;
+        if (static_cast<std::uint64_t>(m_end - m_escape) >= count && m_nibble % 2 == 0)
+        {
+            done = count - count % (2 * static_cast<std::size_t>(m_stride));
+            bool valid = false;
+            switch (m_stride)
+            {
+            case 1:
+                valid = decode_transitions_unchecked<1>(m_at, m_nibble, m_escape, m_codes.data(), m_history.data(), out, done);
+                break;
+            case 2:
+                valid = decode_transitions_unchecked<2>(m_at, m_nibble, m_escape, m_codes.data(), m_history.data(), out, done);
+                break;
+            case 3:
+                valid = decode_transitions_unchecked<3>(m_at, m_nibble, m_escape, m_codes.data(), m_history.data(), out, done);
+                break;
+            default:
+                valid = decode_transitions_unchecked<4>(m_at, m_nibble, m_escape, m_codes.data(), m_history.data(), out, done);
+                break;
+            }
+            if (!valid)
+            {
+                throw std::runtime_error("Game store chunk has an unknown transition");
+            }
+            m_nibble += done;
+        }
+
+        for (std::size_t i = done; i < count; ++i)
+        {
+            const unsigned rank = get_nibble(m_at, m_nibble);
+            unsigned value = m_codes[m_history[0] * 16 + rank];
+            if (rank == MAX_SUCCESSORS)
+            {
+                if (m_escape == m_end)
+                {
+                    throw std::runtime_error("Game store chunk is truncated");
+                }
+                value = *m_escape++;
+            }
+            else if (value == TRANSITION_INVALID)
+            {
+                throw std::runtime_error("Game store chunk has an unknown transition");
+            }
+            ++m_nibble;
+            out[i] = static_cast<std::uint8_t>(value);
+            std::rotate(m_history.begin(), m_history.begin() + 1, m_history.begin() + m_stride);
+            m_history[m_stride - 1] = static_cast<std::uint8_t>(value);
+        }
+        return count;
+    }
+
+    std::size_t StoreColumnCursor::next(std::uint64_t* out, std::size_t capacity)
+    {
+        if (has_byte_values())
+        {
+            std::size_t done = 0;
+            const std::uint8_t* values = nullptr;
+            while (done < capacity)
+            {
+                const std::size_t count = next_bytes(values, capacity - done);
+                if (count == 0)
+                {
+                    break;
+                }
+                std::copy(values, values + count, out + done);
+                done += count;
+            }
+            return done;
+        }
+
+        const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(capacity, m_left));
+        m_left -= count;
+        if (m_encoding == StoreEncoding::BitPacked)
+        {
+            const std::uint64_t mask = m_width == 0 ? 0 : (~std::uint64_t{0} >> (64 - m_width));
+            const std::size_t size = static_cast<std::size_t>(m_end - m_at);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const std::size_t byte = static_cast<std::size_t>(m_bit >> 3);
+                std::uint64_t word = 0;
+                if (size - byte >= 8)
+                {
+                    std::memcpy(&word, m_at + byte, 8);
+                }
+                else
+                {
+                    for (std::size_t k = byte; k < size; ++k)
+                    {
+                        word |= static_cast<std::uint64_t>(m_at[k]) << (8 * (k - byte));
+                    }
+                }
+                out[i] = m_min + ((word >> (m_bit & 7)) & mask);
+                m_bit += static_cast<std::uint64_t>(m_width);
+            }
+            return count;
+        }
+
+        if (m_encoding == StoreEncoding::RunLength)
+        {
+            std::size_t i = 0;
+            while (i < count)
+            {
+                if (m_run_left == 0)
+                {
+                    m_run_delta = static_cast<std::uint64_t>(unzigzag(get_varint(m_at, m_end)));
+                    m_run_left = get_varint(m_at, m_end);
+                    if (m_run_left == 0)
+                    {
+                        throw std::runtime_error("Game store chunk has an empty run");
+                    }
+                }
+                const std::size_t run = static_cast<std::size_t>(std::min<std::uint64_t>(m_run_left, count - i));
+                for (std::size_t k = 0; k < run; ++k)
+                {
+                    m_previous += m_run_delta;
+                    out[i + k] = m_previous;
+                }
+                m_run_left -= run;
+                i += run;
+            }
+            return count;
+        }
+
+        const bool delta = m_encoding == StoreEncoding::DeltaVarint;
+        std::size_t i = 0;
+        while (i < count)
+        {
+            // Most values fit one byte: take eight at a time while none continues
+            std::uint64_t word = 0;
+            if (count - i >= 8 && m_end - m_at >= 8)
+            {
+                std::memcpy(&word, m_at, 8);
+            }
+            if (count - i >= 8 && m_end - m_at >= 8 && (word & 0x8080808080808080ull) == 0)
+            {
+                for (int k = 0; k < 8; ++k)
+                {
+                    const std::uint64_t value = m_at[k];
+                    m_previous = delta ? m_previous + static_cast<std::uint64_t>(unzigzag(value)) : value;
+                    out[i + k] = m_previous;
+                }
+                m_at += 8;
+                i += 8;
+                continue;
+            }
+
+            const std::uint64_t value = get_varint(m_at, m_end);
+            m_previous = delta ? m_previous + static_cast<std::uint64_t>(unzigzag(value)) : value;
+            out[i++] = m_previous;
+        }
+        return count;
+    }
+
+    void merge_game_stores(const std::filesystem::path& out, const std::vector<std::filesystem::path>& inputs)
+    {
+        GameStoreWriter writer(out, false);
+        for (const std::filesystem::path& input : inputs)
+        {
+            writer.copy_stripes(GameStoreReader(input));
+        }
+        writer.close();
+    }
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "utils/mapped_file.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// Per-game simulation records in an append-only columnar file:
+//   "SNLGAMES" u32 version
+//   stripes   each up to stripe_rows games, one compressed chunk per column
+//   footer    per stripe: first row, rows, trace length, then per column its
+//             offset, size, encoding and min / max
+//   trailer   u64 footer offset, u32 footer size, "SNLGEND1"
+// Integers are little-endian. Every chunk is written in whichever encoding
+// comes out smallest: varints, zigzag varint deltas, runs of equal deltas (a
+// constant seed or consecutive game indices take a few bytes per stripe) or
+// values bit-packed above the chunk's min. The tile trace uses a
+// transition code when the board fits a byte (see StoreEncoding::Transition).
+// Appending rewrites only the footer, merging copies chunks without decoding
+// them, and the reader maps the file and decodes just the columns a scan asks
+// for, skipping stripes by their min / max.
+namespace game::map
+{
+    enum class StoreColumn : std::uint8_t
+    {
+        Seed = 0,
+        Game = 1,    // Index in the seed's game sequence (reset_batch_games)
+        Turns = 2,   // All seats together
+        Winner = 3,  // Seat + 1, 0 if unfinished
+        Trace = 4    // Tile after every turn, all games of the stripe end to end (Turns values per game)
+    };
+    constexpr int STORE_COLUMN_COUNT = 5;
+
+    enum class StoreEncoding : std::uint8_t
+    {
+        Varint = 0,
+        DeltaVarint = 1,  // Zigzag varint of the difference to the previous value
+        Bytes = 2,        // One byte per value
+        RunLength = 3,    // (zigzag varint delta, varint count) per run of equal deltas
+        BitPacked = 4,    // u8 width, then value - min in width bits each, LSB first
+        // Values below 256 coded by what came stride values earlier (for a
+        // trace, the same seat's previous tile when stride is the player
+        // count): u8 stride, u8 last tile, per tile up to 15 successors most
+        // common first (u8 count, then the tiles), then a 4-bit rank per value,
+        // low nibble first, then a byte per value of rank 15 (not a successor)
+        Transition = 5
+    };
+    constexpr int STORE_ENCODING_COUNT = 6;
+
+    struct StoreChunk
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        StoreEncoding encoding = StoreEncoding::Varint;
+        std::uint64_t min = 0;
+        std::uint64_t max = 0;
+    };
+
+    struct StoreStripe
+    {
+        std::uint64_t first_row = 0;
+        std::uint32_t rows = 0;
+        std::uint64_t trace_values = 0;
+        std::array<StoreChunk, STORE_COLUMN_COUNT> chunks{};
+    };
+
+    class GameStoreReader;
+
+    class GameStoreWriter
+    {
+    public:
+        // append continues an existing store (a missing or empty file starts a
+        // new one). Throws std::runtime_error on I/O errors or foreign files.
+        explicit GameStoreWriter(const std::filesystem::path& path, bool append = true,
+                                 std::uint32_t stripe_rows = 65536);
+        ~GameStoreWriter();
+
+        GameStoreWriter(const GameStoreWriter&) = delete;
+        GameStoreWriter& operator=(const GameStoreWriter&) = delete;
+
+        // winner -1 = unfinished; trace may be empty or hold turns tiles
+        void add_game(std::uint64_t seed, std::uint64_t game, std::uint32_t turns, int winner,
+                      const std::int32_t* trace = nullptr, std::size_t trace_size = 0);
+
+        // Appends every stripe of reader as is
+        void copy_stripes(const GameStoreReader& reader);
+
+        std::uint64_t rows() const { return m_rows + m_pending[0].size(); }
+
+        // Writes the pending stripe and the footer; later adds start a new stripe
+        void close();
+
+    private:
+        void flush_stripe();
+        void write_footer();
+
+        std::filesystem::path m_path;
+        std::fstream m_file;
+        std::uint32_t m_stripe_rows = 65536;
+        std::uint64_t m_rows = 0;
+        std::uint64_t m_end = 0;  // Where the next stripe goes
+        std::vector<StoreStripe> m_stripes;
+        std::array<std::vector<std::uint64_t>, STORE_COLUMN_COUNT> m_pending;
+        bool m_open = true;
+    };
+
+    class GameStoreReader
+    {
+    public:
+        // Throws std::runtime_error on unreadable or malformed files
+        explicit GameStoreReader(const std::filesystem::path& path);
+
+        std::uint64_t rows() const;
+        const std::vector<StoreStripe>& stripes() const { return m_stripes; }
+
+        // Decodes one column chunk of a stripe into out (replacing its contents).
+        // Scans over large columns should use StoreColumnCursor instead.
+        void read_column(std::size_t stripe, StoreColumn column, std::vector<std::uint64_t>& out) const;
+
+        // The undecoded bytes of a chunk
+        const std::uint8_t* chunk_data(const StoreChunk& chunk) const { return m_file.data() + chunk.offset; }
+
+    private:
+        MappedFile m_file;
+        std::vector<StoreStripe> m_stripes;
+    };
+
+    // Decodes one column chunk of a stripe a block at a time, so a scan works
+    // out of cache instead of widening a whole trace chunk into memory first
+    class StoreColumnCursor
+    {
+    public:
+        // Throws std::runtime_error if the chunk's header does not fit its size
+        StoreColumnCursor(const GameStoreReader& reader, std::size_t stripe, StoreColumn column);
+
+        // Up to capacity values into out; returns how many, 0 once the chunk
+        // is done. Throws std::runtime_error on a truncated or corrupt chunk.
+        std::size_t next(std::uint64_t* out, std::size_t capacity);
+
+        // Bytes and Transition chunks hold values below 256. next_bytes hands
+        // them out without widening: values points into the mapped chunk for
+        // Bytes and at the cursor's own buffer (valid until the next call) for
+        // Transition. Returns 0 once the chunk is done.
+        bool has_byte_values() const;
+        std::size_t next_bytes(const std::uint8_t*& values, std::size_t capacity);
+
+    private:
+        static constexpr std::size_t BYTE_BLOCK = 4096;
+        static constexpr int MAX_STRIDE = 4;
+
+        std::size_t decode_transitions(std::uint8_t* out, std::size_t count);
+
+        const std::uint8_t* m_at = nullptr;
+        const std::uint8_t* m_end = nullptr;
+        StoreEncoding m_encoding = StoreEncoding::Varint;
+        std::uint64_t m_left = 0;      // Values not decoded yet
+        std::uint64_t m_previous = 0;  // Last value, for deltas
+        std::uint64_t m_run_left = 0;  // RunLength: values left in the current run
+        std::uint64_t m_run_delta = 0; // RunLength: the current run's delta
+        std::uint64_t m_min = 0;       // BitPacked: added to every value
+        int m_width = 0;               // BitPacked: bits per value
+        std::uint64_t m_bit = 0;       // BitPacked: next value's bit offset from m_at
+        std::uint64_t m_nibble = 0;    // Transition: next rank nibble from m_at
+        const std::uint8_t* m_escape = nullptr;  // Transition: next value of rank 15, up to m_end
+        int m_stride = 1;              // Transition
+        std::array<std::uint8_t, MAX_STRIDE> m_history{};  // Transition: last stride values, oldest (the next context) first
+        // Transition: per context tile and 4-bit rank, the tile, or 256 for
+        // ranks the chunk has no successor for (rank 15 is the escape)
+        std::vector<std::uint16_t> m_codes;
+        std::vector<std::uint8_t> m_buffer;  // Transition values for next()/next_bytes()
+    };
+
+    // Concatenates stores into out, renumbering rows; chunks are copied as is
+    void merge_game_stores(const std::filesystem::path& out, const std::vector<std::filesystem::path>& inputs);
+}
@@ -0,0 +1,328 @@
+#include "long_games.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace game::map
+{
+    namespace
+    {
+        struct TurnEntry
+        {
+            double cumulative = 0.0;
+            TurnExit exit = TurnExit::Stop;
+            int tile = 0;
+        };
+
+        // enumerate_turn's outcomes per tile as cumulative distributions
+        class TurnSampler
+        {
+        public:
+            explicit TurnSampler(const BoardModel& board)
+                : m_board(board), m_rows(board.tile_count)
+            {
+                std::vector<TurnOutcome> outcomes;
+                for (int tile = 0; tile + 1 < board.tile_count; ++tile)
+                {
+                    outcomes.clear();
+                    enumerate_turn(board, tile, outcomes);
+                    double total = 0.0;
+                    for (const TurnOutcome& outcome : outcomes)
+                    {
+                        total += outcome.probability;
+                        m_rows[tile].push_back({total, outcome.exit, outcome.tile});
+                    }
+                }
+            }
+
+            int final_tile() const
+            {
+                return m_board.tile_count - 1;
+            }
+
+            // One turn from tile; snake is set if it ends down a snake
+            int take_turn(int tile, std::mt19937_64& rng, bool& snake) const
+            {
+                const std::vector<TurnEntry>& row = m_rows[tile];
+                const double draw = std::uniform_real_distribution<double>(0.0, row.back().cumulative)(rng);
+                const auto found = std::upper_bound(row.begin(), row.end() - 1, draw,
+                                                    [](double value, const TurnEntry& entry) {
+                                                        return value < entry.cumulative;
+                                                    });
+                snake = false;
+                switch (found->exit)
+                {
+                case TurnExit::Link:
+                {
+                    const int end = m_board.link_end[found->tile];
+                    snake = end < found->tile;
+                    return end;
+                }
+                case TurnExit::Portal:
+                {
+                    // Any other tile with equal chance
+                    const int warped = std::uniform_int_distribution<int>(0, m_board.tile_count - 2)(rng);
+                    return warped >= found->tile ? warped + 1 : warped;
+                }
+                default:
+                    return found->tile;
+                }
+            }
+
+        private:
+            const BoardModel& m_board;
+            std::vector<std::vector<TurnEntry>> m_rows;
+        };
+
+        struct TailState
+        {
+            std::array<int, 4> tiles{};
+            std::array<int, 4> snakes{};
+            int seat = 0;
+            int turns = 0;
+        };
+
+        enum class StepResult
+        {
+            Going,
+            Finished,  // Someone won; the event can no longer happen
+            Reached    // Level reached
+        };
+
+        int level_of(const TailState& state, const TailQuery& query)
+        {
+            if (query.event == TailEvent::LongGame)
+            {
+                return state.turns / query.players;  // Completed rounds
+            }
+            return *std::max_element(state.snakes.begin(), state.snakes.begin() + query.players);
+        }
+
+        StepResult step(const TurnSampler& sampler, const TailQuery& query, int level, TailState& state,
+                        std::mt19937_64& rng)
+        {
+            bool snake = false;
+            const int seat = state.seat;
+            state.tiles[seat] = sampler.take_turn(state.tiles[seat], rng, snake);
+            state.snakes[seat] += snake ? 1 : 0;
+            ++state.turns;
+            state.seat = seat + 1 == query.players ? 0 : seat + 1;
+            if (state.tiles[seat] >= sampler.final_tile())
+            {
+                return StepResult::Finished;
+            }
+            return level_of(state, query) >= level ? StepResult::Reached : StepResult::Going;
+        }
+
+        std::vector<int> make_levels(const TailQuery& query, const SplittingOptions& options)
+        {
+            std::vector<int> levels;
+            const int step_size = query.event == TailEvent::LongGame ? std::max(1, options.level_step) : 1;
+            for (int level = step_size; level < query.target; level += step_size)
+            {
+                levels.push_back(level);
+            }
+            levels.push_back(query.target);
+            return levels;
+        }
+
+        // One fixed-effort splitting estimate
+        double split_once(const TurnSampler& sampler, const TailQuery& query, const std::vector<int>& levels,
+                          int effort, std::mt19937_64& rng, std::uint64_t& turns)
+        {
+            std::vector<TailState> entrances(1);  // Where paths entered the last level
+            std::vector<TailState> reached;
+            double probability = 1.0;
+            for (const int level : levels)
+            {
+                reached.clear();
+                std::uniform_int_distribution<std::size_t> pick(0, entrances.size() - 1);
+                for (int path = 0; path < effort; ++path)
+                {
+                    TailState state = entrances[pick(rng)];
+                    StepResult result = StepResult::Going;
+                    while (result == StepResult::Going)
+                    {
+                        result = step(sampler, query, level, state, rng);
+                        ++turns;
+                    }
+                    if (result == StepResult::Reached)
+                    {
+                        reached.push_back(state);
+                    }
+                }
+                probability *= static_cast<double>(reached.size()) / effort;
+                if (reached.empty())
+                {
+                    return 0.0;
+                }
+                entrances.swap(reached);
+            }
+            return probability;
+        }
+
+        int thread_count(const SplittingOptions& options, int jobs)
+        {
+            const int threads = options.threads > 0 ? options.threads
+                                                    : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            return std::max(1, std::min(threads, jobs));
+        }
+
+        TailQuery clamp_query(const TailQuery& query)
+        {
+            TailQuery clamped = query;
+            clamped.players = std::clamp(query.players, 1, 4);
+            clamped.target = std::max(1, query.target);
+            return clamped;
+        }
+    }
+
+    TailEstimate estimate_tail_by_splitting(const BoardModel& board, const TailQuery& query,
+                                            const SplittingOptions& options)
+    {
+        const TailQuery clamped = clamp_query(query);
+        const TurnSampler sampler(board);
+        const std::vector<int> levels = make_levels(clamped, options);
+        const int runs = std::max(2, options.runs);
+        const int effort = std::max(1, options.effort);
+
+        std::vector<double> estimates(runs, 0.0);
+        std::vector<std::uint64_t> turns(runs, 0);
+        const int threads = thread_count(options, runs);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int index = 0; index < threads; ++index)
+        {
+            workers.emplace_back([&, index]() {
+                for (int run = index; run < runs; run += threads)
+                {
+                    std::mt19937_64 rng(options.seed + static_cast<std::uint64_t>(run) * 0x9e3779b97f4a7c15ULL);
+                    estimates[run] = split_once(sampler, clamped, levels, effort, rng, turns[run]);
+                }
+            });
+        }
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        TailEstimate estimate;
+        estimate.levels = static_cast<int>(levels.size());
+        double sum = 0.0;
+        double squares = 0.0;
+        for (int run = 0; run < runs; ++run)
+        {
+            sum += estimates[run];
+            squares += estimates[run] * estimates[run];
+            estimate.turns += turns[run];
+        }
+        estimate.probability = sum / runs;
+        const double variance = std::max(0.0, (squares - sum * sum / runs) / (runs - 1));
+        estimate.standard_error = std::sqrt(variance / runs);
+        return estimate;
+    }
+
+    TailEstimate estimate_tail_by_sampling(const BoardModel& board, const TailQuery& query,
+                                           std::uint64_t turn_budget, const SplittingOptions& options)
+    {
+        const TailQuery clamped = clamp_query(query);
+        const TurnSampler sampler(board);
+        const int threads = thread_count(options, 1 << 16);
+
+        std::vector<std::uint64_t> games(threads, 0);
+        std::vector<std::uint64_t> hits(threads, 0);
+        std::vector<std::uint64_t> turns(threads, 0);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int index = 0; index < threads; ++index)
+        {
+            workers.emplace_back([&, index]() {
+                std::mt19937_64 rng(options.seed ^ (0xd1b54a32d192ed03ULL * (index + 1)));
+                const std::uint64_t budget = turn_budget / threads;
+                while (turns[index] < budget)
+                {
+                    TailState state;
+                    StepResult result = StepResult::Going;
+                    while (result == StepResult::Going)
+                    {
+                        result = step(sampler, clamped, clamped.target, state, rng);
+                        ++turns[index];
+                    }
+                    ++games[index];
+                    hits[index] += result == StepResult::Reached ? 1 : 0;
+                }
+            });
+        }
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        TailEstimate estimate;
+        estimate.levels = 1;
+        std::uint64_t played = 0;
+        for (int index = 0; index < threads; ++index)
+        {
+            played += games[index];
+            estimate.hits += hits[index];
+            estimate.turns += turns[index];
+        }
+        if (played > 0)
+        {
+            const double p = static_cast<double>(estimate.hits) / static_cast<double>(played);
+            estimate.probability = p;
+            estimate.standard_error = std::sqrt(p * (1.0 - p) / static_cast<double>(played));
+        }
+        return estimate;
+    }
+
+    double exact_long_game_chance(const BoardModel& board, int players, int rounds)
+    {
+        const std::vector<std::vector<TurnOutcome>> chain = build_turn_chain(board);
+        const int final_tile = board.tile_count - 1;
+        const double portal_share = 1.0 / static_cast<double>(board.tile_count - 1);
+
+        // Where one player is after each turn; finished mass is dropped
+        std::vector<double> current(board.tile_count, 0.0);
+        std::vector<double> next(board.tile_count, 0.0);
+        current[0] = 1.0;
+        for (int turn = 0; turn < rounds; ++turn)
+        {
+            std::fill(next.begin(), next.end(), 0.0);
+            double spread = 0.0;
+            for (int tile = 0; tile < final_tile; ++tile)
+            {
+                for (const TurnOutcome& outcome : chain[tile])
+                {
+                    const double mass = current[tile] * outcome.probability;
+                    if (outcome.exit == TurnExit::Portal)
+                    {
+                        spread += mass * portal_share;
+                        next[outcome.tile] -= mass * portal_share;  // Never back onto the portal
+                    }
+                    else
+                    {
+                        next[outcome.tile] += mass;
+                    }
+                }
+            }
+            for (double& mass : next)
+            {
+                mass += spread;
+            }
+            next[final_tile] = 0.0;
+            current.swap(next);
+        }
+
+        double going = 0.0;
+        for (int tile = 0; tile < final_tile; ++tile)
+        {
+            going += current[tile];
+        }
+        return std::pow(std::max(0.0, going), std::clamp(players, 1, 4));
+    }
+}
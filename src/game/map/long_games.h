@@ -0,0 +1,59 @@
+#pragma once
+
+#include "board_model.h"
+
+#include <cstdint>
+
+// Chances of pathological games - games that drag on for hundreds of rounds,
+// or a player sliding down snake after snake - too rare for plain simulation
+// to see. Estimated by fixed-effort multilevel splitting: the event is cut into
+// levels (every few rounds still unfinished, every further snake hit), each
+// level is entered by a fixed number of paths started from where earlier paths
+// got to, and the chance is the product of the per-level pass rates. Turns are
+// drawn from enumerate_turn's outcomes, so the rules match the game's.
+namespace game::map
+{
+    enum class TailEvent
+    {
+        LongGame,  // Nobody has finished after target rounds
+        SnakeHits  // Some player lands on target snakes before anyone finishes
+    };
+
+    struct TailQuery
+    {
+        TailEvent event = TailEvent::LongGame;
+        int target = 200;
+        int players = 2;
+    };
+
+    struct SplittingOptions
+    {
+        int effort = 10000;     // Paths run per level
+        int level_step = 10;    // Rounds between LongGame levels; SnakeHits levels are every hit
+        int runs = 16;          // Independent estimates, for the standard error
+        int threads = 0;        // 0 = one per core
+        std::uint64_t seed = 1;
+    };
+
+    struct TailEstimate
+    {
+        double probability = 0.0;
+        double standard_error = 0.0;
+        std::uint64_t turns = 0;  // Turns simulated, as a measure of cost
+        std::uint64_t hits = 0;   // Plain sampling only: games that showed the event
+        int levels = 0;
+    };
+
+    TailEstimate estimate_tail_by_splitting(const BoardModel& board, const TailQuery& query,
+                                            const SplittingOptions& options);
+
+    // Plain simulation of whole games until turn_budget turns are spent, for
+    // comparison at equal cost
+    TailEstimate estimate_tail_by_sampling(const BoardModel& board, const TailQuery& query,
+                                           std::uint64_t turn_budget, const SplittingOptions& options);
+
+    // Exact LongGame chance: players never interact, so it is one player's
+    // chance of still going after rounds turns, to the power of players.
+    // Computed in double precision, unlike FinishTable, so far tails survive.
+    double exact_long_game_chance(const BoardModel& board, int players, int rounds);
+}
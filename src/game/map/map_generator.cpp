@@ -712,7 +712,7 @@ namespace game::map
         tile_kinds.front() = TileKind::Start;
         tile_kinds.back() = TileKind::Finish;
 
-        for (const auto& link : BOARD_LINKS)
+        for (const auto& link : active_board().links)
         {
             if (link.is_ladder)
             {
@@ -842,7 +842,7 @@ namespace game::map
             }
         }
 
-        for (const auto& link : BOARD_LINKS)
+        for (const auto& link : active_board().links)
         {
             if (link.is_ladder)
             {
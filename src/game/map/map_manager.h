@@ -5,30 +5,24 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <string>
+#include <vector>
 
 #include "../../core/types.h"
-#include "../player/player.h"
+#include "../../rendering/frustum.h"
+#include "../../rendering/shader_cache.h"
 #include "board.h"
-
-// Forward declarations
-namespace game::minigame
-{
-    struct PrecisionTimingState;
-    struct ReactionState;
-    struct MathQuizState;
-    struct PatternMatchingState;
-}
-
-namespace game::minigame::tile_memory
-{
-    struct TileMemoryState;
-}
+#include "board_rules.h"
 
 namespace game::map
 {
+    constexpr int MAP_CHUNK_TILES = 5;
+
     struct MapData
     {
-        ::Mesh mesh;
+        // The board split into square blocks of MAP_CHUNK_TILES tiles so each
+        // block can be frustum culled on its own
+        std::vector<::Mesh> chunks;
+        Bounds bounds;
         float board_width = 0.0f;
         float board_height = 0.0f;
         float map_length = 0.0f;
@@ -39,36 +33,14 @@ namespace game::map
     // Initialize and build the map
     MapData initialize_map();
 
-    // Check if player is on a ladder tile and warp them if needed
-    // Returns true if player was warped, false otherwise
-    bool check_and_apply_ladder(player::PlayerState& player_state, int current_tile, int& last_processed_tile);
-
-    // Check if player is on a snake tile and warp them if needed (going backward)
-    // Returns true if player was warped, false otherwise
-    bool check_and_apply_snake(player::PlayerState& player_state, int current_tile, int& last_processed_tile);
-
-    // Check tile activity and trigger appropriate minigame or special action
-    // Returns true if a minigame was triggered or special action was applied
-    bool check_tile_activity(int current_tile, 
-                            int& last_processed_tile,
-                            bool minigame_running,
-                            bool tile_memory_active,
-                            player::PlayerState& player_state,
-                            game::minigame::PrecisionTimingState& minigame_state,
-                            game::minigame::tile_memory::TileMemoryState& tile_memory_state,
-                            game::minigame::ReactionState& reaction_state,
-                            game::minigame::MathQuizState& math_state,
-                            game::minigame::PatternMatchingState& pattern_state,
-                            std::string& minigame_message,
-                            float& minigame_message_timer,
-                            std::array<bool, 10>& tile_memory_previous_keys,
-                            bool& precision_space_was_down);
+    void destroy_map(MapData& map_data);
 
-    // Render the map
+    // Render the map. Chunks outside the frustum are skipped; pass nullptr to draw everything.
     void render_map(const MapData& map_data, 
                    const glm::mat4& projection, 
                    const glm::mat4& view,
-                   ::GLuint program,
-                   ::GLint mvp_location);
+                   const ShaderCache& shaders,
+                   const Frustum* frustum,
+                   CullStats& cull_stats);
 }
 
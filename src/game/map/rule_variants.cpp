@@ -0,0 +1,71 @@
+#include "rule_variants.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace game::map
+{
+    static_assert(rule_variant_index({FinishRule::Bounce, true, true}) == RULE_VARIANT_COUNT - 1,
+                  "rule_variant_index must cover every variant");
+
+    RuleVariant parse_rule_variant(const std::string& text)
+    {
+        RuleVariant rules;
+        std::istringstream names(text);
+        std::string name;
+        while (std::getline(names, name, ','))
+        {
+            if (name.empty() || name == "standard")
+            {
+                continue;
+            }
+            if (name == "exact")
+            {
+                rules.finish = FinishRule::Exact;
+            }
+            else if (name == "bounce")
+            {
+                rules.finish = FinishRule::Bounce;
+            }
+            else if (name == "six-again")
+            {
+                rules.six_again = true;
+            }
+            else if (name == "snakes-on-pass")
+            {
+                rules.snakes_on_pass = true;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown rule: " + name);
+            }
+        }
+        return rules;
+    }
+
+    std::string describe_rule_variant(const RuleVariant& rules)
+    {
+        std::string text;
+        const auto add = [&text](const char* name) {
+            text += text.empty() ? "" : ",";
+            text += name;
+        };
+        if (rules.finish == FinishRule::Exact)
+        {
+            add("exact");
+        }
+        else if (rules.finish == FinishRule::Bounce)
+        {
+            add("bounce");
+        }
+        if (rules.six_again)
+        {
+            add("six-again");
+        }
+        if (rules.snakes_on_pass)
+        {
+            add("snakes-on-pass");
+        }
+        return text.empty() ? "standard" : text;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+// House-rule variants of a turn. Simulation kernels take the rules as a
+// compile-time policy (RulePolicy) so every variant is its own specialised
+// loop with no per-game rule checks, and pick the instantiation at run time
+// by rule_variant_index. The exact analysis (enumerate_turn, win_odds)
+// knows the standard rules only.
+namespace game::map
+{
+    enum class FinishRule
+    {
+        Overshoot = 0,  // A roll past the finish still finishes (standard)
+        Exact = 1,      // A roll past the finish is lost; the player stays put
+        Bounce = 2      // A roll past the finish bounces back by the excess
+    };
+
+    struct RuleVariant
+    {
+        FinishRule finish = FinishRule::Overshoot;
+        bool six_again = false;       // Rolling a 6 gives the same player another turn
+        bool snakes_on_pass = false;  // Walking over a snake's head takes the snake too
+    };
+
+    constexpr int RULE_VARIANT_COUNT = 3 * 2 * 2;
+
+    constexpr int rule_variant_index(const RuleVariant& rules)
+    {
+        return static_cast<int>(rules.finish) + 3 * (rules.six_again ? 1 : 0) + 6 * (rules.snakes_on_pass ? 1 : 0);
+    }
+
+    // A variant as template parameters, for kernels specialised per variant
+    template <FinishRule Finish, bool SixAgain, bool SnakesOnPass>
+    struct RulePolicy
+    {
+        static constexpr FinishRule finish = Finish;
+        static constexpr bool six_again = SixAgain;
+        static constexpr bool snakes_on_pass = SnakesOnPass;
+    };
+
+    // The policy of rule_variant_index Index
+    template <int Index>
+    using RulePolicyAt = RulePolicy<static_cast<FinishRule>(Index % 3), (Index / 3) % 2 != 0, Index / 6 != 0>;
+
+    // Comma-separated names: "exact" or "bounce", "six-again", "snakes-on-pass";
+    // "standard" or "" for none. Throws std::runtime_error on unknown names.
+    RuleVariant parse_rule_variant(const std::string& text);
+    std::string describe_rule_variant(const RuleVariant& rules);
+}
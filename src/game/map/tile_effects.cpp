@@ -0,0 +1,214 @@
+#include "tile_effects.h"
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr int TILE_COUNT = BOARD_COLUMNS * BOARD_ROWS;
+
+        struct MinigameName
+        {
+            ActivityKind kind;
+            const char* name;
+        };
+
+        // Same names as the board file's activities
+        constexpr MinigameName MINIGAME_NAMES[] = {
+            {ActivityKind::MiniGame, "precision"},
+            {ActivityKind::MemoryGame, "memory"},
+            {ActivityKind::ReactionGame, "reaction"},
+            {ActivityKind::MathGame, "math"},
+            {ActivityKind::PatternGame, "pattern"},
+        };
+
+        std::string trim(const std::string& text)
+        {
+            const std::size_t first = text.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos)
+            {
+                return {};
+            }
+            const std::size_t last = text.find_last_not_of(" \t\r\n");
+            return text.substr(first, last - first + 1);
+        }
+
+        std::int16_t read_number(std::istringstream& in, int low, int high, const std::string& statement)
+        {
+            int number = 0;
+            if (!(in >> number) || number < low || number > high)
+            {
+                throw std::runtime_error("Bad number in tile effect: " + statement);
+            }
+            return static_cast<std::int16_t>(number);
+        }
+
+        EffectInstruction compile_statement(TileEffects& effects, const std::string& statement)
+        {
+            std::istringstream in(statement);
+            std::string word;
+            in >> word;
+
+            EffectInstruction instruction;
+            if (word == "move")
+            {
+                instruction.op = EffectOp::Move;
+                instruction.value = read_number(in, -TILE_COUNT, TILE_COUNT, statement);
+            }
+            else if (word == "warp")
+            {
+                instruction.op = EffectOp::Warp;
+                instruction.value = read_number(in, 0, TILE_COUNT - 1, statement);
+            }
+            else if (word == "random-warp")
+            {
+                instruction.op = EffectOp::RandomWarp;
+            }
+            else if (word == "skip")
+            {
+                instruction.op = EffectOp::Skip;
+            }
+            else if (word == "minigame")
+            {
+                std::string name;
+                in >> name;
+                instruction.op = EffectOp::Minigame;
+                for (const MinigameName& entry : MINIGAME_NAMES)
+                {
+                    if (name == entry.name)
+                    {
+                        instruction.small = static_cast<std::uint8_t>(entry.kind);
+                    }
+                }
+                if (instruction.small == 0)
+                {
+                    throw std::runtime_error("Unknown minigame in tile effect: " + statement);
+                }
+            }
+            else if (word == "bonus-roll")
+            {
+                instruction.op = EffectOp::BonusRoll;
+                instruction.small = static_cast<std::uint8_t>(read_number(in, 0, 255, statement));
+                instruction.value = read_number(in, instruction.small, TILE_COUNT, statement);
+            }
+            else if (word == "say")
+            {
+                if (effects.strings.size() >= static_cast<std::size_t>(std::numeric_limits<std::int16_t>::max()))
+                {
+                    throw std::runtime_error("Too many tile effect texts");
+                }
+                instruction.op = EffectOp::Say;
+                instruction.value = static_cast<std::int16_t>(effects.strings.size());
+                effects.strings.push_back(trim(statement.substr(word.size())));
+                return instruction;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown tile effect: " + statement);
+            }
+
+            std::string extra;
+            if (in >> extra)
+            {
+                throw std::runtime_error("Unexpected '" + extra + "' in tile effect: " + statement);
+            }
+            return instruction;
+        }
+
+        TileEffects& active_effects_storage()
+        {
+            static TileEffects effects = compile_tile_effects(active_board());
+            return effects;
+        }
+    }
+
+    const char* activity_effect_program(ActivityKind kind)
+    {
+        switch (kind)
+        {
+        case ActivityKind::SkipTurn:
+            return "skip; say Skip Turn!";
+        case ActivityKind::WalkBackward:
+            return "move -3; say Walk Backward 3 steps!";
+        case ActivityKind::MiniGame:
+            return "minigame precision; say Precision Timing Challenge! Stop at 4.99";
+        case ActivityKind::MemoryGame:
+            return "minigame memory; say จำลำดับ! ใช้ปุ่ม 1-9";
+        case ActivityKind::ReactionGame:
+            return "minigame reaction";
+        case ActivityKind::MathGame:
+            return "minigame math";
+        case ActivityKind::PatternGame:
+            return "minigame pattern";
+        case ActivityKind::Slide:
+            return "move 1; say Slide! +1 step";
+        case ActivityKind::Portal:
+            return "random-warp; say Portal! Warped to tile {}";
+        case ActivityKind::Trap:
+            return "skip; say Trap! Skip Turn!";
+        case ActivityKind::Bonus:
+            return "bonus-roll 1 6; say Bonus! +{} steps";
+        default:
+            return "";
+        }
+    }
+
+    std::uint32_t compile_effect_program(TileEffects& effects, const std::string& program)
+    {
+        const std::uint32_t start = static_cast<std::uint32_t>(effects.code.size());
+        std::istringstream statements(program);
+        std::string statement;
+        while (std::getline(statements, statement, ';'))
+        {
+            statement = trim(statement);
+            if (!statement.empty())
+            {
+                effects.code.push_back(compile_statement(effects, statement));
+            }
+        }
+        if (effects.code.size() == start)
+        {
+            return 0;  // Nothing to run; share the lone End
+        }
+        effects.code.push_back(EffectInstruction{});
+        return start;
+    }
+
+    TileEffects compile_tile_effects(const BoardDefinition& board)
+    {
+        TileEffects effects;
+
+        // One copy of each activity's program, shared by its tiles
+        std::array<std::uint32_t, static_cast<int>(ActivityKind::WalkBackward) + 1> by_activity{};
+        for (std::size_t kind = 0; kind < by_activity.size(); ++kind)
+        {
+            by_activity[kind] = compile_effect_program(effects, activity_effect_program(static_cast<ActivityKind>(kind)));
+        }
+        for (int tile = 1; tile < TILE_COUNT - 1; ++tile)
+        {
+            effects.entry[tile] = by_activity[static_cast<int>(board.activities[tile])];
+        }
+        for (const TileEffectSource& source : board.effects)
+        {
+            if (source.tile <= 0 || source.tile >= TILE_COUNT - 1)
+            {
+                throw std::runtime_error("Tile effect on tile " + std::to_string(source.tile));
+            }
+            effects.entry[source.tile] = compile_effect_program(effects, source.program);
+        }
+        return effects;
+    }
+
+    const TileEffects& active_tile_effects()
+    {
+        return active_effects_storage();
+    }
+
+    void reload_active_tile_effects()
+    {
+        active_effects_storage() = compile_tile_effects(active_board());
+    }
+}
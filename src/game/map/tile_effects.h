@@ -0,0 +1,65 @@
+#pragma once
+
+#include "board.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What landing on a tile does, as data. Every activity - and any tile a board
+// file gives an effect of its own - is a short program of ';'-separated
+// statements:
+//   move N            walk N steps on (N > 0) or back (N < 0)
+//   warp T            go to tile T (0-based) and end the turn
+//   random-warp       go to any other tile and end the turn
+//   skip              end the turn
+//   minigame NAME     start precision, memory, reaction, math or pattern
+//   bonus-roll LO HI  walk on LO..HI steps, drawn at random
+//   say TEXT          show TEXT; {} stands for the last warp tile (1-based) or bonus roll
+// Programs are compiled into one bytecode array when a board is loaded and
+// run by run_tile_effect (board_rules.h). The analysis and simulation code
+// reads each program as one BoardModel landing where it can (make_board_model).
+namespace game::map
+{
+    enum class EffectOp : std::uint8_t
+    {
+        End = 0,
+        Move = 1,
+        Warp = 2,
+        RandomWarp = 3,
+        Skip = 4,
+        Minigame = 5,
+        BonusRoll = 6,
+        Say = 7
+    };
+    constexpr int EFFECT_OP_COUNT = 8;
+
+    struct EffectInstruction
+    {
+        EffectOp op = EffectOp::End;
+        std::uint8_t small = 0;  // Minigame ActivityKind, bonus-roll low
+        std::int16_t value = 0;  // Steps, tile, bonus-roll high or index into strings
+    };
+
+    struct TileEffects
+    {
+        std::vector<EffectInstruction> code{EffectInstruction{}};  // Programs end to end, each closed by End
+        std::array<std::uint32_t, BOARD_COLUMNS * BOARD_ROWS> entry{};  // Start of each tile's program; 0 = the lone End
+        std::vector<std::string> strings;                               // say texts
+    };
+
+    // The built-in program of an activity, "" for None
+    const char* activity_effect_program(ActivityKind kind);
+
+    // Appends program to effects and returns where it starts. Throws
+    // std::runtime_error naming the statement it cannot compile.
+    std::uint32_t compile_effect_program(TileEffects& effects, const std::string& program);
+
+    // Every tile of board: its own effect from board.effects, else its activity's
+    TileEffects compile_tile_effects(const BoardDefinition& board);
+
+    // The active board's effects; set_active_board recompiles them
+    const TileEffects& active_tile_effects();
+    void reload_active_tile_effects();
+}
@@ -0,0 +1,136 @@
+#include "win_odds.h"
+
+#include <algorithm>
+
+namespace game::map
+{
+    namespace
+    {
+        constexpr int TILE_COUNT = BOARD_COLUMNS * BOARD_ROWS;
+        constexpr int FINAL_TILE = TILE_COUNT - 1;
+    }
+
+    FinishTable build_finish_table(const WinOddsModel& model)
+    {
+        return build_finish_table(make_board_model(model.minigame_success), model);
+    }
+
+    FinishTable build_finish_table(const BoardModel& board, const WinOddsModel& model)
+    {
+        // One turn from every tile: roll 1-6, walk, resolve the landing
+        const std::vector<std::vector<TurnOutcome>> chain = build_turn_chain(board);
+        const double portal_share = 1.0 / static_cast<double>(TILE_COUNT - 1);
+
+        FinishTable table;
+        table.approximate = !board.unmodelled_tiles.empty();
+        std::vector<double> previous(TILE_COUNT, 1.0);
+        previous[FINAL_TILE] = 0.0;
+        std::vector<double> current(TILE_COUNT, 0.0);
+        table.survival.assign(previous.begin(), previous.end());
+
+        const int max_turns = std::max(1, model.max_turns);
+        while (table.turns < max_turns)
+        {
+            double previous_sum = 0.0;
+            for (int tile = 0; tile < FINAL_TILE; ++tile)
+            {
+                previous_sum += previous[tile];
+            }
+
+            double largest = 0.0;
+            for (int tile = 0; tile < FINAL_TILE; ++tile)
+            {
+                double remaining = 0.0;
+                for (const TurnOutcome& outcome : chain[tile])
+                {
+                    if (outcome.exit == TurnExit::Portal)
+                    {
+                        // Any other tile, the final one included
+                        remaining += outcome.probability * portal_share * (previous_sum - previous[outcome.tile]);
+                    }
+                    else
+                    {
+                        remaining += outcome.probability * previous[outcome.tile];
+                    }
+                }
+                current[tile] = remaining;
+                largest = std::max(largest, remaining);
+            }
+            current[FINAL_TILE] = 0.0;
+
+            table.survival.insert(table.survival.end(), current.begin(), current.end());
+            ++table.turns;
+            previous.swap(current);
+            if (largest < model.tolerance)
+            {
+                break;
+            }
+        }
+        return table;
+    }
+
+    float survival_after(const FinishTable& table, int tile, int turns)
+    {
+        const int row = std::clamp(turns, 0, table.turns);
+        const int column = std::clamp(tile, 0, FINAL_TILE);
+        return table.survival[static_cast<std::size_t>(row) * TILE_COUNT + static_cast<std::size_t>(column)];
+    }
+
+    std::array<float, 4> compute_win_odds(const FinishTable& table, const std::array<int, 4>& tiles,
+                                          int num_players, int current_seat)
+    {
+        std::array<float, 4> odds{};
+        const int count = std::clamp(num_players, 1, 4);
+        if (table.survival.empty())
+        {
+            return odds;
+        }
+
+        // Seats in the order they move from now on
+        std::array<int, 4> order{};
+        for (int i = 0; i < count; ++i)
+        {
+            order[i] = (current_seat + i) % count;
+            if (tiles[order[i]] >= FINAL_TILE)
+            {
+                odds[order[i]] = 1.0f;  // Already finished
+                return odds;
+            }
+        }
+
+        // A seat wins on its k-th turn if it finishes then, everyone before it in
+        // the order is still going after k turns and everyone after it after k - 1
+        std::array<double, 4> totals{};
+        std::array<double, 5> still_going_before_turn{};  // Suffix products of survival at k - 1
+        for (int k = 1; k <= table.turns; ++k)
+        {
+            still_going_before_turn[count] = 1.0;
+            for (int i = count - 1; i >= 0; --i)
+            {
+                still_going_before_turn[i] = still_going_before_turn[i + 1] * survival_after(table, tiles[order[i]], k - 1);
+            }
+
+            double earlier_still_going = 1.0;
+            for (int i = 0; i < count; ++i)
+            {
+                const int tile = tiles[order[i]];
+                const double after = survival_after(table, tile, k);
+                const double finishes = survival_after(table, tile, k - 1) - after;
+                totals[i] += earlier_still_going * finishes * still_going_before_turn[i + 1];
+                earlier_still_going *= after;
+            }
+        }
+
+        // Renormalise the tail the table cut off
+        double sum = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            sum += totals[i];
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            odds[order[i]] = sum > 0.0 ? static_cast<float>(totals[i] / sum) : 1.0f / static_cast<float>(count);
+        }
+        return odds;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "board_model.h"
+
+#include <array>
+#include <vector>
+
+// Estimated win probabilities for the current board. They are exact for
+// BoardModel's rules, which differ from the real game in a few ways:
+//   - every minigame is won with the same fixed chance (minigame_success),
+//     whoever plays it
+//   - the table ends after max_turns, and the mass still unfinished there is
+//     read as never finishing
+//   - survival is stored as float
+//   - board file effects the model cannot play end the turn (unmodelled_tiles)
+// The HUD therefore shows them as an estimate.
+//
+// Players never interact - nobody bumps or blocks anyone - so each one's progress
+// is an independent Markov chain over the 100 tiles. A game with any number of
+// players therefore reduces to each player's distribution of "turns until the
+// final tile", and whoever needs the fewest turns wins (ties go to whoever moves
+// first). That distribution is solved once per tile by value iteration over the
+// single-player chain, which replaces a table over every combination of positions.
+namespace game::map
+{
+    struct WinOddsModel
+    {
+        float minigame_success = 0.5f;  // Chance any minigame is won, for every player
+        // Table rows - in practice the limit that applies: on the built-in board
+        // a player is still unfinished after 1024 turns with chance 2.8e-5, well
+        // above tolerance, so the table always stops here (tolerance alone would
+        // take about 1570 rows). That tail changes the odds by at most 3e-5.
+        int max_turns = 1024;
+        double tolerance = 1e-7;  // Stops earlier once no tile has more unfinished mass than this
+    };
+
+    // Landing rules come from enumerate_turn (board_model.h)
+    struct FinishTable
+    {
+        int turns = 0;  // Rows after row 0
+        // survival[k * TILE_COUNT + tile] = chance a player starting on tile has not
+        // reached the final tile after k of their own turns. Row 0 is 1 except there.
+        std::vector<float> survival;
+        bool approximate = false;  // The board has effects the model plays as Stop (unmodelled_tiles)
+    };
+
+    FinishTable build_finish_table(const WinOddsModel& model = {});
+    // board must have the game's tile count; model.minigame_success is not used
+    FinishTable build_finish_table(const BoardModel& board, const WinOddsModel& model);
+
+    // Rows past the end of the table read as the last row
+    float survival_after(const FinishTable& table, int tile, int turns);
+
+    // Win probability of seats 0..num_players-1 on tiles[seat] with current_seat to
+    // move, summing to 1. Cost is num_players * table.turns multiply-adds.
+    std::array<float, 4> compute_win_odds(const FinishTable& table, const std::array<int, 4>& tiles,
+                                          int num_players, int current_seat);
+}
@@ -1,6 +1,7 @@
 #include "math_minigame.h"
 
-#include <chrono>
+#include "../../core/random.h"
+
 #include <random>
 #include <sstream>
 
@@ -10,14 +11,12 @@ namespace game::minigame
     {
         std::mt19937& get_rng()
         {
-            static std::mt19937 rng(static_cast<unsigned int>(
-                std::chrono::steady_clock::now().time_since_epoch().count()));
-            return rng;
+            return core::random_stream(core::RandomStream::Math);
         }
 
         std::uniform_int_distribution<int>& get_number_distribution()
         {
-            static std::uniform_int_distribution<int> num_dist(1, 20);
+            thread_local std::uniform_int_distribution<int> num_dist(1, 20);
             return num_dist;
         }
     }
@@ -40,6 +39,18 @@ namespace game::minigame
         state.display_text = "Math Quiz Bonus +4";
     }
 
+    void skip_title(MathQuizState& state)
+    {
+        if (state.phase != MathQuizState::Phase::ShowingTitle)
+        {
+            return;
+        }
+        state.phase = MathQuizState::Phase::ShowingQuestion;
+        state.timer = 0.0f;
+        state.title_timer = state.title_duration;
+        state.display_text.clear();
+    }
+
     void advance(MathQuizState& state, float delta_time)
     {
         if (state.phase == MathQuizState::Phase::ShowingTitle)
@@ -33,6 +33,7 @@ namespace game::minigame
     };
 
     void start_math_quiz(MathQuizState& state);
+    void skip_title(MathQuizState& state);  // Title screen -> ShowingQuestion
     void advance(MathQuizState& state, float delta_time);
     void submit_answer(MathQuizState& state, int answer);
     void add_digit(MathQuizState& state, char digit);
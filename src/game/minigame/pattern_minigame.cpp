@@ -1,6 +1,7 @@
 #include "pattern_minigame.h"
 
-#include <chrono>
+#include "../../core/random.h"
+
 #include <random>
 #include <sstream>
 
@@ -10,14 +11,12 @@ namespace game::minigame
     {
         std::mt19937& get_rng()
         {
-            static std::mt19937 rng(static_cast<unsigned int>(
-                std::chrono::steady_clock::now().time_since_epoch().count()));
-            return rng;
+            return core::random_stream(core::RandomStream::Pattern);
         }
 
         std::uniform_int_distribution<int>& get_direction_distribution()
         {
-            static std::uniform_int_distribution<int> dir_dist(1, 4);  // 1=Up, 2=Down, 3=Left, 4=Right
+            thread_local std::uniform_int_distribution<int> dir_dist(1, 4);  // 1=Up, 2=Down, 3=Left, 4=Right
             return dir_dist;
         }
     }
@@ -40,6 +39,26 @@ namespace game::minigame
         state.display_text = "Pattern Matching! Bonus +5";
     }
 
+    void skip_title(PatternMatchingState& state)
+    {
+        if (state.phase != PatternMatchingState::Phase::ShowingTitle)
+        {
+            return;
+        }
+        state.phase = PatternMatchingState::Phase::ShowingPattern;
+        state.show_timer = 0.0f;
+        state.title_timer = state.title_duration;
+        // Pattern text uses the key letters (W S A D) that match the input keys
+        std::ostringstream oss;
+        for (int i = 0; i < 4; ++i)
+        {
+            const char* dirs[] = {"", "W", "S", "A", "D"};
+            oss << dirs[state.pattern[i]];
+            if (i < 3) oss << " ";
+        }
+        state.display_text = oss.str();
+    }
+
     void advance(PatternMatchingState& state, float delta_time)
     {
         switch (state.phase)
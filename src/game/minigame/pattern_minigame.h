@@ -30,6 +30,7 @@ namespace game::minigame
     };
 
     void start_pattern_matching(PatternMatchingState& state);
+    void skip_title(PatternMatchingState& state);  // Title screen -> ShowingPattern
     void advance(PatternMatchingState& state, float delta_time);
     void add_char_input(PatternMatchingState& state, char c);
     void delete_char(PatternMatchingState& state);
@@ -1,11 +1,18 @@
 #include "qte_minigame.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
 
 namespace game::minigame
 {
+    namespace
+    {
+        // Slow down timer by 50% to make it easier
+        constexpr float TIMER_SPEED = 0.5f;
+    }
+
     void start_precision_timing(PrecisionTimingState& state)
     {
         state.status = PrecisionTimingStatus::ShowingTitle;
@@ -19,6 +26,18 @@ namespace game::minigame
         state.display_text = "Precision Timing Game Bonus +6";
     }
 
+    void skip_title(PrecisionTimingState& state, float seconds_ago)
+    {
+        if (state.status != PrecisionTimingStatus::ShowingTitle)
+        {
+            return;
+        }
+        state.status = PrecisionTimingStatus::Running;
+        state.timer = seconds_ago * TIMER_SPEED;
+        state.title_timer = state.title_duration;
+        state.display_text = "Press SPACE to stop at 4.99!";
+    }
+
     void advance(PrecisionTimingState& state, float delta_time)
     {
         if (state.status == PrecisionTimingStatus::ShowingTitle)
@@ -28,8 +47,7 @@ namespace game::minigame
         }
         else if (state.status == PrecisionTimingStatus::Running)
         {
-            // Slow down timer by 50% to make it easier
-            state.timer += delta_time * 0.5f;
+            state.timer += delta_time * TIMER_SPEED;
             // Update display text to show current time (starting from 0)
             std::ostringstream oss;
             oss << std::fixed << std::setprecision(2);
@@ -63,14 +81,14 @@ namespace game::minigame
         }
     }
 
-    void stop_timing(PrecisionTimingState& state)
+    void stop_timing(PrecisionTimingState& state, float seconds_ago)
     {
         if (state.status != PrecisionTimingStatus::Running)
         {
             return;
         }
 
-        state.stopped_time = state.timer;
+        state.stopped_time = std::max(0.0f, state.timer - seconds_ago * TIMER_SPEED);
         const float target = state.target_time;
         const float diff = std::abs(state.stopped_time - target);
 
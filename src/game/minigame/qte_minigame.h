@@ -1,7 +1,5 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
-
 #include <string>
 
 namespace game::minigame
@@ -34,8 +32,13 @@ namespace game::minigame
     };
 
     void start_precision_timing(PrecisionTimingState& state);
+    // Title screen -> Running. seconds_ago is how long before the current tick
+    // the key was pressed, so the clock starts when the player pressed it.
+    void skip_title(PrecisionTimingState& state, float seconds_ago = 0.0f);
     void advance(PrecisionTimingState& state, float delta_time);
-    void stop_timing(PrecisionTimingState& state);
+    // Judges the time the key was really pressed (seconds_ago before the current
+    // tick), not the tick that noticed it
+    void stop_timing(PrecisionTimingState& state, float seconds_ago = 0.0f);
     bool has_expired(const PrecisionTimingState& state);
     bool is_running(const PrecisionTimingState& state);
     bool is_success(const PrecisionTimingState& state);
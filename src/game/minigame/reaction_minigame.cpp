@@ -1,6 +1,7 @@
 #include "reaction_minigame.h"
 
-#include <chrono>
+#include "../../core/random.h"
+
 #include <random>
 #include <sstream>
 #include <algorithm>
@@ -11,14 +12,12 @@ namespace game::minigame
     {
         std::mt19937& get_rng()
         {
-            static std::mt19937 rng(static_cast<unsigned int>(
-                std::chrono::steady_clock::now().time_since_epoch().count()));
-            return rng;
+            return core::random_stream(core::RandomStream::Reaction);
         }
 
         std::uniform_int_distribution<int>& get_number_distribution()
         {
-            static std::uniform_int_distribution<int> number_distribution(1, 9);
+            thread_local std::uniform_int_distribution<int> number_distribution(1, 9);
             return number_distribution;
         }
 
@@ -62,6 +61,23 @@ namespace game::minigame
         state.bonus_steps = 0;
     }
 
+    void skip_title(ReactionState& state)
+    {
+        if (state.phase != ReactionState::Phase::ShowingTitle)
+        {
+            return;
+        }
+        // Straight to the first guess - InitialMessage is only for the timed path
+        state.phase = ReactionState::Phase::PlayerTurn;
+        state.timer = 0.0f;
+        state.title_timer = state.title_duration;
+        state.player_attempts = 0;
+        state.input_buffer.clear();
+        std::ostringstream ss;
+        ss << "Guess " << (state.player_attempts + 1) << "/" << state.max_attempts << " : input _\n(space)";
+        state.display_text = ss.str();
+    }
+
     void advance(ReactionState& state, float delta_time)
     {
         switch (state.phase)
@@ -50,6 +50,7 @@ namespace game::minigame
     };
 
     void start_reaction(ReactionState& state);
+    void skip_title(ReactionState& state);  // Title screen -> PlayerTurn
     void advance(ReactionState& state, float delta_time);
     void submit_guess(ReactionState& state, int guess);
     void add_digit(ReactionState& state, char digit);
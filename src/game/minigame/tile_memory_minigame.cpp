@@ -1,5 +1,7 @@
 #include "tile_memory_minigame.h"
 
+#include "../../core/random.h"
+
 #include <algorithm>
 #include <array>
 #include <iomanip>
@@ -17,8 +19,7 @@ namespace game::minigame::tile_memory
 
         std::mt19937& rng()
         {
-            static std::mt19937 engine(std::random_device{}());
-            return engine;
+            return core::random_stream(core::RandomStream::TileMemory);
         }
 
         int clamp_length(int length)
@@ -126,6 +127,14 @@ namespace game::minigame::tile_memory
         state.display_text = "Tile Memory Game Bonus +4";
     }
 
+    void skip_title(TileMemoryState& state)
+    {
+        if (state.phase == Phase::ShowingTitle)
+        {
+            state.title_timer = state.title_duration;
+        }
+    }
+
     void advance(TileMemoryState& state, float delta_time)
     {
         switch (state.phase)
@@ -36,6 +36,7 @@ namespace game::minigame::tile_memory
     };
 
     void start(TileMemoryState& state, int sequence_length = 3);
+    void skip_title(TileMemoryState& state);  // advance() then starts the first round
     void advance(TileMemoryState& state, float delta_time);
     void submit_choice(TileMemoryState& state, int tile_choice);
     void add_digit(TileMemoryState& state, char digit);
@@ -1,8 +1,9 @@
 #include "dice.h"
 
+#include "../../../core/random.h"
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <random>
-#include <chrono>
 #include <cmath>
 #include <iostream>
 
@@ -12,9 +13,7 @@ namespace game::player::dice
     {
         std::mt19937& get_rng()
         {
-            static std::mt19937 rng(static_cast<unsigned int>(
-                std::chrono::steady_clock::now().time_since_epoch().count()));
-            return rng;
+            return core::random_stream(core::RandomStream::Dice);
         }
         
         // Generate random dice result (1-6)
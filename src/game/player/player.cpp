@@ -1,9 +1,10 @@
 #include "player.h"
 
+#include "../../core/random.h"
 #include "../../game/map/board.h"
+#include "../../game/state_hash.h"
 
 #include <algorithm>
-#include <chrono>
 #include <cmath>
 #include <glm/gtc/constants.hpp>
 #include <random>
@@ -16,17 +17,37 @@ namespace game::player
     {
         std::mt19937& get_rng()
         {
-            static std::mt19937 rng(static_cast<unsigned int>(
-                std::chrono::steady_clock::now().time_since_epoch().count()));
-            return rng;
+            return core::random_stream(core::RandomStream::Player);
         }
 
         std::uniform_int_distribution<int>& get_dice_distribution()
         {
-            static std::uniform_int_distribution<int> dice_distribution(1, 6);
+            thread_local std::uniform_int_distribution<int> dice_distribution(1, 6);
             return dice_distribution;
         }
 
+        // The three hashed fields. Each swaps the old value's key for the new one.
+        void set_tile(PlayerState& state, int tile)
+        {
+            state.hash ^= game::player_tile_key(state.seat, state.current_tile_index) ^ game::player_tile_key(state.seat, tile);
+            state.current_tile_index = tile;
+        }
+
+        void set_steps(PlayerState& state, int steps)
+        {
+            state.hash ^= game::player_steps_key(state.seat, state.steps_remaining) ^ game::player_steps_key(state.seat, steps);
+            state.steps_remaining = steps;
+        }
+
+        void set_walking_backward(PlayerState& state, bool backward)
+        {
+            if (state.is_walking_backward != backward)
+            {
+                state.hash ^= game::player_backward_key(state.seat);
+                state.is_walking_backward = backward;
+            }
+        }
+
         void schedule_step(PlayerState& state, int final_tile_index)
         {
             // Only check if steps remaining and not already stepping
@@ -50,8 +71,9 @@ namespace game::player
         }
     }
 
-    void initialize(PlayerState& state, const glm::vec3& start_position, float ground_y, float radius)
+    void initialize(PlayerState& state, const glm::vec3& start_position, float ground_y, float radius, int seat)
     {
+        state.seat = seat;
         state.position = start_position;
         state.position.y = ground_y;
         state.current_tile_index = 0;
@@ -61,9 +83,10 @@ namespace game::player
         state.step_timer = 0.0f;
         state.steps_remaining = 0;
         state.last_dice_result = 0;
-        state.previous_space_state = false;
+        state.is_walking_backward = false;
         state.ground_y = ground_y;
         state.radius = radius;
+        rehash(state);
     }
 
     void roll_dice(PlayerState& state)
@@ -78,7 +101,7 @@ namespace game::player
     {
         // Set the dice result after dice has finished rolling
         state.last_dice_result = result;
-        state.steps_remaining = result;
+        set_steps(state, result);
     }
 
     void warp_to_tile(PlayerState& state, int tile_index)
@@ -86,8 +109,8 @@ namespace game::player
         const int final_tile_index = BOARD_COLUMNS * BOARD_ROWS - 1;
         const int clamped_tile = std::clamp(tile_index, 0, final_tile_index);
 
-        state.current_tile_index = clamped_tile;
-        state.steps_remaining = 0;
+        set_tile(state, clamped_tile);
+        set_steps(state, 0);
         state.last_dice_result = 0;
         state.is_stepping = false;
         state.step_timer = 0.0f;
@@ -125,15 +148,15 @@ namespace game::player
                 {
                     if (state.current_tile_index > 0)
                     {
-                        --state.current_tile_index;
+                        set_tile(state, state.current_tile_index - 1);
                     }
                 }
                 else
                 {
-                    ++state.current_tile_index;
+                    set_tile(state, state.current_tile_index + 1);
                 }
                 
-                --state.steps_remaining;
+                set_steps(state, state.steps_remaining - 1);
                 state.is_stepping = false;
                 // Continue walking if there are steps remaining - use dice result directly
                 if (state.steps_remaining > 0)
@@ -143,7 +166,7 @@ namespace game::player
                 else
                 {
                     // Reset backward flag when done walking
-                    state.is_walking_backward = false;
+                    set_walking_backward(state, false);
                 }
             }
         }
@@ -167,15 +190,36 @@ namespace game::player
 
     void step_backward(PlayerState& state, int steps)
     {
-        state.is_walking_backward = true;
-        state.steps_remaining = steps;
+        set_walking_backward(state, true);
+        set_steps(state, steps);
     }
 
     void skip_turn(PlayerState& state)
     {
-        state.steps_remaining = 0;
+        set_steps(state, 0);
         state.last_dice_result = 0;
-        state.is_walking_backward = false;
+        set_walking_backward(state, false);
+    }
+
+    void add_steps(PlayerState& state, int steps)
+    {
+        set_steps(state, state.steps_remaining + steps);
+    }
+
+    void stop_walking(PlayerState& state)
+    {
+        set_steps(state, 0);
+        state.is_stepping = false;
+    }
+
+    void rehash(PlayerState& state)
+    {
+        state.hash = game::player_tile_key(state.seat, state.current_tile_index) ^
+                     game::player_steps_key(state.seat, state.steps_remaining);
+        if (state.is_walking_backward)
+        {
+            state.hash ^= game::player_backward_key(state.seat);
+        }
     }
 
     int get_current_tile(const PlayerState& state)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace game::player
@@ -14,22 +15,28 @@ namespace game::player
         float step_timer = 0.0f;
         int steps_remaining = 0;
         int last_dice_result = 0;
-        bool previous_space_state = false;
         bool is_walking_backward = false;  // Flag for backward movement
         bool is_ai = false;  // Flag to indicate if this player is AI-controlled
+        int seat = 0;  // Picks this player's state hash keys
+        std::uint64_t hash = 0;  // Zobrist share of tile, steps and direction (see state_hash.h)
         
         float ground_y = 0.0f;
         float radius = 0.4f;
         float step_duration = 0.55f;
     };
 
-    void initialize(PlayerState& state, const glm::vec3& start_position, float ground_y, float radius);
+    void initialize(PlayerState& state, const glm::vec3& start_position, float ground_y, float radius, int seat);
     void update(PlayerState& state, float delta_time, bool space_just_pressed, int final_tile_index, bool can_start_walking = true);
     void roll_dice(PlayerState& state);  // Kept for compatibility, does nothing now
     void set_dice_result(PlayerState& state, int result);  // Set result after dice finishes rolling
     void warp_to_tile(PlayerState& state, int tile_index);
     void step_backward(PlayerState& state, int steps);  // Walk backward by specified number of steps
     void skip_turn(PlayerState& state);  // Skip the current turn
+    // Tile, steps_remaining and is_walking_backward feed the state hash - change
+    // them through these functions rather than assigning the fields
+    void add_steps(PlayerState& state, int steps);  // Bonus / slide / minigame reward
+    void stop_walking(PlayerState& state);  // No steps left and no step in flight
+    void rehash(PlayerState& state);  // Recomputes hash from the fields, e.g. after a restore
     glm::vec3 get_position(const PlayerState& state);
     int get_current_tile(const PlayerState& state);
 }
@@ -0,0 +1,249 @@
+#include "render_benchmark.h"
+
+#include "../game/player/player.h"
+#include "../rendering/gpu_timer.h"
+#include "../rendering/render_target.h"
+#include "../utils/png_writer.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace game
+{
+    namespace
+    {
+        constexpr float SCRIPT_MENU_END = 0.1f;   // Fraction of the run showing the menu
+        constexpr float SCRIPT_BOARD_END = 0.9f;  // ... then the board, then the win screen
+        constexpr float SCRIPT_FPS = 60.0f;       // Animation time step per scripted frame
+        constexpr float SCRIPT_MIN_FOV = 30.0f;
+        constexpr float SCRIPT_MAX_FOV = 85.0f;
+
+        struct TimingSummary
+        {
+            double mean = 0.0;
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double p99 = 0.0;
+            double max = 0.0;
+        };
+
+        TimingSummary summarize(std::vector<double> samples)
+        {
+            TimingSummary summary;
+            if (samples.empty())
+            {
+                return summary;
+            }
+
+            std::sort(samples.begin(), samples.end());
+            const auto percentile = [&samples](double p) {
+                // Nearest rank
+                const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+                return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+            };
+
+            double total = 0.0;
+            for (double sample : samples)
+            {
+                total += sample;
+            }
+            summary.mean = total / static_cast<double>(samples.size());
+            summary.p50 = percentile(0.50);
+            summary.p95 = percentile(0.95);
+            summary.p99 = percentile(0.99);
+            summary.max = samples.back();
+            return summary;
+        }
+
+        void print_summary(const char* label, const TimingSummary& summary)
+        {
+            std::cout << std::fixed << std::setprecision(3)
+                      << label << " ms: mean " << summary.mean << ", p50 " << summary.p50 << ", p95 " << summary.p95
+                      << ", p99 " << summary.p99 << ", max " << summary.max << '\n';
+            std::cout.unsetf(std::ios::floatfield);
+        }
+
+        void place_player(const GameState& game_state, int tile, game::player::PlayerState& player)
+        {
+            game::player::warp_to_tile(player, std::clamp(tile, 0, game_state.final_tile_index));
+        }
+    }
+
+    void build_render_script_frame(const GameState& game_state, int frame, int frame_count,
+                                   RenderSnapshot& snapshot, core::Camera& camera)
+    {
+        capture_render_snapshot(game_state, snapshot);
+
+        const float progress = frame_count > 1 ? static_cast<float>(frame) / static_cast<float>(frame_count - 1) : 0.0f;
+        const int menu_end_frame = static_cast<int>(SCRIPT_MENU_END * static_cast<float>(frame_count));
+        const int board_end_frame = static_cast<int>(SCRIPT_BOARD_END * static_cast<float>(frame_count));
+
+        snapshot.menu_state.is_active = frame < menu_end_frame;
+        snapshot.menu_state.num_players = 2 + frame % 3;
+        snapshot.menu_state.selected_option = (frame / 30) % 2;
+        snapshot.win_state = game::win::WinState{};
+        snapshot.num_players = 4;
+        snapshot.current_player_index = 0;
+        snapshot.minigame_message.clear();
+        snapshot.minigame_message_timer = 0.0f;
+
+        // Camera follows player 1 across the whole board while the others trail behind
+        const float board_progress = std::clamp((progress - SCRIPT_MENU_END) / (SCRIPT_BOARD_END - SCRIPT_MENU_END),
+                                                0.0f, 1.0f);
+        const int lead_tile = static_cast<int>(board_progress * static_cast<float>(game_state.final_tile_index));
+        for (int i = 0; i < 4; ++i)
+        {
+            place_player(game_state, lead_tile - i * game_state.final_tile_index / 4, snapshot.players[i]);
+        }
+
+        // Triangle wave so both extremes of the FOV range are hit several times
+        const float fov_phase = std::fmod(static_cast<float>(frame) / 240.0f, 1.0f);
+        const float fov_blend = fov_phase < 0.5f ? fov_phase * 2.0f : 2.0f - fov_phase * 2.0f;
+        camera.set_fov(SCRIPT_MIN_FOV + (SCRIPT_MAX_FOV - SCRIPT_MIN_FOV) * fov_blend);
+
+        // Dice spinning above the lead player
+        game::player::dice::DiceState& dice = snapshot.dice_state;
+        dice.is_rolling = false;
+        dice.is_falling = false;
+        dice.is_displaying = frame >= menu_end_frame && frame < board_end_frame;
+        dice.position = snapshot.players[0].position + glm::vec3(0.0f, game_state.player_ground_y + 3.0f, 0.0f);
+        dice.rotation = glm::vec3(static_cast<float>(frame) * 7.0f, static_cast<float>(frame) * 5.0f, 0.0f);
+        dice.result = 1 + frame % 6;
+        snapshot.dice_display_timer = dice.is_displaying ? 1.0f : 0.0f;
+
+        if (frame >= board_end_frame)
+        {
+            snapshot.win_state.is_active = true;
+            snapshot.win_state.show_animation = true;
+            snapshot.win_state.animation_timer = static_cast<float>(frame - board_end_frame) / SCRIPT_FPS;
+            snapshot.win_state.winner_player = 1;
+        }
+
+        // No motion between ticks - every scripted frame is its own tick
+        for (int i = 0; i < 4; ++i)
+        {
+            snapshot.interpolation.previous_player_positions[i] = snapshot.players[i].position;
+        }
+        snapshot.interpolation.previous_dice_position = dice.position;
+        snapshot.interpolation.previous_dice_rotation = dice.rotation;
+        snapshot.interpolation.previous_dice_visible = dice.is_displaying;
+        snapshot.tick = static_cast<std::uint64_t>(frame);
+        snapshot.tick_time = static_cast<double>(frame) / SCRIPT_FPS;
+        snapshot.tick_step = 1.0 / SCRIPT_FPS;
+    }
+
+    void run_render_benchmark(const core::Window& window, core::Camera& camera, const GameState& game_state,
+                              Renderer& renderer, const RenderBenchmarkOptions& options)
+    {
+        if (!window.is_offscreen())
+        {
+            throw std::runtime_error("Render benchmark needs an offscreen window");
+        }
+
+        int width = 0;
+        int height = 0;
+        window.get_framebuffer_size(&width, &height);
+
+        RenderTarget target;
+        create_render_target(target, width, height);
+        GpuTimer gpu_timer;
+        initialize_gpu_timer(gpu_timer);
+
+        const bool capture = !options.capture_dir.empty();
+        if (capture)
+        {
+            std::filesystem::create_directories(options.capture_dir);
+            std::cout << "Capturing frames to " << options.capture_dir
+                      << " (readback serialises CPU and GPU, timings will be pessimistic)\n";
+        }
+
+        std::cout << "Rendering " << options.frame_count << " offscreen frames at " << width << "x" << height
+                  << " (" << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << ")" << std::endl;
+
+        // Snapshots are large (minigame strings, animation poses) - keep them off the stack
+        auto snapshot = std::make_unique<RenderSnapshot>();
+        std::vector<double> cpu_ms(static_cast<std::size_t>(std::max(options.frame_count, 0)), 0.0);
+        std::vector<GpuTimerResult> gpu_results;
+        gpu_results.reserve(cpu_ms.size());
+        std::vector<unsigned char> pixels;
+
+        bind_render_target(target);
+        const auto run_start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < options.frame_count; ++frame)
+        {
+            build_render_script_frame(game_state, frame, options.frame_count, *snapshot, camera);
+
+            begin_gpu_timer(gpu_timer, frame, gpu_results);
+            const auto cpu_start = std::chrono::steady_clock::now();
+            renderer.render(window, camera, game_state, *snapshot, 1.0f);
+            cpu_ms[static_cast<std::size_t>(frame)] =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpu_start).count();
+            end_gpu_timer(gpu_timer);
+
+            if (capture)
+            {
+                read_render_target_pixels(target, pixels);
+                std::ostringstream name;
+                name << "frame_" << std::setw(5) << std::setfill('0') << frame << ".png";
+                write_png(options.capture_dir / name.str(), target.width, target.height, pixels);
+            }
+
+            collect_gpu_timer(gpu_timer, gpu_results, false);
+        }
+        glFinish();
+        const double run_seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - run_start).count();
+        collect_gpu_timer(gpu_timer, gpu_results, true);
+
+        std::vector<double> gpu_ms(cpu_ms.size(), -1.0);
+        std::vector<double> gpu_samples;
+        gpu_samples.reserve(gpu_results.size());
+        for (const GpuTimerResult& result : gpu_results)
+        {
+            if (result.frame >= 0 && result.frame < static_cast<std::int64_t>(gpu_ms.size()))
+            {
+                gpu_ms[static_cast<std::size_t>(result.frame)] = result.milliseconds;
+                gpu_samples.push_back(result.milliseconds);
+            }
+        }
+
+        std::cout << "Rendered " << options.frame_count << " frames in " << run_seconds << " s ("
+                  << (run_seconds > 0.0 ? static_cast<double>(options.frame_count) / run_seconds : 0.0) << " fps)\n";
+        print_summary("CPU", summarize(cpu_ms));
+        print_summary("GPU", summarize(gpu_samples));
+
+        if (!options.timings_path.empty())
+        {
+            std::ofstream file(options.timings_path, std::ios::out | std::ios::trunc);
+            if (!file)
+            {
+                std::cerr << "Warning: Failed to write timings to " << options.timings_path << '\n';
+            }
+            else
+            {
+                // gpu_ms is -1 for frames whose query never returned
+                file << "frame,cpu_ms,gpu_ms\n";
+                for (std::size_t i = 0; i < cpu_ms.size(); ++i)
+                {
+                    file << i << ',' << cpu_ms[i] << ',' << gpu_ms[i] << '\n';
+                }
+                std::cout << "Per-frame timings written to " << options.timings_path << '\n';
+            }
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        destroy_gpu_timer(gpu_timer);
+        destroy_render_target(target);
+    }
+}
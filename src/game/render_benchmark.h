@@ -0,0 +1,33 @@
+#pragma once
+
+#include "game_state.h"
+#include "render_snapshot.h"
+#include "renderer.h"
+#include "../core/camera.h"
+#include "../core/window.h"
+
+#include <filesystem>
+
+namespace game
+{
+    struct RenderBenchmarkOptions
+    {
+        int frame_count = 600;
+        std::filesystem::path capture_dir;   // Empty = don't write PNGs
+        std::filesystem::path timings_path;  // Empty = summary only, no per-frame CSV
+    };
+
+    // Scripted, fully deterministic frame `frame` of `frame_count`: the menu over
+    // the board, then four players spread along the board while the camera follows
+    // player 1 from start to finish and the FOV sweeps its whole range, then the
+    // win screen with confetti. Only depends on the assets in game_state.
+    void build_render_script_frame(const GameState& game_state, int frame, int frame_count,
+                                   RenderSnapshot& snapshot, core::Camera& camera);
+
+    // Renders the script into an offscreen target at the window's size as fast as
+    // possible, optionally saving each frame as capture_dir/frame_NNNNN.png, and
+    // prints CPU (render() submission) and GPU (GL_TIME_ELAPSED) frame time
+    // percentiles. The window must have been created with WindowMode::Offscreen.
+    void run_render_benchmark(const core::Window& window, core::Camera& camera, const GameState& game_state,
+                              Renderer& renderer, const RenderBenchmarkOptions& options);
+}
@@ -0,0 +1,61 @@
+#include "render_interpolation.h"
+
+#include "map/board.h"
+#include "player/player.h"
+
+#include <glm/glm.hpp>
+
+namespace game
+{
+    namespace
+    {
+        // Anything that moves further than this in a single tick teleported
+        // (warp, portal, ladder/snake) - snap instead of sliding across the board
+        constexpr float SNAP_DISTANCE = game::map::TILE_SIZE * 1.5f;
+
+        bool is_dice_visible(const game::player::dice::DiceState& dice)
+        {
+            return dice.is_rolling || dice.is_falling || dice.is_displaying;
+        }
+    }
+
+    void store_previous_transforms(GameState& game_state)
+    {
+        auto& interpolation = game_state.interpolation;
+        for (int i = 0; i < static_cast<int>(game_state.players.size()); ++i)
+        {
+            interpolation.previous_player_positions[i] = game::player::get_position(game_state.players[i]);
+        }
+        interpolation.previous_dice_position = game_state.dice_state.position;
+        interpolation.previous_dice_rotation = game_state.dice_state.rotation;
+        interpolation.previous_dice_visible = is_dice_visible(game_state.dice_state);
+    }
+
+    glm::vec3 get_interpolated_player_position(const RenderSnapshot& snapshot, int player_index, float alpha)
+    {
+        const glm::vec3 current = game::player::get_position(snapshot.players[player_index]);
+        const glm::vec3 previous = snapshot.interpolation.previous_player_positions[player_index];
+        if (glm::length(current - previous) > SNAP_DISTANCE)
+        {
+            return current;
+        }
+        return glm::mix(previous, current, alpha);
+    }
+
+    game::player::dice::DiceState get_interpolated_dice_state(const RenderSnapshot& snapshot, float alpha)
+    {
+        game::player::dice::DiceState dice = snapshot.dice_state;
+        const auto& interpolation = snapshot.interpolation;
+
+        // Dice just appeared this tick (start_roll drops it from fall_height) - nothing to blend from
+        if (!interpolation.previous_dice_visible ||
+            glm::length(dice.position - interpolation.previous_dice_position) > SNAP_DISTANCE)
+        {
+            return dice;
+        }
+
+        dice.position = glm::mix(interpolation.previous_dice_position, dice.position, alpha);
+        dice.rotation = glm::mix(interpolation.previous_dice_rotation, dice.rotation, alpha);
+        return dice;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "game_state.h"
+#include "render_snapshot.h"
+
+#include <glm/glm.hpp>
+
+namespace game
+{
+    // Call once at the start of every simulation tick, before anything moves
+    void store_previous_transforms(GameState& game_state);
+
+    // Blended transforms for the renderer (alpha: 0 = previous tick, 1 = current tick)
+    glm::vec3 get_interpolated_player_position(const RenderSnapshot& snapshot, int player_index, float alpha);
+    game::player::dice::DiceState get_interpolated_dice_state(const RenderSnapshot& snapshot, float alpha);
+}
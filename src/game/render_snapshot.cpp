@@ -0,0 +1,40 @@
+#include "render_snapshot.h"
+
+#include <algorithm>
+
+namespace game
+{
+    void capture_render_snapshot(const GameState& game_state, RenderSnapshot& snapshot)
+    {
+        snapshot.players = game_state.players;
+        snapshot.current_player_index = game_state.current_player_index;
+        snapshot.num_players = game_state.num_players;
+        snapshot.player_animations = game_state.player_animations;
+
+        snapshot.dice_state = game_state.dice_state;
+
+        snapshot.minigame_state = game_state.minigame_state;
+        snapshot.tile_memory_state = game_state.tile_memory_state;
+        snapshot.reaction_state = game_state.reaction_state;
+        snapshot.math_state = game_state.math_state;
+        snapshot.pattern_state = game_state.pattern_state;
+
+        snapshot.minigame_message = game_state.minigame_message;
+        snapshot.minigame_message_timer = game_state.minigame_message_timer;
+        snapshot.dice_display_timer = game_state.dice_display_timer;
+        snapshot.debug_warp_state = game_state.debug_warp_state;
+        snapshot.menu_state = game_state.menu_state;
+        snapshot.win_state = game_state.win_state;
+
+        snapshot.interpolation = game_state.interpolation;
+    }
+
+    float get_snapshot_alpha(const RenderSnapshot& snapshot, double now)
+    {
+        if (snapshot.tick_step <= 0.0)
+        {
+            return 1.0f;
+        }
+        return static_cast<float>(std::clamp((now - snapshot.tick_time) / snapshot.tick_step, 0.0, 1.0));
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "game_state.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace game
+{
+    // Copy of everything the renderer needs that the simulation mutates: player
+    // positions, animation poses, dice, minigame/menu state and UI strings.
+    // The simulation fills one per tick and publishes it; the renderer never
+    // touches the live GameState except for assets (map mesh, models, textures)
+    // which are loaded before the simulation starts and never change afterwards.
+    struct RenderSnapshot
+    {
+        // Players
+        std::array<game::player::PlayerState, 4> players{};
+        int current_player_index = 0;
+        int num_players = 2;
+        std::array<AnimationPlayerState, 4> player_animations{};
+
+        // Dice
+        game::player::dice::DiceState dice_state;
+
+        // Minigames
+        game::minigame::PrecisionTimingState minigame_state;
+        game::minigame::tile_memory::TileMemoryState tile_memory_state;
+        game::minigame::ReactionState reaction_state;
+        game::minigame::MathQuizState math_state;
+        game::minigame::PatternMatchingState pattern_state;
+
+        // UI
+        std::string minigame_message;
+        float minigame_message_timer = 0.0f;
+        float dice_display_timer = 0.0f;
+        DebugWarpState debug_warp_state;
+        game::menu::MenuState menu_state;
+        game::win::WinState win_state;
+
+        // Previous-tick transforms for interpolation
+        RenderInterpolation interpolation;
+
+        // Wall-clock time (glfwGetTime) the snapshot's tick corresponds to,
+        // and the tick length - the renderer derives its blend factor from these
+        double tick_time = 0.0;
+        double tick_step = 1.0 / 60.0;
+        std::uint64_t tick = 0;
+    };
+
+    // Copies into an existing snapshot so strings/containers reuse their storage
+    void capture_render_snapshot(const GameState& game_state, RenderSnapshot& snapshot);
+
+    // 0..1 blend factor between the snapshot's previous and current tick at time `now`
+    float get_snapshot_alpha(const RenderSnapshot& snapshot, double now);
+}
@@ -11,9 +11,15 @@
 #include "../game/menu/menu_renderer.h"
 #include "../game/win/win_renderer.h"
 #include "../game/minigame/minigame_menu_renderer.h"
+#include "render_interpolation.h"
+#include "state_hash.h"
 #include "../rendering/text_renderer.h"
 #include "../rendering/mesh.h"
+#include "../rendering/frustum.h"
+#include "../rendering/mesh_lod.h"
 #include "../rendering/animation_player.h"
+#include "../rendering/shader_cache.h"
+#include "../rendering/ui_batch.h"
 
 #include <glad/glad.h>
 #include <iomanip>
@@ -27,49 +33,78 @@ namespace game
 {
     Renderer::Renderer(const RenderState& render_state)
         : m_render_state(render_state)
+        , m_finish_table(game::map::build_finish_table())
     {
     }
 
-    void Renderer::render(const core::Window& window, const core::Camera& camera, const GameState& game_state)
+    void Renderer::render(const core::Window& window, const core::Camera& camera, const GameState& game_state,
+                          const RenderSnapshot& snapshot, float interpolation_alpha)
     {
+        m_interpolation_alpha = interpolation_alpha;
+
         glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         const float aspect_ratio = window.get_aspect_ratio();
         const glm::mat4 projection = camera.get_projection(aspect_ratio);
-        // Use current player's position for camera
-        const auto& current_player = game_state.players[game_state.current_player_index];
-        const glm::vec3 camera_position = get_position(current_player);
+        // Use current player's position for camera (interpolated so the camera doesn't judder between ticks)
+        const glm::vec3 camera_position = get_interpolated_player_position(snapshot, snapshot.current_player_index, m_interpolation_alpha);
         const glm::mat4 view = camera.get_view(camera_position, game_state.map_length);
 
-        glUseProgram(m_render_state.program);
-        glUniform1i(m_render_state.use_texture_location, 0);
+        // Everything drawn in world space below is tested against this first
+        m_frustum = extract_frustum(projection * view);
+        m_cull_stats = CullStats{};
+        m_lod_stats = LodStats{};
+        int framebuffer_width = 0;
+        int framebuffer_height = 0;
+        window.get_framebuffer_size(&framebuffer_width, &framebuffer_height);
+        m_viewport_height = static_cast<float>(std::max(framebuffer_height, 1));
+
+        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
         glBindTexture(GL_TEXTURE_2D, 0);
-        // Reset color override at the start of each frame
-        if (m_render_state.use_color_override_location >= 0)
-        {
-            glUniform1i(m_render_state.use_color_override_location, 0);
-        }
 
         render_map(projection, view, game_state);
-        render_player(projection, view, game_state);
-        render_dice(projection, view, game_state);
-        render_ui(window, game_state);
+        render_player(projection, view, game_state, snapshot);
+        render_dice(projection, view, game_state, snapshot);
+
+        // All 2D overlays record into the UI batch and flush once per layer
+        begin_ui_frame(m_render_state.ui_batch);
+        render_ui(window, snapshot);
 
         // Render menu popup on top if active (transparent background, shows map behind)
-        if (game_state.win_state.is_active)
+        if (snapshot.win_state.is_active)
         {
-            game::win::render_win_screen(window, &m_render_state, game_state.win_state);
+            game::win::render_win_screen(window, &m_render_state, snapshot.win_state);
         }
-        else if (game_state.menu_state.is_active)
+        else if (snapshot.menu_state.is_active)
         {
-            game::menu::render_menu(window, &m_render_state, game_state.menu_state);
+            game::menu::render_menu(window, &m_render_state, snapshot.menu_state);
         }
+        end_ui_frame(m_render_state.ui_batch);
     }
 
     void Renderer::render_map(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state)
     {
-        game::map::render_map(game_state.map_data, projection, view, m_render_state.program, m_render_state.mvp_location);
+        game::map::render_map(game_state.map_data, projection, view, m_render_state.shaders,
+                              m_culling_enabled ? &m_frustum : nullptr, m_cull_stats);
+    }
+
+    int Renderer::select_lod(int& current_lod, const Bounds& local_bounds, const glm::mat4& model,
+                             const glm::mat4& view, const glm::mat4& projection)
+    {
+        const float projected_size = get_projected_size(local_bounds, model, view, projection, m_viewport_height);
+        current_lod = select_mesh_lod(projected_size, current_lod);
+        m_lod_stats.models_per_level[current_lod]++;
+        return current_lod;
+    }
+
+    bool Renderer::is_visible(const Bounds& local_bounds, const glm::mat4& model)
+    {
+        if (!m_culling_enabled)
+        {
+            return true;
+        }
+        return count_visible(m_cull_stats, intersects_frustum(m_frustum, local_bounds, model));
     }
 
     namespace
@@ -102,12 +137,13 @@ namespace game
         }
     }
 
-    void Renderer::render_player(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state)
+    void Renderer::render_player(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state,
+                                 const RenderSnapshot& snapshot)
     {
         // Render all active players
-        for (int i = 0; i < game_state.num_players; ++i)
+        for (int i = 0; i < snapshot.num_players; ++i)
         {
-            const glm::vec3 player_position = get_position(game_state.players[i]);
+            const glm::vec3 player_position = get_interpolated_player_position(snapshot, i, m_interpolation_alpha);
             
             // Determine which model to use: player4 (GLB) for index 3, player3 (GLB) for index 2, player2 (GLB) for index 1, player1 (GLB) for others
             bool use_player4 = (i == 3 && game_state.has_player4_model && !game_state.player4_model_glb.meshes.empty());
@@ -131,15 +167,22 @@ namespace game
                 model = model * model_to_use.base_transform;
                 
                 // Apply animation transforms if available
-                apply_animation_transform(model, game_state.player_animations[i]);
+                apply_animation_transform(model, snapshot.player_animations[i]);
+
+                if (!is_visible(model_to_use.bounds, model))
+                {
+                    continue;
+                }
+                const int lod = select_lod(m_player_lods[i], model_to_use.bounds, model, view, projection);
                 
                 const glm::mat4 mvp = projection * view * model;
-                glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(mvp));
+                set_shader_mvp(m_render_state.shaders, mvp);
                 
                 // Render all meshes in the model
                 for (size_t mesh_idx = 0; mesh_idx < model_to_use.meshes.size(); ++mesh_idx)
                 {
-                    const auto& mesh = model_to_use.meshes[mesh_idx];
+                    const auto& mesh = get_lod_mesh(model_to_use.meshes, model_to_use.lods, mesh_idx, lod);
+                    m_lod_stats.triangles += mesh.index_count / 3;
                     
                     // Use texture if available (use first texture for now, or match to mesh)
                     bool has_texture = !model_to_use.textures.empty();
@@ -150,7 +193,7 @@ namespace game
                         
                         if (texture.id != 0)
                         {
-                            glUniform1i(m_render_state.use_texture_location, 1);
+                            use_shader_variant(m_render_state.shaders, ShaderVariant::Textured);
                             glActiveTexture(GL_TEXTURE0);
                             glBindTexture(GL_TEXTURE_2D, texture.id);
                         }
@@ -163,7 +206,7 @@ namespace game
                     if (!has_texture)
                     {
                         // No texture, use vertex colors (which should be loaded from model)
-                        glUniform1i(m_render_state.use_texture_location, 0);
+                        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                         glBindTexture(GL_TEXTURE_2D, 0);
                     }
                     
@@ -172,7 +215,7 @@ namespace game
                 }
                 
                 // Reset texture state
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                 glBindTexture(GL_TEXTURE_2D, 0);
             }
             else if (use_player3)
@@ -191,15 +234,22 @@ namespace game
                 model = model * model_to_use.base_transform;
                 
                 // Apply animation transforms if available
-                apply_animation_transform(model, game_state.player_animations[i]);
+                apply_animation_transform(model, snapshot.player_animations[i]);
+
+                if (!is_visible(model_to_use.bounds, model))
+                {
+                    continue;
+                }
+                const int lod = select_lod(m_player_lods[i], model_to_use.bounds, model, view, projection);
                 
                 const glm::mat4 mvp = projection * view * model;
-                glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(mvp));
+                set_shader_mvp(m_render_state.shaders, mvp);
                 
                 // Render all meshes in the model
                 for (size_t mesh_idx = 0; mesh_idx < model_to_use.meshes.size(); ++mesh_idx)
                 {
-                    const auto& mesh = model_to_use.meshes[mesh_idx];
+                    const auto& mesh = get_lod_mesh(model_to_use.meshes, model_to_use.lods, mesh_idx, lod);
+                    m_lod_stats.triangles += mesh.index_count / 3;
                     
                     // Use texture if available (use first texture for now, or match to mesh)
                     bool has_texture = !model_to_use.textures.empty();
@@ -210,7 +260,7 @@ namespace game
                         
                         if (texture.id != 0)
                         {
-                            glUniform1i(m_render_state.use_texture_location, 1);
+                            use_shader_variant(m_render_state.shaders, ShaderVariant::Textured);
                             glActiveTexture(GL_TEXTURE0);
                             glBindTexture(GL_TEXTURE_2D, texture.id);
                         }
@@ -223,7 +273,7 @@ namespace game
                     if (!has_texture)
                     {
                         // No texture, use vertex colors (which should be loaded from model)
-                        glUniform1i(m_render_state.use_texture_location, 0);
+                        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                         glBindTexture(GL_TEXTURE_2D, 0);
                     }
                     
@@ -232,7 +282,7 @@ namespace game
                 }
                 
                 // Reset texture state
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                 glBindTexture(GL_TEXTURE_2D, 0);
             }
             else if (use_player2)
@@ -251,15 +301,22 @@ namespace game
                 model = model * model_to_use.base_transform;
                 
                 // Apply animation transforms if available
-                apply_animation_transform(model, game_state.player_animations[i]);
+                apply_animation_transform(model, snapshot.player_animations[i]);
+
+                if (!is_visible(model_to_use.bounds, model))
+                {
+                    continue;
+                }
+                const int lod = select_lod(m_player_lods[i], model_to_use.bounds, model, view, projection);
                 
                 const glm::mat4 mvp = projection * view * model;
-                glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(mvp));
+                set_shader_mvp(m_render_state.shaders, mvp);
                 
                 // Render all meshes in the model
                 for (size_t mesh_idx = 0; mesh_idx < model_to_use.meshes.size(); ++mesh_idx)
                 {
-                    const auto& mesh = model_to_use.meshes[mesh_idx];
+                    const auto& mesh = get_lod_mesh(model_to_use.meshes, model_to_use.lods, mesh_idx, lod);
+                    m_lod_stats.triangles += mesh.index_count / 3;
                     
                     // Use texture if available (use first texture for now, or match to mesh)
                     bool has_texture = !model_to_use.textures.empty();
@@ -270,7 +327,7 @@ namespace game
                         
                         if (texture.id != 0)
                         {
-                            glUniform1i(m_render_state.use_texture_location, 1);
+                            use_shader_variant(m_render_state.shaders, ShaderVariant::Textured);
                             glActiveTexture(GL_TEXTURE0);
                             glBindTexture(GL_TEXTURE_2D, texture.id);
                         }
@@ -283,7 +340,7 @@ namespace game
                     if (!has_texture)
                     {
                         // No texture, use vertex colors (which should be loaded from model)
-                        glUniform1i(m_render_state.use_texture_location, 0);
+                        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                         glBindTexture(GL_TEXTURE_2D, 0);
                     }
                     
@@ -292,7 +349,7 @@ namespace game
                 }
                 
                 // Reset texture state
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                 glBindTexture(GL_TEXTURE_2D, 0);
             }
             else if (use_player1)
@@ -311,15 +368,22 @@ namespace game
                 model = model * model_to_use.base_transform;
                 
                 // Apply animation transforms if available
-                apply_animation_transform(model, game_state.player_animations[i]);
+                apply_animation_transform(model, snapshot.player_animations[i]);
+
+                if (!is_visible(model_to_use.bounds, model))
+                {
+                    continue;
+                }
+                const int lod = select_lod(m_player_lods[i], model_to_use.bounds, model, view, projection);
                 
                 const glm::mat4 mvp = projection * view * model;
-                glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(mvp));
+                set_shader_mvp(m_render_state.shaders, mvp);
                 
                 // Render all meshes in the model
                 for (size_t mesh_idx = 0; mesh_idx < model_to_use.meshes.size(); ++mesh_idx)
                 {
-                    const auto& mesh = model_to_use.meshes[mesh_idx];
+                    const auto& mesh = get_lod_mesh(model_to_use.meshes, model_to_use.lods, mesh_idx, lod);
+                    m_lod_stats.triangles += mesh.index_count / 3;
                     
                     // Use texture if available
                     bool has_texture = !model_to_use.textures.empty();
@@ -330,13 +394,9 @@ namespace game
                         
                         if (texture.id != 0)
                         {
-                            glUniform1i(m_render_state.use_texture_location, 1);
+                            use_shader_variant(m_render_state.shaders, ShaderVariant::Textured);
                             glActiveTexture(GL_TEXTURE0);
                             glBindTexture(GL_TEXTURE_2D, texture.id);
-                            if (m_render_state.use_color_override_location >= 0)
-                            {
-                                glUniform1i(m_render_state.use_color_override_location, 0);
-                            }
                             has_texture = true;
                         }
                         else
@@ -347,12 +407,8 @@ namespace game
                     
                     if (!has_texture)
                     {
-                        glUniform1i(m_render_state.use_texture_location, 0);
+                        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                         glBindTexture(GL_TEXTURE_2D, 0);
-                        if (m_render_state.use_color_override_location >= 0)
-                        {
-                            glUniform1i(m_render_state.use_color_override_location, 0);
-                        }
                     }
                     
                     glBindVertexArray(mesh.vao);
@@ -360,127 +416,138 @@ namespace game
                 }
                 
                 // Reset texture state
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
                 glBindTexture(GL_TEXTURE_2D, 0);
-                if (m_render_state.use_color_override_location >= 0)
-                {
-                    glUniform1i(m_render_state.use_color_override_location, 0);
-                }
             }
             else
             {
                 // Fallback to sphere
                 const glm::mat4 model = glm::translate(glm::mat4(1.0f), player_position);
+                if (!is_visible(game_state.sphere_mesh.bounds, model))
+                {
+                    continue;
+                }
                 const glm::mat4 mvp = projection * view * model;
-                glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(mvp));
+                set_shader_mvp(m_render_state.shaders, mvp);
                 glBindVertexArray(game_state.sphere_mesh.vao);
                 glDrawElements(GL_TRIANGLES, game_state.sphere_mesh.index_count, GL_UNSIGNED_INT, nullptr);
             }
         }
     }
 
-    void Renderer::render_dice(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state)
+    void Renderer::render_dice(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state,
+                                 const RenderSnapshot& snapshot)
     {
-        if (!(game_state.dice_state.is_rolling || game_state.dice_state.is_falling || game_state.dice_state.is_displaying))
+        if (!(snapshot.dice_state.is_rolling || snapshot.dice_state.is_falling || snapshot.dice_state.is_displaying))
         {
             return;
         }
 
         const std::vector<Mesh>* dice_meshes = nullptr;
+        const MeshLodChain* dice_lods = nullptr;
+        const Bounds* dice_bounds = nullptr;  // Union of every dice mesh, merged at load
         if (game_state.has_dice_model)
         {
             if (game_state.is_obj_format)
             {
                 if (!game_state.dice_model_obj.meshes.empty())
+                {
                     dice_meshes = &game_state.dice_model_obj.meshes;
+                    dice_lods = &game_state.dice_model_obj.lods;
+                    dice_bounds = &game_state.dice_model_obj.bounds;
+                }
             }
             else
             {
                 if (!game_state.dice_model_glb.meshes.empty())
+                {
                     dice_meshes = &game_state.dice_model_glb.meshes;
+                    dice_lods = &game_state.dice_model_glb.lods;
+                    dice_bounds = &game_state.dice_model_glb.bounds;
+                }
             }
         }
 
         if (dice_meshes && !dice_meshes->empty())
         {
-            glm::vec3 render_pos = game_state.dice_state.position;
-            if (game_state.dice_state.is_displaying && !game_state.dice_state.is_falling)
+            // Blend between the last two simulation ticks
+            game::player::dice::DiceState temp_dice_state = get_interpolated_dice_state(snapshot, m_interpolation_alpha);
+            if (temp_dice_state.is_displaying && !temp_dice_state.is_falling)
             {
-                render_pos.y += game_state.dice_state.scale * 0.3f;
+                temp_dice_state.position.y += temp_dice_state.scale * 0.3f;
             }
-
-            game::player::dice::DiceState temp_dice_state = game_state.dice_state;
-            temp_dice_state.position = render_pos;
             glm::mat4 dice_transform = game::player::dice::get_transform(temp_dice_state);
+            if (!is_visible(*dice_bounds, dice_transform))
+            {
+                return;
+            }
+            const int lod = select_lod(m_dice_lod, *dice_bounds, dice_transform, view, projection);
 
             const glm::mat4 dice_mvp = projection * view * dice_transform;
 
             glEnable(GL_POLYGON_OFFSET_FILL);
             glPolygonOffset(-1.0f, -1.0f);
 
-            glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(dice_mvp));
+            set_shader_mvp(m_render_state.shaders, dice_mvp);
 
             if (game_state.has_dice_texture && game_state.dice_texture.id != 0)
             {
-                glUniform1i(m_render_state.use_texture_location, 1);
-                if (m_render_state.dice_texture_mode_location >= 0)
-                {
-                    glUniform1i(m_render_state.dice_texture_mode_location, 1);
-                }
-                glUniform1i(m_render_state.texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::Dice);
                 glActiveTexture(GL_TEXTURE0);
                 glBindTexture(GL_TEXTURE_2D, game_state.dice_texture.id);
             }
             else
             {
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
             }
 
-            glBindVertexArray((*dice_meshes)[0].vao);
-            glDrawElements(GL_TRIANGLES, (*dice_meshes)[0].index_count, GL_UNSIGNED_INT, nullptr);
+            // Every mesh of the model, so what is drawn matches the bounds it was culled by
+            for (std::size_t mesh_index = 0; mesh_index < dice_meshes->size(); ++mesh_index)
+            {
+                const Mesh& dice_mesh = get_lod_mesh(*dice_meshes, *dice_lods, mesh_index, lod);
+                m_lod_stats.triangles += dice_mesh.index_count / 3;
+                glBindVertexArray(dice_mesh.vao);
+                glDrawElements(GL_TRIANGLES, dice_mesh.index_count, GL_UNSIGNED_INT, nullptr);
+            }
 
             if (game_state.has_dice_texture)
             {
                 glBindTexture(GL_TEXTURE_2D, 0);
-                if (m_render_state.dice_texture_mode_location >= 0)
-                {
-                    glUniform1i(m_render_state.dice_texture_mode_location, 0);
-                }
-                glUniform1i(m_render_state.use_texture_location, 0);
+                use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
             }
 
             glDisable(GL_POLYGON_OFFSET_FILL);
         }
     }
 
-    void Renderer::render_ui(const core::Window& window, const GameState& game_state)
+    void Renderer::render_ui(const core::Window& window, const RenderSnapshot& snapshot)
     {
-        const bool precision_running = game::minigame::is_running(game_state.minigame_state);
-        const bool tile_memory_active = game::minigame::tile_memory::is_active(game_state.tile_memory_state);
-        const bool reaction_running = game::minigame::is_running(game_state.reaction_state);
-        const bool reaction_has_result = game::minigame::is_success(game_state.reaction_state) || 
-                                         game::minigame::is_failure(game_state.reaction_state);
-        const bool math_running = game::minigame::is_running(game_state.math_state);
-        const bool math_has_result = game::minigame::is_success(game_state.math_state) || 
-                                     game::minigame::is_failure(game_state.math_state);
-        const bool pattern_running = game::minigame::is_running(game_state.pattern_state);
-        const bool pattern_has_result = game::minigame::is_success(game_state.pattern_state) || 
-                                         game::minigame::is_failure(game_state.pattern_state);
-        const bool precision_showing_time = game_state.minigame_state.is_showing_time;
-        const bool precision_has_result = game::minigame::is_success(game_state.minigame_state) || 
-                                         game::minigame::is_failure(game_state.minigame_state);
-        const auto& current_player = game_state.players[game_state.current_player_index];
+        const bool precision_running = game::minigame::is_running(snapshot.minigame_state);
+        const bool tile_memory_active = game::minigame::tile_memory::is_active(snapshot.tile_memory_state);
+        const bool reaction_running = game::minigame::is_running(snapshot.reaction_state);
+        const bool reaction_has_result = game::minigame::is_success(snapshot.reaction_state) || 
+                                         game::minigame::is_failure(snapshot.reaction_state);
+        const bool math_running = game::minigame::is_running(snapshot.math_state);
+        const bool math_has_result = game::minigame::is_success(snapshot.math_state) || 
+                                     game::minigame::is_failure(snapshot.math_state);
+        const bool pattern_running = game::minigame::is_running(snapshot.pattern_state);
+        const bool pattern_has_result = game::minigame::is_success(snapshot.pattern_state) || 
+                                         game::minigame::is_failure(snapshot.pattern_state);
+        const bool precision_showing_time = snapshot.minigame_state.is_showing_time;
+        const bool precision_has_result = game::minigame::is_success(snapshot.minigame_state) || 
+                                         game::minigame::is_failure(snapshot.minigame_state);
+        const auto& current_player = snapshot.players[snapshot.current_player_index];
         
         // Check if player can roll dice (to show "SPACE!" prompt)
         // Don't show when menu or win screen is active, or when current player is AI
-        const bool can_roll_dice = !game_state.menu_state.is_active &&
-                                  !game_state.win_state.is_active &&
+        const bool can_roll_dice = !snapshot.menu_state.is_active &&
+                                  !snapshot.win_state.is_active &&
                                   !current_player.is_ai &&  // Don't show for AI players
                                   !current_player.is_stepping && 
                                   current_player.steps_remaining == 0 && 
-                                  !game_state.dice_state.is_rolling && 
-                                  !game_state.dice_state.is_falling && 
-                                  !game_state.dice_state.is_displaying &&
+                                  !snapshot.dice_state.is_rolling && 
+                                  !snapshot.dice_state.is_falling && 
+                                  !snapshot.dice_state.is_displaying &&
                                   !precision_running &&
                                   !tile_memory_active &&
                                   !reaction_running &&
@@ -488,9 +555,9 @@ namespace game
                                   !pattern_running &&
                                   current_player.last_dice_result == 0;
         
-        const bool show_ui_overlay = game_state.dice_state.is_displaying || 
-                                    game_state.dice_state.is_rolling ||
-                                    game_state.dice_state.is_falling ||
+        const bool show_ui_overlay = snapshot.dice_state.is_displaying || 
+                                    snapshot.dice_state.is_rolling ||
+                                    snapshot.dice_state.is_falling ||
                                     current_player.steps_remaining > 0 || 
                                     precision_running ||
                                     precision_showing_time ||
@@ -502,12 +569,15 @@ namespace game
                                     math_has_result ||
                                     pattern_running ||
                                     pattern_has_result ||
-                                    game_state.debug_warp_state.active || 
-                                    game_state.debug_warp_state.notification_timer > 0.0f ||
-                                    game_state.minigame_message_timer > 0.0f ||
+                                    snapshot.debug_warp_state.active || 
+                                    snapshot.debug_warp_state.notification_timer > 0.0f ||
+                                    snapshot.minigame_message_timer > 0.0f ||
                                     can_roll_dice;  // Show UI when player can roll dice
 
-        if (game_state.minigame_message_timer <= 0.0f && !show_ui_overlay)
+        const bool show_odds = !snapshot.menu_state.is_active && !snapshot.win_state.is_active &&
+                               snapshot.num_players >= 2;
+
+        if (snapshot.minigame_message_timer <= 0.0f && !show_ui_overlay && !show_odds)
         {
             return;
         }
@@ -519,15 +589,7 @@ namespace game
                                                 static_cast<float>(window_height), 0.0f, -1.0f, 1.0f);
         glm::mat4 identity_view = glm::mat4(1.0f);
         glm::mat4 ui_mvp = ortho_projection * identity_view;
-
-        glUseProgram(m_render_state.program);
-        glUniformMatrix4fv(m_render_state.mvp_location, 1, GL_FALSE, glm::value_ptr(ui_mvp));
-        glUniform1i(m_render_state.use_texture_location, 1);
-        if (m_render_state.dice_texture_mode_location >= 0)
-        {
-            glUniform1i(m_render_state.dice_texture_mode_location, 0);
-        }
-        glActiveTexture(GL_TEXTURE0);
+        UiBatch& ui = m_render_state.ui_batch;
 
         glDisable(GL_DEPTH_TEST);
         glEnable(GL_BLEND);
@@ -540,7 +602,7 @@ namespace game
         const float ui_title_scale = 2.0f;  // Smaller scale for game titles
 
         // Check if minigame is showing title screen - render menu
-        if (game_state.minigame_state.status == game::minigame::PrecisionTimingStatus::ShowingTitle)
+        if (snapshot.minigame_state.status == game::minigame::PrecisionTimingStatus::ShowingTitle)
         {
             game::minigame::menu::render_minigame_menu(window, &m_render_state,
                 "PRECISION TIMING GAME",
@@ -549,7 +611,7 @@ namespace game
                 6);
             return;
         }
-        else if (game_state.tile_memory_state.phase == game::minigame::tile_memory::Phase::ShowingTitle)
+        else if (snapshot.tile_memory_state.phase == game::minigame::tile_memory::Phase::ShowingTitle)
         {
             game::minigame::menu::render_minigame_menu(window, &m_render_state,
                 "TILE MEMORY GAME",
@@ -558,7 +620,7 @@ namespace game
                 4);
             return;
         }
-        else if (game_state.reaction_state.phase == game::minigame::ReactionState::Phase::ShowingTitle)
+        else if (snapshot.reaction_state.phase == game::minigame::ReactionState::Phase::ShowingTitle)
         {
             game::minigame::menu::render_minigame_menu(window, &m_render_state,
                 "NUMBER GUESSING GAME",
@@ -567,7 +629,7 @@ namespace game
                 3);
             return;
         }
-        else if (game_state.math_state.phase == game::minigame::MathQuizState::Phase::ShowingTitle)
+        else if (snapshot.math_state.phase == game::minigame::MathQuizState::Phase::ShowingTitle)
         {
             game::minigame::menu::render_minigame_menu(window, &m_render_state,
                 "MATH QUIZ",
@@ -576,7 +638,7 @@ namespace game
                 4);
             return;
         }
-        else if (game_state.pattern_state.phase == game::minigame::PatternMatchingState::Phase::ShowingTitle)
+        else if (snapshot.pattern_state.phase == game::minigame::PatternMatchingState::Phase::ShowingTitle)
         {
             game::minigame::menu::render_minigame_menu(window, &m_render_state,
                 "PATTERN MATCHING",
@@ -587,34 +649,34 @@ namespace game
         }
 
         // Priority order for UI display
-        if (game_state.minigame_state.is_showing_time)
+        if (snapshot.minigame_state.is_showing_time)
         {
-            std::string time_text = game::minigame::get_display_text(game_state.minigame_state);
+            std::string time_text = game::minigame::get_display_text(snapshot.minigame_state);
             glm::vec3 timing_color = {0.9f, 0.9f, 0.3f};
             // Show (space) in green when showing time
             float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
             const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
             const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-            render_text(m_render_state.text_renderer, time_text, center_x, top_y, ui_primary_scale, timing_color);
-            render_text(m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
+            add_ui_text(ui, m_render_state.text_renderer, time_text, center_x, top_y, ui_primary_scale, timing_color);
+            add_ui_text(ui, m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
         }
-        else if (!game_state.minigame_state.is_showing_time && 
-                 (game::minigame::is_success(game_state.minigame_state) || 
-                  game::minigame::is_failure(game_state.minigame_state)))
+        else if (!snapshot.minigame_state.is_showing_time && 
+                 (game::minigame::is_success(snapshot.minigame_state) || 
+                  game::minigame::is_failure(snapshot.minigame_state)))
         {
-            std::string result_text = game::minigame::get_display_text(game_state.minigame_state);
-            glm::vec3 result_color = game::minigame::is_success(game_state.minigame_state) ?
+            std::string result_text = game::minigame::get_display_text(snapshot.minigame_state);
+            glm::vec3 result_color = game::minigame::is_success(snapshot.minigame_state) ?
                 glm::vec3(0.2f, 1.0f, 0.4f) : glm::vec3(1.0f, 0.3f, 0.3f);
-            render_text(m_render_state.text_renderer, result_text, center_x, top_y, ui_primary_scale, result_color);
+            add_ui_text(ui, m_render_state.text_renderer, result_text, center_x, top_y, ui_primary_scale, result_color);
         }
         else if (tile_memory_active)
         {
-            std::string memory_text = game::minigame::tile_memory::get_display_text(game_state.tile_memory_state);
+            std::string memory_text = game::minigame::tile_memory::get_display_text(snapshot.tile_memory_state);
             glm::vec3 memory_color = glm::vec3(0.9f, 0.9f, 0.3f);
-            bool is_result = game::minigame::tile_memory::is_result(game_state.tile_memory_state);
+            bool is_result = game::minigame::tile_memory::is_result(snapshot.tile_memory_state);
             if (is_result)
             {
-                if (game::minigame::tile_memory::is_success(game_state.tile_memory_state))
+                if (game::minigame::tile_memory::is_success(snapshot.tile_memory_state))
                 {
                     memory_color = glm::vec3(0.2f, 1.0f, 0.4f);
                 }
@@ -638,48 +700,48 @@ namespace game
                 float line_height = ui_title_scale * 50.0f;  // Approximate line height
                 glm::vec3 game_name_color = glm::vec3(0.9f, 0.9f, 0.3f);  // Yellow color for game name
                 glm::vec3 bonus_color = glm::vec3(0.2f, 1.0f, 0.4f);  // Green color for bonus
-                render_text(m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
-                render_text(m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
+                add_ui_text(ui, m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
+                add_ui_text(ui, m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
             }
-            else if (!is_result && game_state.tile_memory_state.phase == game::minigame::tile_memory::Phase::WaitingInput)
+            else if (!is_result && snapshot.tile_memory_state.phase == game::minigame::tile_memory::Phase::WaitingInput)
             {
                 // Show (space) in green only when waiting for input
                 float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
                 const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
                 const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-                render_text(m_render_state.text_renderer, memory_text, center_x, top_y, ui_secondary_scale, memory_color);
-                render_text(m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
+                add_ui_text(ui, m_render_state.text_renderer, memory_text, center_x, top_y, ui_secondary_scale, memory_color);
+                add_ui_text(ui, m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
             }
             else
             {
-                render_text(m_render_state.text_renderer, memory_text, center_x, top_y, ui_primary_scale, memory_color);
+                add_ui_text(ui, m_render_state.text_renderer, memory_text, center_x, top_y, ui_primary_scale, memory_color);
             }
         }
-        else if (game_state.debug_warp_state.active)
+        else if (snapshot.debug_warp_state.active)
         {
             std::string prompt = "wrap to ";
-            prompt += game_state.debug_warp_state.buffer.empty() ? "_" : game_state.debug_warp_state.buffer;
+            prompt += snapshot.debug_warp_state.buffer.empty() ? "_" : snapshot.debug_warp_state.buffer;
             prompt += " [enter]";
             glm::vec3 debug_color = {0.3f, 0.85f, 1.0f};
-            render_text(m_render_state.text_renderer, prompt, center_x, top_y, ui_secondary_scale, debug_color);
+            add_ui_text(ui, m_render_state.text_renderer, prompt, center_x, top_y, ui_secondary_scale, debug_color);
         }
-        else if (game_state.debug_warp_state.notification_timer > 0.0f && !game_state.debug_warp_state.notification.empty())
+        else if (snapshot.debug_warp_state.notification_timer > 0.0f && !snapshot.debug_warp_state.notification.empty())
         {
             glm::vec3 debug_color = {0.3f, 0.85f, 1.0f};
-            render_text(m_render_state.text_renderer, game_state.debug_warp_state.notification, 
+            add_ui_text(ui, m_render_state.text_renderer, snapshot.debug_warp_state.notification, 
                        center_x, top_y, ui_secondary_scale, debug_color);
         }
         else if (pattern_running || pattern_has_result)
         {
-            std::string pattern_text = game::minigame::get_display_text(game_state.pattern_state);
+            std::string pattern_text = game::minigame::get_display_text(snapshot.pattern_state);
             glm::vec3 pattern_color = {0.9f, 0.9f, 0.3f};
-            bool is_result = game::minigame::is_success(game_state.pattern_state) || 
-                            game::minigame::is_failure(game_state.pattern_state);
-            if (game::minigame::is_success(game_state.pattern_state))
+            bool is_result = game::minigame::is_success(snapshot.pattern_state) || 
+                            game::minigame::is_failure(snapshot.pattern_state);
+            if (game::minigame::is_success(snapshot.pattern_state))
             {
                 pattern_color = glm::vec3(0.2f, 1.0f, 0.4f);
             }
-            else if (game::minigame::is_failure(game_state.pattern_state))
+            else if (game::minigame::is_failure(snapshot.pattern_state))
             {
                 pattern_color = glm::vec3(1.0f, 0.3f, 0.3f);
             }
@@ -698,8 +760,8 @@ namespace game
                 float line_height = ui_title_scale * 50.0f;  // Approximate line height
                 glm::vec3 game_name_color = glm::vec3(0.9f, 0.9f, 0.3f);  // Yellow color for game name
                 glm::vec3 bonus_color = glm::vec3(0.2f, 1.0f, 0.4f);  // Green color for bonus
-                render_text(m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
-                render_text(m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
+                add_ui_text(ui, m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
+                add_ui_text(ui, m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
             }
             else if (!is_result && pattern_text.find("Input:") != std::string::npos)
             {
@@ -707,17 +769,17 @@ namespace game
                 float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
                 const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
                 const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-                render_text(m_render_state.text_renderer, pattern_text, center_x, top_y, ui_secondary_scale, pattern_color);
-                render_text(m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
+                add_ui_text(ui, m_render_state.text_renderer, pattern_text, center_x, top_y, ui_secondary_scale, pattern_color);
+                add_ui_text(ui, m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
             }
             else
             {
-                render_text(m_render_state.text_renderer, pattern_text, center_x, top_y, ui_secondary_scale, pattern_color);
+                add_ui_text(ui, m_render_state.text_renderer, pattern_text, center_x, top_y, ui_secondary_scale, pattern_color);
             }
         }
-        else if (game_state.minigame_message_timer > 0.0f && !game_state.minigame_message.empty())
+        else if (snapshot.minigame_message_timer > 0.0f && !snapshot.minigame_message.empty())
         {
-            std::string display_msg = game_state.minigame_message;
+            std::string display_msg = snapshot.minigame_message;
             glm::vec3 msg_color;
             if (display_msg.find("โบนัส") != std::string::npos || 
                 display_msg.find("+6") != std::string::npos ||
@@ -730,11 +792,11 @@ namespace game
             {
                 msg_color = glm::vec3(1.0f, 0.3f, 0.3f);
             }
-            render_text(m_render_state.text_renderer, display_msg, center_x, top_y, ui_primary_scale, msg_color);
+            add_ui_text(ui, m_render_state.text_renderer, display_msg, center_x, top_y, ui_primary_scale, msg_color);
         }
         else if (reaction_running || reaction_has_result)
         {
-            std::string reaction_text = game::minigame::get_display_text(game_state.reaction_state);
+            std::string reaction_text = game::minigame::get_display_text(snapshot.reaction_state);
             
             // Skip displaying if text contains "Bonus" (title screen text)
             size_t bonus_pos = reaction_text.find("Bonus");
@@ -745,11 +807,11 @@ namespace game
             }
             
             glm::vec3 reaction_color = {0.9f, 0.9f, 0.3f};
-            if (game::minigame::is_success(game_state.reaction_state))
+            if (game::minigame::is_success(snapshot.reaction_state))
             {
                 reaction_color = glm::vec3(0.2f, 1.0f, 0.4f);
             }
-            else if (game::minigame::is_failure(game_state.reaction_state))
+            else if (game::minigame::is_failure(snapshot.reaction_state))
             {
                 reaction_color = glm::vec3(1.0f, 0.3f, 0.3f);
             }
@@ -763,25 +825,25 @@ namespace game
                 float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
                 const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
                 const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-                render_text(m_render_state.text_renderer, input_line, center_x, top_y, ui_secondary_scale, reaction_color);
-                render_text(m_render_state.text_renderer, space_line, center_x, top_y + line_height, space_scale, green_color);
+                add_ui_text(ui, m_render_state.text_renderer, input_line, center_x, top_y, ui_secondary_scale, reaction_color);
+                add_ui_text(ui, m_render_state.text_renderer, space_line, center_x, top_y + line_height, space_scale, green_color);
             }
             else
             {
-                render_text(m_render_state.text_renderer, reaction_text, center_x, top_y, ui_secondary_scale, reaction_color);
+                add_ui_text(ui, m_render_state.text_renderer, reaction_text, center_x, top_y, ui_secondary_scale, reaction_color);
             }
         }
         else if (math_running || math_has_result)
         {
-            std::string math_text = game::minigame::get_display_text(game_state.math_state);
+            std::string math_text = game::minigame::get_display_text(snapshot.math_state);
             glm::vec3 math_color = {0.9f, 0.9f, 0.3f};
-            bool is_result = game::minigame::is_success(game_state.math_state) || 
-                            game::minigame::is_failure(game_state.math_state);
-            if (game::minigame::is_success(game_state.math_state))
+            bool is_result = game::minigame::is_success(snapshot.math_state) || 
+                            game::minigame::is_failure(snapshot.math_state);
+            if (game::minigame::is_success(snapshot.math_state))
             {
                 math_color = glm::vec3(0.2f, 1.0f, 0.4f);
             }
-            else if (game::minigame::is_failure(game_state.math_state))
+            else if (game::minigame::is_failure(snapshot.math_state))
             {
                 math_color = glm::vec3(1.0f, 0.3f, 0.3f);
             }
@@ -800,8 +862,8 @@ namespace game
                 float line_height = ui_title_scale * 50.0f;  // Approximate line height
                 glm::vec3 game_name_color = glm::vec3(0.9f, 0.9f, 0.3f);  // Yellow color for game name
                 glm::vec3 bonus_color = glm::vec3(0.2f, 1.0f, 0.4f);  // Green color for bonus
-                render_text(m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
-                render_text(m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
+                add_ui_text(ui, m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
+                add_ui_text(ui, m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
             }
             else if (!is_result && math_text.find("=") != std::string::npos)
             {
@@ -809,20 +871,20 @@ namespace game
                 float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
                 const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
                 const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-                render_text(m_render_state.text_renderer, math_text, center_x, top_y, ui_secondary_scale, math_color);
-                render_text(m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
+                add_ui_text(ui, m_render_state.text_renderer, math_text, center_x, top_y, ui_secondary_scale, math_color);
+                add_ui_text(ui, m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
             }
             else
             {
-                render_text(m_render_state.text_renderer, math_text, center_x, top_y, ui_secondary_scale, math_color);
+                add_ui_text(ui, m_render_state.text_renderer, math_text, center_x, top_y, ui_secondary_scale, math_color);
             }
         }
         else if (precision_running)
         {
-            std::string timing_text = game::minigame::get_display_text(game_state.minigame_state);
+            std::string timing_text = game::minigame::get_display_text(snapshot.minigame_state);
             glm::vec3 timing_color = {0.9f, 0.9f, 0.3f};
-            bool is_result = game::minigame::is_success(game_state.minigame_state) || 
-                            game::minigame::is_failure(game_state.minigame_state);
+            bool is_result = game::minigame::is_success(snapshot.minigame_state) || 
+                            game::minigame::is_failure(snapshot.minigame_state);
             
             // Check if text contains "Bonus" - split into two lines
             size_t bonus_pos = timing_text.find("Bonus");
@@ -838,38 +900,38 @@ namespace game
                 float line_height = ui_title_scale * 50.0f;  // Approximate line height
                 glm::vec3 game_name_color = glm::vec3(0.9f, 0.9f, 0.3f);  // Yellow color for game name
                 glm::vec3 bonus_color = glm::vec3(0.2f, 1.0f, 0.4f);  // Green color for bonus
-                render_text(m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
-                render_text(m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
+                add_ui_text(ui, m_render_state.text_renderer, game_name, center_x, top_y, ui_title_scale, game_name_color);
+                add_ui_text(ui, m_render_state.text_renderer, bonus_text, center_x, top_y + line_height, ui_title_scale, bonus_color);
             }
-            else if (!is_result && !game_state.minigame_state.is_showing_time && timing_text.find("4.99:") != std::string::npos)
+            else if (!is_result && !snapshot.minigame_state.is_showing_time && timing_text.find("4.99:") != std::string::npos)
             {
                 // Show (space) in green when running (showing timer, not result)
                 float line_height = ui_title_scale * 70.0f;  // Increased spacing for (space) line
                 const float space_scale = ui_secondary_scale * 0.8f;  // Smaller scale for (space) line
                 const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color for (space)
-                render_text(m_render_state.text_renderer, timing_text, center_x, top_y, ui_secondary_scale, timing_color);
-                render_text(m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
+                add_ui_text(ui, m_render_state.text_renderer, timing_text, center_x, top_y, ui_secondary_scale, timing_color);
+                add_ui_text(ui, m_render_state.text_renderer, "(space)", center_x, top_y + line_height, space_scale, green_color);
             }
             else
             {
-                render_text(m_render_state.text_renderer, timing_text, center_x, top_y, ui_secondary_scale, timing_color);
+                add_ui_text(ui, m_render_state.text_renderer, timing_text, center_x, top_y, ui_secondary_scale, timing_color);
             }
         }
-        else if (game_state.dice_display_timer > 0.0f && game_state.dice_state.result > 0)
+        else if (snapshot.dice_display_timer > 0.0f && snapshot.dice_state.result > 0)
         {
-            std::string dice_text = std::to_string(game_state.dice_state.result);
+            std::string dice_text = std::to_string(snapshot.dice_state.result);
             glm::vec3 text_color(1.0f, 1.0f, 0.0f);
-            render_text(m_render_state.text_renderer, dice_text, center_x, top_y, ui_primary_scale, text_color);
+            add_ui_text(ui, m_render_state.text_renderer, dice_text, center_x, top_y, ui_primary_scale, text_color);
             
             // Show current player info if multiple players
-            if (game_state.num_players > 1)
+            if (snapshot.num_players > 1)
             {
                 std::ostringstream player_info;
-                player_info << "Player " << (game_state.current_player_index + 1) << "/" << game_state.num_players;
+                player_info << "Player " << (snapshot.current_player_index + 1) << "/" << snapshot.num_players;
                 const float player_info_scale = ui_secondary_scale * 0.6f;
                 const float player_info_y = top_y + ui_title_scale * 80.0f;
                 const glm::vec3 player_info_color(0.7f, 0.7f, 1.0f);  // Light blue
-                render_text(m_render_state.text_renderer, player_info.str(), center_x, player_info_y, player_info_scale, player_info_color);
+                add_ui_text(ui, m_render_state.text_renderer, player_info.str(), center_x, player_info_y, player_info_scale, player_info_color);
             }
         }
         else if (can_roll_dice)
@@ -877,17 +939,63 @@ namespace game
             // Show "SPACE!" in green when player can roll dice
             const float space_scale = ui_primary_scale * 1.2f;  // Larger scale for "SPACE!"
             const glm::vec3 green_color(0.2f, 1.0f, 0.4f);  // Green color
-            render_text(m_render_state.text_renderer, "SPACE!", center_x, top_y, space_scale, green_color);
+            add_ui_text(ui, m_render_state.text_renderer, "SPACE!", center_x, top_y, space_scale, green_color);
         }
 
+        if (show_odds)
+        {
+            render_win_odds(ui, snapshot, static_cast<float>(window_width), static_cast<float>(window_height));
+        }
+
+        flush_ui_layer(ui, m_render_state.shaders, m_render_state.text_renderer, ui_mvp);
+
         glDisable(GL_BLEND);
         glEnable(GL_DEPTH_TEST);
-        glUniform1i(m_render_state.use_texture_location, 0);
-        if (m_render_state.dice_texture_mode_location >= 0)
+        use_shader_variant(m_render_state.shaders, ShaderVariant::VertexColor);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void Renderer::render_win_odds(UiBatch& ui, const RenderSnapshot& snapshot, float window_width, float window_height)
+    {
+        const int num_players = std::clamp(snapshot.num_players, 2, 4);
+        const std::uint64_t hash = hash_turn_state(snapshot.players.data(), num_players, snapshot.current_player_index);
+        // A walking player is only passing through its tile; the odds from
+        // before the roll stay up until the walk has ended
+        bool walking = false;
+        for (int i = 0; i < num_players; ++i)
         {
-            glUniform1i(m_render_state.dice_texture_mode_location, 0);
+            walking = walking || snapshot.players[i].steps_remaining > 0;
+        }
+        if (!m_odds_valid || (hash != m_odds_hash && !walking))
+        {
+            std::array<int, 4> tiles{};
+            for (int i = 0; i < num_players; ++i)
+            {
+                tiles[i] = snapshot.players[i].current_tile_index;
+            }
+            m_odds = game::map::compute_win_odds(m_finish_table, tiles, num_players, snapshot.current_player_index);
+            m_odds_hash = hash;
+            m_odds_valid = true;
+        }
+
+        const float odds_scale = 1.2f;
+        const float odds_y = window_height * 0.94f;
+        const glm::vec3 current_color(1.0f, 0.9f, 0.3f);  // Yellow for the player to move
+        const glm::vec3 other_color(0.7f, 0.7f, 1.0f);    // Light blue like the player info line
+        const glm::vec3 caption_color(0.7f, 0.7f, 0.7f);
+
+        // The odds are an estimate (see win_odds.h), so they always say so
+        const char* caption = m_finish_table.approximate ? "Estimated win odds (some tile effects not modelled)"
+                                                         : "Estimated win odds";
+        add_ui_text(ui, m_render_state.text_renderer, caption, window_width * 0.5f, window_height * 0.895f, 0.8f,
+                    caption_color);
+        for (int i = 0; i < num_players; ++i)
+        {
+            std::ostringstream odds_text;
+            odds_text << "P" << (i + 1) << " ~" << std::fixed << std::setprecision(1) << (m_odds[i] * 100.0f) << "%";
+            const float odds_x = window_width * static_cast<float>(i + 1) / static_cast<float>(num_players + 1);
+            add_ui_text(ui, m_render_state.text_renderer, odds_text.str(), odds_x, odds_y, odds_scale,
+                        i == snapshot.current_player_index ? current_color : other_color);
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
     }
 }
-
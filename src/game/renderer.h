@@ -1,13 +1,19 @@
 #pragma once
 
 #include "game_state.h"
+#include "render_snapshot.h"
 #include "../core/camera.h"
 #include "../core/window.h"
 #include "../rendering/text_renderer.h"
 #include "../rendering/gltf_loader.h"
 #include "../rendering/obj_loader.h"
+#include "../rendering/frustum.h"
+#include "../rendering/mesh_lod.h"
+#include "map/win_odds.h"
 
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
 
 namespace game
 {
@@ -17,15 +23,49 @@ namespace game
         Renderer(const RenderState& render_state);
         ~Renderer() = default;
 
-        void render(const core::Window& window, const core::Camera& camera, const GameState& game_state);
+        // Draws one frame from a simulation snapshot. game_state is only used for
+        // assets (map mesh, models, textures) which the simulation never modifies.
+        void render(const core::Window& window, const core::Camera& camera, const GameState& game_state,
+                    const RenderSnapshot& snapshot, float interpolation_alpha);
+
+        // Frustum culling of board chunks, players and dice (on by default)
+        void set_culling_enabled(bool enabled) { m_culling_enabled = enabled; }
+        // Culling results for the last render() call
+        const CullStats& get_cull_stats() const { return m_cull_stats; }
+        // LOD choices and model triangles drawn in the last render() call
+        const LodStats& get_lod_stats() const { return m_lod_stats; }
 
     private:
         void render_map(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state);
-        void render_player(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state);
-        void render_dice(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state);
-        void render_ui(const core::Window& window, const GameState& game_state);
+        void render_player(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state,
+                           const RenderSnapshot& snapshot);
+        void render_dice(const glm::mat4& projection, const glm::mat4& view, const GameState& game_state,
+                         const RenderSnapshot& snapshot);
+        void render_ui(const core::Window& window, const RenderSnapshot& snapshot);
+        // Each player's chance to win along the bottom edge, current player highlighted
+        void render_win_odds(UiBatch& ui, const RenderSnapshot& snapshot, float window_width, float window_height);
+        // Tests object-space bounds under model against this frame's frustum and counts the result
+        bool is_visible(const Bounds& local_bounds, const glm::mat4& model);
+        // Picks an LOD from projected size; current_lod is the instance's previous choice (for hysteresis)
+        int select_lod(int& current_lod, const Bounds& local_bounds, const glm::mat4& model,
+                       const glm::mat4& view, const glm::mat4& projection);
 
         const RenderState& m_render_state;
+        float m_interpolation_alpha = 1.0f;
+        Frustum m_frustum{};
+        CullStats m_cull_stats{};
+        bool m_culling_enabled = true;
+        float m_viewport_height = 1.0f;
+        std::array<int, 4> m_player_lods{};  // Last LOD picked for each player slot
+        int m_dice_lod = 0;
+        LodStats m_lod_stats{};
+
+        // Odds only change with the rules state, so they are recomputed when its
+        // hash (see state_hash.h) changes rather than every frame
+        game::map::FinishTable m_finish_table;
+        std::uint64_t m_odds_hash = 0;
+        bool m_odds_valid = false;
+        std::array<float, 4> m_odds{};
     };
 }
 
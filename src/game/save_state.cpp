@@ -0,0 +1,608 @@
+#include "save_state.h"
+
+#include "render_interpolation.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace game
+{
+    namespace
+    {
+        constexpr std::uint32_t SAVE_MAGIC = 0x534C4E53u;  // "SNLS" in a little-endian dump
+        constexpr std::size_t HEADER_SIZE = 16;
+        constexpr std::size_t MAX_SAVE_STRING = 4096;      // Longest string a valid save can hold
+        constexpr std::size_t MAX_SAVE_SEQUENCE = 256;     // Longest tile memory sequence / history
+
+        std::uint32_t fnv1a(const unsigned char* data, std::size_t size)
+        {
+            std::uint32_t hash = 2166136261u;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ data[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+        // Appends fields to a byte vector. Only ever grows the vector, so once it has
+        // held one save, later saves of a similar size never allocate.
+        struct SaveWriter
+        {
+            std::vector<unsigned char>& out;
+
+            void bytes(const void* data, std::size_t size)
+            {
+                const std::size_t offset = out.size();
+                out.resize(offset + size);
+                std::memcpy(out.data() + offset, data, size);
+            }
+
+            template <typename T>
+            void field(const T& value)
+            {
+                static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "add a field() overload for this type");
+                bytes(&value, sizeof(T));
+            }
+
+            void field(const bool& value)
+            {
+                const std::uint8_t byte = value ? 1 : 0;
+                bytes(&byte, 1);
+            }
+
+            void field(const glm::vec3& value)
+            {
+                field(value.x);
+                field(value.y);
+                field(value.z);
+            }
+
+            void field(const std::string& value)
+            {
+                field(static_cast<std::uint32_t>(value.size()));
+                bytes(value.data(), value.size());
+            }
+
+            void field(const std::vector<int>& values)
+            {
+                field(static_cast<std::uint32_t>(values.size()));
+                for (int value : values)
+                {
+                    field(value);
+                }
+            }
+
+            template <typename T, std::size_t N>
+            void field(const std::array<T, N>& values)
+            {
+                for (const T& value : values)
+                {
+                    field(value);
+                }
+            }
+        };
+
+        // Mirror of SaveWriter. Any overrun or implausible length clears ok and
+        // every later read becomes a no-op.
+        struct SaveReader
+        {
+            const unsigned char* data;
+            std::size_t size;
+            std::size_t offset = 0;
+            bool ok = true;
+
+            bool bytes(void* destination, std::size_t count)
+            {
+                if (!ok || count > size - offset)
+                {
+                    ok = false;
+                    return false;
+                }
+                std::memcpy(destination, data + offset, count);
+                offset += count;
+                return true;
+            }
+
+            template <typename T>
+            void field(T& value)
+            {
+                static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "add a field() overload for this type");
+                bytes(&value, sizeof(T));
+            }
+
+            void field(bool& value)
+            {
+                std::uint8_t byte = 0;
+                if (bytes(&byte, 1))
+                {
+                    value = byte != 0;
+                }
+            }
+
+            void field(glm::vec3& value)
+            {
+                field(value.x);
+                field(value.y);
+                field(value.z);
+            }
+
+            void field(std::string& value)
+            {
+                std::uint32_t length = 0;
+                field(length);
+                if (!ok || length > MAX_SAVE_STRING || length > size - offset)
+                {
+                    ok = false;
+                    return;
+                }
+                // assign() reuses the string's existing capacity
+                value.assign(reinterpret_cast<const char*>(data + offset), length);
+                offset += length;
+            }
+
+            void field(std::vector<int>& values)
+            {
+                std::uint32_t count = 0;
+                field(count);
+                if (!ok || count > MAX_SAVE_SEQUENCE)
+                {
+                    ok = false;
+                    return;
+                }
+                values.resize(count);
+                for (int& value : values)
+                {
+                    field(value);
+                }
+            }
+
+            template <typename T, std::size_t N>
+            void field(std::array<T, N>& values)
+            {
+                for (T& value : values)
+                {
+                    field(value);
+                }
+            }
+        };
+
+        // Each transfer_* is shared by save and restore (State is const for saving),
+        // so the two can never disagree about field order
+
+        template <typename Archive, typename Player>
+        void transfer_player(Archive& archive, Player& player)
+        {
+            archive.field(player.position);
+            archive.field(player.current_tile_index);
+            archive.field(player.is_stepping);
+            archive.field(player.step_start_position);
+            archive.field(player.step_end_position);
+            archive.field(player.step_timer);
+            archive.field(player.steps_remaining);
+            archive.field(player.last_dice_result);
+            archive.field(player.is_walking_backward);
+            archive.field(player.is_ai);
+            archive.field(player.ground_y);
+            archive.field(player.radius);
+            archive.field(player.step_duration);
+        }
+
+        template <typename Archive, typename Dice>
+        void transfer_dice(Archive& archive, Dice& dice)
+        {
+            archive.field(dice.position);
+            archive.field(dice.velocity);
+            archive.field(dice.target_position);
+            archive.field(dice.rotation);
+            archive.field(dice.rotation_velocity);
+            archive.field(dice.target_rotation);
+            archive.field(dice.roll_duration);
+            archive.field(dice.roll_timer);
+            archive.field(dice.display_duration);
+            archive.field(dice.display_timer);
+            archive.field(dice.is_rolling);
+            archive.field(dice.is_falling);
+            archive.field(dice.is_displaying);
+            archive.field(dice.result);
+            archive.field(dice.pending_result);
+            archive.field(dice.scale);
+            archive.field(dice.fall_height);
+            archive.field(dice.gravity);
+            archive.field(dice.bounce_restitution);
+            archive.field(dice.ground_y);
+        }
+
+        template <typename Archive, typename Precision>
+        void transfer_precision(Archive& archive, Precision& state)
+        {
+            archive.field(state.status);
+            archive.field(state.title_timer);
+            archive.field(state.title_duration);
+            archive.field(state.timer);
+            archive.field(state.stopped_time);
+            archive.field(state.target_time);
+            archive.field(state.max_time);
+            archive.field(state.display_text);
+            archive.field(state.bonus_steps);
+            archive.field(state.is_showing_time);
+            archive.field(state.time_display_timer);
+            archive.field(state.result_message);
+        }
+
+        template <typename Archive, typename TileMemory>
+        void transfer_tile_memory(Archive& archive, TileMemory& state)
+        {
+            archive.field(state.phase);
+            archive.field(state.title_timer);
+            archive.field(state.title_duration);
+            archive.field(state.sequence);
+            archive.field(state.input_history);
+            archive.field(state.input_buffer);
+            archive.field(state.highlight_index);
+            archive.field(state.highlight_timer);
+            archive.field(state.highlight_interval);
+            archive.field(state.input_timer);
+            archive.field(state.input_time_limit);
+            archive.field(state.success);
+            archive.field(state.display_text);
+            archive.field(state.result_text);
+            archive.field(state.result_timer);
+            archive.field(state.bonus_steps);
+            archive.field(state.current_round);
+        }
+
+        template <typename Archive, typename Reaction>
+        void transfer_reaction(Archive& archive, Reaction& state)
+        {
+            archive.field(state.phase);
+            archive.field(state.timer);
+            archive.field(state.title_timer);
+            archive.field(state.title_duration);
+            archive.field(state.ai_thinking_time);
+            archive.field(state.result_display_time);
+            archive.field(state.guess_display_duration);
+            archive.field(state.target_number);
+            archive.field(state.min_range);
+            archive.field(state.max_range);
+            archive.field(state.player_guess);
+            archive.field(state.ai_guess);
+            archive.field(state.ai_min);
+            archive.field(state.ai_max);
+            archive.field(state.player_attempts);
+            archive.field(state.ai_attempts);
+            archive.field(state.max_attempts);
+            archive.field(state.success);
+            archive.field(state.display_text);
+            archive.field(state.last_feedback);
+            archive.field(state.guessed_number_text);
+            archive.field(state.input_buffer);
+            archive.field(state.bonus_steps);
+        }
+
+        template <typename Archive, typename Math>
+        void transfer_math(Archive& archive, Math& state)
+        {
+            archive.field(state.phase);
+            archive.field(state.num1);
+            archive.field(state.num2);
+            archive.field(state.operation);
+            archive.field(state.correct_answer);
+            archive.field(state.player_answer);
+            archive.field(state.title_timer);
+            archive.field(state.title_duration);
+            archive.field(state.timer);
+            archive.field(state.time_limit);
+            archive.field(state.success);
+            archive.field(state.display_text);
+            archive.field(state.input_buffer);
+            archive.field(state.bonus_steps);
+        }
+
+        template <typename Archive, typename Pattern>
+        void transfer_pattern(Archive& archive, Pattern& state)
+        {
+            archive.field(state.phase);
+            archive.field(state.pattern);
+            archive.field(state.input_buffer);
+            archive.field(state.title_timer);
+            archive.field(state.title_duration);
+            archive.field(state.show_timer);
+            archive.field(state.show_duration);
+            archive.field(state.success);
+            archive.field(state.display_text);
+            archive.field(state.bonus_steps);
+        }
+
+        template <typename Archive, typename State>
+        void transfer_game_state(Archive& archive, State& state)
+        {
+            // Players and turn
+            archive.field(state.num_players);
+            archive.field(state.current_player_index);
+            for (auto& player : state.players)
+            {
+                transfer_player(archive, player);
+            }
+            archive.field(state.last_processed_tile);
+            archive.field(state.last_processed_tiles);
+            archive.field(state.turn_finished);
+            archive.field(state.camera_target_position);
+
+            // Dice
+            transfer_dice(archive, state.dice_state);
+            archive.field(state.dice_display_timer);
+
+            // Minigames
+            transfer_precision(archive, state.minigame_state);
+            transfer_tile_memory(archive, state.tile_memory_state);
+            transfer_reaction(archive, state.reaction_state);
+            transfer_math(archive, state.math_state);
+            transfer_pattern(archive, state.pattern_state);
+            archive.field(state.precision_result_applied);
+            archive.field(state.precision_result_display_timer);
+            archive.field(state.tile_memory_result_applied);
+            archive.field(state.reaction_result_applied);
+            archive.field(state.math_result_applied);
+            archive.field(state.pattern_result_applied);
+            archive.field(state.minigame_message);
+            archive.field(state.minigame_message_timer);
+
+            archive.field(state.reaction_input_buffer);
+
+            // Menu and win screen
+            archive.field(state.menu_state.is_active);
+            archive.field(state.menu_state.start_game);
+            archive.field(state.menu_state.num_players);
+            archive.field(state.menu_state.use_ai);
+            archive.field(state.menu_state.selected_option);
+            archive.field(state.win_state.is_active);
+            archive.field(state.win_state.show_animation);
+            archive.field(state.win_state.animation_timer);
+            archive.field(state.win_state.winner_player);
+        }
+
+        // The parts of GameState a save holds, under the same names, so a restore
+        // decodes into this and checks it before the live state is touched.
+        // Keep in step with transfer_game_state and copy_saved_parts.
+        struct SavedParts
+        {
+            std::array<game::player::PlayerState, 4> players{};
+            int current_player_index = 0;
+            int num_players = 2;
+            int last_processed_tile = 0;
+            std::array<int, 4> last_processed_tiles{};
+            bool turn_finished = false;
+            glm::vec3 camera_target_position{};
+            game::player::dice::DiceState dice_state;
+            float dice_display_timer = 0.0f;
+            game::minigame::PrecisionTimingState minigame_state;
+            game::minigame::tile_memory::TileMemoryState tile_memory_state;
+            game::minigame::ReactionState reaction_state;
+            game::minigame::MathQuizState math_state;
+            game::minigame::PatternMatchingState pattern_state;
+            bool precision_result_applied = false;
+            float precision_result_display_timer = 0.0f;
+            bool tile_memory_result_applied = false;
+            bool reaction_result_applied = false;
+            bool math_result_applied = false;
+            bool pattern_result_applied = false;
+            std::string minigame_message;
+            float minigame_message_timer = 0.0f;
+            std::string reaction_input_buffer;
+            game::menu::MenuState menu_state;
+            game::win::WinState win_state;
+        };
+
+        // Whole sub-objects, so fields a save leaves out keep their values on
+        // the round trip GameState -> SavedParts -> GameState
+        template <typename To, typename From>
+        void copy_saved_parts(To& to, const From& from)
+        {
+            to.players = from.players;
+            to.current_player_index = from.current_player_index;
+            to.num_players = from.num_players;
+            to.last_processed_tile = from.last_processed_tile;
+            to.last_processed_tiles = from.last_processed_tiles;
+            to.turn_finished = from.turn_finished;
+            to.camera_target_position = from.camera_target_position;
+            to.dice_state = from.dice_state;
+            to.dice_display_timer = from.dice_display_timer;
+            to.minigame_state = from.minigame_state;
+            to.tile_memory_state = from.tile_memory_state;
+            to.reaction_state = from.reaction_state;
+            to.math_state = from.math_state;
+            to.pattern_state = from.pattern_state;
+            to.precision_result_applied = from.precision_result_applied;
+            to.precision_result_display_timer = from.precision_result_display_timer;
+            to.tile_memory_result_applied = from.tile_memory_result_applied;
+            to.reaction_result_applied = from.reaction_result_applied;
+            to.math_result_applied = from.math_result_applied;
+            to.pattern_result_applied = from.pattern_result_applied;
+            to.minigame_message = from.minigame_message;
+            to.minigame_message_timer = from.minigame_message_timer;
+            to.reaction_input_buffer = from.reaction_input_buffer;
+            to.menu_state = from.menu_state;
+            to.win_state = from.win_state;
+        }
+
+        template <typename Enum>
+        bool in_range(Enum value, Enum last)
+        {
+            const int index = static_cast<int>(value);
+            return index >= 0 && index <= static_cast<int>(last);
+        }
+
+        bool in_range(int value, int first, int last)
+        {
+            return value >= first && value <= last;
+        }
+
+        // Everything that later indexes a table or an array. A save from another
+        // build with the same version can pass the checksum and still hold these
+        // out of range.
+        bool is_playable(const SavedParts& saved)
+        {
+            const int final_tile = game::map::BOARD_COLUMNS * game::map::BOARD_ROWS - 1;
+            if (!in_range(saved.num_players, 2, 4) || !in_range(saved.current_player_index, 0, saved.num_players - 1) ||
+                !in_range(saved.last_processed_tile, -1, final_tile))
+            {
+                return false;
+            }
+            for (int seat = 0; seat < 4; ++seat)
+            {
+                const game::player::PlayerState& player = saved.players[seat];
+                if (!in_range(player.current_tile_index, 0, final_tile) ||
+                    player.steps_remaining < 0 || !in_range(player.last_dice_result, 0, 6) ||
+                    !in_range(saved.last_processed_tiles[seat], -1, final_tile))
+                {
+                    return false;
+                }
+            }
+            if (!in_range(saved.dice_state.result, 0, 6) || !in_range(saved.dice_state.pending_result, 0, 6))
+            {
+                return false;
+            }
+
+            using game::minigame::tile_memory::Phase;
+            const bool phases = in_range(saved.minigame_state.status, game::minigame::PrecisionTimingStatus::Failure) &&
+                                in_range(saved.tile_memory_state.phase, Phase::Result) &&
+                                in_range(saved.reaction_state.phase, game::minigame::ReactionState::Phase::Failure) &&
+                                in_range(saved.math_state.phase, game::minigame::MathQuizState::Phase::Failure) &&
+                                in_range(saved.pattern_state.phase, game::minigame::PatternMatchingState::Phase::Failure);
+            if (!phases)
+            {
+                return false;
+            }
+            // Sequence digits are typed back as '0' + digit
+            for (int digit : saved.tile_memory_state.sequence)
+            {
+                if (!in_range(digit, 0, 9))
+                {
+                    return false;
+                }
+            }
+
+            return in_range(saved.menu_state.num_players, 2, 4) && in_range(saved.menu_state.selected_option, 0, 1) &&
+                   in_range(saved.win_state.winner_player, 1, 4);
+        }
+
+        void write_header(unsigned char* header, std::uint32_t payload_size, std::uint32_t checksum)
+        {
+            const std::uint16_t version = SAVE_STATE_VERSION;
+            const std::uint16_t header_size = static_cast<std::uint16_t>(HEADER_SIZE);
+            std::memcpy(header, &SAVE_MAGIC, 4);
+            std::memcpy(header + 4, &version, 2);
+            std::memcpy(header + 6, &header_size, 2);
+            std::memcpy(header + 8, &payload_size, 4);
+            std::memcpy(header + 12, &checksum, 4);
+        }
+    }
+
+    void save_game_state(const GameState& state, std::vector<unsigned char>& out)
+    {
+        out.clear();
+        out.resize(HEADER_SIZE);  // Filled in once the payload size and checksum are known
+
+        SaveWriter writer{out};
+        transfer_game_state(writer, state);
+
+        const std::size_t payload_size = out.size() - HEADER_SIZE;
+        write_header(out.data(), static_cast<std::uint32_t>(payload_size),
+                     fnv1a(out.data() + HEADER_SIZE, payload_size));
+    }
+
+    bool restore_game_state(GameState& state, const unsigned char* data, std::size_t size)
+    {
+        if (data == nullptr || size < HEADER_SIZE)
+        {
+            return false;
+        }
+
+        std::uint32_t magic = 0;
+        std::uint16_t version = 0;
+        std::uint16_t header_size = 0;
+        std::uint32_t payload_size = 0;
+        std::uint32_t checksum = 0;
+        std::memcpy(&magic, data, 4);
+        std::memcpy(&version, data + 4, 2);
+        std::memcpy(&header_size, data + 6, 2);
+        std::memcpy(&payload_size, data + 8, 4);
+        std::memcpy(&checksum, data + 12, 4);
+        if (magic != SAVE_MAGIC || version != SAVE_STATE_VERSION || header_size != HEADER_SIZE ||
+            payload_size != size - HEADER_SIZE || fnv1a(data + HEADER_SIZE, payload_size) != checksum)
+        {
+            return false;
+        }
+
+        // Decode over a copy of the live parts, so fields a save leaves out keep
+        // their values. The copy is kept between restores, so its strings and
+        // sequences reuse their storage.
+        static thread_local SavedParts saved;
+        copy_saved_parts(saved, state);
+        SaveReader reader{data + HEADER_SIZE, payload_size};
+        transfer_game_state(reader, saved);
+        if (!reader.ok || reader.offset != payload_size || !is_playable(saved))
+        {
+            return false;
+        }
+        copy_saved_parts(state, saved);
+
+        // Hashes aren't saved either; seats are untouched, so recompute from the fields
+        for (game::player::PlayerState& player : state.players)
+        {
+            game::player::rehash(player);
+        }
+
+        // Interpolation isn't saved; start from the restored positions so nothing slides in
+        store_previous_transforms(state);
+        return true;
+    }
+
+    bool write_save_file(const std::filesystem::path& path, const std::vector<unsigned char>& bytes)
+    {
+        std::filesystem::path temporary_path = path;
+        temporary_path += ".tmp";
+        {
+            std::ofstream file(temporary_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            file.flush();
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temporary_path, path, ec);
+        return !ec;
+    }
+
+    bool read_save_file(const std::filesystem::path& path, std::vector<unsigned char>& bytes)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg();
+        if (size < 0)
+        {
+            return false;
+        }
+        file.seekg(0, std::ios::beg);
+        bytes.resize(static_cast<std::size_t>(size));
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+}
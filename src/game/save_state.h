@@ -0,0 +1,35 @@
+#pragma once
+
+#include "game_state.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace game
+{
+    // Bump whenever a field is added, removed or reordered in save_state.cpp
+    constexpr std::uint16_t SAVE_STATE_VERSION = 2;  // 2 dropped the key trackers; older saves are rejected
+
+    // Serialises the rules state of a game: players, dice, every minigame, turn
+    // bookkeeping and menu / win screen. Assets, GPU handles, audio, input and
+    // render interpolation are not part of a save.
+    //
+    // Layout: 16-byte header (magic, version, payload size, FNV-1a checksum of the
+    // payload) followed by the fields in native byte order. out is cleared and
+    // refilled, so reusing the same vector makes repeated saves allocation-free.
+    void save_game_state(const GameState& state, std::vector<unsigned char>& out);
+
+    // Validates the header and checksum, decodes into a staging copy and range-checks
+    // tiles, counts and enum values there, and only then writes state - so a torn,
+    // stale, foreign or out-of-range save leaves the game untouched. Returns false
+    // if the data is rejected. Strings and the tile memory sequences are assigned
+    // into their existing storage.
+    bool restore_game_state(GameState& state, const unsigned char* data, std::size_t size);
+
+    // Writes to a temporary file and renames it over path, so a crash mid-write
+    // never leaves a half-written save behind. Returns false on I/O failure.
+    bool write_save_file(const std::filesystem::path& path, const std::vector<unsigned char>& bytes);
+    bool read_save_file(const std::filesystem::path& path, std::vector<unsigned char>& bytes);
+}
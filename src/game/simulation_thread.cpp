@@ -0,0 +1,92 @@
+#include "simulation_thread.h"
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace game
+{
+    SimulationThread::SimulationThread(GameLoop& game_loop, GameState& game_state, core::FixedTimestep& timestep,
+                                       core::TripleBuffer<RenderSnapshot>& snapshots)
+        : m_game_loop(game_loop)
+        , m_game_state(game_state)
+        , m_timestep(timestep)
+        , m_snapshots(snapshots)
+    {
+    }
+
+    SimulationThread::~SimulationThread()
+    {
+        stop();
+    }
+
+    void SimulationThread::start()
+    {
+        if (m_running.exchange(true))
+        {
+            return;
+        }
+        m_thread = std::thread(&SimulationThread::run, this);
+    }
+
+    void SimulationThread::stop()
+    {
+        m_running.store(false);
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    void SimulationThread::run()
+    {
+        try
+        {
+            // glfwGetTime may be called from any thread - it is the same clock the
+            // render thread uses to work out its interpolation factor
+            double previous_time = glfwGetTime();
+            while (m_running.load(std::memory_order_relaxed))
+            {
+                const double current_time = glfwGetTime();
+                const int ticks = core::accumulate(m_timestep, current_time - previous_time);
+                previous_time = current_time;
+
+                for (int tick = 0; tick < ticks; ++tick)
+                {
+                    // Each tick of a batch stands for its own moment, so key events land on the right one
+                    m_game_loop.set_input_time(current_time - m_timestep.accumulator - (ticks - 1 - tick) * m_timestep.step);
+                    m_game_loop.update(core::get_step(m_timestep));
+                }
+
+                if (ticks > 0)
+                {
+                    publish_render_snapshot(m_game_state, m_timestep, current_time - m_timestep.accumulator, m_snapshots);
+                }
+
+                // Sleep until the next tick is due
+                const double until_next_tick = m_timestep.step - m_timestep.accumulator;
+                if (until_next_tick > 0.0)
+                {
+                    std::this_thread::sleep_for(std::chrono::duration<double>(until_next_tick));
+                }
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Simulation thread error: " << ex.what() << '\n';
+            m_failed.store(true, std::memory_order_release);
+        }
+    }
+
+    void publish_render_snapshot(const GameState& game_state, const core::FixedTimestep& timestep,
+                                 double tick_time, core::TripleBuffer<RenderSnapshot>& snapshots)
+    {
+        RenderSnapshot& snapshot = snapshots.write_buffer();
+        capture_render_snapshot(game_state, snapshot);
+        snapshot.tick_time = tick_time;
+        snapshot.tick_step = timestep.step;
+        snapshot.tick = timestep.tick_count;
+        snapshots.publish();
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "game_loop.h"
+#include "game_state.h"
+#include "render_snapshot.h"
+#include "../core/fixed_timestep.h"
+#include "../core/triple_buffer.h"
+
+#include <atomic>
+#include <thread>
+
+namespace game
+{
+    // Runs GameLoop::update on its own thread at the fixed tick rate and publishes
+    // a RenderSnapshot after every batch of ticks. The GL thread only ever reads
+    // the latest published snapshot, so a frame costs max(update, render) instead
+    // of update + render.
+    class SimulationThread
+    {
+    public:
+        SimulationThread(GameLoop& game_loop, GameState& game_state, core::FixedTimestep& timestep,
+                         core::TripleBuffer<RenderSnapshot>& snapshots);
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+
+        void start();
+        void stop();
+
+        // Set if update() threw - the main loop should shut down
+        bool has_failed() const { return m_failed.load(std::memory_order_acquire); }
+
+    private:
+        void run();
+
+        GameLoop& m_game_loop;
+        GameState& m_game_state;
+        core::FixedTimestep& m_timestep;
+        core::TripleBuffer<RenderSnapshot>& m_snapshots;
+
+        std::thread m_thread;
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_failed{false};
+    };
+
+    // Captures game_state into the producer slot and publishes it. tick_time is
+    // the wall-clock time the latest simulated tick corresponds to.
+    void publish_render_snapshot(const GameState& game_state, const core::FixedTimestep& timestep,
+                                 double tick_time, core::TripleBuffer<RenderSnapshot>& snapshots);
+}
@@ -0,0 +1,71 @@
+#include "state_hash.h"
+
+#include "map/board.h"
+
+#include <array>
+#include <cstddef>
+
+namespace game
+{
+    namespace
+    {
+        constexpr int TILE_COUNT = map::BOARD_COLUMNS * map::BOARD_ROWS;
+        constexpr std::size_t TILE_KEYS = HASH_SEATS * TILE_COUNT;
+        constexpr std::size_t STEP_KEYS = HASH_SEATS * HASH_STEP_KEYS;
+        constexpr std::size_t KEY_COUNT = TILE_KEYS + STEP_KEYS + 2 * HASH_SEATS;
+
+        // splitmix64 from a fixed seed - any change here changes every hash
+        constexpr std::array<std::uint64_t, KEY_COUNT> make_keys()
+        {
+            std::array<std::uint64_t, KEY_COUNT> keys{};
+            std::uint64_t x = 0x536e616b65734c64ull;
+            for (std::size_t i = 0; i < KEY_COUNT; ++i)
+            {
+                x += 0x9e3779b97f4a7c15ull;
+                std::uint64_t z = x;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                keys[i] = z ^ (z >> 31);
+            }
+            return keys;
+        }
+
+        constexpr std::array<std::uint64_t, KEY_COUNT> KEYS = make_keys();
+
+        std::size_t seat_slot(int seat)
+        {
+            return static_cast<std::size_t>(seat) & (HASH_SEATS - 1);
+        }
+    }
+
+    std::uint64_t player_tile_key(int seat, int tile)
+    {
+        const int clamped_tile = tile < 0 ? 0 : (tile >= TILE_COUNT ? TILE_COUNT - 1 : tile);
+        return KEYS[seat_slot(seat) * TILE_COUNT + static_cast<std::size_t>(clamped_tile)];
+    }
+
+    std::uint64_t player_steps_key(int seat, int steps)
+    {
+        return KEYS[TILE_KEYS + seat_slot(seat) * HASH_STEP_KEYS + (static_cast<std::size_t>(steps) & (HASH_STEP_KEYS - 1))];
+    }
+
+    std::uint64_t player_backward_key(int seat)
+    {
+        return KEYS[TILE_KEYS + STEP_KEYS + seat_slot(seat)];
+    }
+
+    std::uint64_t turn_key(int seat)
+    {
+        return KEYS[TILE_KEYS + STEP_KEYS + HASH_SEATS + seat_slot(seat)];
+    }
+
+    std::uint64_t hash_turn_state(const player::PlayerState* players, int count, int current_seat)
+    {
+        std::uint64_t hash = turn_key(current_seat);
+        for (int i = 0; i < count; ++i)
+        {
+            hash ^= players[i].hash;
+        }
+        return hash;
+    }
+}
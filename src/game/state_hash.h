@@ -0,0 +1,27 @@
+#pragma once
+
+#include "player/player.h"
+
+#include <cstdint>
+
+// 64-bit Zobrist hash of the discrete rules state: every seat's tile, steps left
+// and walking direction, plus whose turn it is. Each PlayerState keeps its own
+// share up to date as it changes (see player.cpp), so hashing a position is a
+// few XORs instead of a serialisation pass.
+//
+// The keys are fixed at compile time, so the game, a replay and snl_server all
+// hash the same position to the same value - compare hashes to find a desync, or
+// use one as a transposition key.
+namespace game
+{
+    constexpr int HASH_SEATS = 4;
+    constexpr int HASH_STEP_KEYS = 64;  // steps_remaining is keyed modulo this
+
+    std::uint64_t player_tile_key(int seat, int tile);
+    std::uint64_t player_steps_key(int seat, int steps);
+    std::uint64_t player_backward_key(int seat);
+    std::uint64_t turn_key(int seat);
+
+    // Hash of count seats starting at players[0], with current_seat to move
+    std::uint64_t hash_turn_state(const player::PlayerState* players, int count, int current_seat);
+}
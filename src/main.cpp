@@ -1,25 +1,439 @@
  #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "core/camera.h"
+#include "core/fixed_timestep.h"
+#include "core/random.h"
 #include "core/window.h"
 #include "game/game_state.h"
 #include "game/game_loop.h"
+#include "game/input_log.h"
+#include "game/map/board_file.h"
 #include "game/renderer.h"
-#include "rendering/shader.h"
+#include "game/render_benchmark.h"
+#include "game/render_snapshot.h"
+#include "game/save_state.h"
+#include "game/simulation_thread.h"
+#include "rendering/shader_cache.h"
 #include "rendering/text_renderer.h"
 #include "rendering/texture_loader.h"
+#include "rendering/ui_batch.h"
 #include "rendering/gltf_loader.h"
+#include "rendering/latency_probe.h"
 #include "rendering/obj_loader.h"
 #include "utils/file_utils.h"
 #include "game/menu/menu_renderer.h"
 
 namespace
 {
+    struct LaunchOptions
+    {
+        double tick_rate = 60.0;  // Simulation ticks per second (--tick-rate=N)
+        double max_fps = 0.0;     // Render frame cap, 0 = uncapped (--max-fps=N)
+        bool vsync = true;        // --no-vsync to render as fast as the GPU allows
+        bool single_thread = false;  // --single-thread runs simulation and rendering back to back
+        bool shader_cache = true;    // --no-shader-cache always compiles shaders from source
+        bool render_stats = false;   // --render-stats prints UI batch and culling statistics once a second
+        bool latency_probe = false;  // --latency-probe reports key press to display latency on exit
+        int max_frames_in_flight = 0;  // --max-frames-in-flight=N, 0 = as many as the driver queues
+        bool late_input = false;     // --late-input waits out --max-fps before sampling input, not after presenting
+        bool culling = true;         // --no-culling draws every mesh regardless of the camera
+        bool headless = false;       // --headless renders the benchmark script offscreen and exits
+        int width = 800;             // --size=WxH, window (or offscreen target) size
+        int height = 600;
+        int frames = 600;                      // --frames=N, headless frame count
+        std::filesystem::path capture_dir;     // --capture-dir=DIR, headless PNG output
+        std::filesystem::path timings_path;    // --timings=FILE, headless per-frame CSV
+        bool has_seed = false;                 // --seed=N fixes the RNG seed (otherwise random)
+        std::uint64_t seed = 0;
+        std::filesystem::path record_path;     // --record=FILE saves seed + key edges on exit
+        std::filesystem::path replay_path;     // --replay=FILE re-simulates a recording
+        double replay_fps = 30.0;              // --replay-fps=N, 0 = simulate without a visible window
+        std::filesystem::path autosave_path;   // --autosave=FILE saves the game on every turn change
+        std::filesystem::path resume_path;     // --resume=FILE continues a saved game
+        std::filesystem::path board_path;      // --board=FILE plays a snl_board_optimizer layout
+    };
+
+    LaunchOptions parse_launch_options(int argc, char* argv[])
+    {
+        LaunchOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--tick-rate=", 0) == 0)
+                {
+                    options.tick_rate = std::stod(arg.substr(std::strlen("--tick-rate=")));
+                }
+                else if (arg.rfind("--max-fps=", 0) == 0)
+                {
+                    options.max_fps = std::stod(arg.substr(std::strlen("--max-fps=")));
+                }
+                else if (arg == "--no-vsync")
+                {
+                    options.vsync = false;
+                }
+                else if (arg == "--single-thread")
+                {
+                    options.single_thread = true;
+                }
+                else if (arg == "--no-shader-cache")
+                {
+                    options.shader_cache = false;
+                }
+                else if (arg == "--render-stats")
+                {
+                    options.render_stats = true;
+                }
+                else if (arg == "--latency-probe")
+                {
+                    options.latency_probe = true;
+                }
+                else if (arg.rfind("--max-frames-in-flight=", 0) == 0)
+                {
+                    options.max_frames_in_flight = std::clamp(std::stoi(arg.substr(std::strlen("--max-frames-in-flight="))),
+                                                              0, LATENCY_PROBE_FRAME_COUNT);
+                }
+                else if (arg == "--late-input")
+                {
+                    options.late_input = true;
+                }
+                else if (arg == "--no-culling")
+                {
+                    options.culling = false;
+                }
+                else if (arg == "--headless")
+                {
+                    options.headless = true;
+                }
+                else if (arg.rfind("--size=", 0) == 0)
+                {
+                    const std::string size = arg.substr(std::strlen("--size="));
+                    const std::size_t separator = size.find('x');
+                    if (separator == std::string::npos)
+                    {
+                        throw std::invalid_argument(size);
+                    }
+                    options.width = std::max(1, std::stoi(size.substr(0, separator)));
+                    options.height = std::max(1, std::stoi(size.substr(separator + 1)));
+                }
+                else if (arg.rfind("--frames=", 0) == 0)
+                {
+                    options.frames = std::max(1, std::stoi(arg.substr(std::strlen("--frames="))));
+                }
+                else if (arg.rfind("--capture-dir=", 0) == 0)
+                {
+                    options.capture_dir = arg.substr(std::strlen("--capture-dir="));
+                }
+                else if (arg.rfind("--timings=", 0) == 0)
+                {
+                    options.timings_path = arg.substr(std::strlen("--timings="));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                    options.has_seed = true;
+                }
+                else if (arg.rfind("--record=", 0) == 0)
+                {
+                    options.record_path = arg.substr(std::strlen("--record="));
+                }
+                else if (arg.rfind("--replay=", 0) == 0)
+                {
+                    options.replay_path = arg.substr(std::strlen("--replay="));
+                }
+                else if (arg.rfind("--replay-fps=", 0) == 0)
+                {
+                    options.replay_fps = std::max(0.0, std::stod(arg.substr(std::strlen("--replay-fps="))));
+                }
+                else if (arg.rfind("--autosave=", 0) == 0)
+                {
+                    options.autosave_path = arg.substr(std::strlen("--autosave="));
+                }
+                else if (arg.rfind("--resume=", 0) == 0)
+                {
+                    options.resume_path = arg.substr(std::strlen("--resume="));
+                }
+                else if (arg.rfind("--board=", 0) == 0)
+                {
+                    options.board_path = arg.substr(std::strlen("--board="));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    // Interactive session: runs until the window is closed
+    void run_game(core::Window& window, core::Camera& camera, game::GameState& game_state,
+                  game::RenderState& render_state, game::GameLoop& game_loop, game::Renderer& renderer,
+                  const LaunchOptions& options)
+    {
+        std::cout << "Entering main game loop..." << std::endl;
+
+        // Main game loop - the simulation runs on a fixed tick (on its own thread
+        // unless --single-thread), rendering runs as fast as vsync / --max-fps
+        // allows and interpolates between the last two published ticks
+        core::FixedTimestep timestep;
+        core::set_tick_rate(timestep, options.tick_rate);
+        std::cout << "Simulation tick rate: " << timestep.tick_rate << " Hz"
+                  << (options.single_thread ? " (single-threaded)" : " (simulation thread)") << std::endl;
+
+        game::InputLog recording;
+        recording.seed = core::get_random_seed();
+        recording.tick_rate = timestep.tick_rate;
+        const bool record = !options.record_path.empty();
+        if (record)
+        {
+            game_loop.set_input_recording(&recording);
+        }
+        // Written on the way out even if the game failed - those are the runs worth replaying
+        const auto save_recording = [&]() {
+            if (!record)
+            {
+                return;
+            }
+            game_loop.set_input_recording(nullptr);
+            recording.tick_count = game_loop.get_tick();
+            game::save_input_log(options.record_path, recording);
+            std::cout << "Recorded " << recording.tick_count << " ticks, " << recording.edges.size()
+                      << " key edges to " << options.record_path << std::endl;
+        };
+
+        // Snapshots are large (minigame strings, animation poses) - keep them off the stack
+        auto snapshots = std::make_unique<core::TripleBuffer<game::RenderSnapshot>>();
+        double previous_time = glfwGetTime();
+        game_state.last_time = static_cast<float>(previous_time);
+        game::publish_render_snapshot(game_state, timestep, previous_time, *snapshots);
+        snapshots->acquire_latest();
+
+        game::SimulationThread simulation(game_loop, game_state, timestep, *snapshots);
+        if (!options.single_thread)
+        {
+            simulation.start();
+        }
+
+        // Fences behind every present, for --max-frames-in-flight and --latency-probe
+        LatencyProbe latency_probe;
+        const bool use_fences = options.latency_probe || options.max_frames_in_flight > 0;
+        if (use_fences)
+        {
+            initialize_latency_probe(latency_probe, options.latency_probe);
+        }
+        if (options.latency_probe)
+        {
+            window.set_key_event_callback([&latency_probe](const core::KeyEvent& event) {
+                if (event.down)
+                {
+                    record_latency_input(latency_probe, event.time);
+                }
+            });
+        }
+        const auto finish_latency_probe = [&]() {
+            window.set_key_event_callback(nullptr);
+            if (!use_fences)
+            {
+                return;
+            }
+            wait_for_frames_in_flight(latency_probe, 1);  // Every frame presented so far
+            print_latency_report(latency_probe);
+            destroy_latency_probe(latency_probe);
+        };
+
+        const double min_frame_time = options.max_fps > 0.0 ? 1.0 / options.max_fps : 0.0;
+        double last_stats_time = previous_time;
+        try
+        {
+            while (!window.should_close())
+            {
+                // Block on the GPU (and the frame cap, with --late-input) before
+                // sampling input rather than after, so the frame shows newer input
+                if (use_fences)
+                {
+                    wait_for_frames_in_flight(latency_probe, options.max_frames_in_flight);
+                }
+                if (options.late_input && min_frame_time > 0.0)
+                {
+                    const double remaining = min_frame_time - (glfwGetTime() - previous_time);
+                    if (remaining > 0.0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+                    }
+                }
+
+                const double current_time = glfwGetTime();
+                game_state.last_time = static_cast<float>(current_time);
+
+                window.poll_events();
+
+                if (window.is_key_pressed(GLFW_KEY_ESCAPE))
+                {
+                    window.close();
+                }
+
+                if (options.single_thread)
+                {
+                    // Update game in fixed steps on this thread
+                    const int ticks = core::accumulate(timestep, current_time - previous_time);
+                    for (int tick = 0; tick < ticks; ++tick)
+                    {
+                        game_loop.set_input_time(current_time - timestep.accumulator - (ticks - 1 - tick) * timestep.step);
+                        game_loop.update(core::get_step(timestep));
+                    }
+                    if (ticks > 0)
+                    {
+                        game::publish_render_snapshot(game_state, timestep, current_time - timestep.accumulator, *snapshots);
+                    }
+                }
+                else if (simulation.has_failed())
+                {
+                    throw std::runtime_error("Simulation thread stopped unexpectedly.");
+                }
+                previous_time = current_time;
+
+                // Render the newest snapshot the simulation has published
+                snapshots->acquire_latest();
+                const game::RenderSnapshot& snapshot = snapshots->read_buffer();
+                renderer.render(window, camera, game_state, snapshot, game::get_snapshot_alpha(snapshot, glfwGetTime()));
+
+                window.swap_buffers();
+                if (use_fences)
+                {
+                    mark_latency_present(latency_probe, snapshot.tick_time);
+                }
+
+                if (options.render_stats && current_time - last_stats_time >= 1.0)
+                {
+                    const UiBatchStats& stats = render_state.ui_batch.last_frame_stats;
+                    std::cout << "UI batch: " << stats.layers << " layers, " << stats.draw_calls << " draws, "
+                              << stats.vertices << " vertices (" << stats.quads << " quads, " << stats.circles
+                              << " circles, " << stats.glyphs << " glyphs), " << stats.buffer_orphans << " orphans\n";
+                    const CullStats& cull_stats = renderer.get_cull_stats();
+                    std::cout << "Culling: " << cull_stats.culled << "/" << cull_stats.tested << " culled\n";
+                    const LodStats& lod_stats = renderer.get_lod_stats();
+                    std::cout << "LOD: " << lod_stats.triangles << " model triangles, models per level";
+                    for (int count : lod_stats.models_per_level)
+                    {
+                        std::cout << ' ' << count;
+                    }
+                    std::cout << '\n';
+                    last_stats_time = current_time;
+                }
+
+                // Optional frame cap (independent of the simulation rate)
+                if (min_frame_time > 0.0 && !options.late_input)
+                {
+                    const double remaining = min_frame_time - (glfwGetTime() - current_time);
+                    if (remaining > 0.0)
+                    {
+                        std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+                    }
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            simulation.stop();
+            save_recording();
+            finish_latency_probe();
+            throw;
+        }
+
+        simulation.stop();
+        save_recording();
+        finish_latency_probe();
+    }
+
+    // Re-simulates a recording as fast as the CPU allows. Frames are rendered at
+    // most replay_fps times a second of wall time (never when it is 0), so the
+    // simulation rather than the GPU sets the pace.
+    void run_replay(core::Window& window, core::Camera& camera, game::GameState& game_state,
+                    game::GameLoop& game_loop, game::Renderer& renderer, const game::InputLog& log,
+                    const LaunchOptions& options)
+    {
+        core::FixedTimestep timestep;
+        core::set_tick_rate(timestep, log.tick_rate);
+        const float step = core::get_step(timestep);
+        game_loop.set_input_replay(&log);
+
+        std::cout << "Replaying " << log.tick_count << " ticks at " << timestep.tick_rate << " Hz (seed "
+                  << log.seed << ", " << log.edges.size() << " key edges)" << std::endl;
+
+        auto snapshot = std::make_unique<game::RenderSnapshot>();
+        const double render_interval = options.replay_fps > 0.0 ? 1.0 / options.replay_fps : 0.0;
+        const double start_time = glfwGetTime();
+        double last_event_time = start_time;
+        double last_render_time = -render_interval;
+        while (game_loop.get_tick() < log.tick_count && !window.should_close())
+        {
+            game_loop.update(step);
+            timestep.tick_count++;
+
+            const double now = glfwGetTime();
+            if (now - last_event_time >= 0.1)
+            {
+                // Keep the window responsive; the keys themselves come from the log
+                window.poll_events();
+                if (window.is_key_pressed(GLFW_KEY_ESCAPE))
+                {
+                    window.close();
+                }
+                last_event_time = now;
+            }
+
+            if (render_interval > 0.0 && now - last_render_time >= render_interval)
+            {
+                game::capture_render_snapshot(game_state, *snapshot);
+                snapshot->tick = timestep.tick_count;
+                snapshot->tick_step = timestep.step;
+                renderer.render(window, camera, game_state, *snapshot, 1.0f);
+                window.swap_buffers();
+                last_render_time = now;
+            }
+        }
+        game_loop.set_input_replay(nullptr);
+
+        const double elapsed = glfwGetTime() - start_time;
+        const double simulated = static_cast<double>(game_loop.get_tick()) * timestep.step;
+        std::cout << "Replayed " << game_loop.get_tick() << " ticks (" << simulated << " s of game time) in "
+                  << elapsed << " s, " << (elapsed > 0.0 ? simulated / elapsed : 0.0) << "x real time\n";
+        std::cout << "Final state: current player " << (game_state.current_player_index + 1) << ", tiles";
+        for (int i = 0; i < game_state.num_players; ++i)
+        {
+            std::cout << ' ' << (game_state.players[i].current_tile_index + 1);
+        }
+        if (game_state.win_state.is_active)
+        {
+            std::cout << ", player " << game_state.win_state.winner_player << " won";
+        }
+        std::cout << std::endl;
+        if (!log.turn_hashes.empty())
+        {
+            std::cout << "Turn hashes: " << game_loop.get_replay_turns_checked() << " of " << log.turn_hashes.size()
+                      << " checked, " << (game_loop.has_replay_diverged() ? "diverged" : "all matched") << std::endl;
+        }
+    }
+
     void load_dice_assets(const std::filesystem::path& executable_dir, 
                          const std::filesystem::path& source_dir,
                          game::GameState& game_state)
@@ -229,9 +643,38 @@ int main(int argc, char* argv[])
 {
     try
     {
+        const LaunchOptions options = parse_launch_options(argc, argv);
+        if (!options.board_path.empty())
+        {
+            // Before the map mesh, the rules or the win odds table read the layout
+            game::map::set_active_board(game::map::load_board_definition(options.board_path));
+            std::cout << "Board: " << options.board_path.string() << std::endl;
+        }
+
+        // A replay brings its own seed and tick rate; everything else seeds once here
+        std::unique_ptr<game::InputLog> replay_log;
+        if (!options.replay_path.empty())
+        {
+            replay_log = std::make_unique<game::InputLog>(game::load_input_log(options.replay_path));
+            core::seed_random_streams(replay_log->seed);
+        }
+        else
+        {
+            core::seed_random_streams(options.has_seed ? options.seed : core::make_random_seed());
+        }
+        std::cout << "Random seed: " << core::get_random_seed() << std::endl;
+
         std::cout << "Initializing window..." << std::endl;
         // Initialize window
-        core::Window window(800, 600, "Pacman OpenGL");
+        // Replays that never draw don't need a display either
+        const bool offscreen = options.headless || (replay_log && options.replay_fps <= 0.0);
+        core::Window window(options.width, options.height, "Pacman OpenGL",
+                            offscreen ? core::WindowMode::Offscreen : core::WindowMode::Visible);
+        if (!offscreen)
+        {
+            // Replays present without waiting for vsync so the simulation is never held back
+            window.set_vsync(options.vsync && !replay_log);
+        }
         std::cout << "Window created successfully!" << std::endl;
         
         // Setup camera
@@ -284,27 +727,15 @@ int main(int argc, char* argv[])
             }
         }
 
-        // Load shaders
+        // Load shaders - every variant is built up-front, linked programs are
+        // cached on disk so later launches skip compilation
         const auto shaders_dir = executable_dir / "shaders";
         const std::string vertex_source = load_file(shaders_dir / "simple.vert");
         const std::string fragment_source = load_file(shaders_dir / "simple.frag");
-        const GLuint program = create_program(vertex_source, fragment_source);
-        const GLint mvp_location = glGetUniformLocation(program, "uMVP");
-        const GLint use_texture_location = glGetUniformLocation(program, "uUseTexture");
-        const GLint texture_location = glGetUniformLocation(program, "uTexture");
-        const GLint dice_texture_mode_location = glGetUniformLocation(program, "uDiceTextureMode");
-        const GLint color_override_location = glGetUniformLocation(program, "uColorOverride");
-        const GLint use_color_override_location = glGetUniformLocation(program, "uUseColorOverride");
-        
-        glUseProgram(program);
-        if (texture_location >= 0)
-        {
-            glUniform1i(texture_location, 0);
-        }
-        if (dice_texture_mode_location >= 0)
-        {
-            glUniform1i(dice_texture_mode_location, 0);
-        }
+        game::RenderState render_state;
+        initialize_shader_cache(render_state.shaders, vertex_source, fragment_source,
+                                options.shader_cache ? executable_dir / "shader_cache" : std::filesystem::path());
+
         glEnable(GL_DEPTH_TEST);
 
         // Initialize game state
@@ -334,6 +765,11 @@ int main(int argc, char* argv[])
             audio_dir = source_dir.parent_path() / "assets" / "audio";
         }
         
+        if (options.headless || replay_log)
+        {
+            // Benchmarks and replays run far faster than real time - stay silent
+            game_state.audio_manager.shutdown();
+        }
         if (game_state.audio_manager.is_available())
         {
             // Load BGM
@@ -379,14 +815,6 @@ int main(int argc, char* argv[])
         }
 
         // Initialize text renderer
-        game::RenderState render_state;
-        render_state.program = program;
-        render_state.mvp_location = mvp_location;
-        render_state.use_texture_location = use_texture_location;
-        render_state.texture_location = texture_location;
-        render_state.dice_texture_mode_location = dice_texture_mode_location;
-        render_state.color_override_location = color_override_location;
-        render_state.use_color_override_location = use_color_override_location;
 
         std::filesystem::path font_path = executable_dir / "pixel-game.regular.otf";
         if (!std::filesystem::exists(font_path))
@@ -405,6 +833,7 @@ int main(int argc, char* argv[])
         {
             throw std::runtime_error("Failed to initialize text renderer.");
         }
+        initialize_ui_batch(render_state.ui_batch);
 
         // Load menu textures
         std::filesystem::path assets_dir = source_dir.parent_path() / "assets";
@@ -421,37 +850,54 @@ int main(int argc, char* argv[])
         std::cout << "Initializing game loop and renderer..." << std::endl;
         game::GameLoop game_loop(window, camera, game_state, render_state);
         game::Renderer renderer(render_state);
-        std::cout << "Entering main game loop..." << std::endl;
+        renderer.set_culling_enabled(options.culling);
 
-        // Main game loop
-        game_state.last_time = static_cast<float>(glfwGetTime());
-        while (!window.should_close())
+        // Replays and benchmarks must start from a fresh game to be reproducible
+        if (!options.resume_path.empty() && !options.headless && !replay_log)
         {
-            const float current_time = static_cast<float>(glfwGetTime());
-            const float delta_time = current_time - game_state.last_time;
-            game_state.last_time = current_time;
-
-            window.poll_events();
-
-            if (window.is_key_pressed(GLFW_KEY_ESCAPE))
+            std::vector<unsigned char> save_data;
+            if (!game::read_save_file(options.resume_path, save_data))
             {
-                window.close();
+                std::cerr << "Warning: No saved game at " << options.resume_path << ", starting a new game\n";
             }
+            else if (!game::restore_game_state(game_state, save_data.data(), save_data.size()))
+            {
+                std::cerr << "Warning: Saved game " << options.resume_path
+                          << " is corrupt or from another version, starting a new game\n";
+            }
+            else
+            {
+                std::cout << "Resumed saved game from " << options.resume_path << std::endl;
+            }
+        }
+        if (!options.autosave_path.empty() && !options.headless && !replay_log)
+        {
+            game_loop.set_autosave(options.autosave_path);
+        }
 
-            // Update game
-            game_loop.update(delta_time);
-
-            // Render
-            renderer.render(window, camera, game_state);
-
-            window.swap_buffers();
+        if (options.headless)
+        {
+            game::RenderBenchmarkOptions benchmark_options;
+            benchmark_options.frame_count = options.frames;
+            benchmark_options.capture_dir = options.capture_dir;
+            benchmark_options.timings_path = options.timings_path;
+            game::run_render_benchmark(window, camera, game_state, renderer, benchmark_options);
+        }
+        else if (replay_log)
+        {
+            run_replay(window, camera, game_state, game_loop, renderer, *replay_log, options);
+        }
+        else
+        {
+            run_game(window, camera, game_state, render_state, game_loop, renderer, options);
         }
 
         // Cleanup
         game::menu::destroy_menu_textures();
         game::cleanup_game_state(game_state);
+        destroy_ui_batch(render_state.ui_batch);
         destroy_text_renderer(render_state.text_renderer);
-        glDeleteProgram(program);
+        destroy_shader_cache(render_state.shaders);
     }
     catch (const std::exception& ex)
     {
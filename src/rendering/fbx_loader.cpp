@@ -13,6 +13,7 @@
 
 #include "mesh.h"
 #include "texture_loader.h"
+#include "utils/bounds_utils.h"
 #include "utils/file_utils.h"
 #include "../../external/stb_image.h"
 
@@ -94,6 +95,7 @@ void process_node(const aiNode* node, const aiScene* scene, FBXModel& model,
         const aiMesh* ai_mesh = scene->mMeshes[node->mMeshes[i]];
         Mesh mesh = load_mesh_from_ai(ai_mesh);
         model.meshes.push_back(mesh);
+        expand_bounds(model.bounds, mesh.bounds);
     }
 
     // Process children
@@ -455,6 +457,7 @@ void destroy_fbx_model(FBXModel& model)
         destroy_mesh(mesh);
     }
     model.meshes.clear();
+    model.bounds = Bounds{};
     
     for (auto& texture : model.textures)
     {
@@ -13,6 +13,7 @@
 struct FBXModel
 {
     std::vector<Mesh> meshes;
+    Bounds bounds;  // Union of the mesh bounds, before base_transform
     glm::mat4 base_transform{1.0f};
     std::vector<Texture> textures;  // Textures loaded from the model
 };
@@ -0,0 +1,67 @@
+#include "frustum.h"
+
+#include "utils/bounds_utils.h"
+
+Frustum extract_frustum(const glm::mat4& view_projection)
+{
+    // glm is column-major: row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+    const glm::mat4& m = view_projection;
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;  // Left
+    frustum.planes[1] = row3 - row0;  // Right
+    frustum.planes[2] = row3 + row1;  // Bottom
+    frustum.planes[3] = row3 - row1;  // Top
+    frustum.planes[4] = row3 + row2;  // Near
+    frustum.planes[5] = row3 - row2;  // Far
+
+    for (glm::vec4& plane : frustum.planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+        {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool intersects_frustum(const Frustum& frustum, const Bounds& world_bounds)
+{
+    if (!is_valid(world_bounds))
+    {
+        return true;  // Nothing to test against - never cull what we can't reason about
+    }
+
+    for (const glm::vec4& plane : frustum.planes)
+    {
+        // Corner of the box furthest along the plane normal
+        const glm::vec3 positive(plane.x >= 0.0f ? world_bounds.max.x : world_bounds.min.x,
+                                 plane.y >= 0.0f ? world_bounds.max.y : world_bounds.min.y,
+                                 plane.z >= 0.0f ? world_bounds.max.z : world_bounds.min.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool intersects_frustum(const Frustum& frustum, const Bounds& local_bounds, const glm::mat4& model)
+{
+    return intersects_frustum(frustum, transform_bounds(local_bounds, model));
+}
+
+bool count_visible(CullStats& stats, bool visible)
+{
+    stats.tested++;
+    if (!visible)
+    {
+        stats.culled++;
+    }
+    return visible;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <glm/glm.hpp>
+#include <array>
+
+// View frustum as six inward-facing planes (a, b, c, d): a point p is inside
+// a plane when dot(plane.xyz, p) + plane.w >= 0
+struct Frustum
+{
+    std::array<glm::vec4, 6> planes{};  // Left, right, bottom, top, near, far
+};
+
+struct CullStats
+{
+    int tested = 0;  // Bounds tested this frame
+    int culled = 0;  // ...that were entirely outside the frustum
+};
+
+// Extracts the planes straight from a projection * view matrix (Gribb & Hartmann)
+Frustum extract_frustum(const glm::mat4& view_projection);
+
+// Conservative: may keep boxes that are just outside a corner, never drops a visible one
+bool intersects_frustum(const Frustum& frustum, const Bounds& world_bounds);
+bool intersects_frustum(const Frustum& frustum, const Bounds& local_bounds, const glm::mat4& model);
+
+// Records one test in stats and passes the result through
+bool count_visible(CullStats& stats, bool visible);
@@ -14,6 +14,7 @@
 
 #include "mesh.h"
 #include "texture_loader.h"
+#include "utils/bounds_utils.h"
 #include "utils/file_utils.h"
 
 GLTFModel load_gltf_model(const std::filesystem::path& path)
@@ -387,6 +388,8 @@ GLTFModel load_gltf_model(const std::filesystem::path& path)
             {
                 Mesh mesh = create_mesh(vertices, indices);
                 model.meshes.push_back(mesh);
+                expand_bounds(model.bounds, mesh.bounds);
+                append_mesh_lods(model.lods, vertices, indices);
                 
                 // Try to find texture for this primitive's material
                 if (primitive->material)
@@ -522,6 +525,13 @@ GLTFModel load_gltf_model(const std::filesystem::path& path)
         std::cout << "Warning: Model has NO animations. Player will be static (no movement animations).\n";
     }
 
+    std::cout << "LOD triangles:";
+    for (int lod = 0; lod < MESH_LOD_COUNT; ++lod)
+    {
+        std::cout << (lod > 0 ? " ->" : "") << ' ' << get_lod_triangle_count(model.meshes, model.lods, lod);
+    }
+    std::cout << '\n';
+
     cgltf_free(data);
     return model;
 }
@@ -533,6 +543,8 @@ void destroy_gltf_model(GLTFModel& model)
         destroy_mesh(mesh);
     }
     model.meshes.clear();
+    destroy_mesh_lods(model.lods);
+    model.bounds = Bounds{};
     
     for (auto& texture : model.textures)
     {
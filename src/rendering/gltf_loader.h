@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "mesh_lod.h"
 #include "texture_loader.h"
 #include <glm/gtc/quaternion.hpp>
 #include <filesystem>
@@ -29,6 +30,8 @@ struct GLTFAnimation
 struct GLTFModel
 {
     std::vector<Mesh> meshes;
+    Bounds bounds;  // Union of the mesh bounds, before base_transform
+    MeshLodChain lods;  // Simplified meshes, built at load
     glm::mat4 base_transform{1.0f};
     std::vector<Texture> textures;  // Textures loaded from the model
     std::vector<GLTFAnimation> animations;  // Animations from the model
@@ -0,0 +1,102 @@
+#include "gpu_timer.h"
+
+#include <glad/glad.h>
+
+namespace
+{
+    // Reads slot if finished (or unconditionally when wait is set) and frees it
+    bool read_query(GpuTimer& timer, int slot, std::vector<GpuTimerResult>& results, bool wait)
+    {
+        if (timer.query_frames[slot] < 0)
+        {
+            return false;
+        }
+
+        if (!wait)
+        {
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(timer.queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available == GL_FALSE)
+            {
+                return false;
+            }
+        }
+
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(timer.queries[slot], GL_QUERY_RESULT, &elapsed_ns);
+        results.push_back({timer.query_frames[slot], static_cast<double>(elapsed_ns) / 1.0e6});
+        timer.query_frames[slot] = -1;
+        return true;
+    }
+}
+
+void initialize_gpu_timer(GpuTimer& timer)
+{
+    if (timer.initialized)
+    {
+        destroy_gpu_timer(timer);
+    }
+
+    glGenQueries(GPU_TIMER_QUERY_COUNT, timer.queries.data());
+    timer.query_frames.fill(-1);
+    timer.next_query = 0;
+    timer.active = false;
+    timer.initialized = true;
+}
+
+void destroy_gpu_timer(GpuTimer& timer)
+{
+    if (!timer.initialized)
+    {
+        return;
+    }
+
+    glDeleteQueries(GPU_TIMER_QUERY_COUNT, timer.queries.data());
+    timer = GpuTimer{};
+}
+
+void begin_gpu_timer(GpuTimer& timer, std::int64_t frame, std::vector<GpuTimerResult>& results)
+{
+    if (!timer.initialized || timer.active)
+    {
+        return;
+    }
+
+    // Ring is full: the oldest query is GPU_TIMER_QUERY_COUNT frames old and
+    // almost certainly done, so waiting on it costs next to nothing
+    read_query(timer, timer.next_query, results, true);
+
+    timer.query_frames[timer.next_query] = frame;
+    glBeginQuery(GL_TIME_ELAPSED, timer.queries[timer.next_query]);
+    timer.active = true;
+}
+
+void end_gpu_timer(GpuTimer& timer)
+{
+    if (!timer.active)
+    {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    timer.active = false;
+    timer.next_query = (timer.next_query + 1) % GPU_TIMER_QUERY_COUNT;
+}
+
+void collect_gpu_timer(GpuTimer& timer, std::vector<GpuTimerResult>& results, bool wait)
+{
+    if (!timer.initialized)
+    {
+        return;
+    }
+
+    // Oldest first so results stay in frame order
+    for (int i = 0; i < GPU_TIMER_QUERY_COUNT; ++i)
+    {
+        const int slot = (timer.next_query + i) % GPU_TIMER_QUERY_COUNT;
+        if (!read_query(timer, slot, results, wait) && !wait && timer.query_frames[slot] >= 0)
+        {
+            break;  // Later queries can't be done before this one
+        }
+    }
+}
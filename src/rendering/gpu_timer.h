@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations for OpenGL types
+typedef unsigned int GLuint;
+
+constexpr int GPU_TIMER_QUERY_COUNT = 4;  // Frames a result may lag behind before we block on it
+
+// GL_TIME_ELAPSED queries in a small ring, so reading a frame's GPU time never
+// stalls the frames queued behind it. Results arrive a few frames late, tagged
+// with the frame index passed to begin_gpu_timer.
+struct GpuTimer
+{
+    std::array<GLuint, GPU_TIMER_QUERY_COUNT> queries{};
+    std::array<std::int64_t, GPU_TIMER_QUERY_COUNT> query_frames{};  // -1 = slot free
+    int next_query = 0;
+    bool active = false;
+    bool initialized = false;
+};
+
+struct GpuTimerResult
+{
+    std::int64_t frame = 0;
+    double milliseconds = 0.0;
+};
+
+void initialize_gpu_timer(GpuTimer& timer);
+void destroy_gpu_timer(GpuTimer& timer);
+
+// Brackets one frame's GL commands. If the next slot still holds an unread
+// query its result is waited for and appended to results first.
+void begin_gpu_timer(GpuTimer& timer, std::int64_t frame, std::vector<GpuTimerResult>& results);
+void end_gpu_timer(GpuTimer& timer);
+
+// Appends every finished result; wait = true blocks until all are in (end of run)
+void collect_gpu_timer(GpuTimer& timer, std::vector<GpuTimerResult>& results, bool wait);
@@ -0,0 +1,203 @@
+#include "latency_probe.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    constexpr double CALIBRATION_INTERVAL = 1.0;  // Seconds between GPU clock re-syncs
+    constexpr GLuint64 WAIT_FOREVER = ~GLuint64{0};
+
+    int oldest_pending(const LatencyProbe& probe)
+    {
+        return (probe.next_frame - probe.pending_frames + LATENCY_PROBE_FRAME_COUNT) % LATENCY_PROBE_FRAME_COUNT;
+    }
+
+    // Reads the oldest pending frame if the GPU is done with it (or waits for it)
+    bool read_oldest_frame(LatencyProbe& probe, bool wait)
+    {
+        if (probe.pending_frames == 0)
+        {
+            return false;
+        }
+
+        LatencyProbe::Frame& frame = probe.frames[oldest_pending(probe)];
+        const GLenum status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? WAIT_FOREVER : 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            return false;
+        }
+        glDeleteSync(frame.fence);
+        frame.fence = nullptr;
+        --probe.pending_frames;
+
+        if (probe.measure)
+        {
+            GLuint64 gpu_ns = 0;
+            glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &gpu_ns);
+            const double done_time = static_cast<double>(gpu_ns) * 1.0e-9 + probe.gpu_clock_offset;
+            probe.present_to_gpu_done.push_back((done_time - frame.present_time) * 1000.0);
+            for (double input_time : frame.inputs)
+            {
+                probe.input_to_present.push_back((frame.present_time - input_time) * 1000.0);
+                probe.input_to_gpu_done.push_back((done_time - input_time) * 1000.0);
+            }
+            frame.inputs.clear();
+        }
+        return true;
+    }
+
+    void calibrate_gpu_clock(LatencyProbe& probe, double now)
+    {
+        GLint64 gpu_ns = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpu_ns);
+        probe.gpu_clock_offset = glfwGetTime() - static_cast<double>(gpu_ns) * 1.0e-9;
+        probe.last_calibration = now;
+    }
+
+    void print_percentiles(const char* label, std::vector<double> samples)
+    {
+        if (samples.empty())
+        {
+            std::cout << label << ": no samples\n";
+            return;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        const auto percentile = [&samples](double p) {
+            // Nearest rank
+            const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+            return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+        };
+        double total = 0.0;
+        for (double sample : samples)
+        {
+            total += sample;
+        }
+        std::cout << std::fixed << std::setprecision(2)
+                  << label << " ms: mean " << total / static_cast<double>(samples.size()) << ", p50 "
+                  << percentile(0.50) << ", p90 " << percentile(0.90) << ", p99 " << percentile(0.99) << ", max "
+                  << samples.back() << " (" << samples.size() << " samples)\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+
+void initialize_latency_probe(LatencyProbe& probe, bool measure)
+{
+    if (probe.initialized)
+    {
+        destroy_latency_probe(probe);
+    }
+
+    probe.measure = measure;
+    if (measure)
+    {
+        for (LatencyProbe::Frame& frame : probe.frames)
+        {
+            glGenQueries(1, &frame.query);
+        }
+        calibrate_gpu_clock(probe, glfwGetTime());
+    }
+    probe.initialized = true;
+}
+
+void destroy_latency_probe(LatencyProbe& probe)
+{
+    if (!probe.initialized)
+    {
+        return;
+    }
+
+    for (LatencyProbe::Frame& frame : probe.frames)
+    {
+        if (frame.fence)
+        {
+            glDeleteSync(frame.fence);
+        }
+        if (frame.query != 0)
+        {
+            glDeleteQueries(1, &frame.query);
+        }
+    }
+    probe = LatencyProbe{};
+}
+
+void record_latency_input(LatencyProbe& probe, double time)
+{
+    if (probe.measure)
+    {
+        probe.waiting_inputs.push_back(time);
+    }
+}
+
+void wait_for_frames_in_flight(LatencyProbe& probe, int max_frames_in_flight)
+{
+    if (!probe.initialized)
+    {
+        return;
+    }
+
+    if (max_frames_in_flight > 0)
+    {
+        const int limit = std::min(max_frames_in_flight, LATENCY_PROBE_FRAME_COUNT);
+        while (probe.pending_frames >= limit)
+        {
+            read_oldest_frame(probe, true);
+        }
+    }
+    while (read_oldest_frame(probe, false))
+    {
+    }
+}
+
+void mark_latency_present(LatencyProbe& probe, double shown_until)
+{
+    if (!probe.initialized)
+    {
+        return;
+    }
+
+    // Ring is full: the oldest frame is LATENCY_PROBE_FRAME_COUNT presents old
+    // and almost certainly done, so waiting on it costs next to nothing
+    if (probe.pending_frames == LATENCY_PROBE_FRAME_COUNT)
+    {
+        read_oldest_frame(probe, true);
+    }
+
+    const double now = glfwGetTime();
+    LatencyProbe::Frame& frame = probe.frames[probe.next_frame];
+    if (probe.measure)
+    {
+        if (now - probe.last_calibration >= CALIBRATION_INTERVAL)
+        {
+            calibrate_gpu_clock(probe, now);
+        }
+        glQueryCounter(frame.query, GL_TIMESTAMP);
+
+        // Presses the simulation had taken in by the presented snapshot
+        const auto shown = std::partition(probe.waiting_inputs.begin(), probe.waiting_inputs.end(),
+                                          [shown_until](double time) { return time <= shown_until; });
+        frame.inputs.assign(probe.waiting_inputs.begin(), shown);
+        probe.waiting_inputs.erase(probe.waiting_inputs.begin(), shown);
+    }
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.present_time = now;
+    probe.next_frame = (probe.next_frame + 1) % LATENCY_PROBE_FRAME_COUNT;
+    ++probe.pending_frames;
+}
+
+void print_latency_report(const LatencyProbe& probe)
+{
+    if (!probe.measure)
+    {
+        return;
+    }
+    print_percentiles("Key press to present", probe.input_to_present);
+    print_percentiles("Key press to GPU done", probe.input_to_gpu_done);
+    print_percentiles("Present to GPU done", probe.present_to_gpu_done);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+// Forward declarations for OpenGL types
+typedef unsigned int GLuint;
+typedef struct __GLsync* GLsync;
+
+constexpr int LATENCY_PROBE_FRAME_COUNT = 8;  // Presented frames that may be unfinished at once
+
+// Input-to-display latency. Every presented frame gets a GL_TIMESTAMP query and
+// a fence behind its swap; once the fence has signalled, the query says when
+// the GPU finished the frame, on the glfwGetTime() clock. Each key press is
+// charged to the first frame whose snapshot includes it, so press -> GPU done
+// is the latency up to scan-out (vsync adds up to one refresh on top).
+//
+// The fences also limit how many frames the CPU may queue ahead of the GPU;
+// waiting on them before input is sampled keeps that input fresh.
+struct LatencyProbe
+{
+    struct Frame
+    {
+        GLsync fence = nullptr;
+        GLuint query = 0;
+        double present_time = 0.0;   // glfwGetTime() right after the swap
+        std::vector<double> inputs;  // Key presses this frame is the first to show
+    };
+
+    std::array<Frame, LATENCY_PROBE_FRAME_COUNT> frames{};
+    int next_frame = 0;      // Slot the next present uses
+    int pending_frames = 0;  // Presented frames whose fence has not been read
+    std::vector<double> waiting_inputs;  // Presses no presented frame shows yet
+    double gpu_clock_offset = 0.0;       // glfwGetTime() minus GL_TIMESTAMP, in seconds
+    double last_calibration = -1.0;
+    bool measure = false;  // false = frame limiting only, no queries or samples
+    bool initialized = false;
+
+    // Milliseconds: per press to present and to GPU done, per frame present to GPU done
+    std::vector<double> input_to_present;
+    std::vector<double> input_to_gpu_done;
+    std::vector<double> present_to_gpu_done;
+};
+
+void initialize_latency_probe(LatencyProbe& probe, bool measure);
+void destroy_latency_probe(LatencyProbe& probe);
+
+// A key press at time (glfwGetTime() seconds); main thread only
+void record_latency_input(LatencyProbe& probe, double time);
+
+// Reads every finished frame, first blocking until fewer than
+// max_frames_in_flight presented frames are unfinished (0 = no limit)
+void wait_for_frames_in_flight(LatencyProbe& probe, int max_frames_in_flight);
+
+// Right after swap_buffers. shown_until is the latest input time the presented
+// frame reflects (RenderSnapshot::tick_time).
+void mark_latency_present(LatencyProbe& probe, double shown_until);
+
+// Percentiles of everything measured so far
+void print_latency_report(const LatencyProbe& probe);
@@ -1,5 +1,7 @@
 #include "mesh.h"
 
+#include "utils/bounds_utils.h"
+
 #include <glad/glad.h>
 #include <cstddef>
 
@@ -48,6 +50,10 @@ Mesh create_mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned
     glBindVertexArray(0);
 
     mesh.index_count = static_cast<GLsizei>(indices.size());
+    for (const Vertex& vertex : vertices)
+    {
+        expand_bounds(mesh.bounds, vertex.position);
+    }
     return mesh;
 }
 
@@ -69,5 +75,6 @@ void destroy_mesh(Mesh& mesh)
         mesh.vao = 0;
     }
     mesh.index_count = 0;
+    mesh.bounds = Bounds{};
 }
 
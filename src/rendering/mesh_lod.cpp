@@ -0,0 +1,109 @@
+#include "mesh_lod.h"
+
+#include "mesh.h"
+#include "mesh_simplifier.h"
+#include "utils/bounds_utils.h"
+
+#include <algorithm>
+
+namespace
+{
+    // A level has to drop at least this share of the previous level's triangles to be worth a draw
+    constexpr float MIN_LOD_REDUCTION = 0.85f;
+}
+
+void append_mesh_lods(MeshLodChain& chain, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    std::size_t previous_index_count = indices.size();
+    for (int lod = 1; lod < MESH_LOD_COUNT; ++lod)
+    {
+        const std::size_t target = static_cast<std::size_t>(static_cast<float>(indices.size()) * MESH_LOD_TRIANGLE_RATIOS[lod]) / 3 * 3;
+        const std::vector<unsigned int> simplified = simplify_mesh(vertices, indices, target);
+
+        if (simplified.empty() || static_cast<float>(simplified.size()) > static_cast<float>(previous_index_count) * MIN_LOD_REDUCTION)
+        {
+            chain.levels[lod - 1].push_back(Mesh{});
+            continue;
+        }
+
+        std::vector<Vertex> lod_vertices;
+        std::vector<unsigned int> lod_indices;
+        compact_mesh(vertices, simplified, lod_vertices, lod_indices);
+        chain.levels[lod - 1].push_back(create_mesh(lod_vertices, lod_indices));
+        previous_index_count = simplified.size();
+    }
+}
+
+void destroy_mesh_lods(MeshLodChain& chain)
+{
+    for (auto& level : chain.levels)
+    {
+        for (Mesh& mesh : level)
+        {
+            destroy_mesh(mesh);
+        }
+        level.clear();
+    }
+}
+
+const Mesh& get_lod_mesh(const std::vector<Mesh>& meshes, const MeshLodChain& chain, std::size_t mesh_index, int lod)
+{
+    for (int level = std::min(lod, MESH_LOD_COUNT - 1); level > 0; --level)
+    {
+        const auto& lod_meshes = chain.levels[level - 1];
+        if (mesh_index < lod_meshes.size() && lod_meshes[mesh_index].vao != 0)
+        {
+            return lod_meshes[mesh_index];
+        }
+    }
+    return meshes[mesh_index];
+}
+
+std::size_t get_lod_triangle_count(const std::vector<Mesh>& meshes, const MeshLodChain& chain, int lod)
+{
+    std::size_t triangles = 0;
+    for (std::size_t i = 0; i < meshes.size(); ++i)
+    {
+        triangles += static_cast<std::size_t>(get_lod_mesh(meshes, chain, i, lod).index_count) / 3;
+    }
+    return triangles;
+}
+
+float get_projected_size(const Bounds& local_bounds, const glm::mat4& model, const glm::mat4& view,
+                         const glm::mat4& projection, float viewport_height)
+{
+    if (!is_valid(local_bounds))
+    {
+        return viewport_height;  // Unknown size - treat as close up
+    }
+
+    const Bounds world_bounds = transform_bounds(local_bounds, model);
+    const glm::vec3 center = (world_bounds.min + world_bounds.max) * 0.5f;
+    const float radius = glm::length(world_bounds.max - world_bounds.min) * 0.5f;
+
+    const float view_depth = -(view * glm::vec4(center, 1.0f)).z;
+    if (view_depth <= radius)
+    {
+        return viewport_height;  // Camera is inside or right against the sphere
+    }
+    // projection[1][1] = cot(fov_y / 2): a unit at depth 1 spans projection[1][1] half-screens
+    return radius * projection[1][1] / view_depth * viewport_height;
+}
+
+int select_mesh_lod(float projected_size, int current_lod)
+{
+    int lod = 0;
+    for (int level = 1; level < MESH_LOD_COUNT; ++level)
+    {
+        float threshold = MESH_LOD_SWITCH_PIXELS[level - 1];
+        if (current_lod >= level)
+        {
+            threshold *= MESH_LOD_HYSTERESIS;  // Already this coarse - only refine once clearly bigger
+        }
+        if (projected_size < threshold)
+        {
+            lod = level;
+        }
+    }
+    return lod;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// LOD 0 is the mesh as loaded; each further level keeps roughly this fraction of its triangles
+constexpr int MESH_LOD_COUNT = 3;
+constexpr std::array<float, MESH_LOD_COUNT> MESH_LOD_TRIANGLE_RATIOS = {1.0f, 0.4f, 0.15f};
+
+// Switch to level N once the projected height drops below MESH_LOD_SWITCH_PIXELS[N - 1].
+// Going back to a finer level needs MESH_LOD_HYSTERESIS times that size, so a model
+// hovering around a threshold doesn't flicker between levels.
+constexpr std::array<float, MESH_LOD_COUNT - 1> MESH_LOD_SWITCH_PIXELS = {160.0f, 60.0f};
+constexpr float MESH_LOD_HYSTERESIS = 1.25f;
+
+// Simplified copies of a model's meshes: levels[N - 1][i] is mesh i at LOD N.
+// A level that could not be reduced meaningfully holds an empty Mesh (vao == 0)
+// and draws fall back to the next finer level.
+struct MeshLodChain
+{
+    std::array<std::vector<Mesh>, MESH_LOD_COUNT - 1> levels;
+};
+
+struct LodStats
+{
+    std::array<int, MESH_LOD_COUNT> models_per_level{};
+    long long triangles = 0;
+};
+
+// Builds every coarser level for one source mesh and appends it to the chain
+void append_mesh_lods(MeshLodChain& chain, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+void destroy_mesh_lods(MeshLodChain& chain);
+
+const Mesh& get_lod_mesh(const std::vector<Mesh>& meshes, const MeshLodChain& chain, std::size_t mesh_index, int lod);
+std::size_t get_lod_triangle_count(const std::vector<Mesh>& meshes, const MeshLodChain& chain, int lod);
+
+// Height in pixels of the bounds' enclosing sphere after model, view and projection
+float get_projected_size(const Bounds& local_bounds, const glm::mat4& model, const glm::mat4& view,
+                         const glm::mat4& projection, float viewport_height);
+int select_mesh_lod(float projected_size, int current_lod);
@@ -0,0 +1,430 @@
+#include "mesh_simplifier.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+    constexpr unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+    constexpr double MIN_NORMAL_COSINE = 0.2;  // Reject collapses that turn a face more than ~78 degrees
+
+    // Symmetric 4x4 error quadric, stored as its upper triangle
+    struct Quadric
+    {
+        double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+        double b2 = 0.0, bc = 0.0, bd = 0.0;
+        double c2 = 0.0, cd = 0.0;
+        double d2 = 0.0;
+    };
+
+    Quadric make_plane_quadric(const glm::dvec3& normal, double d, double weight)
+    {
+        Quadric q;
+        q.a2 = normal.x * normal.x * weight;
+        q.ab = normal.x * normal.y * weight;
+        q.ac = normal.x * normal.z * weight;
+        q.ad = normal.x * d * weight;
+        q.b2 = normal.y * normal.y * weight;
+        q.bc = normal.y * normal.z * weight;
+        q.bd = normal.y * d * weight;
+        q.c2 = normal.z * normal.z * weight;
+        q.cd = normal.z * d * weight;
+        q.d2 = d * d * weight;
+        return q;
+    }
+
+    void add_quadric(Quadric& target, const Quadric& q)
+    {
+        target.a2 += q.a2; target.ab += q.ab; target.ac += q.ac; target.ad += q.ad;
+        target.b2 += q.b2; target.bc += q.bc; target.bd += q.bd;
+        target.c2 += q.c2; target.cd += q.cd;
+        target.d2 += q.d2;
+    }
+
+    double evaluate_quadric(const Quadric& q, const glm::dvec3& p)
+    {
+        // p^T Q p with p = (x, y, z, 1)
+        return q.a2 * p.x * p.x + 2.0 * q.ab * p.x * p.y + 2.0 * q.ac * p.x * p.z + 2.0 * q.ad * p.x
+             + q.b2 * p.y * p.y + 2.0 * q.bc * p.y * p.z + 2.0 * q.bd * p.y
+             + q.c2 * p.z * p.z + 2.0 * q.cd * p.z
+             + q.d2;
+    }
+
+    struct PositionKey
+    {
+        std::uint32_t x, y, z;
+        bool operator==(const PositionKey& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    struct PositionKeyHash
+    {
+        std::size_t operator()(const PositionKey& key) const
+        {
+            return (static_cast<std::size_t>(key.x) * 73856093u) ^
+                   (static_cast<std::size_t>(key.y) * 19349663u) ^
+                   (static_cast<std::size_t>(key.z) * 83492791u);
+        }
+    };
+
+    PositionKey make_position_key(const glm::vec3& position)
+    {
+        PositionKey key{};
+        std::memcpy(&key.x, &position.x, sizeof(float));
+        std::memcpy(&key.y, &position.y, sizeof(float));
+        std::memcpy(&key.z, &position.z, sizeof(float));
+        return key;
+    }
+
+    struct Collapse
+    {
+        double cost;
+        unsigned int from;
+        unsigned int to;
+        std::uint32_t from_version;
+        std::uint32_t to_version;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    class Simplifier
+    {
+    public:
+        Simplifier(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+            : m_vertices(vertices)
+            , m_indices(indices)
+            , m_remap(vertices.size())
+            , m_locked(vertices.size(), false)
+            , m_versions(vertices.size(), 0)
+            , m_quadrics(vertices.size())
+            , m_vertex_triangles(vertices.size())
+            , m_triangle_alive(indices.size() / 3, true)
+            , m_live_triangles(indices.size() / 3)
+        {
+            for (unsigned int v = 0; v < m_remap.size(); ++v)
+            {
+                m_remap[v] = v;
+            }
+            build_topology();
+            build_quadrics();
+        }
+
+        std::vector<unsigned int> run(std::size_t target_index_count)
+        {
+            const std::size_t target_triangles = target_index_count / 3;
+
+            for (std::size_t t = 0; t < m_triangle_alive.size(); ++t)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    const unsigned int a = m_indices[t * 3 + corner];
+                    const unsigned int b = m_indices[t * 3 + (corner + 1) % 3];
+                    push_collapse(a, b);
+                    push_collapse(b, a);
+                }
+            }
+
+            while (m_live_triangles > target_triangles && !m_queue.empty())
+            {
+                const Collapse collapse = m_queue.top();
+                m_queue.pop();
+
+                if (resolve(collapse.from) != collapse.from || resolve(collapse.to) != collapse.to)
+                {
+                    continue;  // One end has already been collapsed away
+                }
+                if (collapse.from_version != m_versions[collapse.from] || collapse.to_version != m_versions[collapse.to])
+                {
+                    push_collapse(collapse.from, collapse.to);  // Quadrics changed - re-queue at the new cost
+                    continue;
+                }
+                if (!is_still_edge(collapse.from, collapse.to) || would_flip(collapse.from, collapse.to))
+                {
+                    continue;
+                }
+                apply_collapse(collapse.from, collapse.to);
+            }
+
+            std::vector<unsigned int> result;
+            result.reserve(m_live_triangles * 3);
+            for (std::size_t t = 0; t < m_triangle_alive.size(); ++t)
+            {
+                if (m_triangle_alive[t])
+                {
+                    result.push_back(resolve(m_indices[t * 3 + 0]));
+                    result.push_back(resolve(m_indices[t * 3 + 1]));
+                    result.push_back(resolve(m_indices[t * 3 + 2]));
+                }
+            }
+            return result;
+        }
+
+    private:
+        void build_topology()
+        {
+            // Weld by exact position to find seams; a seam vertex has siblings at the same spot
+            std::unordered_map<PositionKey, unsigned int, PositionKeyHash> position_groups;
+            std::vector<unsigned int> group_of(m_vertices.size());
+            std::vector<int> group_size;
+            for (unsigned int v = 0; v < m_vertices.size(); ++v)
+            {
+                const auto [it, inserted] = position_groups.emplace(make_position_key(m_vertices[v].position),
+                                                                    static_cast<unsigned int>(group_size.size()));
+                if (inserted)
+                {
+                    group_size.push_back(0);
+                }
+                group_of[v] = it->second;
+                group_size[it->second]++;
+            }
+
+            // Edges used by exactly one triangle are open borders; more than two is non-manifold
+            std::unordered_map<std::uint64_t, int> edge_use;
+            for (std::size_t t = 0; t < m_triangle_alive.size(); ++t)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    const unsigned int v = m_indices[t * 3 + corner];
+                    m_vertex_triangles[v].push_back(static_cast<unsigned int>(t));
+
+                    const std::uint64_t a = group_of[v];
+                    const std::uint64_t b = group_of[m_indices[t * 3 + (corner + 1) % 3]];
+                    edge_use[a < b ? (a << 32) | b : (b << 32) | a]++;
+                }
+            }
+
+            std::vector<bool> group_locked(group_size.size(), false);
+            for (std::size_t g = 0; g < group_size.size(); ++g)
+            {
+                group_locked[g] = group_size[g] > 1;
+            }
+            for (const auto& [edge, uses] : edge_use)
+            {
+                if (uses != 2)
+                {
+                    group_locked[static_cast<std::size_t>(edge >> 32)] = true;
+                    group_locked[static_cast<std::size_t>(edge & 0xFFFFFFFFu)] = true;
+                }
+            }
+            for (unsigned int v = 0; v < m_vertices.size(); ++v)
+            {
+                m_locked[v] = group_locked[group_of[v]];
+            }
+        }
+
+        void build_quadrics()
+        {
+            for (std::size_t t = 0; t < m_triangle_alive.size(); ++t)
+            {
+                const glm::dvec3 p0 = position(m_indices[t * 3 + 0]);
+                const glm::dvec3 p1 = position(m_indices[t * 3 + 1]);
+                const glm::dvec3 p2 = position(m_indices[t * 3 + 2]);
+                const glm::dvec3 cross = glm::cross(p1 - p0, p2 - p0);
+                const double double_area = glm::length(cross);
+                if (double_area <= 0.0)
+                {
+                    continue;
+                }
+                const glm::dvec3 normal = cross / double_area;
+                // Area-weighted so big faces resist being folded more than slivers do
+                const Quadric q = make_plane_quadric(normal, -glm::dot(normal, p0), double_area * 0.5);
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    add_quadric(m_quadrics[m_indices[t * 3 + corner]], q);
+                }
+            }
+        }
+
+        glm::dvec3 position(unsigned int v) const
+        {
+            return glm::dvec3(m_vertices[v].position);
+        }
+
+        unsigned int resolve(unsigned int v)
+        {
+            unsigned int root = v;
+            while (m_remap[root] != root)
+            {
+                root = m_remap[root];
+            }
+            while (m_remap[v] != root)
+            {
+                const unsigned int next = m_remap[v];
+                m_remap[v] = root;
+                v = next;
+            }
+            return root;
+        }
+
+        void push_collapse(unsigned int from, unsigned int to)
+        {
+            if (from == to || m_locked[from])
+            {
+                return;
+            }
+            Quadric combined = m_quadrics[from];
+            add_quadric(combined, m_quadrics[to]);
+            m_queue.push({evaluate_quadric(combined, position(to)), from, to, m_versions[from], m_versions[to]});
+        }
+
+        bool is_still_edge(unsigned int from, unsigned int to)
+        {
+            for (unsigned int t : m_vertex_triangles[from])
+            {
+                if (!m_triangle_alive[t])
+                {
+                    continue;
+                }
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    if (resolve(m_indices[t * 3 + corner]) == to)
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        bool would_flip(unsigned int from, unsigned int to)
+        {
+            const glm::dvec3 target = position(to);
+            for (unsigned int t : m_vertex_triangles[from])
+            {
+                if (!m_triangle_alive[t])
+                {
+                    continue;
+                }
+
+                unsigned int corners[3];
+                bool touches_target = false;
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    corners[corner] = resolve(m_indices[t * 3 + corner]);
+                    touches_target = touches_target || corners[corner] == to;
+                }
+                if (touches_target)
+                {
+                    continue;  // This triangle disappears with the collapse
+                }
+
+                glm::dvec3 before[3];
+                glm::dvec3 after[3];
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    before[corner] = position(corners[corner]);
+                    after[corner] = corners[corner] == from ? target : before[corner];
+                }
+                const glm::dvec3 normal_before = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::dvec3 normal_after = glm::cross(after[1] - after[0], after[2] - after[0]);
+                const double lengths = glm::length(normal_before) * glm::length(normal_after);
+                if (lengths <= 0.0 || glm::dot(normal_before, normal_after) < MIN_NORMAL_COSINE * lengths)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void apply_collapse(unsigned int from, unsigned int to)
+        {
+            m_remap[from] = to;
+            add_quadric(m_quadrics[to], m_quadrics[from]);
+            m_versions[to]++;
+
+            for (unsigned int t : m_vertex_triangles[from])
+            {
+                if (!m_triangle_alive[t])
+                {
+                    continue;
+                }
+                const unsigned int a = resolve(m_indices[t * 3 + 0]);
+                const unsigned int b = resolve(m_indices[t * 3 + 1]);
+                const unsigned int c = resolve(m_indices[t * 3 + 2]);
+                if (a == b || b == c || a == c)
+                {
+                    m_triangle_alive[t] = false;
+                    m_live_triangles--;
+                }
+                else
+                {
+                    m_vertex_triangles[to].push_back(t);
+                }
+            }
+            m_vertex_triangles[from].clear();
+
+            // Re-evaluate every edge around the merged vertex against its new quadric
+            for (unsigned int t : m_vertex_triangles[to])
+            {
+                if (!m_triangle_alive[t])
+                {
+                    continue;
+                }
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    const unsigned int neighbour = resolve(m_indices[t * 3 + corner]);
+                    if (neighbour != to)
+                    {
+                        push_collapse(to, neighbour);
+                        push_collapse(neighbour, to);
+                    }
+                }
+            }
+        }
+
+        const std::vector<Vertex>& m_vertices;
+        const std::vector<unsigned int>& m_indices;
+        std::vector<unsigned int> m_remap;  // Collapsed vertex -> vertex it was merged into
+        std::vector<bool> m_locked;
+        std::vector<std::uint32_t> m_versions;
+        std::vector<Quadric> m_quadrics;
+        std::vector<std::vector<unsigned int>> m_vertex_triangles;
+        std::vector<bool> m_triangle_alive;
+        std::size_t m_live_triangles;
+        std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> m_queue;
+    };
+}
+
+std::vector<unsigned int> simplify_mesh(const std::vector<Vertex>& vertices,
+                                        const std::vector<unsigned int>& indices,
+                                        std::size_t target_index_count)
+{
+    if (indices.size() <= target_index_count || indices.size() % 3 != 0)
+    {
+        return indices;
+    }
+    for (unsigned int index : indices)
+    {
+        if (index >= vertices.size())
+        {
+            return indices;  // Malformed input - leave it alone
+        }
+    }
+
+    Simplifier simplifier(vertices, indices);
+    return simplifier.run(target_index_count);
+}
+
+void compact_mesh(const std::vector<Vertex>& vertices,
+                  const std::vector<unsigned int>& indices,
+                  std::vector<Vertex>& out_vertices,
+                  std::vector<unsigned int>& out_indices)
+{
+    std::vector<unsigned int> new_index(vertices.size(), INVALID_INDEX);
+    out_vertices.clear();
+    out_indices.clear();
+    out_indices.reserve(indices.size());
+    for (unsigned int index : indices)
+    {
+        if (new_index[index] == INVALID_INDEX)
+        {
+            new_index[index] = static_cast<unsigned int>(out_vertices.size());
+            out_vertices.push_back(vertices[index]);
+        }
+        out_indices.push_back(new_index[index]);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "core/types.h"
+
+#include <cstddef>
+#include <vector>
+
+// Quadric error metric simplification (Garland & Heckbert) using half-edge
+// collapses: a vertex is only ever merged into one of its neighbours, so every
+// surviving vertex keeps its original position, colour and texcoord and the
+// result indexes the input vertex array unchanged.
+//
+// Vertices on open borders or UV seams (several vertices sharing a position)
+// are never moved, which keeps silhouettes and texture layout intact at the
+// cost of stopping early on heavily seamed meshes.
+//
+// Returns at most target_index_count indices (a multiple of 3), or fewer
+// collapses if no legal collapse remains. Triangles whose normal would flip
+// are never produced.
+std::vector<unsigned int> simplify_mesh(const std::vector<Vertex>& vertices,
+                                        const std::vector<unsigned int>& indices,
+                                        std::size_t target_index_count);
+
+// Drops vertices no index refers to and rewrites indices to match
+void compact_mesh(const std::vector<Vertex>& vertices,
+                  const std::vector<unsigned int>& indices,
+                  std::vector<Vertex>& out_vertices,
+                  std::vector<unsigned int>& out_indices);
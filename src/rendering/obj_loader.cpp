@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "mesh.h"
+#include "utils/bounds_utils.h"
 #include "utils/file_utils.h"
 
 OBJModel load_obj_model(const std::filesystem::path& path)
@@ -155,6 +156,8 @@ OBJModel load_obj_model(const std::filesystem::path& path)
     {
         Mesh mesh = create_mesh(vertices, indices);
         model.meshes.push_back(mesh);
+        expand_bounds(model.bounds, mesh.bounds);
+        append_mesh_lods(model.lods, vertices, indices);
     }
 
     return model;
@@ -167,5 +170,7 @@ void destroy_obj_model(OBJModel& model)
         destroy_mesh(mesh);
     }
     model.meshes.clear();
+    destroy_mesh_lods(model.lods);
+    model.bounds = Bounds{};
 }
 
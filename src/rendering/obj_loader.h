@@ -1,12 +1,15 @@
 #pragma once
 
 #include "core/types.h"
+#include "mesh_lod.h"
 #include <filesystem>
 #include <vector>
 
 struct OBJModel
 {
     std::vector<Mesh> meshes;
+    Bounds bounds;  // Union of the mesh bounds, before base_transform
+    MeshLodChain lods;  // Simplified meshes, built at load
     glm::mat4 base_transform{1.0f};
 };
 
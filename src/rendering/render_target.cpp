@@ -0,0 +1,83 @@
+#include "render_target.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+void create_render_target(RenderTarget& target, int width, int height)
+{
+    destroy_render_target(target);
+
+    target.width = std::max(width, 1);
+    target.height = std::max(height, 1);
+
+    glGenRenderbuffers(1, &target.color_renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.color_renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, target.width, target.height);
+
+    glGenRenderbuffers(1, &target.depth_renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depth_renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, target.width, target.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.color_renderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depth_renderbuffer);
+
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        destroy_render_target(target);
+        throw std::runtime_error("Offscreen framebuffer incomplete (status " + std::to_string(status) + ")");
+    }
+}
+
+void destroy_render_target(RenderTarget& target)
+{
+    if (target.framebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &target.framebuffer);
+    }
+    if (target.color_renderbuffer != 0)
+    {
+        glDeleteRenderbuffers(1, &target.color_renderbuffer);
+    }
+    if (target.depth_renderbuffer != 0)
+    {
+        glDeleteRenderbuffers(1, &target.depth_renderbuffer);
+    }
+    target = RenderTarget{};
+}
+
+void bind_render_target(const RenderTarget& target)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glViewport(0, 0, target.width, target.height);
+}
+
+void read_render_target_pixels(const RenderTarget& target, std::vector<unsigned char>& rgba)
+{
+    const std::size_t row_bytes = static_cast<std::size_t>(target.width) * 4;
+    rgba.resize(row_bytes * static_cast<std::size_t>(target.height));
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, target.framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, target.width, target.height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+
+    // Flip in place so row 0 is the top of the image
+    std::vector<unsigned char> swap_row(row_bytes);
+    for (int top = 0, bottom = target.height - 1; top < bottom; ++top, --bottom)
+    {
+        unsigned char* top_row = rgba.data() + static_cast<std::size_t>(top) * row_bytes;
+        unsigned char* bottom_row = rgba.data() + static_cast<std::size_t>(bottom) * row_bytes;
+        std::memcpy(swap_row.data(), top_row, row_bytes);
+        std::memcpy(top_row, bottom_row, row_bytes);
+        std::memcpy(bottom_row, swap_row.data(), row_bytes);
+    }
+}
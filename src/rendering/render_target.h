@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+// Forward declarations for OpenGL types
+typedef unsigned int GLuint;
+
+// Framebuffer object with an RGBA8 colour and 24-bit depth / 8-bit stencil
+// renderbuffer, used to render without a visible window (captures, benchmarks)
+struct RenderTarget
+{
+    GLuint framebuffer = 0;
+    GLuint color_renderbuffer = 0;
+    GLuint depth_renderbuffer = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Throws std::runtime_error if the driver reports the framebuffer incomplete
+void create_render_target(RenderTarget& target, int width, int height);
+void destroy_render_target(RenderTarget& target);
+
+// Binds the target for drawing and reading and sets the viewport to cover it
+void bind_render_target(const RenderTarget& target);
+
+// Reads the colour buffer back as tightly packed RGBA8, rows top to bottom
+// (GL returns them bottom-up). Blocks until rendering into the target finishes.
+void read_render_target_pixels(const RenderTarget& target, std::vector<unsigned char>& rgba);
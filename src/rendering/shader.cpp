@@ -28,7 +28,8 @@ GLuint compile_shader(GLenum shader_type, const std::string& source)
     return shader;
 }
 
-GLuint create_program(const std::string& vertex_source, const std::string& fragment_source)
+GLuint create_program(const std::string& vertex_source, const std::string& fragment_source,
+                      bool binary_retrievable)
 {
     GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER, vertex_source);
     GLuint fragment_shader = compile_shader(GL_FRAGMENT_SHADER, fragment_source);
@@ -36,6 +37,10 @@ GLuint create_program(const std::string& vertex_source, const std::string& fragm
     GLuint program = glCreateProgram();
     glAttachShader(program, vertex_shader);
     glAttachShader(program, fragment_shader);
+    if (binary_retrievable)
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glLinkProgram(program);
 
     GLint success = 0;
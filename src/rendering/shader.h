@@ -8,5 +8,8 @@ typedef unsigned int GLuint;
 typedef unsigned int GLenum;
 
 GLuint compile_shader(GLenum shader_type, const std::string& source);
-GLuint create_program(const std::string& vertex_source, const std::string& fragment_source);
+// binary_retrievable: link with GL_PROGRAM_BINARY_RETRIEVABLE_HINT so the result
+// can be saved with glGetProgramBinary (see shader_cache.h)
+GLuint create_program(const std::string& vertex_source, const std::string& fragment_source,
+                      bool binary_retrievable = false);
 
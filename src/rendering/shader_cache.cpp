@@ -0,0 +1,294 @@
+#include "shader_cache.h"
+
+#include "shader.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t CACHE_FILE_VERSION = 1;
+    constexpr char CACHE_FILE_MAGIC[4] = {'S', 'N', 'L', 'P'};
+
+    struct CacheFileHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t binary_format;
+        std::uint32_t binary_length;
+    };
+
+    const char* variant_define(ShaderVariant variant)
+    {
+        switch (variant)
+        {
+            case ShaderVariant::Textured: return "#define VARIANT_TEXTURED\n";
+            case ShaderVariant::Text: return "#define VARIANT_TEXT\n";
+            case ShaderVariant::Dice: return "#define VARIANT_DICE\n";
+            case ShaderVariant::ColorOverride: return "#define VARIANT_COLOR_OVERRIDE\n";
+            default: return "";
+        }
+    }
+
+    // Defines go right after the #version line (which must stay first)
+    std::string inject_defines(const std::string& source, const std::string& defines)
+    {
+        if (defines.empty())
+        {
+            return source;
+        }
+        const std::size_t version_pos = source.find("#version");
+        if (version_pos == std::string::npos)
+        {
+            return defines + source;
+        }
+        std::size_t line_end = source.find('\n', version_pos);
+        line_end = (line_end == std::string::npos) ? source.size() : line_end + 1;
+        return source.substr(0, line_end) + defines + source.substr(line_end);
+    }
+
+    // FNV-1a - only used to name cache files, collisions just cost a recompile
+    void hash_append(std::uint64_t& hash, const std::string& data)
+    {
+        for (unsigned char c : data)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        // Separator so "ab"+"c" and "a"+"bc" differ
+        hash ^= 0xff;
+        hash *= 1099511628211ull;
+    }
+
+    std::string gl_string(GLenum name)
+    {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    std::filesystem::path cache_file_path(const ShaderCache& cache, ShaderVariant variant, std::uint64_t key)
+    {
+        std::ostringstream name;
+        name << get_shader_variant_name(variant) << '-' << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return cache.cache_dir / name.str();
+    }
+
+    GLuint load_program_binary(const std::filesystem::path& path, std::uint64_t key)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return 0;
+        }
+
+        CacheFileHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0 ||
+            header.version != CACHE_FILE_VERSION || header.key != key || header.binary_length == 0)
+        {
+            return 0;
+        }
+
+        std::vector<char> binary(header.binary_length);
+        if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size())))
+        {
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, header.binary_format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        // Drivers reject binaries after an update - fall back to compiling
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (success == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            return 0;
+        }
+        return program;
+    }
+
+    void save_program_binary(const std::filesystem::path& path, std::uint64_t key, GLuint program)
+    {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        CacheFileHeader header{};
+        std::memcpy(header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+        header.version = CACHE_FILE_VERSION;
+        header.key = key;
+        header.binary_format = format;
+        header.binary_length = static_cast<std::uint32_t>(binary.size());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(binary.data(), static_cast<std::streamsize>(binary.size())))
+        {
+            std::cerr << "Warning: Failed to write shader cache " << path << '\n';
+        }
+    }
+
+    void upload_mvp_if_stale(const ShaderCache& cache, int variant_index)
+    {
+        if (cache.uploaded_mvp_revision[variant_index] == cache.mvp_revision)
+        {
+            return;
+        }
+        const ShaderProgram& program = cache.programs[variant_index];
+        if (program.mvp_location >= 0)
+        {
+            glUniformMatrix4fv(program.mvp_location, 1, GL_FALSE, glm::value_ptr(cache.mvp));
+        }
+        cache.uploaded_mvp_revision[variant_index] = cache.mvp_revision;
+    }
+}
+
+void initialize_shader_cache(ShaderCache& cache,
+                             const std::string& vertex_source,
+                             const std::string& fragment_source,
+                             const std::filesystem::path& cache_dir)
+{
+    destroy_shader_cache(cache);
+    cache.cache_dir = cache_dir;
+
+    // Binaries are only valid for the driver that produced them
+    GLint binary_format_count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_format_count);
+    const bool use_disk_cache = !cache.cache_dir.empty() && binary_format_count > 0;
+    const std::string driver = gl_string(GL_VENDOR) + '|' + gl_string(GL_RENDERER) + '|' + gl_string(GL_VERSION);
+
+    for (int i = 0; i < static_cast<int>(ShaderVariant::Count); ++i)
+    {
+        const ShaderVariant variant = static_cast<ShaderVariant>(i);
+        const std::string defines = variant_define(variant);
+        const std::string vertex = inject_defines(vertex_source, defines);
+        const std::string fragment = inject_defines(fragment_source, defines);
+
+        std::uint64_t key = 14695981039346656037ull;
+        hash_append(key, std::to_string(CACHE_FILE_VERSION));
+        hash_append(key, driver);
+        hash_append(key, vertex);
+        hash_append(key, fragment);
+
+        GLuint program = 0;
+        const std::filesystem::path path = use_disk_cache ? cache_file_path(cache, variant, key) : std::filesystem::path();
+        if (use_disk_cache)
+        {
+            program = load_program_binary(path, key);
+            if (program != 0)
+            {
+                ++cache.binaries_loaded;
+            }
+        }
+        if (program == 0)
+        {
+            program = create_program(vertex, fragment, use_disk_cache);
+            ++cache.programs_compiled;
+            if (use_disk_cache)
+            {
+                save_program_binary(path, key, program);
+            }
+        }
+
+        ShaderProgram& entry = cache.programs[i];
+        entry.program = program;
+        entry.mvp_location = glGetUniformLocation(program, "uMVP");
+        entry.texture_location = glGetUniformLocation(program, "uTexture");
+        entry.color_override_location = glGetUniformLocation(program, "uColorOverride");
+
+        // Samplers always read texture unit 0
+        if (entry.texture_location >= 0)
+        {
+            glUseProgram(program);
+            glUniform1i(entry.texture_location, 0);
+        }
+    }
+
+    glUseProgram(0);
+    cache.active_variant = -1;
+    cache.uploaded_mvp_revision.fill(0);
+
+    std::cout << "Shader variants ready: " << cache.binaries_loaded << " from cache, "
+              << cache.programs_compiled << " compiled" << std::endl;
+}
+
+void destroy_shader_cache(ShaderCache& cache)
+{
+    for (auto& entry : cache.programs)
+    {
+        if (entry.program != 0)
+        {
+            glDeleteProgram(entry.program);
+        }
+        entry = ShaderProgram{};
+    }
+    cache.binaries_loaded = 0;
+    cache.programs_compiled = 0;
+    cache.active_variant = -1;
+}
+
+void use_shader_variant(const ShaderCache& cache, ShaderVariant variant)
+{
+    const int index = static_cast<int>(variant);
+    if (cache.active_variant != index)
+    {
+        glUseProgram(cache.programs[index].program);
+        cache.active_variant = index;
+    }
+    upload_mvp_if_stale(cache, index);
+}
+
+void set_shader_mvp(const ShaderCache& cache, const glm::mat4& mvp)
+{
+    cache.mvp = mvp;
+    ++cache.mvp_revision;
+    if (cache.active_variant >= 0)
+    {
+        upload_mvp_if_stale(cache, cache.active_variant);
+    }
+}
+
+void set_shader_color_override(const ShaderCache& cache, const glm::vec3& color)
+{
+    const ShaderProgram& program = cache.programs[static_cast<int>(ShaderVariant::ColorOverride)];
+    if (program.color_override_location < 0)
+    {
+        return;
+    }
+    use_shader_variant(cache, ShaderVariant::ColorOverride);
+    glUniform3fv(program.color_override_location, 1, glm::value_ptr(color));
+}
+
+const char* get_shader_variant_name(ShaderVariant variant)
+{
+    switch (variant)
+    {
+        case ShaderVariant::VertexColor: return "vertex_color";
+        case ShaderVariant::Textured: return "textured";
+        case ShaderVariant::Text: return "text";
+        case ShaderVariant::Dice: return "dice";
+        case ShaderVariant::ColorOverride: return "color_override";
+        default: return "unknown";
+    }
+}
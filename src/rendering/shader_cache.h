@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Forward declarations for OpenGL types
+typedef unsigned int GLuint;
+typedef int GLint;
+
+// Permutations of shaders/simple.frag, selected with VARIANT_* defines
+enum class ShaderVariant
+{
+    VertexColor = 0,  // Plain vertex colour (board, UI shapes, fallback sphere)
+    Textured,         // Texture colour (character models)
+    Text,             // Glyph coverage in the red channel, colour from the vertex
+    Dice,             // Dice texture thresholded to white face / black pips
+    ColorOverride,    // Flat uColorOverride with vertex alpha
+    Count
+};
+
+struct ShaderProgram
+{
+    GLuint program = 0;
+    GLint mvp_location = -1;
+    GLint texture_location = -1;
+    GLint color_override_location = -1;
+};
+
+struct ShaderCache
+{
+    std::array<ShaderProgram, static_cast<std::size_t>(ShaderVariant::Count)> programs{};
+    std::filesystem::path cache_dir;  // Empty = don't read/write program binaries
+    int binaries_loaded = 0;          // Variants restored from disk this run
+    int programs_compiled = 0;        // Variants compiled from source this run
+
+    // Draw-time state. Draw code only holds a const RenderState, so this is
+    // mutable; it is only ever touched from the GL thread.
+    mutable int active_variant = -1;
+    mutable glm::mat4 mvp = glm::mat4(1.0f);
+    mutable std::uint32_t mvp_revision = 1;
+    mutable std::array<std::uint32_t, static_cast<std::size_t>(ShaderVariant::Count)> uploaded_mvp_revision{};
+};
+
+// Builds every variant, restoring linked programs from cache_dir when a binary
+// for this exact source + driver exists and writing new binaries otherwise.
+// Throws std::runtime_error if a variant fails to compile.
+void initialize_shader_cache(ShaderCache& cache,
+                             const std::string& vertex_source,
+                             const std::string& fragment_source,
+                             const std::filesystem::path& cache_dir);
+void destroy_shader_cache(ShaderCache& cache);
+
+// Binds the variant's program. The current MVP is re-uploaded lazily, so
+// set_shader_mvp and use_shader_variant can be called in either order.
+void use_shader_variant(const ShaderCache& cache, ShaderVariant variant);
+void set_shader_mvp(const ShaderCache& cache, const glm::mat4& mvp);
+void set_shader_color_override(const ShaderCache& cache, const glm::vec3& color);
+
+const char* get_shader_variant_name(ShaderVariant variant);
@@ -5,12 +5,44 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 namespace
 {
-    constexpr int FIRST_CHAR = 32;
-    constexpr int LAST_CHAR = 126;
+    constexpr int ATLAS_WIDTH = 1024;
+    constexpr int ATLAS_PADDING = 1;  // Empty texels between glyphs so neighbours never bleed in
+    constexpr float MISSING_GLYPH_ADVANCE = 10.0f;
+
+    struct GlyphBitmap
+    {
+        std::vector<unsigned char> pixels;
+        int width = 0;
+        int rows = 0;
+        glm::ivec2 atlas_position = glm::ivec2(0);
+    };
+
+    int next_power_of_two(int value)
+    {
+        int result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const TextGlyph* find_glyph(const TextRenderer& renderer, char c)
+    {
+        const int index = static_cast<unsigned char>(c) - TEXT_FIRST_CHAR;
+        if (index < 0 || index >= TEXT_GLYPH_COUNT || !renderer.glyphs[index].loaded)
+        {
+            return nullptr;
+        }
+        return &renderer.glyphs[index];
+    }
 }
 
 bool initialize_text_renderer(TextRenderer& renderer, const std::string& font_path, int pixel_height)
@@ -36,72 +68,102 @@ bool initialize_text_renderer(TextRenderer& renderer, const std::string& font_pa
     }
 
     FT_Set_Pixel_Sizes(face, 0, pixel_height);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+    // Rasterise every glyph and shelf-pack them left to right, top to bottom
+    std::array<GlyphBitmap, TEXT_GLYPH_COUNT> bitmaps{};
+    int shelf_x = ATLAS_PADDING;
+    int shelf_y = ATLAS_PADDING;
+    int shelf_height = 0;
     int loaded_glyphs = 0;
-    for (unsigned char c = FIRST_CHAR; c <= LAST_CHAR; ++c)
+    for (int c = TEXT_FIRST_CHAR; c <= TEXT_LAST_CHAR; ++c)
     {
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER) != 0)
+        if (FT_Load_Char(face, static_cast<FT_ULong>(c), FT_LOAD_RENDER) != 0)
         {
-            std::cerr << "Failed to load glyph for char " << static_cast<int>(c) << '\n';
+            std::cerr << "Failed to load glyph for char " << c << '\n';
             continue;
         }
 
-        GLuint texture = 0;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(GL_TEXTURE_2D,
-                     0,
-                     GL_RED,
-                     face->glyph->bitmap.width,
-                     face->glyph->bitmap.rows,
-                     0,
-                     GL_RED,
-                     GL_UNSIGNED_BYTE,
-                     face->glyph->bitmap.buffer);
-
-        // Set texture swizzle for GL_RED format: use red channel for alpha
-        // This makes the texture work correctly with blending
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        // Use GL_NEAREST for font textures to avoid blurring and artifacts
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-        TextGlyph glyph;
-        glyph.texture_id = texture;
-        glyph.size = glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows);
+        const FT_Bitmap& source = face->glyph->bitmap;
+        GlyphBitmap& bitmap = bitmaps[c - TEXT_FIRST_CHAR];
+        bitmap.width = static_cast<int>(source.width);
+        bitmap.rows = static_cast<int>(source.rows);
+        bitmap.pixels.resize(static_cast<std::size_t>(bitmap.width) * bitmap.rows);
+        for (int row = 0; row < bitmap.rows; ++row)
+        {
+            std::memcpy(bitmap.pixels.data() + static_cast<std::size_t>(row) * bitmap.width,
+                        source.buffer + static_cast<std::ptrdiff_t>(row) * std::abs(source.pitch),
+                        static_cast<std::size_t>(bitmap.width));
+        }
+
+        if (shelf_x + bitmap.width + ATLAS_PADDING > ATLAS_WIDTH)
+        {
+            shelf_x = ATLAS_PADDING;
+            shelf_y += shelf_height + ATLAS_PADDING;
+            shelf_height = 0;
+        }
+        bitmap.atlas_position = glm::ivec2(shelf_x, shelf_y);
+        shelf_x += bitmap.width + ATLAS_PADDING;
+        shelf_height = std::max(shelf_height, bitmap.rows);
+
+        TextGlyph& glyph = renderer.glyphs[c - TEXT_FIRST_CHAR];
+        glyph.size = glm::ivec2(bitmap.width, bitmap.rows);
         glyph.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
         glyph.advance = static_cast<GLuint>(face->glyph->advance.x);
-
-        renderer.glyphs[static_cast<char>(c)] = glyph;
+        glyph.loaded = true;
         loaded_glyphs++;
     }
 
-    std::cout << "Loaded " << loaded_glyphs << " glyphs from font: " << font_path << std::endl;
-
-    glBindTexture(GL_TEXTURE_2D, 0);
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
-    glGenVertexArrays(1, &renderer.vao);
-    glGenBuffers(1, &renderer.vbo);
-    glBindVertexArray(renderer.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 8, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void*>(0));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void*>(6 * sizeof(float)));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    const int atlas_height = next_power_of_two(shelf_y + shelf_height + ATLAS_PADDING);
+    renderer.atlas_size = glm::ivec2(ATLAS_WIDTH, atlas_height);
+
+    std::vector<unsigned char> atlas(static_cast<std::size_t>(ATLAS_WIDTH) * atlas_height, 0);
+    for (int i = 0; i < TEXT_GLYPH_COUNT; ++i)
+    {
+        const GlyphBitmap& bitmap = bitmaps[i];
+        for (int row = 0; row < bitmap.rows; ++row)
+        {
+            std::memcpy(atlas.data() + static_cast<std::size_t>(bitmap.atlas_position.y + row) * ATLAS_WIDTH + bitmap.atlas_position.x,
+                        bitmap.pixels.data() + static_cast<std::size_t>(row) * bitmap.width,
+                        static_cast<std::size_t>(bitmap.width));
+        }
+
+        TextGlyph& glyph = renderer.glyphs[i];
+        glyph.uv_min = glm::vec2(bitmap.atlas_position) / glm::vec2(renderer.atlas_size);
+        glyph.uv_max = glm::vec2(bitmap.atlas_position + glyph.size) / glm::vec2(renderer.atlas_size);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGenTextures(1, &renderer.atlas_texture);
+    glBindTexture(GL_TEXTURE_2D, renderer.atlas_texture);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_R8,
+                 ATLAS_WIDTH,
+                 atlas_height,
+                 0,
+                 GL_RED,
+                 GL_UNSIGNED_BYTE,
+                 atlas.data());
+
+    // Set texture swizzle for GL_RED format: use red channel for alpha
+    // This makes the texture work correctly with blending
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // Use GL_NEAREST for font textures to avoid blurring and artifacts
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    std::cout << "Loaded " << loaded_glyphs << " glyphs from font: " << font_path
+              << " (" << ATLAS_WIDTH << "x" << atlas_height << " atlas)" << std::endl;
 
     renderer.initialized = true;
     return true;
@@ -114,92 +176,79 @@ void destroy_text_renderer(TextRenderer& renderer)
         return;
     }
 
-    for (auto& entry : renderer.glyphs)
-    {
-        glDeleteTextures(1, &entry.second.texture_id);
-    }
-    renderer.glyphs.clear();
-
-    if (renderer.vbo != 0)
-    {
-        glDeleteBuffers(1, &renderer.vbo);
-        renderer.vbo = 0;
-    }
-    if (renderer.vao != 0)
+    if (renderer.atlas_texture != 0)
     {
-        glDeleteVertexArrays(1, &renderer.vao);
-        renderer.vao = 0;
+        glDeleteTextures(1, &renderer.atlas_texture);
+        renderer.atlas_texture = 0;
     }
+    renderer.glyphs = {};
+    renderer.atlas_size = glm::ivec2(0);
 
     renderer.initialized = false;
 }
 
-void render_text(const TextRenderer& renderer,
-                 const std::string& text,
-                 float x,
-                 float y,
-                 float scale,
-                 const glm::vec3& color)
+float measure_text(const TextRenderer& renderer, const std::string& text, float scale)
 {
-    if (!renderer.initialized)
+    float total_width = 0.0f;
+    for (char c : text)
     {
-        return;
+        const TextGlyph* glyph = find_glyph(renderer, c);
+        total_width += glyph ? static_cast<float>(glyph->advance >> 6) * scale : MISSING_GLYPH_ADVANCE * scale;
     }
+    return total_width;
+}
 
-    glBindVertexArray(renderer.vao);
-
-    float total_width = 0.0f;
-    for (char c : text)
+std::size_t append_text_vertices(const TextRenderer& renderer,
+                                 const std::string& text,
+                                 float x,
+                                 float y,
+                                 float scale,
+                                 const glm::vec4& color,
+                                 std::vector<float>& vertices)
+{
+    if (!renderer.initialized)
     {
-        auto glyph_it = renderer.glyphs.find(c);
-        if (glyph_it == renderer.glyphs.end())
-        {
-            total_width += scale * 10.0f;
-            continue;
-        }
-        total_width += static_cast<float>(glyph_it->second.advance >> 6) * scale;
+        return 0;
     }
 
-    float cursor_x = x - total_width * 0.5f;
+    std::size_t glyph_count = 0;
+    float cursor_x = x - measure_text(renderer, text, scale) * 0.5f;
     for (char c : text)
     {
-        auto glyph_it = renderer.glyphs.find(c);
-        if (glyph_it == renderer.glyphs.end())
+        const TextGlyph* glyph = find_glyph(renderer, c);
+        if (!glyph)
         {
-            cursor_x += scale * 10.0f;
+            cursor_x += scale * MISSING_GLYPH_ADVANCE;
             continue;
         }
 
-        const TextGlyph& glyph = glyph_it->second;
-        float xpos = cursor_x + static_cast<float>(glyph.bearing.x) * scale;
-        float ypos = y - static_cast<float>(glyph.size.y - glyph.bearing.y) * scale;
+        const float xpos = cursor_x + static_cast<float>(glyph->bearing.x) * scale;
+        const float ypos = y - static_cast<float>(glyph->size.y - glyph->bearing.y) * scale;
+        const float w = static_cast<float>(glyph->size.x) * scale;
+        const float h = static_cast<float>(glyph->size.y) * scale;
+        cursor_x += static_cast<float>(glyph->advance >> 6) * scale;
 
-        const float w = static_cast<float>(glyph.size.x) * scale;
-        const float h = static_cast<float>(glyph.size.y) * scale;
+        if (glyph->size.x == 0 || glyph->size.y == 0)
+        {
+            continue;  // Space and friends only advance the cursor
+        }
 
+        const float u0 = glyph->uv_min.x;
+        const float v0 = glyph->uv_min.y;
+        const float u1 = glyph->uv_max.x;
+        const float v1 = glyph->uv_max.y;
         const float z = -0.5f;
-        const float vertices[6][8] = {
-            {xpos,     ypos + h, z, color.r, color.g, color.b, 0.0f, 1.0f},
-            {xpos,     ypos,     z, color.r, color.g, color.b, 0.0f, 0.0f},
-            {xpos + w, ypos,     z, color.r, color.g, color.b, 1.0f, 0.0f},
-
-            {xpos,     ypos + h, z, color.r, color.g, color.b, 0.0f, 1.0f},
-            {xpos + w, ypos,     z, color.r, color.g, color.b, 1.0f, 0.0f},
-            {xpos + w, ypos + h, z, color.r, color.g, color.b, 1.0f, 1.0f}
+        const float quad[6][9] = {
+            {xpos,     ypos + h, z, color.r, color.g, color.b, color.a, u0, v1},
+            {xpos,     ypos,     z, color.r, color.g, color.b, color.a, u0, v0},
+            {xpos + w, ypos,     z, color.r, color.g, color.b, color.a, u1, v0},
+
+            {xpos,     ypos + h, z, color.r, color.g, color.b, color.a, u0, v1},
+            {xpos + w, ypos,     z, color.r, color.g, color.b, color.a, u1, v0},
+            {xpos + w, ypos + h, z, color.r, color.g, color.b, color.a, u1, v1}
         };
-
-        glBindTexture(GL_TEXTURE_2D, glyph.texture_id);
-        glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
-        cursor_x += static_cast<float>(glyph.advance >> 6) * scale;
+        vertices.insert(vertices.end(), &quad[0][0], &quad[0][0] + 6 * 9);
+        glyph_count++;
     }
-
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return glyph_count;
 }
-
-
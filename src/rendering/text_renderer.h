@@ -1,33 +1,46 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
 #include <string>
-#include <map>
+#include <vector>
 
 // Forward declarations for OpenGL types
 typedef unsigned int GLuint;
 typedef int GLsizei;
 
+constexpr int TEXT_FIRST_CHAR = 32;
+constexpr int TEXT_LAST_CHAR = 126;
+constexpr int TEXT_GLYPH_COUNT = TEXT_LAST_CHAR - TEXT_FIRST_CHAR + 1;
+
 struct TextGlyph
 {
-    GLuint texture_id = 0;
     glm::ivec2 size = glm::ivec2(0);     // Size of glyph
     glm::ivec2 bearing = glm::ivec2(0);  // Offset from baseline to left/top of glyph
     GLuint advance = 0;                 // Offset to advance to next glyph
+    glm::vec2 uv_min = glm::vec2(0.0f);  // Glyph rectangle inside the atlas
+    glm::vec2 uv_max = glm::vec2(0.0f);
+    bool loaded = false;
 };
 
+// All printable ASCII glyphs packed into one GL_RED atlas, so a whole layer of
+// text can be drawn with a single texture bind (see rendering/ui_batch.h)
 struct TextRenderer
 {
-    GLuint vao = 0;
-    GLuint vbo = 0;
-    std::map<char, TextGlyph> glyphs;
+    GLuint atlas_texture = 0;
+    glm::ivec2 atlas_size = glm::ivec2(0);
+    std::array<TextGlyph, TEXT_GLYPH_COUNT> glyphs{};
     bool initialized = false;
 };
 
 bool initialize_text_renderer(TextRenderer& renderer, const std::string& font_path, int pixel_height);
 void destroy_text_renderer(TextRenderer& renderer);
-void render_text(const TextRenderer& renderer, const std::string& text, float x, float y, float scale, const glm::vec3& color);
-
-
 
+float measure_text(const TextRenderer& renderer, const std::string& text, float scale);
 
+// Appends two triangles per glyph (x, y, z, r, g, b, a, u, v) for text centred
+// horizontally on x. Returns the number of glyph quads written.
+std::size_t append_text_vertices(const TextRenderer& renderer, const std::string& text,
+                                 float x, float y, float scale, const glm::vec4& color,
+                                 std::vector<float>& vertices);
@@ -0,0 +1,246 @@
+#include "ui_batch.h"
+
+#include "shader_cache.h"
+#include "text_renderer.h"
+
+#include <glad/glad.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr int FLOATS_PER_VERTEX = 9;
+    constexpr std::size_t VERTEX_BYTES = FLOATS_PER_VERTEX * sizeof(float);
+
+    void push_vertex(std::vector<float>& vertices, float x, float y, const glm::vec4& color)
+    {
+        const float vertex[FLOATS_PER_VERTEX] = {x, y, 0.0f, color.r, color.g, color.b, color.a, 0.0f, 0.0f};
+        vertices.insert(vertices.end(), vertex, vertex + FLOATS_PER_VERTEX);
+    }
+
+    void allocate_buffer(UiBatch& batch, std::size_t capacity_vertices)
+    {
+        batch.capacity_vertices = capacity_vertices;
+        batch.write_vertex = 0;
+        glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity_vertices * VERTEX_BYTES), nullptr, GL_STREAM_DRAW);
+    }
+
+    // Copies the staged layer into the ring and returns the first vertex it landed at.
+    // Appends are mapped unsynchronized - earlier draws only read ranges behind
+    // write_vertex. When the ring is full the buffer is orphaned, so the driver hands
+    // back fresh storage instead of stalling on draws still in flight.
+    std::size_t upload_layer(UiBatch& batch, std::size_t vertex_count)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+
+        if (vertex_count > batch.capacity_vertices)
+        {
+            std::size_t capacity = batch.capacity_vertices;
+            while (capacity < vertex_count)
+            {
+                capacity *= 2;
+            }
+            allocate_buffer(batch, capacity);
+            batch.frame_stats.buffer_orphans++;
+        }
+        else if (batch.write_vertex + vertex_count > batch.capacity_vertices)
+        {
+            allocate_buffer(batch, batch.capacity_vertices);
+            batch.frame_stats.buffer_orphans++;
+        }
+
+        const std::size_t first_vertex = batch.write_vertex;
+        void* mapped = glMapBufferRange(GL_ARRAY_BUFFER,
+                                        static_cast<GLintptr>(first_vertex * VERTEX_BYTES),
+                                        static_cast<GLsizeiptr>(vertex_count * VERTEX_BYTES),
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped)
+        {
+            auto* destination = static_cast<unsigned char*>(mapped);
+            const std::size_t shape_bytes = batch.shape_vertices.size() * sizeof(float);
+            std::memcpy(destination, batch.shape_vertices.data(), shape_bytes);
+            std::memcpy(destination + shape_bytes, batch.text_vertices.data(), batch.text_vertices.size() * sizeof(float));
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        else
+        {
+            // Mapping can fail on some drivers; fall back to two plain uploads
+            const std::size_t shape_bytes = batch.shape_vertices.size() * sizeof(float);
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first_vertex * VERTEX_BYTES),
+                            static_cast<GLsizeiptr>(shape_bytes), batch.shape_vertices.data());
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first_vertex * VERTEX_BYTES + shape_bytes),
+                            static_cast<GLsizeiptr>(batch.text_vertices.size() * sizeof(float)), batch.text_vertices.data());
+        }
+
+        batch.write_vertex += vertex_count;
+        return first_vertex;
+    }
+}
+
+void initialize_ui_batch(UiBatch& batch, std::size_t capacity_vertices)
+{
+    if (batch.initialized)
+    {
+        destroy_ui_batch(batch);
+    }
+
+    glGenVertexArrays(1, &batch.vao);
+    glGenBuffers(1, &batch.vbo);
+    glBindVertexArray(batch.vao);
+    allocate_buffer(batch, capacity_vertices > 0 ? capacity_vertices : 1024);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_BYTES, reinterpret_cast<void*>(0));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, VERTEX_BYTES, reinterpret_cast<void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_BYTES, reinterpret_cast<void*>(7 * sizeof(float)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Enough for the heaviest screen (win screen + confetti) without growing mid-frame
+    batch.shape_vertices.reserve(4096 * FLOATS_PER_VERTEX);
+    batch.text_vertices.reserve(4096 * FLOATS_PER_VERTEX);
+
+    const float angle_step = 2.0f * 3.14159265f / UI_CIRCLE_SEGMENTS;
+    for (int i = 0; i <= UI_CIRCLE_SEGMENTS; ++i)
+    {
+        batch.unit_circle[i] = glm::vec2(std::cos(i * angle_step), std::sin(i * angle_step));
+    }
+
+    batch.frame_stats = {};
+    batch.last_frame_stats = {};
+    batch.initialized = true;
+}
+
+void destroy_ui_batch(UiBatch& batch)
+{
+    if (!batch.initialized)
+    {
+        return;
+    }
+
+    glDeleteBuffers(1, &batch.vbo);
+    glDeleteVertexArrays(1, &batch.vao);
+    batch.vbo = 0;
+    batch.vao = 0;
+    batch.capacity_vertices = 0;
+    batch.write_vertex = 0;
+    batch.shape_vertices.clear();
+    batch.text_vertices.clear();
+    batch.initialized = false;
+}
+
+void begin_ui_frame(UiBatch& batch)
+{
+    batch.shape_vertices.clear();
+    batch.text_vertices.clear();
+    batch.frame_stats = {};
+}
+
+void end_ui_frame(UiBatch& batch)
+{
+    batch.last_frame_stats = batch.frame_stats;
+}
+
+void add_ui_quad(UiBatch& batch, float x, float y, float width, float height, const glm::vec4& color)
+{
+    std::vector<float>& vertices = batch.shape_vertices;
+    push_vertex(vertices, x,         y,          color);  // Top-left
+    push_vertex(vertices, x,         y + height, color);  // Bottom-left
+    push_vertex(vertices, x + width, y + height, color);  // Bottom-right
+    push_vertex(vertices, x,         y,          color);  // Top-left
+    push_vertex(vertices, x + width, y + height, color);  // Bottom-right
+    push_vertex(vertices, x + width, y,          color);  // Top-right
+    batch.frame_stats.quads++;
+}
+
+void add_ui_line(UiBatch& batch, float x1, float y1, float x2, float y2, float thickness, const glm::vec4& color)
+{
+    // Calculate line direction and perpendicular
+    const float dx = x2 - x1;
+    const float dy = y2 - y1;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 0.001f)
+    {
+        return;
+    }
+
+    const float half_thickness = thickness * 0.5f;
+    const float nx = -dy / length * half_thickness;
+    const float ny = dx / length * half_thickness;
+
+    std::vector<float>& vertices = batch.shape_vertices;
+    push_vertex(vertices, x1 + nx, y1 + ny, color);
+    push_vertex(vertices, x1 - nx, y1 - ny, color);
+    push_vertex(vertices, x2 - nx, y2 - ny, color);
+    push_vertex(vertices, x1 + nx, y1 + ny, color);
+    push_vertex(vertices, x2 - nx, y2 - ny, color);
+    push_vertex(vertices, x2 + nx, y2 + ny, color);
+    batch.frame_stats.quads++;
+}
+
+void add_ui_circle(UiBatch& batch, float center_x, float center_y, float radius, const glm::vec4& color)
+{
+    // Triangle fan written out as a list so circles batch with everything else
+    std::vector<float>& vertices = batch.shape_vertices;
+    for (int i = 0; i < UI_CIRCLE_SEGMENTS; ++i)
+    {
+        const glm::vec2& edge1 = batch.unit_circle[i];
+        const glm::vec2& edge2 = batch.unit_circle[i + 1];
+        push_vertex(vertices, center_x, center_y, color);
+        push_vertex(vertices, center_x + radius * edge1.x, center_y + radius * edge1.y, color);
+        push_vertex(vertices, center_x + radius * edge2.x, center_y + radius * edge2.y, color);
+    }
+    batch.frame_stats.circles++;
+}
+
+void add_ui_text(UiBatch& batch, const TextRenderer& text_renderer, const std::string& text,
+                 float x, float y, float scale, const glm::vec3& color)
+{
+    const std::size_t glyphs = append_text_vertices(text_renderer, text, x, y, scale, glm::vec4(color, 1.0f),
+                                                    batch.text_vertices);
+    batch.frame_stats.glyphs += static_cast<int>(glyphs);
+}
+
+void flush_ui_layer(UiBatch& batch, const ShaderCache& shaders, const TextRenderer& text_renderer,
+                    const glm::mat4& mvp)
+{
+    const std::size_t shape_count = batch.shape_vertices.size() / FLOATS_PER_VERTEX;
+    const std::size_t text_count = batch.text_vertices.size() / FLOATS_PER_VERTEX;
+    if (!batch.initialized || shape_count + text_count == 0)
+    {
+        batch.shape_vertices.clear();
+        batch.text_vertices.clear();
+        return;
+    }
+
+    glBindVertexArray(batch.vao);
+    const std::size_t first_vertex = upload_layer(batch, shape_count + text_count);
+    set_shader_mvp(shaders, mvp);
+
+    if (shape_count > 0)
+    {
+        use_shader_variant(shaders, ShaderVariant::VertexColor);
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first_vertex), static_cast<GLsizei>(shape_count));
+        batch.frame_stats.draw_calls++;
+    }
+
+    if (text_count > 0)
+    {
+        use_shader_variant(shaders, ShaderVariant::Text);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, text_renderer.atlas_texture);
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first_vertex + shape_count), static_cast<GLsizei>(text_count));
+        batch.frame_stats.draw_calls++;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    batch.frame_stats.layers++;
+    batch.frame_stats.vertices += static_cast<int>(shape_count + text_count);
+    batch.shape_vertices.clear();
+    batch.text_vertices.clear();
+}
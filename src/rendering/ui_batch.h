@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward declarations for OpenGL types
+typedef unsigned int GLuint;
+
+struct ShaderCache;
+struct TextRenderer;
+
+constexpr int UI_CIRCLE_SEGMENTS = 32;
+
+struct UiBatchStats
+{
+    int layers = 0;          // flush_ui_layer calls that drew something
+    int draw_calls = 0;
+    int vertices = 0;
+    int quads = 0;           // Includes lines, which are drawn as quads
+    int circles = 0;
+    int glyphs = 0;
+    int buffer_orphans = 0;  // Times the streaming buffer wrapped and was re-specified
+};
+
+// Records 2D shapes and text for one UI layer and draws them with at most two
+// draw calls (shapes, then text on top) from a single streaming vertex buffer.
+// Vertices are (x, y, z, r, g, b, a, u, v) - the layout of shaders/simple.vert.
+struct UiBatch
+{
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    std::size_t capacity_vertices = 0;  // Size of the GPU buffer
+    std::size_t write_vertex = 0;       // Next free vertex; the buffer is written as a ring
+
+    // CPU staging for the layer being recorded. Cleared, never shrunk, after each flush.
+    std::vector<float> shape_vertices;
+    std::vector<float> text_vertices;
+
+    // cos/sin of each circle segment edge, so circles are just multiply-adds
+    std::array<glm::vec2, UI_CIRCLE_SEGMENTS + 1> unit_circle{};
+
+    UiBatchStats frame_stats{};
+    UiBatchStats last_frame_stats{};  // Totals for the previous complete frame
+    bool initialized = false;
+};
+
+void initialize_ui_batch(UiBatch& batch, std::size_t capacity_vertices = 64 * 1024);
+void destroy_ui_batch(UiBatch& batch);
+
+// Frame bracketing for the statistics; begin also drops anything left unflushed
+void begin_ui_frame(UiBatch& batch);
+void end_ui_frame(UiBatch& batch);
+
+void add_ui_quad(UiBatch& batch, float x, float y, float width, float height, const glm::vec4& color);
+void add_ui_line(UiBatch& batch, float x1, float y1, float x2, float y2, float thickness, const glm::vec4& color);
+void add_ui_circle(UiBatch& batch, float center_x, float center_y, float radius, const glm::vec4& color);
+// Text is centred horizontally on x, like the rest of the UI expects
+void add_ui_text(UiBatch& batch, const TextRenderer& text_renderer, const std::string& text,
+                 float x, float y, float scale, const glm::vec3& color);
+
+// Uploads everything recorded since the last flush and draws it: shapes with
+// ShaderVariant::VertexColor, then text with ShaderVariant::Text and the glyph atlas.
+// Leaves the Text variant bound if any text was drawn.
+void flush_ui_layer(UiBatch& batch, const ShaderCache& shaders, const TextRenderer& text_renderer,
+                    const glm::mat4& mvp);
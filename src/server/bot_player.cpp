@@ -0,0 +1,242 @@
+#include "bot_player.h"
+
+#include "../game/map/board.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+namespace server
+{
+    namespace
+    {
+        using game::map::ActivityKind;
+
+        bool starts_with(const std::string& text, const char* prefix)
+        {
+            return text.rfind(prefix, 0) == 0;
+        }
+
+        void start_minigame(BotPlayer& bot, std::uint8_t minigame, std::mt19937& rng)
+        {
+            bot.minigame = minigame;
+            std::uniform_real_distribution<float> stop_dist(4.8f, 5.2f);
+            bot.stop_at = stop_dist(rng);
+            bot.stopped = false;
+            bot.sequence.clear();
+            bot.sequence_sent = false;
+            bot.pattern.clear();
+            bot.pattern_sent = false;
+            bot.math_sent = false;
+            bot.guess_low = 1;
+            bot.guess_high = 9;
+            bot.last_guess = 0;
+            bot.guessed_attempt = 0;
+        }
+
+        std::string play_precision(BotPlayer& bot, const std::string& text)
+        {
+            // "Target: 4.99 | Time: 4.53"
+            const std::size_t time_at = text.find("Time: ");
+            if (bot.stopped || time_at == std::string::npos)
+            {
+                return {};
+            }
+            if (std::strtof(text.c_str() + time_at + 6, nullptr) >= bot.stop_at)
+            {
+                bot.stopped = true;
+                return " ";
+            }
+            return {};
+        }
+
+        std::string play_tile_memory(BotPlayer& bot, const std::string& text)
+        {
+            if (starts_with(text, "mem "))
+            {
+                // "mem 3 7 _" - digits appear one at a time; a new "mem" starts the next round
+                std::string digits;
+                for (std::size_t i = 4; i < text.size(); ++i)
+                {
+                    if (std::isdigit(static_cast<unsigned char>(text[i])))
+                    {
+                        digits += text[i];
+                    }
+                }
+                if (digits.size() < bot.sequence.size())
+                {
+                    bot.sequence_sent = false;
+                }
+                bot.sequence = digits;
+                return {};
+            }
+            if (starts_with(text, "input") && !bot.sequence_sent && !bot.sequence.empty())
+            {
+                bot.sequence_sent = true;
+                return bot.sequence + "\n";
+            }
+            return {};
+        }
+
+        std::string play_reaction(BotPlayer& bot, const std::string& text)
+        {
+            if (bot.last_guess != 0 && starts_with(text, "Too "))
+            {
+                if (starts_with(text, "Too low"))
+                {
+                    bot.guess_low = bot.last_guess + 1;
+                }
+                else
+                {
+                    bot.guess_high = bot.last_guess - 1;
+                }
+                bot.last_guess = 0;
+                return {};
+            }
+
+            // "Guess 2/3 : input _"
+            if (!starts_with(text, "Guess ") || text.find("input _") == std::string::npos)
+            {
+                return {};
+            }
+            const int attempt = std::atoi(text.c_str() + 6);
+            if (attempt <= bot.guessed_attempt)
+            {
+                return {};
+            }
+            bot.guessed_attempt = attempt;
+            bot.last_guess = (bot.guess_low + bot.guess_high) / 2;
+            return std::to_string(bot.last_guess) + "\n";
+        }
+
+        std::string play_math(BotPlayer& bot, const std::string& text)
+        {
+            // "12 + 7 =    (T: 15s)"
+            if (bot.math_sent || text.find(" =") == std::string::npos ||
+                text.empty() || !std::isdigit(static_cast<unsigned char>(text[0])))
+            {
+                return {};
+            }
+            char* cursor = nullptr;
+            const long left = std::strtol(text.c_str(), &cursor, 10);
+            while (*cursor == ' ')
+            {
+                ++cursor;
+            }
+            const char operation = *cursor++;
+            const long right = std::strtol(cursor, nullptr, 10);
+
+            long answer = left + right;
+            if (operation == '-')
+            {
+                answer = left - right;
+            }
+            else if (operation == '*' || operation == 'x')
+            {
+                answer = left * right;
+            }
+            bot.math_sent = true;
+            return std::to_string(answer) + "\n";
+        }
+
+        std::string play_pattern(BotPlayer& bot, const std::string& text)
+        {
+            if (starts_with(text, "Input:"))
+            {
+                if (bot.pattern_sent || bot.pattern.size() != 4)
+                {
+                    return {};
+                }
+                bot.pattern_sent = true;
+                return bot.pattern + "\n";
+            }
+
+            // "W S A D" while the pattern is on screen
+            std::string letters;
+            for (char c : text)
+            {
+                if (c == 'W' || c == 'A' || c == 'S' || c == 'D')
+                {
+                    letters += c;
+                }
+                else if (c != ' ')
+                {
+                    return {};
+                }
+            }
+            if (letters.size() == 4)
+            {
+                bot.pattern = letters;
+            }
+            return {};
+        }
+    }
+
+    BotAction decide_bot_action(BotPlayer& bot, const RoomSnapshot& snapshot, const std::string& text, std::mt19937& rng)
+    {
+        BotAction action;
+        if (bot.roll_pending &&
+            (snapshot.turn != bot.roll_turn || snapshot.phase != RoomPhase::AwaitRoll || snapshot.current_seat != bot.seat))
+        {
+            bot.roll_pending = false;
+        }
+
+        if (snapshot.current_seat != bot.seat)
+        {
+            return action;
+        }
+
+        if (snapshot.phase == RoomPhase::AwaitRoll)
+        {
+            bot.minigame = 0;
+            if (!bot.roll_pending)
+            {
+                bot.roll_pending = true;
+                bot.roll_turn = snapshot.turn;
+                action.roll = true;
+            }
+            return action;
+        }
+
+        if (snapshot.phase != RoomPhase::Minigame)
+        {
+            return action;
+        }
+
+        // Every minigame opens on a "... Bonus +N" title that waits for Space. Title
+        // text keeps arriving until the Space lands, so only press it once.
+        if (text.find("Bonus +") != std::string::npos)
+        {
+            if (!bot.title_skipped)
+            {
+                start_minigame(bot, snapshot.minigame, rng);
+                bot.title_skipped = true;
+                action.keys = " ";
+            }
+            return action;
+        }
+        bot.title_skipped = false;
+
+        switch (static_cast<ActivityKind>(snapshot.minigame))
+        {
+        case ActivityKind::MiniGame:
+            action.keys = play_precision(bot, text);
+            break;
+        case ActivityKind::MemoryGame:
+            action.keys = play_tile_memory(bot, text);
+            break;
+        case ActivityKind::ReactionGame:
+            action.keys = play_reaction(bot, text);
+            break;
+        case ActivityKind::MathGame:
+            action.keys = play_math(bot, text);
+            break;
+        case ActivityKind::PatternGame:
+            action.keys = play_pattern(bot, text);
+            break;
+        default:
+            break;
+        }
+        return action;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "protocol.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace server
+{
+    // A remote player driven only by what the server sends - the state frame and
+    // the on-screen text - using the same strategies as GameLoop::handle_ai_input:
+    // skip titles, stop the precision timer near 4.99, repeat the memory sequence
+    // and the pattern, answer the math quiz, and binary-search the number guess.
+    struct BotPlayer
+    {
+        int seat = -1;
+        std::uint8_t minigame = 0;         // Minigame the fields below belong to
+        bool title_skipped = false;
+        bool roll_pending = false;
+        std::uint16_t roll_turn = 0;
+
+        float stop_at = 5.0f;              // Precision timing target for this attempt
+        bool stopped = false;
+        std::string sequence;              // Tile memory digits seen so far
+        bool sequence_sent = false;
+        std::string pattern;               // Pattern letters, without spaces
+        bool pattern_sent = false;
+        bool math_sent = false;
+        int guess_low = 1;
+        int guess_high = 9;
+        int last_guess = 0;
+        int guessed_attempt = 0;
+    };
+
+    struct BotAction
+    {
+        bool roll = false;
+        std::string keys;  // Sent one MinigameInput frame per character
+    };
+
+    // Called for every state + text pair the bot's room broadcasts
+    BotAction decide_bot_action(BotPlayer& bot, const RoomSnapshot& snapshot, const std::string& text, std::mt19937& rng);
+}
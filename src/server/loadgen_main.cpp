@@ -0,0 +1,495 @@
+#include "bot_player.h"
+#include "protocol.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// snl_loadgen: opens many bot clients against snl_server over loopback, lets them
+// play whole games and reports turn latency, throughput and server memory per room.
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int MAX_EVENTS = 512;
+    constexpr std::size_t READ_CHUNK = 4096;
+
+    volatile std::sig_atomic_t g_stop = 0;
+
+    struct LoadOptions
+    {
+        std::string host = "127.0.0.1";
+        std::uint16_t port = 7777;
+        int clients = 1000;
+        int room_size = 2;
+        double duration = 30.0;        // Seconds of measured play
+        std::uint32_t first_room = 1;
+        int server_pid = 0;            // Read VmRSS from /proc when set
+        std::uint64_t seed = 1;
+    };
+
+    struct Client
+    {
+        int fd = -1;
+        server::BotPlayer bot;
+        std::uint32_t room = 0;
+        bool joined = false;
+        bool rejoining = false;
+        server::RoomSnapshot snapshot;
+        bool has_snapshot = false;
+        std::vector<std::uint8_t> input;
+        std::vector<std::uint8_t> output;
+        std::size_t output_offset = 0;
+        bool want_write = false;
+
+        // Outstanding roll, answered by the next state frame
+        bool awaiting_roll = false;
+        Clock::time_point roll_sent{};
+    };
+
+    struct LoadStats
+    {
+        std::vector<double> roll_rtt_us;
+        std::uint64_t minigame_keys = 0;
+        std::uint64_t games_finished = 0;
+        std::uint64_t errors = 0;
+        std::uint64_t disconnects = 0;
+    };
+
+    void handle_stop_signal(int)
+    {
+        g_stop = 1;
+    }
+
+    LoadOptions parse_load_options(int argc, char* argv[])
+    {
+        LoadOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--host=", 0) == 0)
+                {
+                    options.host = arg.substr(std::strlen("--host="));
+                }
+                else if (arg.rfind("--port=", 0) == 0)
+                {
+                    options.port = static_cast<std::uint16_t>(std::stoi(arg.substr(std::strlen("--port="))));
+                }
+                else if (arg.rfind("--clients=", 0) == 0)
+                {
+                    options.clients = std::max(1, std::stoi(arg.substr(std::strlen("--clients="))));
+                }
+                else if (arg.rfind("--room-size=", 0) == 0)
+                {
+                    options.room_size = std::clamp(std::stoi(arg.substr(std::strlen("--room-size="))), 2, 4);
+                }
+                else if (arg.rfind("--duration=", 0) == 0)
+                {
+                    options.duration = std::max(1.0, std::stod(arg.substr(std::strlen("--duration="))));
+                }
+                else if (arg.rfind("--first-room=", 0) == 0)
+                {
+                    options.first_room = static_cast<std::uint32_t>(std::stoul(arg.substr(std::strlen("--first-room="))));
+                }
+                else if (arg.rfind("--server-pid=", 0) == 0)
+                {
+                    options.server_pid = std::stoi(arg.substr(std::strlen("--server-pid=")));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        // Whole rooms only
+        options.clients = std::max(options.room_size, options.clients / options.room_size * options.room_size);
+        return options;
+    }
+
+    // Resident set size of a process in KiB, 0 if unavailable
+    long read_rss_kib(int pid)
+    {
+        std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmRSS:", 0) == 0)
+            {
+                return std::atol(line.c_str() + 6);
+            }
+        }
+        return 0;
+    }
+
+    int connect_client(const sockaddr_in& address)
+    {
+        const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+        }
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            const std::string error = std::strerror(errno);
+            close(fd);
+            throw std::runtime_error("connect: " + error);
+        }
+
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        const int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        return fd;
+    }
+
+    bool flush(int epoll_fd, std::size_t index, Client& client)
+    {
+        while (client.output_offset < client.output.size())
+        {
+            const ssize_t written = send(client.fd, client.output.data() + client.output_offset,
+                                         client.output.size() - client.output_offset, MSG_NOSIGNAL);
+            if (written < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            client.output_offset += static_cast<std::size_t>(written);
+        }
+        if (client.output_offset == client.output.size())
+        {
+            client.output.clear();
+            client.output_offset = 0;
+        }
+
+        const bool want_write = !client.output.empty();
+        if (want_write != client.want_write)
+        {
+            client.want_write = want_write;
+            epoll_event event{};
+            event.events = EPOLLIN | (want_write ? EPOLLOUT : 0u);
+            event.data.u64 = index;
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client.fd, &event);
+        }
+        return true;
+    }
+
+    void join(Client& client, std::uint32_t room)
+    {
+        client.room = room;
+        client.joined = false;
+        client.rejoining = true;
+        client.has_snapshot = false;
+        client.awaiting_roll = false;
+        client.bot = server::BotPlayer{};
+        server::append_u32_frame(client.output, server::MessageType::Join, room);
+    }
+
+    void handle_frame(Client& client, const server::Frame& frame, int room_count, bool measuring,
+                      std::mt19937& rng, LoadStats& stats)
+    {
+        switch (frame.type)
+        {
+        case server::MessageType::Joined:
+            if (frame.payload_size >= 5 && server::read_u32(frame.payload) == client.room)
+            {
+                client.bot.seat = frame.payload[4];
+                client.joined = true;
+                client.rejoining = false;
+            }
+            break;
+        case server::MessageType::State:
+        {
+            server::RoomSnapshot snapshot;
+            if (client.rejoining || !server::decode_state(frame, snapshot))
+            {
+                break;
+            }
+            if (client.awaiting_roll)
+            {
+                client.awaiting_roll = false;
+                if (measuring)
+                {
+                    const auto elapsed = Clock::now() - client.roll_sent;
+                    stats.roll_rtt_us.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+                }
+            }
+            client.snapshot = snapshot;
+            client.has_snapshot = true;
+
+            if (snapshot.phase == server::RoomPhase::Finished)
+            {
+                // Seat 0 counts the game; everyone moves on to a fresh room
+                if (client.bot.seat == 0 && measuring)
+                {
+                    stats.games_finished++;
+                }
+                join(client, client.room + static_cast<std::uint32_t>(room_count));
+            }
+            break;
+        }
+        case server::MessageType::Text:
+        {
+            if (!client.joined || !client.has_snapshot || frame.payload_size < 1)
+            {
+                break;
+            }
+            const std::string text(reinterpret_cast<const char*>(frame.payload) + 1, frame.payload_size - 1);
+            const server::BotAction action = server::decide_bot_action(client.bot, client.snapshot, text, rng);
+            if (action.roll)
+            {
+                server::append_frame(client.output, server::MessageType::Roll, nullptr, 0);
+                client.awaiting_roll = true;
+                client.roll_sent = Clock::now();
+            }
+            for (char key : action.keys)
+            {
+                server::append_frame(client.output, server::MessageType::MinigameInput, &key, 1);
+                stats.minigame_keys++;
+            }
+            break;
+        }
+        case server::MessageType::Error:
+            stats.errors++;
+            client.awaiting_roll = false;
+            client.bot.roll_pending = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void print_latency(const std::vector<double>& samples_in)
+    {
+        if (samples_in.empty())
+        {
+            std::cout << "Roll round trip: no samples\n";
+            return;
+        }
+
+        std::vector<double> samples = samples_in;
+        std::sort(samples.begin(), samples.end());
+        const auto percentile = [&samples](double p) {
+            // Nearest rank
+            const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(samples.size())));
+            return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+        };
+
+        double total = 0.0;
+        for (double sample : samples)
+        {
+            total += sample;
+        }
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Roll round trip us: mean " << total / static_cast<double>(samples.size())
+                  << ", p50 " << percentile(0.50) << ", p90 " << percentile(0.90)
+                  << ", p99 " << percentile(0.99) << ", p99.9 " << percentile(0.999)
+                  << ", max " << samples.back() << '\n';
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    void run_load(const LoadOptions& options)
+    {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.port);
+        if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1)
+        {
+            throw std::runtime_error("Invalid host: " + options.host);
+        }
+
+        const int room_count = options.clients / options.room_size;
+        const long rss_before = options.server_pid > 0 ? read_rss_kib(options.server_pid) : 0;
+
+        const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd < 0)
+        {
+            throw std::runtime_error(std::string("epoll_create1: ") + std::strerror(errno));
+        }
+
+        std::vector<Client> clients(static_cast<std::size_t>(options.clients));
+        for (std::size_t i = 0; i < clients.size(); ++i)
+        {
+            Client& client = clients[i];
+            client.fd = connect_client(address);
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = i;
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client.fd, &event);
+
+            join(client, options.first_room + static_cast<std::uint32_t>(i / static_cast<std::size_t>(options.room_size)));
+            flush(epoll_fd, i, client);
+        }
+        std::cout << "Connected " << clients.size() << " clients in " << room_count << " rooms" << std::endl;
+
+        std::mt19937 rng(static_cast<std::mt19937::result_type>(options.seed));
+        LoadStats stats;
+        std::vector<std::uint8_t> scratch(READ_CHUNK);
+        long rss_rooms = 0;
+        bool measuring = false;
+        Clock::time_point measure_start{};
+        const Clock::time_point start = Clock::now();
+
+        epoll_event events[MAX_EVENTS];
+        while (!g_stop)
+        {
+            const Clock::time_point now = Clock::now();
+            if (!measuring)
+            {
+                const bool all_joined = std::all_of(clients.begin(), clients.end(),
+                                                    [](const Client& client) { return client.fd < 0 || client.joined; });
+                if (all_joined || now - start > std::chrono::seconds(10))
+                {
+                    // Every room is now open, so the server's footprint covers them all
+                    rss_rooms = options.server_pid > 0 ? read_rss_kib(options.server_pid) : 0;
+                    measuring = true;
+                    measure_start = now;
+                }
+            }
+            else if (std::chrono::duration<double>(now - measure_start).count() >= options.duration)
+            {
+                break;
+            }
+
+            const int count = epoll_wait(epoll_fd, events, MAX_EVENTS, 50);
+            for (int e = 0; e < count; ++e)
+            {
+                const std::size_t index = static_cast<std::size_t>(events[e].data.u64);
+                Client& client = clients[index];
+                if (client.fd < 0)
+                {
+                    continue;
+                }
+
+                bool alive = true;
+                if (events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                {
+                    for (;;)
+                    {
+                        const ssize_t received = recv(client.fd, scratch.data(), scratch.size(), 0);
+                        if (received > 0)
+                        {
+                            client.input.insert(client.input.end(), scratch.begin(), scratch.begin() + received);
+                            continue;
+                        }
+                        if (received < 0 && errno == EINTR)
+                        {
+                            continue;
+                        }
+                        alive = received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+                        break;
+                    }
+
+                    std::size_t consumed = 0;
+                    for (;;)
+                    {
+                        server::Frame frame;
+                        const long used = server::parse_frame(client.input.data() + consumed,
+                                                              client.input.size() - consumed, frame);
+                        if (used <= 0)
+                        {
+                            alive = alive && used == 0;
+                            break;
+                        }
+                        handle_frame(client, frame, room_count, measuring, rng, stats);
+                        consumed += static_cast<std::size_t>(used);
+                    }
+                    client.input.erase(client.input.begin(), client.input.begin() + static_cast<std::ptrdiff_t>(consumed));
+                }
+
+                if (alive)
+                {
+                    alive = flush(epoll_fd, index, client);
+                }
+                if (!alive)
+                {
+                    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+                    close(client.fd);
+                    client.fd = -1;
+                    stats.disconnects++;
+                }
+            }
+        }
+
+        const double measured = measuring ? std::chrono::duration<double>(Clock::now() - measure_start).count() : 0.0;
+        for (Client& client : clients)
+        {
+            if (client.fd >= 0)
+            {
+                close(client.fd);
+            }
+        }
+        close(epoll_fd);
+
+        std::cout << "Measured " << std::fixed << std::setprecision(1) << measured << " s with "
+                  << clients.size() << " clients, " << room_count << " rooms\n";
+        std::cout.unsetf(std::ios::floatfield);
+        print_latency(stats.roll_rtt_us);
+        if (measured > 0.0)
+        {
+            std::cout << "Throughput: " << static_cast<long>(static_cast<double>(stats.roll_rtt_us.size()) / measured)
+                      << " rolls/s, " << static_cast<long>(static_cast<double>(stats.minigame_keys) / measured)
+                      << " minigame keys/s, " << stats.games_finished << " games finished\n";
+        }
+        std::cout << "Errors: " << stats.errors << ", disconnects: " << stats.disconnects << '\n';
+        if (options.server_pid > 0 && rss_rooms > 0)
+        {
+            std::cout << "Server RSS: " << rss_before << " KiB idle, " << rss_rooms << " KiB with all rooms open ("
+                      << (rss_rooms - rss_before) * 1024 / room_count << " bytes per room, connections included)\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
+
+    try
+    {
+        run_load(parse_load_options(argc, argv));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "protocol.h"
+
+#include <algorithm>
+
+namespace server
+{
+    namespace
+    {
+        constexpr std::size_t STATE_PAYLOAD_SIZE = 20;
+
+        void put_u16(std::uint8_t* out, std::uint16_t value)
+        {
+            out[0] = static_cast<std::uint8_t>(value);
+            out[1] = static_cast<std::uint8_t>(value >> 8);
+        }
+
+        void put_u64(std::uint8_t* out, std::uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+    }
+
+    void append_frame(std::vector<std::uint8_t>& out, MessageType type, const void* payload, std::size_t payload_size)
+    {
+        payload_size = std::min(payload_size, MAX_FRAME_PAYLOAD);
+        const std::size_t offset = out.size();
+        out.resize(offset + FRAME_HEADER_SIZE + payload_size);
+        put_u16(out.data() + offset, static_cast<std::uint16_t>(payload_size + 1));
+        out[offset + 2] = static_cast<std::uint8_t>(type);
+        if (payload_size > 0)
+        {
+            const auto* bytes = static_cast<const std::uint8_t*>(payload);
+            std::copy(bytes, bytes + payload_size, out.begin() + static_cast<std::ptrdiff_t>(offset + FRAME_HEADER_SIZE));
+        }
+    }
+
+    void append_u32_frame(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t value)
+    {
+        const std::uint8_t payload[4] = {
+            static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8),
+            static_cast<std::uint8_t>(value >> 16), static_cast<std::uint8_t>(value >> 24)};
+        append_frame(out, type, payload, sizeof(payload));
+    }
+
+    void append_state_frame(std::vector<std::uint8_t>& out, const RoomSnapshot& snapshot)
+    {
+        std::uint8_t payload[STATE_PAYLOAD_SIZE] = {
+            static_cast<std::uint8_t>(snapshot.phase), snapshot.num_players, snapshot.current_seat,
+            snapshot.last_roll, snapshot.winner_seat, snapshot.minigame,
+            snapshot.tiles[0], snapshot.tiles[1], snapshot.tiles[2], snapshot.tiles[3]};
+        put_u16(payload + 10, snapshot.turn);
+        put_u64(payload + 12, snapshot.hash);
+        append_frame(out, MessageType::State, payload, sizeof(payload));
+    }
+
+    void append_text_frame(std::vector<std::uint8_t>& out, std::uint8_t seat, const std::string& text)
+    {
+        // Seat byte plus the text, truncated to fit a frame
+        const std::size_t text_size = std::min(text.size(), MAX_FRAME_PAYLOAD - 1);
+        const std::size_t offset = out.size();
+        out.resize(offset + FRAME_HEADER_SIZE + 1 + text_size);
+        put_u16(out.data() + offset, static_cast<std::uint16_t>(text_size + 2));
+        out[offset + 2] = static_cast<std::uint8_t>(MessageType::Text);
+        out[offset + 3] = seat;
+        std::copy(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(text_size),
+                  out.begin() + static_cast<std::ptrdiff_t>(offset + FRAME_HEADER_SIZE + 1));
+    }
+
+    void append_error_frame(std::vector<std::uint8_t>& out, ErrorCode code)
+    {
+        const std::uint8_t payload = static_cast<std::uint8_t>(code);
+        append_frame(out, MessageType::Error, &payload, 1);
+    }
+
+    long parse_frame(const std::uint8_t* data, std::size_t size, Frame& frame)
+    {
+        if (size < FRAME_HEADER_SIZE)
+        {
+            return 0;
+        }
+
+        const std::size_t length = static_cast<std::size_t>(data[0]) | (static_cast<std::size_t>(data[1]) << 8);
+        if (length == 0 || length > MAX_FRAME_PAYLOAD + 1)
+        {
+            return -1;
+        }
+        if (size < 2 + length)
+        {
+            return 0;
+        }
+
+        frame.type = static_cast<MessageType>(data[2]);
+        frame.payload = data + FRAME_HEADER_SIZE;
+        frame.payload_size = length - 1;
+        return static_cast<long>(2 + length);
+    }
+
+    std::uint32_t read_u32(const std::uint8_t* data)
+    {
+        return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+               (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+    }
+
+    std::uint64_t read_u64(const std::uint8_t* data)
+    {
+        return static_cast<std::uint64_t>(read_u32(data)) | (static_cast<std::uint64_t>(read_u32(data + 4)) << 32);
+    }
+
+    bool decode_state(const Frame& frame, RoomSnapshot& snapshot)
+    {
+        if (frame.type != MessageType::State || frame.payload_size < STATE_PAYLOAD_SIZE)
+        {
+            return false;
+        }
+
+        const std::uint8_t* p = frame.payload;
+        snapshot.phase = static_cast<RoomPhase>(p[0]);
+        snapshot.num_players = p[1];
+        snapshot.current_seat = p[2];
+        snapshot.last_roll = p[3];
+        snapshot.winner_seat = p[4];
+        snapshot.minigame = p[5];
+        std::copy(p + 6, p + 10, snapshot.tiles);
+        snapshot.turn = static_cast<std::uint16_t>(p[10] | (p[11] << 8));
+        snapshot.hash = read_u64(p + 12);
+        return true;
+    }
+}
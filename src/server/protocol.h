@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wire format shared by snl_server and its clients. Every message is a frame:
+//   u16 length (of everything after it), u8 type, payload
+// with all integers little-endian. Clients only ever send intents; the server
+// owns the dice, the board rules and the minigames and answers with state.
+namespace server
+{
+    constexpr std::size_t FRAME_HEADER_SIZE = 3;
+    constexpr std::size_t MAX_FRAME_PAYLOAD = 512;  // Anything longer drops the connection
+
+    enum class MessageType : std::uint8_t
+    {
+        // Client -> server
+        Join = 1,           // u32 room id
+        Roll = 2,           // -
+        MinigameInput = 3,  // u8 character: digit, 'W'/'A'/'S'/'D', '\b', '\n' or ' '
+        Leave = 4,          // -
+        Ping = 5,           // u64 opaque, echoed back in Pong
+
+        // Server -> client
+        Joined = 64,        // u32 room id, u8 seat
+        State = 65,         // RoomSnapshot (see below)
+        Text = 66,          // u8 seat, then the message/minigame text (rest of the frame)
+        Error = 67,         // u8 ErrorCode
+        Pong = 68           // u64 copied from the Ping
+    };
+
+    enum class ErrorCode : std::uint8_t
+    {
+        None = 0,           // Never sent; the request was accepted
+        BadMessage = 1,
+        RoomFull = 2,
+        NotInRoom = 3,
+        NotYourTurn = 4,
+        GameInProgress = 5,
+        NoMinigame = 6
+    };
+
+    enum class RoomPhase : std::uint8_t
+    {
+        Waiting = 0,   // Fewer than two players
+        AwaitRoll = 1,
+        Minigame = 2,
+        Finished = 3
+    };
+
+    // Payload of MessageType::State, 20 bytes on the wire
+    struct RoomSnapshot
+    {
+        RoomPhase phase = RoomPhase::Waiting;
+        std::uint8_t num_players = 0;
+        std::uint8_t current_seat = 0;
+        std::uint8_t last_roll = 0;      // 0 = no roll yet this turn
+        std::uint8_t winner_seat = 0xFF; // 0xFF while nobody has won
+        std::uint8_t minigame = 0;       // ActivityKind of the running minigame, 0 if none
+        std::uint8_t tiles[4] = {0, 0, 0, 0};
+        std::uint16_t turn = 0;
+        std::uint64_t hash = 0;          // game::hash_turn_state of the room, for desync checks
+    };
+
+    struct Frame
+    {
+        MessageType type = MessageType::Ping;
+        const std::uint8_t* payload = nullptr;
+        std::size_t payload_size = 0;
+    };
+
+    // Appends one complete frame to out
+    void append_frame(std::vector<std::uint8_t>& out, MessageType type, const void* payload, std::size_t payload_size);
+    void append_u32_frame(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t value);
+    void append_state_frame(std::vector<std::uint8_t>& out, const RoomSnapshot& snapshot);
+    void append_text_frame(std::vector<std::uint8_t>& out, std::uint8_t seat, const std::string& text);
+    void append_error_frame(std::vector<std::uint8_t>& out, ErrorCode code);
+
+    // Parses the frame at data[0..size). Returns bytes consumed, 0 if more data is
+    // needed, or -1 if the stream is malformed.
+    long parse_frame(const std::uint8_t* data, std::size_t size, Frame& frame);
+
+    std::uint32_t read_u32(const std::uint8_t* data);
+    std::uint64_t read_u64(const std::uint8_t* data);
+    bool decode_state(const Frame& frame, RoomSnapshot& snapshot);
+}
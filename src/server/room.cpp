@@ -0,0 +1,538 @@
+#include "room.h"
+
+#include "../core/random.h"
+#include "../game/map/board_rules.h"
+#include "../game/state_hash.h"
+
+#include <algorithm>
+#include <random>
+
+namespace server
+{
+    namespace
+    {
+        using game::map::ActivityKind;
+
+        constexpr int FINAL_TILE = game::map::BOARD_COLUMNS * game::map::BOARD_ROWS - 1;
+        constexpr int MAX_WALK_UPDATES = 64;    // Longest move is a 6 plus a 6 bonus, two updates per step at most
+        constexpr int MAX_LANDING_CHAIN = 8;    // Slide -> Bonus -> WalkBackward -> ... never chains this far on the real board
+
+        // Runs the player's step state machine to completion in one go - each update
+        // with a full step_duration finishes the step in flight and schedules the next
+        void walk(game::player::PlayerState& player)
+        {
+            for (int i = 0; i < MAX_WALK_UPDATES && (player.steps_remaining > 0 || player.is_stepping); ++i)
+            {
+                game::player::update(player, player.step_duration, false, FINAL_TILE, true);
+            }
+        }
+
+        bool has_started(const Room& room)
+        {
+            return room.turn > 0 || room.last_roll > 0;
+        }
+
+        void seat_first_player(Room& room)
+        {
+            for (int seat = 0; seat < ROOM_SEATS; ++seat)
+            {
+                if (room.connections[seat] != NO_CONNECTION)
+                {
+                    room.current_seat = seat;
+                    return;
+                }
+            }
+        }
+
+        void end_turn(Room& room)
+        {
+            game::player::PlayerState& player = room.players[room.current_seat];
+            game::player::stop_walking(player);
+            player.last_dice_result = 0;
+            room.minigame = ActivityKind::None;
+            room.phase = RoomPhase::AwaitRoll;
+
+            for (int i = 1; i <= ROOM_SEATS; ++i)
+            {
+                const int seat = (room.current_seat + i) % ROOM_SEATS;
+                if (room.connections[seat] != NO_CONNECTION)
+                {
+                    room.current_seat = seat;
+                    break;
+                }
+            }
+            room.last_roll = 0;
+            room.turn++;
+        }
+
+        void finish_game(Room& room, int seat)
+        {
+            game::player::warp_to_tile(room.players[seat], FINAL_TILE);
+            room.winner_seat = seat;
+            room.phase = RoomPhase::Finished;
+        }
+
+        // Same order of checks as GameLoop: win, ladder, snake, then the tile effect.
+        // Activities that add steps walk again and land on a new tile.
+        void resolve_move(Room& room)
+        {
+            const int seat = room.current_seat;
+            game::player::PlayerState& player = room.players[seat];
+            int& last_processed_tile = room.last_processed_tiles[seat];
+
+            for (int chain = 0; chain < MAX_LANDING_CHAIN; ++chain)
+            {
+                walk(player);
+                const int tile = std::min(player.current_tile_index, FINAL_TILE);
+                if (tile == last_processed_tile)
+                {
+                    break;
+                }
+                last_processed_tile = tile;
+
+                if (tile >= FINAL_TILE)
+                {
+                    // Overshooting steps count as reaching the end, as in the game
+                    finish_game(room, seat);
+                    return;
+                }
+
+                if (game::map::check_and_apply_ladder(player, tile, last_processed_tile) ||
+                    game::map::check_and_apply_snake(player, tile, last_processed_tile))
+                {
+                    break;
+                }
+
+                game::map::TileEffectContext context{player, room.precision_state, room.tile_memory_state,
+                                                     room.reaction_state, room.math_state, room.pattern_state,
+                                                     room.message, room.message_timer};
+                const game::map::TileEffectResult effect = game::map::run_tile_effect(tile, context);
+                if (!effect.applied)
+                {
+                    break;
+                }
+                if (effect.warped)
+                {
+                    last_processed_tile = player.current_tile_index;
+                }
+
+                if (player.current_tile_index >= FINAL_TILE)
+                {
+                    // A portal can drop the player straight onto the final tile
+                    finish_game(room, seat);
+                    return;
+                }
+
+                if (effect.minigame != ActivityKind::None)
+                {
+                    room.minigame = effect.minigame;
+                    room.phase = RoomPhase::Minigame;
+                    return;
+                }
+                if (player.steps_remaining <= 0)
+                {
+                    break;  // Skip turn, trap or portal
+                }
+            }
+
+            end_turn(room);
+        }
+
+        bool in_title(const Room& room)
+        {
+            switch (room.minigame)
+            {
+            case ActivityKind::MiniGame:
+                return room.precision_state.status == game::minigame::PrecisionTimingStatus::ShowingTitle;
+            case ActivityKind::MemoryGame:
+                return room.tile_memory_state.phase == game::minigame::tile_memory::Phase::ShowingTitle;
+            case ActivityKind::ReactionGame:
+                return room.reaction_state.phase == game::minigame::ReactionState::Phase::ShowingTitle;
+            case ActivityKind::MathGame:
+                return room.math_state.phase == game::minigame::MathQuizState::Phase::ShowingTitle;
+            case ActivityKind::PatternGame:
+                return room.pattern_state.phase == game::minigame::PatternMatchingState::Phase::ShowingTitle;
+            default:
+                return false;
+            }
+        }
+
+        // Returns true once the minigame has a result, with bonus set to the steps won
+        bool take_minigame_result(Room& room, int& bonus)
+        {
+            bool success = false;
+            switch (room.minigame)
+            {
+            case ActivityKind::MiniGame:
+                if (room.precision_state.is_showing_time ||
+                    !(game::minigame::is_success(room.precision_state) || game::minigame::is_failure(room.precision_state)))
+                {
+                    return false;
+                }
+                success = game::minigame::is_success(room.precision_state);
+                bonus = game::minigame::get_bonus_steps(room.precision_state);
+                room.message = room.precision_state.result_message;
+                game::minigame::reset(room.precision_state);
+                break;
+            case ActivityKind::MemoryGame:
+                if (!game::minigame::tile_memory::is_result(room.tile_memory_state))
+                {
+                    return false;
+                }
+                success = game::minigame::tile_memory::is_success(room.tile_memory_state);
+                bonus = game::minigame::tile_memory::get_bonus_steps(room.tile_memory_state);
+                room.message = game::minigame::tile_memory::get_display_text(room.tile_memory_state);
+                game::minigame::tile_memory::reset(room.tile_memory_state);
+                break;
+            case ActivityKind::ReactionGame:
+                if (!game::minigame::is_success(room.reaction_state) && !game::minigame::is_failure(room.reaction_state))
+                {
+                    return false;
+                }
+                success = game::minigame::is_success(room.reaction_state);
+                bonus = game::minigame::get_bonus_steps(room.reaction_state);
+                room.message = game::minigame::get_display_text(room.reaction_state);
+                game::minigame::reset(room.reaction_state);
+                break;
+            case ActivityKind::MathGame:
+                if (!game::minigame::is_success(room.math_state) && !game::minigame::is_failure(room.math_state))
+                {
+                    return false;
+                }
+                success = game::minigame::is_success(room.math_state);
+                bonus = game::minigame::get_bonus_steps(room.math_state);
+                room.message = game::minigame::get_display_text(room.math_state);
+                game::minigame::reset(room.math_state);
+                break;
+            case ActivityKind::PatternGame:
+                if (!game::minigame::is_success(room.pattern_state) && !game::minigame::is_failure(room.pattern_state))
+                {
+                    return false;
+                }
+                success = game::minigame::is_success(room.pattern_state);
+                bonus = game::minigame::get_bonus_steps(room.pattern_state);
+                room.message = game::minigame::get_display_text(room.pattern_state);
+                game::minigame::reset(room.pattern_state);
+                break;
+            default:
+                bonus = 0;
+                return true;
+            }
+
+            if (!success)
+            {
+                bonus = 0;
+            }
+            return true;
+        }
+
+        void finish_minigame_if_done(Room& room)
+        {
+            int bonus = 0;
+            if (!take_minigame_result(room, bonus))
+            {
+                return;
+            }
+
+            room.minigame = ActivityKind::None;
+            room.phase = RoomPhase::AwaitRoll;
+            if (bonus > 0)
+            {
+                game::player::add_steps(room.players[room.current_seat], bonus);
+                resolve_move(room);
+            }
+            else
+            {
+                end_turn(room);
+            }
+        }
+    }
+
+    void initialize_room(Room& room, std::uint32_t id)
+    {
+        room = Room{};
+        room.id = id;
+        for (int seat = 0; seat < ROOM_SEATS; ++seat)
+        {
+            game::player::PlayerState& player = room.players[seat];
+            game::player::initialize(player, game::map::tile_center_world(0), 0.0f, player.radius, seat);
+        }
+    }
+
+    int find_seat(const Room& room, std::uint32_t connection)
+    {
+        for (int seat = 0; seat < ROOM_SEATS; ++seat)
+        {
+            if (room.connections[seat] == connection)
+            {
+                return seat;
+            }
+        }
+        return -1;
+    }
+
+    int occupied_seats(const Room& room)
+    {
+        int count = 0;
+        for (std::uint32_t connection : room.connections)
+        {
+            count += connection != NO_CONNECTION ? 1 : 0;
+        }
+        return count;
+    }
+
+    ErrorCode join_room(Room& room, std::uint32_t connection, int& seat)
+    {
+        if (has_started(room) || room.phase == RoomPhase::Finished)
+        {
+            return ErrorCode::GameInProgress;
+        }
+
+        seat = find_seat(room, NO_CONNECTION);
+        if (seat < 0)
+        {
+            return ErrorCode::RoomFull;
+        }
+
+        room.connections[seat] = connection;
+        room.num_players = std::max(room.num_players, seat + 1);
+        if (occupied_seats(room) >= 2)
+        {
+            room.phase = RoomPhase::AwaitRoll;
+            seat_first_player(room);
+        }
+        return ErrorCode::None;
+    }
+
+    void leave_room(Room& room, int seat)
+    {
+        if (seat < 0 || seat >= ROOM_SEATS || room.connections[seat] == NO_CONNECTION)
+        {
+            return;
+        }
+        room.connections[seat] = NO_CONNECTION;
+
+        if (room.phase == RoomPhase::Finished)
+        {
+            return;
+        }
+
+        if (!has_started(room))
+        {
+            // Nobody has rolled yet, so the seat can simply be given back
+            room.phase = occupied_seats(room) >= 2 ? RoomPhase::AwaitRoll : RoomPhase::Waiting;
+            seat_first_player(room);
+            return;
+        }
+
+        if (occupied_seats(room) == 1)
+        {
+            seat_first_player(room);
+            room.winner_seat = room.current_seat;
+            room.minigame = ActivityKind::None;
+            room.phase = RoomPhase::Finished;
+            return;
+        }
+
+        if (seat == room.current_seat)
+        {
+            // Abandon whatever the leaver had going and pass the turn on
+            game::minigame::reset(room.precision_state);
+            game::minigame::tile_memory::reset(room.tile_memory_state);
+            game::minigame::reset(room.reaction_state);
+            game::minigame::reset(room.math_state);
+            game::minigame::reset(room.pattern_state);
+            end_turn(room);
+        }
+    }
+
+    ErrorCode roll(Room& room, int seat)
+    {
+        if (room.phase != RoomPhase::AwaitRoll || seat != room.current_seat)
+        {
+            return ErrorCode::NotYourTurn;
+        }
+
+        std::uniform_int_distribution<int> dist(1, 6);
+        room.last_roll = dist(core::random_stream(core::RandomStream::Dice));
+        room.message.clear();
+        game::player::set_dice_result(room.players[seat], room.last_roll);
+        resolve_move(room);
+        return ErrorCode::None;
+    }
+
+    ErrorCode minigame_input(Room& room, int seat, char c)
+    {
+        if (room.phase != RoomPhase::Minigame)
+        {
+            return ErrorCode::NoMinigame;
+        }
+        if (seat != room.current_seat)
+        {
+            return ErrorCode::NotYourTurn;
+        }
+
+        // Space on a title screen starts the minigame, as it does in the game
+        const bool title = in_title(room);
+        const bool digit = c >= '0' && c <= '9';
+        switch (room.minigame)
+        {
+        case ActivityKind::MiniGame:
+            if (title && c == ' ')
+            {
+                game::minigame::skip_title(room.precision_state);
+            }
+            else if (c == ' ')
+            {
+                game::minigame::stop_timing(room.precision_state);
+            }
+            break;
+        case ActivityKind::MemoryGame:
+            if (title && c == ' ')
+            {
+                game::minigame::tile_memory::skip_title(room.tile_memory_state);
+            }
+            else if (digit)
+            {
+                game::minigame::tile_memory::add_digit(room.tile_memory_state, c);
+            }
+            else if (c == '\b')
+            {
+                game::minigame::tile_memory::remove_digit(room.tile_memory_state);
+            }
+            else if (c == '\n')
+            {
+                game::minigame::tile_memory::submit_buffer(room.tile_memory_state);
+            }
+            break;
+        case ActivityKind::ReactionGame:
+            if (title && c == ' ')
+            {
+                game::minigame::skip_title(room.reaction_state);
+            }
+            else if (digit)
+            {
+                game::minigame::add_digit(room.reaction_state, c);
+            }
+            else if (c == '\b')
+            {
+                game::minigame::remove_digit(room.reaction_state);
+            }
+            else if (c == '\n')
+            {
+                game::minigame::submit_buffer(room.reaction_state);
+            }
+            break;
+        case ActivityKind::MathGame:
+            if (title && c == ' ')
+            {
+                game::minigame::skip_title(room.math_state);
+            }
+            else if (digit)
+            {
+                game::minigame::add_digit(room.math_state, c);
+            }
+            else if (c == '\b')
+            {
+                game::minigame::remove_digit(room.math_state);
+            }
+            else if (c == '\n')
+            {
+                game::minigame::submit_buffer(room.math_state);
+            }
+            break;
+        case ActivityKind::PatternGame:
+            if (title && c == ' ')
+            {
+                game::minigame::skip_title(room.pattern_state);
+            }
+            else if (c == 'W' || c == 'A' || c == 'S' || c == 'D')
+            {
+                game::minigame::add_char_input(room.pattern_state, c);
+            }
+            else if (c == '\b')
+            {
+                game::minigame::delete_char(room.pattern_state);
+            }
+            else if (c == '\n')
+            {
+                game::minigame::submit_answer(room.pattern_state);
+            }
+            break;
+        default:
+            break;
+        }
+
+        finish_minigame_if_done(room);
+        return ErrorCode::None;
+    }
+
+    bool tick_room(Room& room, float delta_time)
+    {
+        if (room.phase != RoomPhase::Minigame)
+        {
+            return false;
+        }
+
+        switch (room.minigame)
+        {
+        case ActivityKind::MiniGame:
+            game::minigame::advance(room.precision_state, delta_time);
+            break;
+        case ActivityKind::MemoryGame:
+            game::minigame::tile_memory::advance(room.tile_memory_state, delta_time);
+            break;
+        case ActivityKind::ReactionGame:
+            game::minigame::advance(room.reaction_state, delta_time);
+            break;
+        case ActivityKind::MathGame:
+            game::minigame::advance(room.math_state, delta_time);
+            break;
+        case ActivityKind::PatternGame:
+            game::minigame::advance(room.pattern_state, delta_time);
+            break;
+        default:
+            break;
+        }
+
+        finish_minigame_if_done(room);
+        return true;
+    }
+
+    RoomSnapshot snapshot_room(const Room& room)
+    {
+        RoomSnapshot snapshot;
+        snapshot.phase = room.phase;
+        snapshot.num_players = static_cast<std::uint8_t>(room.num_players);
+        snapshot.current_seat = static_cast<std::uint8_t>(room.current_seat);
+        snapshot.last_roll = static_cast<std::uint8_t>(room.last_roll);
+        snapshot.winner_seat = room.winner_seat >= 0 ? static_cast<std::uint8_t>(room.winner_seat) : 0xFF;
+        snapshot.minigame = static_cast<std::uint8_t>(room.minigame);
+        for (int seat = 0; seat < ROOM_SEATS; ++seat)
+        {
+            snapshot.tiles[seat] = static_cast<std::uint8_t>(room.players[seat].current_tile_index);
+        }
+        snapshot.turn = room.turn;
+        snapshot.hash = game::hash_turn_state(room.players.data(), ROOM_SEATS, room.current_seat);
+        return snapshot;
+    }
+
+    std::string room_text(const Room& room)
+    {
+        switch (room.minigame)
+        {
+        case ActivityKind::MiniGame:
+            return game::minigame::get_display_text(room.precision_state);
+        case ActivityKind::MemoryGame:
+            return game::minigame::tile_memory::get_display_text(room.tile_memory_state);
+        case ActivityKind::ReactionGame:
+            return game::minigame::get_display_text(room.reaction_state);
+        case ActivityKind::MathGame:
+            return game::minigame::get_display_text(room.math_state);
+        case ActivityKind::PatternGame:
+            return game::minigame::get_display_text(room.pattern_state);
+        default:
+            return room.message;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "protocol.h"
+
+#include "../game/map/board.h"
+#include "../game/minigame/math_minigame.h"
+#include "../game/minigame/pattern_minigame.h"
+#include "../game/minigame/qte_minigame.h"
+#include "../game/minigame/reaction_minigame.h"
+#include "../game/minigame/tile_memory_minigame.h"
+#include "../game/player/player.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace server
+{
+    constexpr int ROOM_SEATS = 4;
+    constexpr std::uint32_t NO_CONNECTION = 0;
+
+    // One game. Owned by exactly one worker thread, so nothing in here is locked.
+    // Moves resolve instantly - walking animation is the client's business - which
+    // keeps a turn down to a handful of rule checks.
+    struct Room
+    {
+        std::uint32_t id = 0;
+        std::array<std::uint32_t, ROOM_SEATS> connections{};  // NO_CONNECTION = empty seat
+        std::array<game::player::PlayerState, ROOM_SEATS> players{};
+        std::array<int, ROOM_SEATS> last_processed_tiles{};
+        int num_players = 0;   // Seats taken since the room opened
+        int current_seat = 0;
+        int last_roll = 0;
+        int winner_seat = -1;
+        std::uint16_t turn = 0;
+        RoomPhase phase = RoomPhase::Waiting;
+
+        game::map::ActivityKind minigame = game::map::ActivityKind::None;
+        game::minigame::PrecisionTimingState precision_state{};
+        game::minigame::tile_memory::TileMemoryState tile_memory_state{};
+        game::minigame::ReactionState reaction_state{};
+        game::minigame::MathQuizState math_state{};
+        game::minigame::PatternMatchingState pattern_state{};
+
+        // Scratch required by run_tile_effect; the server only forwards the text
+        std::string message;
+        float message_timer = 0.0f;
+    };
+
+    void initialize_room(Room& room, std::uint32_t id);
+
+    // Seat of connection, or -1 if it is not in the room
+    int find_seat(const Room& room, std::uint32_t connection);
+    int occupied_seats(const Room& room);
+
+    // Seats a connection. Players can join until the first roll of the game.
+    ErrorCode join_room(Room& room, std::uint32_t connection, int& seat);
+    // Frees the seat; the game carries on without it, and the last player left wins
+    void leave_room(Room& room, int seat);
+
+    ErrorCode roll(Room& room, int seat);
+    // c is a digit, 'W'/'A'/'S'/'D', '\b' (delete), '\n' (submit) or ' ' (skip title / stop timer)
+    ErrorCode minigame_input(Room& room, int seat, char c);
+
+    // Runs the active minigame's timers and finishes the turn once it has a result.
+    // Returns true if clients should get a fresh state (a minigame was running).
+    bool tick_room(Room& room, float delta_time);
+
+    RoomSnapshot snapshot_room(const Room& room);
+    // Minigame display text while one runs, otherwise the last tile message
+    std::string room_text(const Room& room);
+}
@@ -0,0 +1,736 @@
+#include "server.h"
+
+#include "protocol.h"
+#include "room.h"
+
+#include "../core/random.h"
+#include "../game/map/board_file.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+    namespace
+    {
+        // epoll tokens above the 32-bit connection ids
+        constexpr std::uint64_t LISTEN_TOKEN = 1ull << 32;
+        constexpr std::uint64_t OUTBOX_TOKEN = LISTEN_TOKEN + 1;
+        constexpr std::uint64_t TICK_TOKEN = LISTEN_TOKEN + 2;
+
+        constexpr int MAX_EVENTS = 256;
+        constexpr int STOP_POLL_MS = 200;
+        constexpr std::size_t READ_CHUNK = 4096;
+        constexpr std::size_t MAX_PENDING_OUTPUT = 256 * 1024;  // A client this far behind is dropped
+
+        std::atomic<bool> g_stop_requested{false};
+
+        enum class IntentKind
+        {
+            Join,
+            Roll,
+            MinigameInput,
+            Leave,
+            Tick
+        };
+
+        struct Intent
+        {
+            IntentKind kind = IntentKind::Tick;
+            std::uint32_t connection = NO_CONNECTION;
+            std::uint32_t room = 0;
+            char input = 0;
+        };
+
+        struct Delivery
+        {
+            std::uint32_t connection = NO_CONNECTION;
+            std::vector<std::uint8_t> bytes;
+        };
+
+        // Worker -> network thread. The eventfd wakes epoll_wait when it fills up.
+        struct Outbox
+        {
+            std::mutex mutex;
+            std::vector<Delivery> deliveries;
+            int event_fd = -1;
+        };
+
+        struct Worker
+        {
+            std::thread thread;
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::vector<Intent> queue;
+            bool tick_pending = false;  // Ticks collapse if the worker falls behind
+            bool stop = false;
+
+            // Only touched by the worker thread
+            std::unordered_map<std::uint32_t, Room> rooms;
+            core::RandomStreams streams;
+        };
+
+        struct Connection
+        {
+            int fd = -1;
+            std::vector<std::uint8_t> input;
+            std::vector<std::uint8_t> output;
+            std::size_t output_offset = 0;
+            std::uint32_t room = 0;
+            bool in_room = false;
+            bool want_write = false;
+        };
+
+        struct Server
+        {
+            int epoll_fd = -1;
+            int listen_fd = -1;
+            int tick_fd = -1;
+            std::uint32_t next_connection = 1;
+            std::unordered_map<std::uint32_t, Connection> connections;
+            std::vector<std::unique_ptr<Worker>> workers;
+            Outbox outbox;
+        };
+
+        std::runtime_error system_error(const std::string& what)
+        {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        // --- Workers -----------------------------------------------------------
+
+        void post(Worker& worker, const Intent& intent)
+        {
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (intent.kind == IntentKind::Tick)
+                {
+                    if (worker.tick_pending)
+                    {
+                        return;
+                    }
+                    worker.tick_pending = true;
+                }
+                worker.queue.push_back(intent);
+            }
+            worker.wake.notify_one();
+        }
+
+        void send_error(std::vector<Delivery>& deliveries, std::uint32_t connection, ErrorCode code)
+        {
+            Delivery delivery{connection, {}};
+            append_error_frame(delivery.bytes, code);
+            deliveries.push_back(std::move(delivery));
+        }
+
+        // State and text are encoded once and copied to every seat
+        void broadcast(const Room& room, std::vector<Delivery>& deliveries)
+        {
+            std::vector<std::uint8_t> bytes;
+            append_state_frame(bytes, snapshot_room(room));
+            append_text_frame(bytes, static_cast<std::uint8_t>(room.current_seat), room_text(room));
+            for (std::uint32_t connection : room.connections)
+            {
+                if (connection != NO_CONNECTION)
+                {
+                    deliveries.push_back({connection, bytes});
+                }
+            }
+        }
+
+        void handle_intent(Worker& worker, const Intent& intent,
+                           std::chrono::steady_clock::time_point& last_tick,
+                           std::vector<Delivery>& deliveries)
+        {
+            if (intent.kind == IntentKind::Tick)
+            {
+                const auto now = std::chrono::steady_clock::now();
+                const float delta_time = std::chrono::duration<float>(now - last_tick).count();
+                last_tick = now;
+                for (auto& entry : worker.rooms)
+                {
+                    if (tick_room(entry.second, delta_time))
+                    {
+                        broadcast(entry.second, deliveries);
+                    }
+                }
+                return;
+            }
+
+            auto it = worker.rooms.find(intent.room);
+            if (intent.kind == IntentKind::Join)
+            {
+                if (it == worker.rooms.end())
+                {
+                    it = worker.rooms.emplace(intent.room, Room{}).first;
+                    initialize_room(it->second, intent.room);
+                }
+
+                Room& room = it->second;
+                int seat = -1;
+                const ErrorCode error = join_room(room, intent.connection, seat);
+                if (error != ErrorCode::None)
+                {
+                    send_error(deliveries, intent.connection, error);
+                    return;
+                }
+
+                const std::uint8_t payload[5] = {
+                    static_cast<std::uint8_t>(intent.room), static_cast<std::uint8_t>(intent.room >> 8),
+                    static_cast<std::uint8_t>(intent.room >> 16), static_cast<std::uint8_t>(intent.room >> 24),
+                    static_cast<std::uint8_t>(seat)};
+                Delivery joined{intent.connection, {}};
+                append_frame(joined.bytes, MessageType::Joined, payload, sizeof(payload));
+                deliveries.push_back(std::move(joined));
+                broadcast(room, deliveries);
+                return;
+            }
+
+            const int seat = it != worker.rooms.end() ? find_seat(it->second, intent.connection) : -1;
+            if (intent.kind == IntentKind::Leave)
+            {
+                if (seat < 0)
+                {
+                    return;
+                }
+                leave_room(it->second, seat);
+                if (occupied_seats(it->second) == 0)
+                {
+                    worker.rooms.erase(it);
+                }
+                else
+                {
+                    broadcast(it->second, deliveries);
+                }
+                return;
+            }
+
+            if (seat < 0)
+            {
+                send_error(deliveries, intent.connection, ErrorCode::NotInRoom);
+                return;
+            }
+
+            Room& room = it->second;
+            const ErrorCode error = intent.kind == IntentKind::Roll ? roll(room, seat)
+                                                                    : minigame_input(room, seat, intent.input);
+            if (error != ErrorCode::None)
+            {
+                send_error(deliveries, intent.connection, error);
+                return;
+            }
+            broadcast(room, deliveries);
+        }
+
+        void run_worker(Worker& worker, Outbox& outbox)
+        {
+            core::set_thread_random_streams(&worker.streams);
+
+            std::vector<Intent> batch;
+            std::vector<Delivery> deliveries;
+            auto last_tick = std::chrono::steady_clock::now();
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(worker.mutex);
+                    worker.wake.wait(lock, [&worker] { return worker.stop || !worker.queue.empty(); });
+                    if (worker.stop)
+                    {
+                        break;
+                    }
+                    batch.swap(worker.queue);
+                    worker.tick_pending = false;
+                }
+
+                for (const Intent& intent : batch)
+                {
+                    handle_intent(worker, intent, last_tick, deliveries);
+                }
+                batch.clear();
+
+                if (!deliveries.empty())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(outbox.mutex);
+                        std::move(deliveries.begin(), deliveries.end(), std::back_inserter(outbox.deliveries));
+                    }
+                    deliveries.clear();
+                    const std::uint64_t one = 1;
+                    (void)!write(outbox.event_fd, &one, sizeof(one));
+                }
+            }
+
+            core::set_thread_random_streams(nullptr);
+        }
+
+        Worker& worker_for_room(Server& server, std::uint32_t room)
+        {
+            return *server.workers[room % server.workers.size()];
+        }
+
+        // --- Network thread ----------------------------------------------------
+
+        void watch(Server& server, int fd, std::uint32_t events, std::uint64_t token, int operation = EPOLL_CTL_ADD)
+        {
+            epoll_event event{};
+            event.events = events;
+            event.data.u64 = token;
+            if (epoll_ctl(server.epoll_fd, operation, fd, &event) != 0)
+            {
+                throw system_error("epoll_ctl");
+            }
+        }
+
+        int open_listen_socket(const ServerOptions& options)
+        {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(options.port);
+            if (inet_pton(AF_INET, options.bind_address.c_str(), &address.sin_addr) != 1)
+            {
+                throw std::runtime_error("Invalid bind address: " + options.bind_address);
+            }
+
+            const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd < 0)
+            {
+                throw system_error("socket");
+            }
+
+            const int enable = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+            if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(fd, SOMAXCONN) != 0)
+            {
+                const std::runtime_error error = system_error("bind/listen " + options.bind_address + ":" + std::to_string(options.port));
+                close(fd);
+                throw error;
+            }
+            return fd;
+        }
+
+        void close_connection(Server& server, std::uint32_t id)
+        {
+            auto it = server.connections.find(id);
+            if (it == server.connections.end())
+            {
+                return;
+            }
+
+            Connection& connection = it->second;
+            if (connection.in_room)
+            {
+                post(worker_for_room(server, connection.room), {IntentKind::Leave, id, connection.room, 0});
+            }
+            epoll_ctl(server.epoll_fd, EPOLL_CTL_DEL, connection.fd, nullptr);
+            close(connection.fd);
+            server.connections.erase(it);
+        }
+
+        // Writes as much as the socket takes and asks for EPOLLOUT only while
+        // something is left over. Returns false if the connection should be dropped.
+        bool flush_output(Server& server, std::uint32_t id, Connection& connection)
+        {
+            while (connection.output_offset < connection.output.size())
+            {
+                const ssize_t written = send(connection.fd,
+                                             connection.output.data() + connection.output_offset,
+                                             connection.output.size() - connection.output_offset,
+                                             MSG_NOSIGNAL);
+                if (written < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        break;
+                    }
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                connection.output_offset += static_cast<std::size_t>(written);
+            }
+
+            const std::size_t pending = connection.output.size() - connection.output_offset;
+            if (pending == 0)
+            {
+                connection.output.clear();
+                connection.output_offset = 0;
+            }
+            else if (pending > MAX_PENDING_OUTPUT)
+            {
+                return false;
+            }
+
+            const bool want_write = pending > 0;
+            if (want_write != connection.want_write)
+            {
+                connection.want_write = want_write;
+                watch(server, connection.fd, EPOLLIN | EPOLLRDHUP | (want_write ? EPOLLOUT : 0u), id, EPOLL_CTL_MOD);
+            }
+            return true;
+        }
+
+        bool queue_output(Server& server, std::uint32_t id, Connection& connection, const std::vector<std::uint8_t>& bytes)
+        {
+            connection.output.insert(connection.output.end(), bytes.begin(), bytes.end());
+            return flush_output(server, id, connection);
+        }
+
+        // Returns false if the client broke the protocol
+        bool handle_frame(Server& server, std::uint32_t id, Connection& connection, const Frame& frame,
+                          std::vector<std::uint8_t>& reply)
+        {
+            switch (frame.type)
+            {
+            case MessageType::Join:
+            {
+                if (frame.payload_size != 4)
+                {
+                    return false;
+                }
+                const std::uint32_t room = read_u32(frame.payload);
+                if (connection.in_room && connection.room != room)
+                {
+                    post(worker_for_room(server, connection.room), {IntentKind::Leave, id, connection.room, 0});
+                }
+                connection.room = room;
+                connection.in_room = true;
+                post(worker_for_room(server, room), {IntentKind::Join, id, room, 0});
+                return true;
+            }
+            case MessageType::Roll:
+            case MessageType::MinigameInput:
+            {
+                const bool input = frame.type == MessageType::MinigameInput;
+                if (input && frame.payload_size != 1)
+                {
+                    return false;
+                }
+                if (!connection.in_room)
+                {
+                    append_error_frame(reply, ErrorCode::NotInRoom);
+                    return true;
+                }
+                const Intent intent{input ? IntentKind::MinigameInput : IntentKind::Roll, id, connection.room,
+                                    input ? static_cast<char>(frame.payload[0]) : '\0'};
+                post(worker_for_room(server, connection.room), intent);
+                return true;
+            }
+            case MessageType::Leave:
+                if (connection.in_room)
+                {
+                    post(worker_for_room(server, connection.room), {IntentKind::Leave, id, connection.room, 0});
+                    connection.in_room = false;
+                }
+                return true;
+            case MessageType::Ping:
+                // Answered here so it measures the network path, not the workers
+                if (frame.payload_size != 8)
+                {
+                    return false;
+                }
+                append_frame(reply, MessageType::Pong, frame.payload, frame.payload_size);
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void read_connection(Server& server, std::uint32_t id)
+        {
+            auto it = server.connections.find(id);
+            if (it == server.connections.end())
+            {
+                return;
+            }
+            Connection& connection = it->second;
+
+            bool closed = false;
+            for (;;)
+            {
+                const std::size_t offset = connection.input.size();
+                connection.input.resize(offset + READ_CHUNK);
+                const ssize_t received = recv(connection.fd, connection.input.data() + offset, READ_CHUNK, 0);
+                connection.input.resize(offset + static_cast<std::size_t>(std::max<ssize_t>(received, 0)));
+                if (received > 0)
+                {
+                    continue;
+                }
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                break;
+            }
+
+            std::vector<std::uint8_t> reply;
+            std::size_t consumed = 0;
+            bool valid = true;
+            while (valid)
+            {
+                Frame frame;
+                const long used = parse_frame(connection.input.data() + consumed, connection.input.size() - consumed, frame);
+                if (used == 0)
+                {
+                    break;
+                }
+                if (used < 0 || !handle_frame(server, id, connection, frame, reply))
+                {
+                    append_error_frame(reply, ErrorCode::BadMessage);
+                    valid = false;
+                    break;
+                }
+                consumed += static_cast<std::size_t>(used);
+            }
+            connection.input.erase(connection.input.begin(), connection.input.begin() + static_cast<std::ptrdiff_t>(consumed));
+
+            const bool sent = reply.empty() || queue_output(server, id, connection, reply);
+            if (closed || !valid || !sent)
+            {
+                close_connection(server, id);
+            }
+        }
+
+        void accept_connections(Server& server)
+        {
+            for (;;)
+            {
+                const int fd = accept4(server.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        std::cerr << "Warning: accept failed: " << std::strerror(errno) << '\n';
+                    }
+                    return;
+                }
+
+                const int enable = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+                std::uint32_t id = server.next_connection++;
+                if (id == NO_CONNECTION)
+                {
+                    id = server.next_connection++;
+                }
+                server.connections[id].fd = fd;
+                watch(server, fd, EPOLLIN | EPOLLRDHUP, id);
+            }
+        }
+
+        void drain_outbox(Server& server)
+        {
+            std::uint64_t count = 0;
+            (void)!read(server.outbox.event_fd, &count, sizeof(count));
+
+            std::vector<Delivery> deliveries;
+            {
+                std::lock_guard<std::mutex> lock(server.outbox.mutex);
+                deliveries.swap(server.outbox.deliveries);
+            }
+
+            for (const Delivery& delivery : deliveries)
+            {
+                auto it = server.connections.find(delivery.connection);
+                if (it != server.connections.end() && !queue_output(server, delivery.connection, it->second, delivery.bytes))
+                {
+                    close_connection(server, delivery.connection);
+                }
+            }
+        }
+
+        void post_ticks(Server& server)
+        {
+            std::uint64_t expirations = 0;
+            (void)!read(server.tick_fd, &expirations, sizeof(expirations));
+            for (auto& worker : server.workers)
+            {
+                post(*worker, {IntentKind::Tick, NO_CONNECTION, 0, 0});
+            }
+        }
+
+        void start_tick_timer(Server& server, float tick_rate)
+        {
+            server.tick_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (server.tick_fd < 0)
+            {
+                throw system_error("timerfd_create");
+            }
+
+            const long interval_ns = static_cast<long>(1.0e9f / std::max(tick_rate, 1.0f));
+            itimerspec spec{};
+            spec.it_interval.tv_sec = interval_ns / 1000000000L;
+            spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+            spec.it_value = spec.it_interval;
+            timerfd_settime(server.tick_fd, 0, &spec, nullptr);
+            watch(server, server.tick_fd, EPOLLIN, TICK_TOKEN);
+        }
+
+        void shutdown(Server& server)
+        {
+            for (auto& worker : server.workers)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(worker->mutex);
+                    worker->stop = true;
+                }
+                worker->wake.notify_one();
+            }
+            for (auto& worker : server.workers)
+            {
+                if (worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+
+            for (auto& entry : server.connections)
+            {
+                close(entry.second.fd);
+            }
+            server.connections.clear();
+
+            for (int fd : {server.tick_fd, server.outbox.event_fd, server.listen_fd, server.epoll_fd})
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    void run_server(const ServerOptions& options)
+    {
+        g_stop_requested = false;
+        if (!options.board_path.empty())
+        {
+            // Workers only ever read the layout, so set it before any start
+            game::map::set_active_board(game::map::load_board_definition(options.board_path));
+        }
+
+        Server server;
+        try
+        {
+            server.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (server.epoll_fd < 0)
+            {
+                throw system_error("epoll_create1");
+            }
+            server.outbox.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (server.outbox.event_fd < 0)
+            {
+                throw system_error("eventfd");
+            }
+            server.listen_fd = open_listen_socket(options);
+            watch(server, server.listen_fd, EPOLLIN, LISTEN_TOKEN);
+            watch(server, server.outbox.event_fd, EPOLLIN, OUTBOX_TOKEN);
+            start_tick_timer(server, options.tick_rate);
+
+            const int worker_count = options.workers > 0
+                ? options.workers
+                : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            const std::uint64_t seed = options.seed != 0 ? options.seed : core::make_random_seed();
+            for (int i = 0; i < worker_count; ++i)
+            {
+                auto worker = std::make_unique<Worker>();
+                core::seed_random_streams(worker->streams, seed + static_cast<std::uint64_t>(i));
+                server.workers.push_back(std::move(worker));
+            }
+            for (auto& worker : server.workers)
+            {
+                Worker& ref = *worker;
+                worker->thread = std::thread([&ref, &server] { run_worker(ref, server.outbox); });
+            }
+
+            std::cout << "snl_server listening on " << options.bind_address << ":" << options.port
+                      << " with " << worker_count << " workers (seed " << seed << ", "
+                      << sizeof(Room) << " bytes of state per room)" << std::endl;
+
+            epoll_event events[MAX_EVENTS];
+            while (!g_stop_requested)
+            {
+                const int count = epoll_wait(server.epoll_fd, events, MAX_EVENTS, STOP_POLL_MS);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw system_error("epoll_wait");
+                }
+
+                for (int i = 0; i < count; ++i)
+                {
+                    const std::uint64_t token = events[i].data.u64;
+                    if (token == LISTEN_TOKEN)
+                    {
+                        accept_connections(server);
+                    }
+                    else if (token == OUTBOX_TOKEN)
+                    {
+                        drain_outbox(server);
+                    }
+                    else if (token == TICK_TOKEN)
+                    {
+                        post_ticks(server);
+                    }
+                    else
+                    {
+                        const std::uint32_t id = static_cast<std::uint32_t>(token);
+                        if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                        {
+                            read_connection(server, id);
+                        }
+                        auto it = server.connections.find(id);
+                        if (it != server.connections.end() && (events[i].events & EPOLLOUT) &&
+                            !flush_output(server, id, it->second))
+                        {
+                            close_connection(server, id);
+                        }
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            shutdown(server);
+            throw;
+        }
+
+        shutdown(server);
+    }
+
+    void request_server_stop()
+    {
+        g_stop_requested = true;
+    }
+}
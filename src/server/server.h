@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace server
+{
+    struct ServerOptions
+    {
+        std::string bind_address = "127.0.0.1";
+        std::uint16_t port = 7777;
+        int workers = 0;            // 0 = one per hardware thread
+        std::uint64_t seed = 0;     // 0 = pick one; worker N uses seed + N
+        float tick_rate = 20.0f;    // Minigame timer updates per second
+        std::string board_path;     // Layout file for every room, empty = built-in board
+    };
+
+    // One epoll thread owns every socket: it accepts, reads, splits frames and
+    // writes. Rooms are sharded over the workers by room id, so each room only ever
+    // runs on one thread and needs no lock; workers hand their replies back through
+    // an outbox and an eventfd. Blocks until request_server_stop(), throws
+    // std::runtime_error if the listening socket cannot be set up.
+    void run_server(const ServerOptions& options);
+
+    // Async-signal-safe
+    void request_server_stop();
+}
@@ -0,0 +1,79 @@
+#include "server.h"
+
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    void handle_stop_signal(int)
+    {
+        server::request_server_stop();
+    }
+
+    server::ServerOptions parse_server_options(int argc, char* argv[])
+    {
+        server::ServerOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--port=", 0) == 0)
+                {
+                    options.port = static_cast<std::uint16_t>(std::stoi(arg.substr(std::strlen("--port="))));
+                }
+                else if (arg.rfind("--bind=", 0) == 0)
+                {
+                    options.bind_address = arg.substr(std::strlen("--bind="));
+                }
+                else if (arg.rfind("--workers=", 0) == 0)
+                {
+                    options.workers = std::stoi(arg.substr(std::strlen("--workers=")));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg.rfind("--tick-rate=", 0) == 0)
+                {
+                    options.tick_rate = std::stof(arg.substr(std::strlen("--tick-rate=")));
+                }
+                else if (arg.rfind("--board=", 0) == 0)
+                {
+                    options.board_path = arg.substr(std::strlen("--board="));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
+
+    try
+    {
+        server::run_server(parse_server_options(argc, argv));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
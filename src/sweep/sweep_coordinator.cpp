@@ -0,0 +1,547 @@
+#include "sweep_coordinator.h"
+
+#include "sweep_protocol.h"
+
+#include "game/map/board_file.h"
+#include "game/map/board_model.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sweep
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr int MAX_EVENTS = 64;
+        constexpr int POLL_MS = 200;  // Timeouts and dead children are checked this often
+        constexpr std::size_t READ_CHUNK = 65536;
+
+        struct Job
+        {
+            JobSpec spec;           // board left empty; sent from the variant's text
+            bool done = false;
+            bool queued = true;
+            Clock::time_point started{};
+        };
+
+        struct WorkerConnection
+        {
+            int fd = -1;
+            bool greeted = false;
+            std::uint32_t pid = 0;
+            std::vector<std::uint8_t> input;
+            std::vector<std::uint8_t> output;
+            std::size_t output_offset = 0;
+            bool want_write = false;
+            std::vector<std::uint32_t> in_flight;
+        };
+
+        struct Coordinator
+        {
+            const SweepOptions* options = nullptr;
+            int epoll_fd = -1;
+            int listen_fd = -1;
+            std::uint16_t port = 0;
+            std::vector<std::string> boards;  // write_board_definition text per variant
+            std::vector<Job> jobs;
+            std::deque<std::uint32_t> queue;
+            std::unordered_map<int, WorkerConnection> workers;
+            std::unordered_set<pid_t> children;  // Local workers still running
+            int respawns = 0;
+            std::uint32_t completed = 0;
+            SweepResult result;
+        };
+
+        std::runtime_error system_error(const std::string& what)
+        {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        int open_listen_socket(const SweepOptions& options, std::uint16_t& port)
+        {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(options.port);
+            if (inet_pton(AF_INET, options.bind_address.c_str(), &address.sin_addr) != 1)
+            {
+                throw std::runtime_error("Invalid bind address: " + options.bind_address);
+            }
+
+            const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd < 0)
+            {
+                throw system_error("socket");
+            }
+            const int enable = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+            socklen_t length = sizeof(address);
+            if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(fd, SOMAXCONN) != 0 ||
+                getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+            {
+                const std::runtime_error error = system_error("bind/listen " + options.bind_address + ":" + std::to_string(options.port));
+                close(fd);
+                throw error;
+            }
+            port = ntohs(address.sin_port);
+            return fd;
+        }
+
+        void watch(Coordinator& coordinator, int fd, std::uint32_t events, int operation)
+        {
+            epoll_event event{};
+            event.events = events;
+            event.data.fd = fd;
+            if (epoll_ctl(coordinator.epoll_fd, operation, fd, &event) != 0)
+            {
+                throw system_error("epoll_ctl");
+            }
+        }
+
+        // fork/exec of this binary in worker mode, pointed at our port
+        void spawn_worker(Coordinator& coordinator, bool crash)
+        {
+            const std::string target = "--worker=127.0.0.1:" + std::to_string(coordinator.port);
+            const std::string crash_option = "--crash-after=" + std::to_string(coordinator.options->crash_worker_after);
+            const pid_t pid = fork();
+            if (pid < 0)
+            {
+                std::cerr << "Warning: fork failed: " << std::strerror(errno) << '\n';
+                return;
+            }
+            if (pid == 0)
+            {
+                const char* program = "/proc/self/exe";
+                if (crash)
+                {
+                    execl(program, "snl_sweep", target.c_str(), crash_option.c_str(), static_cast<char*>(nullptr));
+                }
+                else
+                {
+                    execl(program, "snl_sweep", target.c_str(), static_cast<char*>(nullptr));
+                }
+                _exit(127);
+            }
+            coordinator.children.insert(pid);
+        }
+
+        void requeue(Coordinator& coordinator, std::uint32_t id, bool front)
+        {
+            Job& job = coordinator.jobs[id];
+            if (job.done || job.queued)
+            {
+                return;
+            }
+            job.queued = true;
+            ++coordinator.result.reassigned;
+            if (front)
+            {
+                coordinator.queue.push_front(id);
+            }
+            else
+            {
+                coordinator.queue.push_back(id);
+            }
+        }
+
+        void drop_worker(Coordinator& coordinator, int fd, bool lost)
+        {
+            auto it = coordinator.workers.find(fd);
+            if (it == coordinator.workers.end())
+            {
+                return;
+            }
+            for (const std::uint32_t id : it->second.in_flight)
+            {
+                requeue(coordinator, id, true);
+            }
+            if (lost)
+            {
+                ++coordinator.result.workers_lost;
+                std::cerr << "Warning: Lost worker " << it->second.pid << " with "
+                          << it->second.in_flight.size() << " jobs in flight\n";
+            }
+            epoll_ctl(coordinator.epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            close(fd);
+            coordinator.workers.erase(it);
+        }
+
+        bool flush(Coordinator& coordinator, WorkerConnection& worker)
+        {
+            while (worker.output_offset < worker.output.size())
+            {
+                const ssize_t written = send(worker.fd, worker.output.data() + worker.output_offset,
+                                             worker.output.size() - worker.output_offset, MSG_NOSIGNAL);
+                if (written < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        break;
+                    }
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                worker.output_offset += static_cast<std::size_t>(written);
+            }
+            if (worker.output_offset == worker.output.size())
+            {
+                worker.output.clear();
+                worker.output_offset = 0;
+            }
+
+            const bool want_write = !worker.output.empty();
+            if (want_write != worker.want_write)
+            {
+                worker.want_write = want_write;
+                watch(coordinator, worker.fd, EPOLLIN | EPOLLRDHUP | (want_write ? EPOLLOUT : 0u), EPOLL_CTL_MOD);
+            }
+            return true;
+        }
+
+        // Tops the worker up to jobs_in_flight; false if it had to be dropped
+        bool assign_jobs(Coordinator& coordinator, WorkerConnection& worker)
+        {
+            const std::size_t limit = static_cast<std::size_t>(std::max(1, coordinator.options->jobs_in_flight));
+            while (worker.greeted && worker.in_flight.size() < limit && !coordinator.queue.empty())
+            {
+                const std::uint32_t id = coordinator.queue.front();
+                coordinator.queue.pop_front();
+                Job& job = coordinator.jobs[id];
+                job.queued = false;
+                if (job.done)
+                {
+                    continue;
+                }
+                JobSpec spec = job.spec;
+                spec.board = coordinator.boards[spec.variant];
+                append_job_frame(worker.output, spec);
+                job.started = Clock::now();
+                worker.in_flight.push_back(id);
+            }
+            return flush(coordinator, worker);
+        }
+
+        // Handles every complete frame in the worker's input; false on protocol errors
+        bool handle_input(Coordinator& coordinator, WorkerConnection& worker)
+        {
+            std::size_t consumed = 0;
+            Frame frame;
+            long used = 0;
+            while ((used = parse_frame(worker.input.data() + consumed, worker.input.size() - consumed, frame)) > 0)
+            {
+                consumed += static_cast<std::size_t>(used);
+                if (frame.type == MessageType::Hello)
+                {
+                    std::uint32_t version = 0;
+                    if (!decode_hello(frame, version, worker.pid) || version != PROTOCOL_VERSION)
+                    {
+                        std::cerr << "Warning: Worker speaks protocol " << version << ", expected "
+                                  << PROTOCOL_VERSION << '\n';
+                        return false;
+                    }
+                    worker.greeted = true;
+                    ++coordinator.result.workers_seen;
+                    continue;
+                }
+
+                std::uint32_t id = 0;
+                game::map::GameSketch sketch;
+                if (!decode_result(frame, id, sketch) || id >= coordinator.jobs.size())
+                {
+                    return false;
+                }
+                worker.in_flight.erase(std::remove(worker.in_flight.begin(), worker.in_flight.end(), id),
+                                       worker.in_flight.end());
+                Job& job = coordinator.jobs[id];
+                if (job.done)
+                {
+                    ++coordinator.result.duplicates;
+                    continue;
+                }
+                if (sketch.games != job.spec.games)
+                {
+                    return false;
+                }
+                game::map::merge_sketch(coordinator.result.variants[job.spec.variant], sketch);
+                job.done = true;
+                ++coordinator.completed;
+            }
+            worker.input.erase(worker.input.begin(), worker.input.begin() + static_cast<std::ptrdiff_t>(consumed));
+            return used >= 0;
+        }
+
+        void read_worker(Coordinator& coordinator, int fd)
+        {
+            WorkerConnection& worker = coordinator.workers[fd];
+            std::uint8_t chunk[READ_CHUNK];
+            bool closed = false;
+            for (;;)
+            {
+                const ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+                if (received > 0)
+                {
+                    worker.input.insert(worker.input.end(), chunk, chunk + received);
+                    continue;
+                }
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                break;
+            }
+
+            if (!handle_input(coordinator, worker))
+            {
+                std::cerr << "Warning: Malformed message from worker " << worker.pid << '\n';
+                drop_worker(coordinator, fd, true);
+                return;
+            }
+            if (closed)
+            {
+                drop_worker(coordinator, fd, coordinator.completed < coordinator.jobs.size());
+                return;
+            }
+            if (!assign_jobs(coordinator, worker))
+            {
+                drop_worker(coordinator, fd, true);
+            }
+        }
+
+        void accept_workers(Coordinator& coordinator)
+        {
+            for (;;)
+            {
+                const int fd = accept4(coordinator.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        std::cerr << "Warning: accept failed: " << std::strerror(errno) << '\n';
+                    }
+                    return;
+                }
+                const int enable = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                coordinator.workers[fd].fd = fd;
+                watch(coordinator, fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+            }
+        }
+
+        // Reaps local workers that exited and replaces them while work remains
+        void tend_children(Coordinator& coordinator)
+        {
+            int status = 0;
+            pid_t pid = 0;
+            while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+            {
+                coordinator.children.erase(pid);
+                if (coordinator.completed < coordinator.jobs.size() &&
+                    coordinator.respawns < coordinator.options->max_respawns)
+                {
+                    ++coordinator.respawns;
+                    spawn_worker(coordinator, false);
+                }
+            }
+        }
+
+        // Jobs running longer than job_timeout are also queued for another worker
+        void requeue_stalled(Coordinator& coordinator)
+        {
+            const Clock::time_point now = Clock::now();
+            const auto timeout = std::chrono::duration<double>(std::max(1.0, coordinator.options->job_timeout));
+            for (auto& [fd, worker] : coordinator.workers)
+            {
+                for (const std::uint32_t id : worker.in_flight)
+                {
+                    Job& job = coordinator.jobs[id];
+                    if (!job.done && !job.queued && now - job.started > timeout)
+                    {
+                        requeue(coordinator, id, false);
+                        job.started = now;
+                    }
+                }
+            }
+        }
+
+        void stop_workers(Coordinator& coordinator)
+        {
+            std::vector<std::uint8_t> stop;
+            append_frame(stop, MessageType::Stop, {});
+            std::vector<int> fds;
+            for (auto& [fd, worker] : coordinator.workers)
+            {
+                worker.output.insert(worker.output.end(), stop.begin(), stop.end());
+                flush(coordinator, worker);
+                fds.push_back(fd);
+            }
+            for (const int fd : fds)
+            {
+                drop_worker(coordinator, fd, false);
+            }
+            for (const pid_t pid : coordinator.children)
+            {
+                int status = 0;
+                waitpid(pid, &status, 0);
+            }
+            coordinator.children.clear();
+        }
+    }
+
+    int local_worker_count(const SweepOptions& options)
+    {
+        return options.local_workers >= 0 ? options.local_workers
+                                          : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    SweepResult run_sweep(const SweepOptions& options, const std::function<void(std::uint16_t)>& listening,
+                          const SweepProgress& progress)
+    {
+        Coordinator coordinator;
+        coordinator.options = &options;
+
+        const std::vector<std::string> boards = options.boards.empty() ? std::vector<std::string>{""} : options.boards;
+        for (const std::string& path : boards)
+        {
+            const game::map::BoardDefinition definition = path.empty() ? game::map::default_board_definition()
+                                                                       : game::map::load_board_definition(path);
+            game::map::warn_unmodelled_effects(game::map::make_board_model(definition, options.minigame_success),
+                                               path.empty() ? "built-in board" : path);
+            std::ostringstream text;
+            game::map::write_board_definition(text, definition);
+            coordinator.boards.push_back(text.str());
+        }
+        coordinator.result.variants.resize(boards.size());
+
+        const std::uint32_t job_games = std::max<std::uint32_t>(1, options.job_games);
+        for (std::uint32_t variant = 0; variant < boards.size(); ++variant)
+        {
+            for (std::uint64_t first = 0; first < options.games; first += job_games)
+            {
+                Job job;
+                job.spec.id = static_cast<std::uint32_t>(coordinator.jobs.size());
+                job.spec.variant = variant;
+                job.spec.players = static_cast<std::uint8_t>(std::clamp(options.players, 2, 4));
+                job.spec.minigame_success = options.minigame_success;
+                job.spec.seed = options.seed;
+                job.spec.first_game = first;
+                job.spec.games = static_cast<std::uint32_t>(std::min<std::uint64_t>(job_games, options.games - first));
+                job.spec.max_turns = std::max<std::uint32_t>(1, options.max_turns);
+                coordinator.queue.push_back(job.spec.id);
+                coordinator.jobs.push_back(std::move(job));
+            }
+        }
+        coordinator.result.jobs = static_cast<std::uint32_t>(coordinator.jobs.size());
+
+        coordinator.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (coordinator.epoll_fd < 0)
+        {
+            throw system_error("epoll_create1");
+        }
+        try
+        {
+            coordinator.listen_fd = open_listen_socket(options, coordinator.port);
+        }
+        catch (...)
+        {
+            close(coordinator.epoll_fd);
+            throw;
+        }
+        watch(coordinator, coordinator.listen_fd, EPOLLIN, EPOLL_CTL_ADD);
+        if (listening)
+        {
+            listening(coordinator.port);
+        }
+        const int local_workers = local_worker_count(options);
+        for (int index = 0; index < local_workers; ++index)
+        {
+            spawn_worker(coordinator, index == 0 && options.crash_worker_after > 0);
+        }
+
+        epoll_event events[MAX_EVENTS];
+        std::uint32_t reported = ~0u;
+        while (coordinator.completed < coordinator.jobs.size())
+        {
+            const int ready = epoll_wait(coordinator.epoll_fd, events, MAX_EVENTS, POLL_MS);
+            if (ready < 0 && errno != EINTR)
+            {
+                throw system_error("epoll_wait");
+            }
+            for (int i = 0; i < ready; ++i)
+            {
+                const int fd = events[i].data.fd;
+                if (fd == coordinator.listen_fd)
+                {
+                    accept_workers(coordinator);
+                    continue;
+                }
+                auto it = coordinator.workers.find(fd);
+                if (it == coordinator.workers.end())
+                {
+                    continue;
+                }
+                if ((events[i].events & EPOLLOUT) && !flush(coordinator, it->second))
+                {
+                    drop_worker(coordinator, fd, true);
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                {
+                    read_worker(coordinator, fd);
+                }
+            }
+
+            tend_children(coordinator);
+            requeue_stalled(coordinator);
+            std::vector<int> failed;
+            for (auto& [fd, worker] : coordinator.workers)
+            {
+                if (worker.greeted && !coordinator.queue.empty() && !assign_jobs(coordinator, worker))
+                {
+                    failed.push_back(fd);
+                }
+            }
+            for (const int fd : failed)
+            {
+                drop_worker(coordinator, fd, true);
+            }
+
+            if (progress && coordinator.completed != reported)
+            {
+                reported = coordinator.completed;
+                progress(coordinator.completed, coordinator.result.jobs, static_cast<int>(coordinator.workers.size()));
+            }
+        }
+
+        stop_workers(coordinator);
+        close(coordinator.listen_fd);
+        close(coordinator.epoll_fd);
+        return coordinator.result;
+    }
+}
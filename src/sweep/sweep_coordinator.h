@@ -0,0 +1,60 @@
+#pragma once
+
+#include "game/map/game_sketch.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Shards a simulation sweep - every board variant times a range of game
+// indices - into jobs for worker processes connected over TCP, and merges the
+// GameSketch each job streams back. Workers can be spawned on this machine
+// (fork/exec of snl_sweep --worker) or started by hand anywhere that can reach
+// the coordinator's port; the protocol is the same. A job whose worker
+// disconnects goes back on the queue, and a job that takes longer than
+// job_timeout is handed to a second worker; games are seeded by index, so
+// whichever copy finishes first gives the same sketch.
+namespace sweep
+{
+    struct SweepOptions
+    {
+        std::vector<std::string> boards;  // Board files; "" = the built-in board
+        int players = 2;
+        float minigame_success = 0.5f;
+        std::uint64_t games = 10000000;   // Per variant
+        std::uint32_t job_games = 100000;
+        std::uint32_t max_turns = 100000;
+        std::uint64_t seed = 1;           // Shared by every variant, so they see the same dice
+
+        std::string bind_address = "127.0.0.1";
+        std::uint16_t port = 0;           // 0 = any free port
+        int local_workers = -1;           // Spawned and kept running on this machine; < 0 = one per core
+        int max_respawns = 8;             // Local workers replaced after dying, in total
+        int jobs_in_flight = 2;           // Per worker, so no worker idles waiting for its next job
+        double job_timeout = 120.0;       // Seconds before a job is also handed to another worker
+        int crash_worker_after = 0;       // > 0: first local worker dies after this many jobs (testing)
+    };
+
+    struct SweepResult
+    {
+        std::vector<game::map::GameSketch> variants;  // In options.boards order
+        std::uint32_t jobs = 0;
+        std::uint32_t reassigned = 0;   // Jobs requeued after a worker died or stalled
+        std::uint32_t duplicates = 0;   // Results for jobs already done, dropped
+        int workers_seen = 0;
+        int workers_lost = 0;
+    };
+
+    // Called on the coordinator's thread as jobs complete: (done, total, workers connected)
+    using SweepProgress = std::function<void(std::uint32_t, std::uint32_t, int)>;
+
+    // local_workers with "one per core" resolved
+    int local_worker_count(const SweepOptions& options);
+
+    // Blocks until every job is merged. listening, if set, is told the port
+    // once the socket is open. Throws std::runtime_error on socket failures
+    // or unreadable board files.
+    SweepResult run_sweep(const SweepOptions& options, const std::function<void(std::uint16_t)>& listening = {},
+                          const SweepProgress& progress = {});
+}
@@ -0,0 +1,173 @@
+#include "sweep_coordinator.h"
+#include "sweep_worker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// snl_sweep: coordinator by default, worker with --worker=HOST:PORT
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct SweepToolOptions
+    {
+        sweep::SweepOptions sweep;
+        std::string worker_target;  // HOST:PORT in worker mode
+        int crash_after = 0;
+    };
+
+    SweepToolOptions parse_sweep_options(int argc, char* argv[])
+    {
+        SweepToolOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--board=", 0) == 0)
+                {
+                    const std::string path = arg.substr(std::strlen("--board="));
+                    options.sweep.boards.push_back(path == "default" ? "" : path);
+                }
+                else if (arg.rfind("--games=", 0) == 0)
+                {
+                    options.sweep.games = std::max(1ull, std::stoull(arg.substr(std::strlen("--games="))));
+                }
+                else if (arg.rfind("--job-games=", 0) == 0)
+                {
+                    options.sweep.job_games = static_cast<std::uint32_t>(std::max(1, std::stoi(arg.substr(std::strlen("--job-games=")))));
+                }
+                else if (arg.rfind("--players=", 0) == 0)
+                {
+                    options.sweep.players = std::clamp(std::stoi(arg.substr(std::strlen("--players="))), 2, 4);
+                }
+                else if (arg.rfind("--minigame-success=", 0) == 0)
+                {
+                    options.sweep.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--minigame-success="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.sweep.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg.rfind("--bind=", 0) == 0)
+                {
+                    options.sweep.bind_address = arg.substr(std::strlen("--bind="));
+                }
+                else if (arg.rfind("--port=", 0) == 0)
+                {
+                    options.sweep.port = static_cast<std::uint16_t>(std::stoi(arg.substr(std::strlen("--port="))));
+                }
+                else if (arg.rfind("--local-workers=", 0) == 0)
+                {
+                    options.sweep.local_workers = std::max(0, std::stoi(arg.substr(std::strlen("--local-workers="))));
+                }
+                else if (arg.rfind("--job-timeout=", 0) == 0)
+                {
+                    options.sweep.job_timeout = std::max(1.0, std::stod(arg.substr(std::strlen("--job-timeout="))));
+                }
+                else if (arg.rfind("--crash-worker-after=", 0) == 0)
+                {
+                    options.sweep.crash_worker_after = std::max(0, std::stoi(arg.substr(std::strlen("--crash-worker-after="))));
+                }
+                else if (arg.rfind("--worker=", 0) == 0)
+                {
+                    options.worker_target = arg.substr(std::strlen("--worker="));
+                }
+                else if (arg.rfind("--crash-after=", 0) == 0)
+                {
+                    options.crash_after = std::max(0, std::stoi(arg.substr(std::strlen("--crash-after="))));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    void print_variant(const std::string& name, const game::map::GameSketch& sketch, int players)
+    {
+        std::cout << name << ": " << sketch.games << " games\n"
+                  << std::fixed << std::setprecision(2) << "  Turns per game: mean " << game::map::mean_turns(sketch)
+                  << ", stddev " << game::map::stddev_turns(sketch)
+                  << ", p50 " << game::map::turns_quantile(sketch, 0.5)
+                  << ", p90 " << game::map::turns_quantile(sketch, 0.9)
+                  << ", p99 " << game::map::turns_quantile(sketch, 0.99)
+                  << ", p99.9 " << game::map::turns_quantile(sketch, 0.999)
+                  << ", max " << game::map::turns_quantile(sketch, 1.0) << '\n';
+        std::cout << "  Wins:" << std::setprecision(4);
+        for (int seat = 0; seat < players; ++seat)
+        {
+            std::cout << " P" << seat + 1 << " "
+                      << static_cast<double>(sketch.wins[seat]) / static_cast<double>(std::max<std::uint64_t>(1, sketch.games));
+        }
+        std::cout << (sketch.unfinished > 0 ? ", " + std::to_string(sketch.unfinished) + " unfinished" : "") << '\n';
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const SweepToolOptions options = parse_sweep_options(argc, argv);
+        if (!options.worker_target.empty())
+        {
+            const std::size_t colon = options.worker_target.rfind(':');
+            if (colon == std::string::npos)
+            {
+                throw std::runtime_error("--worker expects HOST:PORT, got " + options.worker_target);
+            }
+            sweep::run_sweep_worker(options.worker_target.substr(0, colon),
+                                    static_cast<std::uint16_t>(std::stoi(options.worker_target.substr(colon + 1))),
+                                    options.crash_after);
+            return 0;
+        }
+
+        const Clock::time_point began = Clock::now();
+        const sweep::SweepResult result = sweep::run_sweep(
+            options.sweep,
+            [&options](std::uint16_t port) {
+                const int local_workers = sweep::local_worker_count(options.sweep);
+                std::cout << "Coordinator on " << options.sweep.bind_address << ":" << port << " with "
+                          << local_workers << " local workers - add more with: snl_sweep --worker=HOST:" << port
+                          << std::endl;
+                if (local_workers == 0)
+                {
+                    std::cout << "Waiting for snl_sweep --worker= processes to connect" << std::endl;
+                }
+            },
+            [](std::uint32_t done, std::uint32_t total, int workers) {
+                std::cout << "\r" << done << "/" << total << " jobs, " << workers << " workers    " << std::flush;
+            });
+        const double seconds = std::chrono::duration<double>(Clock::now() - began).count();
+
+        std::uint64_t games = 0;
+        for (std::size_t variant = 0; variant < result.variants.size(); ++variant)
+        {
+            const std::string& path = options.sweep.boards.empty() ? "" : options.sweep.boards[variant];
+            std::cout << '\n';
+            print_variant(path.empty() ? "Built-in board" : path, result.variants[variant], options.sweep.players);
+            games += result.variants[variant].games;
+        }
+        std::cout << std::setprecision(1) << "\n" << result.jobs << " jobs on " << result.workers_seen
+                  << " workers in " << seconds << " s (" << std::setprecision(0) << games / seconds << " games/s); "
+                  << result.workers_lost << " workers lost, " << result.reassigned << " jobs reassigned, "
+                  << result.duplicates << " duplicate results dropped\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
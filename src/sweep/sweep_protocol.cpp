@@ -0,0 +1,228 @@
+#include "sweep_protocol.h"
+
+#include <cstring>
+
+namespace sweep
+{
+    namespace
+    {
+        constexpr int MAX_HISTOGRAM_BUCKETS = 4096;
+
+        void put_u8(std::vector<std::uint8_t>& out, std::uint8_t value)
+        {
+            out.push_back(value);
+        }
+
+        void put_u32(std::vector<std::uint8_t>& out, std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void put_u64(std::vector<std::uint8_t>& out, std::uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        // Bounds-checked little-endian reads; ok drops to false on the first overrun
+        struct Reader
+        {
+            const std::uint8_t* data = nullptr;
+            std::size_t size = 0;
+            std::size_t offset = 0;
+            bool ok = true;
+
+            bool take(std::size_t bytes)
+            {
+                ok = ok && size - offset >= bytes;
+                return ok;
+            }
+
+            std::uint8_t u8()
+            {
+                return take(1) ? data[offset++] : 0;
+            }
+
+            std::uint32_t u32()
+            {
+                std::uint32_t value = 0;
+                if (take(4))
+                {
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        value |= static_cast<std::uint32_t>(data[offset++]) << (8 * i);
+                    }
+                }
+                return value;
+            }
+
+            std::uint64_t u64()
+            {
+                std::uint64_t value = 0;
+                if (take(8))
+                {
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        value |= static_cast<std::uint64_t>(data[offset++]) << (8 * i);
+                    }
+                }
+                return value;
+            }
+        };
+    }
+
+    void append_frame(std::vector<std::uint8_t>& out, MessageType type, const std::vector<std::uint8_t>& payload)
+    {
+        put_u32(out, static_cast<std::uint32_t>(payload.size() + 1));
+        put_u8(out, static_cast<std::uint8_t>(type));
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    void append_hello_frame(std::vector<std::uint8_t>& out, std::uint32_t pid)
+    {
+        std::vector<std::uint8_t> payload;
+        put_u32(payload, PROTOCOL_VERSION);
+        put_u32(payload, pid);
+        append_frame(out, MessageType::Hello, payload);
+    }
+
+    void append_job_frame(std::vector<std::uint8_t>& out, const JobSpec& job)
+    {
+        std::uint32_t success_bits = 0;
+        std::memcpy(&success_bits, &job.minigame_success, sizeof(success_bits));
+
+        std::vector<std::uint8_t> payload;
+        put_u32(payload, job.id);
+        put_u32(payload, job.variant);
+        put_u8(payload, job.players);
+        put_u32(payload, success_bits);
+        put_u64(payload, job.seed);
+        put_u64(payload, job.first_game);
+        put_u32(payload, job.games);
+        put_u32(payload, job.max_turns);
+        payload.insert(payload.end(), job.board.begin(), job.board.end());
+        append_frame(out, MessageType::Job, payload);
+    }
+
+    void append_result_frame(std::vector<std::uint8_t>& out, std::uint32_t job_id, const game::map::GameSketch& sketch)
+    {
+        std::vector<std::uint8_t> payload;
+        put_u32(payload, job_id);
+        put_u64(payload, sketch.games);
+        put_u64(payload, sketch.unfinished);
+        for (std::uint64_t wins : sketch.wins)
+        {
+            put_u64(payload, wins);
+        }
+        put_u64(payload, sketch.turns);
+        put_u64(payload, sketch.turns_squared);
+
+        // Sparse histogram: (bucket, count) for the non-empty buckets
+        std::uint32_t used = 0;
+        for (std::uint64_t count : sketch.histogram)
+        {
+            used += count > 0 ? 1 : 0;
+        }
+        put_u32(payload, used);
+        for (std::size_t bucket = 0; bucket < sketch.histogram.size(); ++bucket)
+        {
+            if (sketch.histogram[bucket] > 0)
+            {
+                put_u32(payload, static_cast<std::uint32_t>(bucket));
+                put_u64(payload, sketch.histogram[bucket]);
+            }
+        }
+        append_frame(out, MessageType::Result, payload);
+    }
+
+    long parse_frame(const std::uint8_t* data, std::size_t size, Frame& frame)
+    {
+        if (size < FRAME_HEADER_SIZE)
+        {
+            return 0;
+        }
+        Reader reader{data, size};
+        const std::uint32_t length = reader.u32();
+        if (length < 1 || length - 1 > MAX_FRAME_PAYLOAD)
+        {
+            return -1;
+        }
+        if (size < 4 + static_cast<std::size_t>(length))
+        {
+            return 0;
+        }
+        frame.type = static_cast<MessageType>(data[4]);
+        frame.payload = data + FRAME_HEADER_SIZE;
+        frame.payload_size = length - 1;
+        return static_cast<long>(4 + length);
+    }
+
+    bool decode_hello(const Frame& frame, std::uint32_t& version, std::uint32_t& pid)
+    {
+        Reader reader{frame.payload, frame.payload_size};
+        version = reader.u32();
+        pid = reader.u32();
+        return reader.ok && frame.type == MessageType::Hello;
+    }
+
+    bool decode_job(const Frame& frame, JobSpec& job)
+    {
+        Reader reader{frame.payload, frame.payload_size};
+        job.id = reader.u32();
+        job.variant = reader.u32();
+        job.players = reader.u8();
+        const std::uint32_t success_bits = reader.u32();
+        std::memcpy(&job.minigame_success, &success_bits, sizeof(success_bits));
+        job.seed = reader.u64();
+        job.first_game = reader.u64();
+        job.games = reader.u32();
+        job.max_turns = reader.u32();
+        if (!reader.ok || frame.type != MessageType::Job)
+        {
+            return false;
+        }
+        job.board.assign(reinterpret_cast<const char*>(frame.payload) + reader.offset,
+                         frame.payload_size - reader.offset);
+        return true;
+    }
+
+    bool decode_result(const Frame& frame, std::uint32_t& job_id, game::map::GameSketch& sketch)
+    {
+        Reader reader{frame.payload, frame.payload_size};
+        job_id = reader.u32();
+        sketch = {};
+        sketch.games = reader.u64();
+        sketch.unfinished = reader.u64();
+        for (std::uint64_t& wins : sketch.wins)
+        {
+            wins = reader.u64();
+        }
+        sketch.turns = reader.u64();
+        sketch.turns_squared = reader.u64();
+        const std::uint32_t used = reader.u32();
+        if (!reader.ok || used > MAX_HISTOGRAM_BUCKETS)
+        {
+            return false;
+        }
+        for (std::uint32_t i = 0; i < used; ++i)
+        {
+            const std::uint32_t bucket = reader.u32();
+            const std::uint64_t count = reader.u64();
+            if (!reader.ok || bucket >= MAX_HISTOGRAM_BUCKETS)
+            {
+                return false;
+            }
+            if (bucket >= sketch.histogram.size())
+            {
+                sketch.histogram.resize(bucket + 1, 0);
+            }
+            sketch.histogram[bucket] = count;
+        }
+        return reader.ok && reader.offset == frame.payload_size && frame.type == MessageType::Result;
+    }
+}
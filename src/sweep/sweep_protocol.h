@@ -0,0 +1,68 @@
+#pragma once
+
+#include "game/map/game_sketch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Wire format between snl_sweep's coordinator and its workers. Every message
+// is a frame:
+//   u32 length (of everything after it), u8 type, payload
+// with all integers little-endian, the same over loopback and across machines.
+// A job is a contiguous range of games of one board variant; games are seeded
+// by their index (reset_batch_games), so a job run twice - after a worker dies
+// or stalls - gives the same sketch and the coordinator keeps the first.
+namespace sweep
+{
+    constexpr std::uint32_t PROTOCOL_VERSION = 1;
+    constexpr std::size_t FRAME_HEADER_SIZE = 5;
+    constexpr std::size_t MAX_FRAME_PAYLOAD = 1 << 20;  // Anything longer drops the connection
+
+    enum class MessageType : std::uint8_t
+    {
+        // Worker -> coordinator
+        Hello = 1,   // u32 PROTOCOL_VERSION, u32 pid
+        Result = 2,  // u32 job id, sketch (see encode_sketch)
+
+        // Coordinator -> worker
+        Job = 64,    // JobSpec
+        Stop = 65    // -
+    };
+
+    struct JobSpec
+    {
+        std::uint32_t id = 0;
+        std::uint32_t variant = 0;
+        std::uint8_t players = 2;
+        float minigame_success = 0.5f;
+        std::uint64_t seed = 1;
+        std::uint64_t first_game = 0;
+        std::uint32_t games = 0;
+        std::uint32_t max_turns = 100000;
+        std::string board;  // write_board_definition text
+    };
+
+    struct Frame
+    {
+        MessageType type = MessageType::Hello;
+        const std::uint8_t* payload = nullptr;
+        std::size_t payload_size = 0;
+    };
+
+    // Appends one complete frame to out
+    void append_frame(std::vector<std::uint8_t>& out, MessageType type, const std::vector<std::uint8_t>& payload);
+    void append_hello_frame(std::vector<std::uint8_t>& out, std::uint32_t pid);
+    void append_job_frame(std::vector<std::uint8_t>& out, const JobSpec& job);
+    void append_result_frame(std::vector<std::uint8_t>& out, std::uint32_t job_id, const game::map::GameSketch& sketch);
+
+    // Parses the frame at data[0..size). Returns bytes consumed, 0 if more data is
+    // needed, or -1 if the stream is malformed.
+    long parse_frame(const std::uint8_t* data, std::size_t size, Frame& frame);
+
+    // Decoders return false on truncated or inconsistent payloads
+    bool decode_hello(const Frame& frame, std::uint32_t& version, std::uint32_t& pid);
+    bool decode_job(const Frame& frame, JobSpec& job);
+    bool decode_result(const Frame& frame, std::uint32_t& job_id, game::map::GameSketch& sketch);
+}
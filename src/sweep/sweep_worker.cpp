@@ -0,0 +1,204 @@
+#include "sweep_worker.h"
+
+#include "game/map/batch_games.h"
+#include "game/map/board_file.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace sweep
+{
+    namespace
+    {
+        constexpr std::size_t READ_CHUNK = 65536;
+
+        int connect_coordinator(const std::string& host, std::uint16_t port)
+        {
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            addrinfo* found = nullptr;
+            const int status = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &found);
+            if (status != 0)
+            {
+                throw std::runtime_error("Cannot resolve " + host + ": " + gai_strerror(status));
+            }
+
+            int fd = -1;
+            for (addrinfo* candidate = found; candidate && fd < 0; candidate = candidate->ai_next)
+            {
+                fd = socket(candidate->ai_family, candidate->ai_socktype | SOCK_CLOEXEC, candidate->ai_protocol);
+                if (fd >= 0 && connect(fd, candidate->ai_addr, candidate->ai_addrlen) != 0)
+                {
+                    close(fd);
+                    fd = -1;
+                }
+            }
+            freeaddrinfo(found);
+            if (fd < 0)
+            {
+                throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port) + ": " +
+                                         std::strerror(errno));
+            }
+
+            const int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            return fd;
+        }
+
+        bool send_all(int fd, const std::vector<std::uint8_t>& data)
+        {
+            std::size_t offset = 0;
+            while (offset < data.size())
+            {
+                const ssize_t written = send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                offset += static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+
+        // The last job's tile table, reused while jobs stay on one variant
+        struct TableCache
+        {
+            bool valid = false;
+            std::string board;
+            float minigame_success = 0.0f;
+            game::map::BatchTileTable table;
+        };
+
+        const game::map::BatchTileTable& table_for(const JobSpec& job, TableCache& cache)
+        {
+            if (!cache.valid || cache.board != job.board || cache.minigame_success != job.minigame_success)
+            {
+                std::istringstream text(job.board);
+                const game::map::BoardDefinition definition =
+                    game::map::read_board_definition(text, "job " + std::to_string(job.id));
+                cache.table = game::map::make_batch_tile_table(
+                    game::map::make_board_model(definition, job.minigame_success));
+                cache.board = job.board;
+                cache.minigame_success = job.minigame_success;
+                cache.valid = true;
+            }
+            return cache.table;
+        }
+
+        // One job's games on the batch kernel
+        game::map::GameSketch play(const JobSpec& job, const game::map::BatchTileTable& table)
+        {
+            game::map::BatchOutcomes outcomes;
+            outcomes.turns.assign(job.games, 0);
+            outcomes.winner.assign(job.games, -1);
+
+            game::map::BatchGames games;
+            game::map::BatchTally tally;
+            game::map::reset_batch_games(games, static_cast<int>(job.games), job.players, job.seed, job.first_game);
+            for (std::uint32_t turn = 0; turn < job.max_turns && games.count > 0; ++turn)
+            {
+                const int running = game::map::advance_batch_games(games, table);
+                if (running * 2 < games.count)
+                {
+                    game::map::compact_batch_games(games, tally, &outcomes);
+                }
+            }
+            game::map::compact_batch_games(games, tally, &outcomes);
+            for (int game = 0; game < games.count; ++game)
+            {
+                outcomes.turns[games.id[game]] = games.turns[game];
+            }
+
+            game::map::GameSketch sketch;
+            for (std::uint32_t game = 0; game < job.games; ++game)
+            {
+                game::map::record_game(sketch, outcomes.turns[game], outcomes.winner[game]);
+            }
+            return sketch;
+        }
+    }
+
+    void run_sweep_worker(const std::string& host, std::uint16_t port, int crash_after)
+    {
+        const int fd = connect_coordinator(host, port);
+        std::vector<std::uint8_t> output;
+        append_hello_frame(output, static_cast<std::uint32_t>(getpid()));
+        if (!send_all(fd, output))
+        {
+            close(fd);
+            throw std::runtime_error("Coordinator closed the connection");
+        }
+
+        TableCache cache;
+        std::vector<std::uint8_t> input;
+        std::vector<std::uint8_t> chunk(READ_CHUNK);
+        int jobs_done = 0;
+        bool running = true;
+        while (running)
+        {
+            const ssize_t received = recv(fd, chunk.data(), chunk.size(), 0);
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (received <= 0)
+            {
+                break;  // Coordinator finished or died
+            }
+            input.insert(input.end(), chunk.begin(), chunk.begin() + received);
+
+            std::size_t consumed = 0;
+            Frame frame;
+            long used = 0;
+            while (running && (used = parse_frame(input.data() + consumed, input.size() - consumed, frame)) > 0)
+            {
+                consumed += static_cast<std::size_t>(used);
+                JobSpec job;
+                if (frame.type == MessageType::Stop)
+                {
+                    running = false;
+                }
+                else if (decode_job(frame, job))
+                {
+                    if (crash_after > 0 && jobs_done >= crash_after)
+                    {
+                        std::cerr << "Worker " << getpid() << " crashing on purpose in job " << job.id << '\n';
+                        _exit(3);
+                    }
+                    output.clear();
+                    append_result_frame(output, job.id, play(job, table_for(job, cache)));
+                    ++jobs_done;
+                    running = send_all(fd, output);
+                }
+                else
+                {
+                    std::cerr << "Warning: Worker ignoring malformed message type "
+                              << static_cast<int>(frame.type) << '\n';
+                }
+            }
+            if (used < 0)
+            {
+                std::cerr << "Warning: Malformed stream from coordinator\n";
+                break;
+            }
+            input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(consumed));
+        }
+        close(fd);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "sweep_protocol.h"
+
+#include <cstdint>
+#include <string>
+
+namespace sweep
+{
+    // Connects to a coordinator, plays jobs until it says Stop or goes away.
+    // crash_after > 0 makes the worker die abruptly in the middle of its next
+    // job after that many, for trying out the coordinator's recovery. Throws
+    // std::runtime_error if the coordinator cannot be reached.
+    void run_sweep_worker(const std::string& host, std::uint16_t port, int crash_after = 0);
+}
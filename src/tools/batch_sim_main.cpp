@@ -0,0 +1,295 @@
+#include "game/map/batch_games.h"
+#include "game/map/board_file.h"
+#include "game/map/game_store.h"
+#include "game/map/win_odds.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// snl_batch_sim: plays many games of the board at once with the batch kernel
+// and reports throughput, game length and each seat's win rate next to the
+// exact odds. With --store every game is appended to a game store (see
+// game_store.h), optionally with its tile trace.
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct BatchOptions
+    {
+        int games = 1000000;
+        int players = 2;
+        float minigame_success = 0.5f;
+        int threads = 0;              // 0 = one per core
+        int max_rounds = 100000;      // Calls before unfinished games are abandoned
+        std::uint64_t seed = 1;
+        std::filesystem::path board_path;
+        std::filesystem::path store_path;
+        bool traces = false;          // Store the tile after every turn too
+        bool scalar = false;          // Baseline-ISA kernel even where AVX2 is available
+        game::map::RuleVariant rules;
+    };
+
+    // Games a thread plays before handing them to the store, one stripe's worth
+    constexpr int STORE_CHUNK = 65536;
+
+    BatchOptions parse_batch_options(int argc, char* argv[])
+    {
+        BatchOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--games=", 0) == 0)
+                {
+                    options.games = std::max(1, std::stoi(arg.substr(std::strlen("--games="))));
+                }
+                else if (arg.rfind("--players=", 0) == 0)
+                {
+                    options.players = std::clamp(std::stoi(arg.substr(std::strlen("--players="))), 2, 4);
+                }
+                else if (arg.rfind("--minigame-success=", 0) == 0)
+                {
+                    options.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--minigame-success="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--threads=", 0) == 0)
+                {
+                    options.threads = std::max(0, std::stoi(arg.substr(std::strlen("--threads="))));
+                }
+                else if (arg.rfind("--max-rounds=", 0) == 0)
+                {
+                    options.max_rounds = std::max(1, std::stoi(arg.substr(std::strlen("--max-rounds="))));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg.rfind("--board=", 0) == 0)
+                {
+                    options.board_path = arg.substr(std::strlen("--board="));
+                }
+                else if (arg.rfind("--rules=", 0) == 0)
+                {
+                    options.rules = game::map::parse_rule_variant(arg.substr(std::strlen("--rules=")));
+                }
+                else if (arg.rfind("--store=", 0) == 0)
+                {
+                    options.store_path = arg.substr(std::strlen("--store="));
+                }
+                else if (arg == "--traces")
+                {
+                    options.traces = true;
+                }
+                else if (arg == "--scalar")
+                {
+                    options.scalar = true;
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const BatchOptions options = parse_batch_options(argc, argv);
+        game::map::force_generic_batch_kernel(options.scalar);
+        if (!options.board_path.empty())
+        {
+            game::map::set_active_board(game::map::load_board_definition(options.board_path));
+        }
+        const game::map::BoardModel board = game::map::make_board_model(options.minigame_success);
+        game::map::warn_unmodelled_effects(board,
+                                           options.board_path.empty() ? "built-in board" : options.board_path.string());
+        const game::map::BatchTileTable table = game::map::make_batch_tile_table(board, options.rules);
+
+        // Each thread plays its own batch and compacts it as games finish
+        const int threads = std::min(options.games,
+                                     options.threads > 0 ? options.threads
+                                                         : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+        std::unique_ptr<game::map::GameStoreWriter> store;
+        std::mutex store_mutex;
+        std::exception_ptr store_error;  // First write failure, rethrown after the join
+        if (!options.store_path.empty())
+        {
+            store = std::make_unique<game::map::GameStoreWriter>(options.store_path);
+        }
+
+        // Plays until every game finishes or max_rounds runs out, compacting
+        // as games finish. traces, if given, gets the mover's tile after each
+        // turn of every game, by id.
+        const auto play = [&](game::map::BatchGames& games, game::map::BatchTally& tally,
+                              game::map::BatchOutcomes* outcomes, std::vector<std::vector<std::int32_t>>* traces) {
+            std::vector<std::int8_t> mover;
+            for (int round = 0; round < options.max_rounds && games.count > 0; ++round)
+            {
+                if (traces)
+                {
+                    mover.resize(games.count);
+                    for (int game = 0; game < games.count; ++game)
+                    {
+                        mover[game] = games.winner[game] < 0 ? static_cast<std::int8_t>(games.seat[game]) : -1;
+                    }
+                }
+                const int running = game::map::advance_batch_games(games, table);
+                if (traces)
+                {
+                    for (int game = 0; game < games.count; ++game)
+                    {
+                        if (mover[game] >= 0)
+                        {
+                            (*traces)[games.id[game]].push_back(
+                                game::map::get_batch_tile(games, game, mover[game]));
+                        }
+                    }
+                }
+                if (running * 2 < games.count)
+                {
+                    game::map::compact_batch_games(games, tally, outcomes);
+                }
+            }
+            game::map::compact_batch_games(games, tally, outcomes);  // Leaves only the abandoned games
+        };
+
+        std::vector<game::map::BatchTally> tallies(threads);
+        std::vector<int> unfinished(threads, 0);
+        const Clock::time_point began = Clock::now();
+        std::vector<std::thread> workers;
+        for (int index = 0; index < threads; ++index)
+        {
+            workers.emplace_back([&, index]() {
+                game::map::BatchGames games;
+                const int share = options.games / threads;
+                const int extra = options.games % threads;
+                const int first = index * share + std::min(index, extra);
+                const int count = share + (index < extra ? 1 : 0);
+                if (!store)
+                {
+                    game::map::reset_batch_games(games, count, options.players, options.seed, first);
+                    play(games, tallies[index], nullptr, nullptr);
+                    unfinished[index] = games.count;
+                    return;
+                }
+
+                // Stored runs go a stripe at a time so outcomes and traces stay small
+                game::map::BatchOutcomes outcomes;
+                std::vector<std::vector<std::int32_t>> traces;
+                for (int done = 0; done < count; done += STORE_CHUNK)
+                {
+                    const int chunk = std::min(STORE_CHUNK, count - done);
+                    outcomes.turns.assign(chunk, 0);
+                    outcomes.winner.assign(chunk, -1);
+                    traces.assign(options.traces ? chunk : 0, {});
+                    game::map::reset_batch_games(games, chunk, options.players, options.seed,
+                                                 static_cast<std::uint64_t>(first + done));
+                    play(games, tallies[index], &outcomes, options.traces ? &traces : nullptr);
+                    for (int game = 0; game < games.count; ++game)
+                    {
+                        outcomes.turns[games.id[game]] = games.turns[game];
+                    }
+                    unfinished[index] += games.count;
+
+                    const std::lock_guard<std::mutex> lock(store_mutex);
+                    if (store_error)
+                    {
+                        return;
+                    }
+                    try
+                    {
+                        for (int game = 0; game < chunk; ++game)
+                        {
+                            const std::vector<std::int32_t>* trace = options.traces ? &traces[game] : nullptr;
+                            store->add_game(options.seed, static_cast<std::uint64_t>(first + done + game),
+                                            outcomes.turns[game], outcomes.winner[game],
+                                            trace ? trace->data() : nullptr, trace ? trace->size() : 0);
+                        }
+                    }
+                    catch (...)
+                    {
+                        store_error = std::current_exception();
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        if (store_error)
+        {
+            std::rethrow_exception(store_error);
+        }
+        if (store)
+        {
+            store->close();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - began).count();
+
+        game::map::BatchTally tally;
+        int abandoned = 0;
+        for (int index = 0; index < threads; ++index)
+        {
+            tally.games += tallies[index].games;
+            tally.turns += tallies[index].turns;
+            for (int seat = 0; seat < 4; ++seat)
+            {
+                tally.wins[seat] += tallies[index].wins[seat];
+            }
+            abandoned += unfinished[index];
+        }
+
+        game::map::WinOddsModel odds_model;
+        odds_model.minigame_success = options.minigame_success;
+        const game::map::FinishTable finish = game::map::build_finish_table(board, odds_model);
+        const std::array<float, 4> odds = game::map::compute_win_odds(finish, {0, 0, 0, 0}, options.players, 0);
+
+        const double finished = static_cast<double>(std::max<std::uint64_t>(1, tally.games));
+        std::cout << std::fixed << std::setprecision(2)
+                  << options.games << " games of " << options.players << " players on " << threads << " threads in "
+                  << seconds << " s: " << std::setprecision(0) << options.games / seconds << " games/s, "
+                  << tally.turns / seconds << " turns/s (" << game::map::get_batch_kernel_name() << " kernel)\n"
+                  << std::setprecision(2) << "Turns per game: " << tally.turns / finished
+                  << " (" << abandoned << " unfinished after " << options.max_rounds << " rounds)\n";
+        // The exact odds know the standard rules only
+        const bool standard = game::map::rule_variant_index(options.rules) == 0;
+        if (!standard)
+        {
+            std::cout << "Rules: " << game::map::describe_rule_variant(options.rules) << '\n';
+        }
+        for (int seat = 0; seat < options.players; ++seat)
+        {
+            std::cout << "  P" << seat + 1 << " wins " << std::setprecision(4) << tally.wins[seat] / finished;
+            if (standard)
+            {
+                std::cout << " (exact " << odds[seat] << ")";
+            }
+            std::cout << '\n';
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "game/map/board_compare.h"
+#include "game/map/board_file.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// snl_board_compare: plays board A against board B on common dice until the
+// differences are known to the requested precision and prints them with
+// their confidence intervals.
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct VariantOptions
+    {
+        std::filesystem::path board_path;  // Empty = the built-in board
+        float minigame_success = 0.5f;
+    };
+
+    struct CompareToolOptions
+    {
+        VariantOptions a;
+        VariantOptions b;
+        game::map::CompareOptions compare;
+    };
+
+    CompareToolOptions parse_compare_options(int argc, char* argv[])
+    {
+        CompareToolOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--a=", 0) == 0)
+                {
+                    options.a.board_path = arg.substr(std::strlen("--a="));
+                }
+                else if (arg.rfind("--b=", 0) == 0)
+                {
+                    options.b.board_path = arg.substr(std::strlen("--b="));
+                }
+                else if (arg.rfind("--success-a=", 0) == 0)
+                {
+                    options.a.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--success-a="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--success-b=", 0) == 0)
+                {
+                    options.b.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--success-b="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--rules-a=", 0) == 0)
+                {
+                    options.compare.rules_a = game::map::parse_rule_variant(arg.substr(std::strlen("--rules-a=")));
+                }
+                else if (arg.rfind("--rules-b=", 0) == 0)
+                {
+                    options.compare.rules_b = game::map::parse_rule_variant(arg.substr(std::strlen("--rules-b=")));
+                }
+                else if (arg.rfind("--players=", 0) == 0)
+                {
+                    options.compare.players = std::clamp(std::stoi(arg.substr(std::strlen("--players="))), 2, 4);
+                }
+                else if (arg.rfind("--threads=", 0) == 0)
+                {
+                    options.compare.threads = std::max(0, std::stoi(arg.substr(std::strlen("--threads="))));
+                }
+                else if (arg.rfind("--turns-precision=", 0) == 0)
+                {
+                    options.compare.turns_precision = std::max(0.0, std::stod(arg.substr(std::strlen("--turns-precision="))));
+                }
+                else if (arg.rfind("--win-precision=", 0) == 0)
+                {
+                    options.compare.win_precision = std::max(0.0, std::stod(arg.substr(std::strlen("--win-precision="))));
+                }
+                else if (arg.rfind("--max-pairs=", 0) == 0)
+                {
+                    options.compare.max_pairs = std::max(1ull, std::stoull(arg.substr(std::strlen("--max-pairs="))));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.compare.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg == "--no-antithetic")
+                {
+                    options.compare.antithetic = false;
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    game::map::BoardModel load_variant(const VariantOptions& variant)
+    {
+        const game::map::BoardDefinition definition = variant.board_path.empty()
+                                                           ? game::map::default_board_definition()
+                                                           : game::map::load_board_definition(variant.board_path);
+        game::map::BoardModel board = game::map::make_board_model(definition, variant.minigame_success);
+        game::map::warn_unmodelled_effects(board,
+                                           variant.board_path.empty() ? "built-in board" : variant.board_path.string());
+        return board;
+    }
+
+    void print_effect(const std::string& label, const game::map::Effect& effect, int precision)
+    {
+        std::cout << std::fixed << std::setprecision(precision) << "  " << std::left << std::setw(16) << label
+                  << std::right << " A " << effect.a << "  B " << effect.b << "  B-A " << std::showpos
+                  << effect.difference << std::noshowpos << " +- " << effect.half_width
+                  << std::setprecision(3) << "  (d = " << effect.effect_size << ", ";
+        if (std::isfinite(effect.variance_ratio))
+        {
+            std::cout << std::setprecision(1) << effect.variance_ratio << "x fewer games)\n";
+        }
+        else
+        {
+            std::cout << "fewer games n/a: B-A never varies)\n";
+        }
+    }
+
+    bool same_landing(const game::map::TileLanding& a, const game::map::TileLanding& b)
+    {
+        return a.kind == b.kind && a.steps == b.steps && a.span == b.span && a.target == b.target &&
+               a.minigame == b.minigame;
+    }
+
+    // Both sides would play exactly the same games
+    bool same_variant(const game::map::BoardModel& a, const game::map::BoardModel& b,
+                      const game::map::CompareOptions& compare)
+    {
+        return a.tile_count == b.tile_count && a.link_end == b.link_end &&
+               std::equal(a.landings.begin(), a.landings.end(), b.landings.begin(), b.landings.end(), same_landing) &&
+               a.minigame_success == b.minigame_success &&
+               game::map::rule_variant_index(compare.rules_a) == game::map::rule_variant_index(compare.rules_b);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const CompareToolOptions options = parse_compare_options(argc, argv);
+        const game::map::BoardModel a = load_variant(options.a);
+        const game::map::BoardModel b = load_variant(options.b);
+        if (same_variant(a, b, options.compare))
+        {
+            throw std::runtime_error("Variants A and B are identical - give a different --b, --rules-b or --success-b");
+        }
+
+        const Clock::time_point began = Clock::now();
+        const game::map::CompareResult result = game::map::compare_boards(
+            a, b, options.compare, [](const game::map::CompareResult& so_far) {
+                std::cout << "\r" << so_far.pairs << " pairs, turns B-A " << std::fixed << std::setprecision(3)
+                          << std::showpos << so_far.turns.difference << std::noshowpos << " +- "
+                          << so_far.turns.half_width << "    " << std::flush;
+            });
+        const double seconds = std::chrono::duration<double>(Clock::now() - began).count();
+
+        std::cout << "\n" << result.pairs << (options.compare.antithetic ? " antithetic pairs" : " games")
+                  << " per board in " << std::setprecision(1) << seconds << " s, "
+                  << (result.converged ? "precision reached" : "stopped at --max-pairs") << '\n';
+        if (game::map::rule_variant_index(options.compare.rules_a) != 0 ||
+            game::map::rule_variant_index(options.compare.rules_b) != 0)
+        {
+            std::cout << "Rules A: " << game::map::describe_rule_variant(options.compare.rules_a)
+                      << ", B: " << game::map::describe_rule_variant(options.compare.rules_b) << '\n';
+        }
+        print_effect("Turns per game", result.turns, 3);
+        for (int seat = 0; seat < result.players; ++seat)
+        {
+            print_effect("P" + std::to_string(seat + 1) + " win rate", result.wins[seat], 4);
+        }
+        if (result.unfinished > 0)
+        {
+            std::cout << "Warning: " << result.unfinished << " games never finished and count as nobody winning\n";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
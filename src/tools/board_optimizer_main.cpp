@@ -0,0 +1,135 @@
+#include "game/map/board_file.h"
+#include "game/map/board_model.h"
+#include "game/map/board_optimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// snl_board_optimizer: anneals the ladders, snakes and activity tiles towards
+// design goals and writes the best board found for --board=FILE.
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct OptimizerOptions
+    {
+        game::map::LayoutGoals goals;
+        game::map::AnnealOptions anneal;
+        std::filesystem::path start_path;  // Empty = the built-in board
+        std::filesystem::path out_path = "board.txt";
+    };
+
+    OptimizerOptions parse_optimizer_options(int argc, char* argv[])
+    {
+        OptimizerOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--turns=", 0) == 0)
+                {
+                    options.goals.mean_turns = std::max(0.0, std::stod(arg.substr(std::strlen("--turns="))));
+                }
+                else if (arg.rfind("--stddev=", 0) == 0)
+                {
+                    options.goals.stddev_turns = std::max(0.0, std::stod(arg.substr(std::strlen("--stddev="))));
+                }
+                else if (arg.rfind("--comeback=", 0) == 0)
+                {
+                    options.goals.comeback_rate = std::clamp(std::stod(arg.substr(std::strlen("--comeback="))), 0.0, 1.0);
+                }
+                else if (arg.rfind("--seat-weight=", 0) == 0)
+                {
+                    options.goals.seat_weight = std::max(0.0, std::stod(arg.substr(std::strlen("--seat-weight="))));
+                }
+                else if (arg.rfind("--players=", 0) == 0)
+                {
+                    options.goals.players = std::clamp(std::stoi(arg.substr(std::strlen("--players="))), 2, 4);
+                }
+                else if (arg.rfind("--minigame-success=", 0) == 0)
+                {
+                    options.goals.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--minigame-success="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--iterations=", 0) == 0)
+                {
+                    options.anneal.iterations = std::max(1, std::stoi(arg.substr(std::strlen("--iterations="))));
+                }
+                else if (arg.rfind("--threads=", 0) == 0)
+                {
+                    options.anneal.threads = std::max(0, std::stoi(arg.substr(std::strlen("--threads="))));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.anneal.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg.rfind("--start=", 0) == 0)
+                {
+                    options.start_path = arg.substr(std::strlen("--start="));
+                }
+                else if (arg.rfind("--out=", 0) == 0)
+                {
+                    options.out_path = arg.substr(std::strlen("--out="));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    void print_score(const char* label, const game::map::LayoutScore& score)
+    {
+        std::cout << std::fixed << std::setprecision(3) << label
+                  << ": mean " << score.mean_turns << " turns, stddev " << score.stddev_turns
+                  << ", comeback " << score.comeback_rate << ", seat gap " << score.seat_gap
+                  << ", cost " << score.cost << '\n';
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const OptimizerOptions options = parse_optimizer_options(argc, argv);
+        const game::map::BoardDefinition start = options.start_path.empty()
+                                                     ? game::map::default_board_definition()
+                                                     : game::map::load_board_definition(options.start_path);
+        game::map::warn_unmodelled_effects(game::map::make_board_model(start, options.goals.minigame_success),
+                                           options.start_path.empty() ? "built-in board" : options.start_path.string());
+        print_score("Start", game::map::score_layout(start, options.goals));
+
+        const Clock::time_point began = Clock::now();
+        const game::map::AnnealResult result = game::map::optimize_layout(
+            start, options.goals, options.anneal, [](std::uint64_t done, std::uint64_t total, double best_cost) {
+                std::cout << "\r" << done << "/" << total << " iterations, best cost "
+                          << std::setprecision(4) << best_cost << std::flush;
+            });
+        const double seconds = std::chrono::duration<double>(Clock::now() - began).count();
+        std::cout << "\n" << result.evaluated << " boards scored in " << std::setprecision(1) << seconds
+                  << " s (" << std::setprecision(0) << result.evaluated / std::max(seconds, 1e-9) << " / s)\n";
+        print_score("Best", result.score);
+
+        game::map::save_board_definition(options.out_path, result.board);
+        std::cout << "Wrote " << options.out_path.string() << " - play it with --board="
+                  << options.out_path.string() << '\n';
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
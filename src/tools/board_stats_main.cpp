@@ -0,0 +1,171 @@
+#include "game/map/board_analysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// snl_board_stats: expected game length and the tile-visit heatmap of the board,
+// re-solved after every link edit typed on stdin.
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct StatsOptions
+    {
+        int repeat = 1;                  // Copies of the board laid end to end
+        float minigame_success = 0.5f;
+    };
+
+    StatsOptions parse_stats_options(int argc, char* argv[])
+    {
+        StatsOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--repeat=", 0) == 0)
+                {
+                    options.repeat = std::max(1, std::stoi(arg.substr(std::strlen("--repeat="))));
+                }
+                else if (arg.rfind("--minigame-success=", 0) == 0)
+                {
+                    options.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--minigame-success="))), 0.0f, 1.0f);
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    double elapsed_ms(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Tiles are 1-based on the command line, like the board's labels
+    void print_summary(const game::map::BoardAnalysis& analysis, int hottest)
+    {
+        const std::vector<double>& visits = analysis.visits;
+        std::vector<int> order(visits.size());
+        std::iota(order.begin(), order.end(), 0);
+        hottest = std::clamp(hottest, 0, static_cast<int>(order.size()));
+        std::partial_sort(order.begin(), order.begin() + hottest, order.end(),
+                          [&visits](int a, int b) { return visits[a] > visits[b]; });
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Expected turns: " << game::map::expected_game_turns(analysis)
+                  << " (" << analysis.board.tile_count << " tiles, "
+                  << analysis.u.size() << " low-rank terms)\n";
+        for (int i = 0; i < hottest; ++i)
+        {
+            std::cout << "  tile " << std::setw(5) << order[i] + 1 << "  " << visits[order[i]] << " visits\n";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const StatsOptions options = parse_stats_options(argc, argv);
+
+    game::map::BoardModel board = game::map::make_board_model(options.minigame_success);
+    if (options.repeat > 1)
+    {
+        board = game::map::repeat_board_model(board, options.repeat);
+    }
+
+    game::map::BoardAnalysis analysis;
+    try
+    {
+        Clock::time_point start = Clock::now();
+        game::map::analyze_board(analysis, board);
+        std::cout << "Factored in " << std::setprecision(2) << std::fixed << elapsed_ms(start)
+                  << " ms (band " << analysis.lower << "/" << analysis.upper << ")\n";
+        print_summary(analysis, 10);
+
+        std::cout << "Commands: link S E | unlink S | move FROM TO END | show [N] | rebuild | quit\n";
+        std::string line;
+        while (std::getline(std::cin, line))
+        {
+            std::istringstream input(line);
+            std::string command;
+            if (!(input >> command))
+            {
+                continue;
+            }
+            if (command == "quit")
+            {
+                break;
+            }
+
+            start = Clock::now();
+            bool ok = true;
+            if (command == "link")
+            {
+                int link_start = 0;
+                int link_end = 0;
+                ok = static_cast<bool>(input >> link_start >> link_end) &&
+                     game::map::set_link(analysis, link_start - 1, link_end - 1);
+            }
+            else if (command == "unlink")
+            {
+                int link_start = 0;
+                ok = static_cast<bool>(input >> link_start) && game::map::set_link(analysis, link_start - 1, -1);
+            }
+            else if (command == "move")
+            {
+                int from = 0;
+                int to = 0;
+                int to_end = 0;
+                ok = static_cast<bool>(input >> from >> to >> to_end) &&
+                     game::map::move_link(analysis, from - 1, to - 1, to_end - 1);
+            }
+            else if (command == "rebuild")
+            {
+                const game::map::BoardModel current = analysis.board;
+                game::map::analyze_board(analysis, current);
+            }
+            else if (command == "show")
+            {
+                int hottest = 10;
+                input >> hottest;
+                print_summary(analysis, hottest);
+                continue;
+            }
+            else
+            {
+                std::cerr << "Warning: Unknown command " << command << '\n';
+                continue;
+            }
+
+            if (!ok)
+            {
+                std::cerr << "Warning: Invalid tiles in " << line << '\n';
+                continue;
+            }
+            const double ms = elapsed_ms(start);
+            std::cout << std::fixed << std::setprecision(3) << command << ": "
+                      << game::map::expected_game_turns(analysis) << " expected turns in " << ms << " ms\n";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
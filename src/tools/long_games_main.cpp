@@ -0,0 +1,173 @@
+#include "game/map/board_file.h"
+#include "game/map/long_games.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// snl_long_games: chances of games that drag on or of one player hitting snake
+// after snake, by multilevel splitting, next to plain sampling at the same
+// cost (and the exact figure where there is one).
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct LongGameOptions
+    {
+        int rounds = 400;   // 0 = skip the long-game query
+        int snakes = 40;    // 0 = skip the snake query
+        int players = 2;
+        float minigame_success = 0.5f;
+        bool sampling = true;
+        game::map::SplittingOptions splitting;
+        std::filesystem::path board_path;
+    };
+
+    LongGameOptions parse_long_game_options(int argc, char* argv[])
+    {
+        LongGameOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--rounds=", 0) == 0)
+                {
+                    options.rounds = std::max(0, std::stoi(arg.substr(std::strlen("--rounds="))));
+                }
+                else if (arg.rfind("--snakes=", 0) == 0)
+                {
+                    options.snakes = std::max(0, std::stoi(arg.substr(std::strlen("--snakes="))));
+                }
+                else if (arg.rfind("--players=", 0) == 0)
+                {
+                    options.players = std::clamp(std::stoi(arg.substr(std::strlen("--players="))), 1, 4);
+                }
+                else if (arg.rfind("--minigame-success=", 0) == 0)
+                {
+                    options.minigame_success = std::clamp(std::stof(arg.substr(std::strlen("--minigame-success="))), 0.0f, 1.0f);
+                }
+                else if (arg.rfind("--effort=", 0) == 0)
+                {
+                    options.splitting.effort = std::max(1, std::stoi(arg.substr(std::strlen("--effort="))));
+                }
+                else if (arg.rfind("--level-step=", 0) == 0)
+                {
+                    options.splitting.level_step = std::max(1, std::stoi(arg.substr(std::strlen("--level-step="))));
+                }
+                else if (arg.rfind("--runs=", 0) == 0)
+                {
+                    options.splitting.runs = std::max(2, std::stoi(arg.substr(std::strlen("--runs="))));
+                }
+                else if (arg.rfind("--threads=", 0) == 0)
+                {
+                    options.splitting.threads = std::max(0, std::stoi(arg.substr(std::strlen("--threads="))));
+                }
+                else if (arg.rfind("--seed=", 0) == 0)
+                {
+                    options.splitting.seed = std::stoull(arg.substr(std::strlen("--seed=")));
+                }
+                else if (arg.rfind("--board=", 0) == 0)
+                {
+                    options.board_path = arg.substr(std::strlen("--board="));
+                }
+                else if (arg == "--no-sampling")
+                {
+                    options.sampling = false;
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+        return options;
+    }
+
+    void print_estimate(const char* label, const game::map::TailEstimate& estimate, double seconds)
+    {
+        std::cout << "  " << std::left << std::setw(10) << label << std::right << std::scientific
+                  << std::setprecision(3) << estimate.probability << " +- " << estimate.standard_error;
+        if (estimate.probability > 0.0)
+        {
+            std::cout << std::fixed << std::setprecision(1) << " ("
+                      << 100.0 * estimate.standard_error / estimate.probability << "% rel.)";
+        }
+        std::cout << std::fixed << std::setprecision(2) << "  " << estimate.turns / 1e6 << "M turns, "
+                  << seconds << " s\n";
+    }
+
+    void run_query(const game::map::BoardModel& board, const game::map::TailQuery& query,
+                   const LongGameOptions& options)
+    {
+        Clock::time_point began = Clock::now();
+        const game::map::TailEstimate split = game::map::estimate_tail_by_splitting(board, query, options.splitting);
+        print_estimate("Splitting", split, std::chrono::duration<double>(Clock::now() - began).count());
+
+        if (options.sampling)
+        {
+            began = Clock::now();
+            const game::map::TailEstimate plain =
+                game::map::estimate_tail_by_sampling(board, query, split.turns, options.splitting);
+            print_estimate("Sampling", plain, std::chrono::duration<double>(Clock::now() - began).count());
+            if (plain.hits == 0)
+            {
+                std::cout << "  Plain sampling saw no such game in the same number of turns\n";
+            }
+            else if (split.standard_error > 0.0)
+            {
+                const double gain = (plain.standard_error * plain.standard_error) /
+                                    (split.standard_error * split.standard_error);
+                std::cout << "  Splitting needs " << std::setprecision(1) << gain
+                          << "x fewer turns for the same error\n";
+            }
+        }
+        if (query.event == game::map::TailEvent::LongGame)
+        {
+            std::cout << "  " << std::left << std::setw(10) << "Exact" << std::right << std::scientific
+                      << std::setprecision(3)
+                      << game::map::exact_long_game_chance(board, query.players, query.target) << std::fixed << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const LongGameOptions options = parse_long_game_options(argc, argv);
+        const game::map::BoardDefinition definition = options.board_path.empty()
+                                                          ? game::map::default_board_definition()
+                                                          : game::map::load_board_definition(options.board_path);
+        const game::map::BoardModel board = game::map::make_board_model(definition, options.minigame_success);
+        game::map::warn_unmodelled_effects(board,
+                                           options.board_path.empty() ? "built-in board" : options.board_path.string());
+
+        if (options.rounds > 0)
+        {
+            std::cout << "Nobody finished after " << options.rounds << " rounds, " << options.players << " players:\n";
+            run_query(board, {game::map::TailEvent::LongGame, options.rounds, options.players}, options);
+        }
+        if (options.snakes > 0)
+        {
+            std::cout << "A player lands on " << options.snakes << " snakes before anyone finishes, "
+                      << options.players << " players:\n";
+            run_query(board, {game::map::TailEvent::SnakeHits, options.snakes, options.players}, options);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
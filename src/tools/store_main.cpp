@@ -0,0 +1,201 @@
+#include "game/map/game_store.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// snl_store: inspects, scans and merges game stores written by snl_batch_sim.
+//   snl_store info FILE
+//   snl_store scan FILE [--column=turns] [--at-least=N]
+//   snl_store merge OUT IN...
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr const char* COLUMN_NAMES[game::map::STORE_COLUMN_COUNT] = {"seed", "game", "turns", "winner", "trace"};
+    constexpr const char* ENCODING_NAMES[game::map::STORE_ENCODING_COUNT] = {
+        "varint", "delta-varint", "bytes", "run-length", "bit-packed", "transition"};
+
+    game::map::StoreColumn parse_column(const std::string& name)
+    {
+        for (int column = 0; column < game::map::STORE_COLUMN_COUNT; ++column)
+        {
+            if (name == COLUMN_NAMES[column])
+            {
+                return static_cast<game::map::StoreColumn>(column);
+            }
+        }
+        throw std::runtime_error("Unknown column: " + name);
+    }
+
+    void print_info(const std::filesystem::path& path)
+    {
+        const game::map::GameStoreReader reader(path);
+        std::array<std::uint64_t, game::map::STORE_COLUMN_COUNT> bytes{};
+        std::array<std::array<std::uint64_t, game::map::STORE_ENCODING_COUNT>, game::map::STORE_COLUMN_COUNT> encodings{};
+        std::uint64_t trace_values = 0;
+        for (const game::map::StoreStripe& stripe : reader.stripes())
+        {
+            trace_values += stripe.trace_values;
+            for (int column = 0; column < game::map::STORE_COLUMN_COUNT; ++column)
+            {
+                bytes[column] += stripe.chunks[column].size;
+                ++encodings[column][static_cast<int>(stripe.chunks[column].encoding)];
+            }
+        }
+
+        std::cout << path.string() << ": " << reader.rows() << " games in " << reader.stripes().size() << " stripes, "
+                  << trace_values << " trace tiles\n"
+                  << std::fixed << std::setprecision(2);
+        for (int column = 0; column < game::map::STORE_COLUMN_COUNT; ++column)
+        {
+            const std::uint64_t values = column == static_cast<int>(game::map::StoreColumn::Trace) ? trace_values
+                                                                                                 : reader.rows();
+            std::cout << "  " << std::left << std::setw(8) << COLUMN_NAMES[column] << std::right << std::setw(12)
+                      << bytes[column] << " bytes, " << (values > 0 ? static_cast<double>(bytes[column]) / values : 0.0)
+                      << " per value (";
+            const char* separator = "";
+            for (int encoding = 0; encoding < game::map::STORE_ENCODING_COUNT; ++encoding)
+            {
+                if (encodings[column][encoding] > 0)
+                {
+                    std::cout << separator << ENCODING_NAMES[encoding] << " x" << encodings[column][encoding];
+                    separator = ", ";
+                }
+            }
+            std::cout << ")\n";
+        }
+    }
+
+    // Sums a column, counting values >= at_least; stripes whose max is below
+    // at_least are skipped without touching their chunk
+    void scan(const std::filesystem::path& path, int argc, char* argv[])
+    {
+        game::map::StoreColumn column = game::map::StoreColumn::Turns;
+        std::uint64_t at_least = 0;
+        for (int i = 0; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            try
+            {
+                if (arg.rfind("--column=", 0) == 0)
+                {
+                    column = parse_column(arg.substr(std::strlen("--column=")));
+                }
+                else if (arg.rfind("--at-least=", 0) == 0)
+                {
+                    at_least = std::stoull(arg.substr(std::strlen("--at-least=")));
+                }
+                else
+                {
+                    std::cerr << "Warning: Unknown option " << arg << '\n';
+                }
+            }
+            catch (const std::exception&)
+            {
+                std::cerr << "Warning: Invalid value in option " << arg << '\n';
+            }
+        }
+
+        const Clock::time_point began = Clock::now();
+        const game::map::GameStoreReader reader(path);
+        std::vector<std::uint64_t> values(4096);
+        std::uint64_t scanned = 0;
+        std::uint64_t matched = 0;
+        std::uint64_t sum = 0;
+        std::uint64_t bytes = 0;
+        std::size_t skipped = 0;
+        for (std::size_t stripe = 0; stripe < reader.stripes().size(); ++stripe)
+        {
+            const game::map::StoreChunk& chunk = reader.stripes()[stripe].chunks[static_cast<int>(column)];
+            if (chunk.max < at_least)
+            {
+                ++skipped;
+                continue;
+            }
+            bytes += chunk.size;
+            game::map::StoreColumnCursor cursor(reader, stripe, column);
+            if (cursor.has_byte_values())
+            {
+                // Byte-wide compares straight over the chunk (or the decoded
+                // block); the per-block sums fit 32 bits, so this vectorises
+                const std::uint8_t* bytes_in = nullptr;
+                const std::uint32_t threshold = static_cast<std::uint32_t>(std::min<std::uint64_t>(at_least, 256));
+                while (const std::size_t count = cursor.next_bytes(bytes_in, 4096))
+                {
+                    scanned += count;
+                    std::uint32_t block_matched = 0;
+                    std::uint32_t block_sum = 0;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const std::uint32_t value = bytes_in[i];
+                        const std::uint32_t counts = value >= threshold;
+                        block_matched += counts;
+                        block_sum += value & (0u - counts);
+                    }
+                    matched += block_matched;
+                    sum += block_sum;
+                }
+                continue;
+            }
+            while (const std::size_t count = cursor.next(values.data(), values.size()))
+            {
+                scanned += count;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const bool counts = values[i] >= at_least;
+                    matched += counts;
+                    sum += counts ? values[i] : 0;
+                }
+            }
+        }
+        const double seconds = std::max(1e-9, std::chrono::duration<double>(Clock::now() - began).count());
+
+        std::cout << std::fixed << std::setprecision(2) << COLUMN_NAMES[static_cast<int>(column)] << ": " << matched
+                  << " values >= " << at_least << ", mean " << (matched > 0 ? static_cast<double>(sum) / matched : 0.0)
+                  << '\n'
+                  << "Scanned " << scanned << " values (" << bytes << " bytes) in " << seconds * 1000.0 << " ms, "
+                  << skipped << " of " << reader.stripes().size() << " stripes skipped: " << std::setprecision(0)
+                  << scanned / seconds << " values/s, " << std::setprecision(2) << bytes / seconds / 1e9 << " GB/s\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const std::string command = argc > 1 ? argv[1] : "";
+        if (command == "info" && argc == 3)
+        {
+            print_info(argv[2]);
+        }
+        else if (command == "scan" && argc >= 3)
+        {
+            scan(argv[2], argc - 3, argv + 3);
+        }
+        else if (command == "merge" && argc >= 4)
+        {
+            const std::vector<std::filesystem::path> inputs(argv + 3, argv + argc);
+            game::map::merge_game_stores(argv[2], inputs);
+            print_info(argv[2]);
+        }
+        else
+        {
+            std::cerr << "Usage: snl_store info FILE | scan FILE [--column=NAME] [--at-least=N] | merge OUT IN...\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
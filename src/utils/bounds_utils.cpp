@@ -1,8 +1,51 @@
 #include "bounds_utils.h"
 
+#include <cmath>
+
 void expand_bounds(Bounds& bounds, const glm::vec3& point)
 {
     bounds.min = glm::min(bounds.min, point);
     bounds.max = glm::max(bounds.max, point);
 }
 
+void expand_bounds(Bounds& bounds, const Bounds& other)
+{
+    if (!is_valid(other))
+    {
+        return;
+    }
+    expand_bounds(bounds, other.min);
+    expand_bounds(bounds, other.max);
+}
+
+bool is_valid(const Bounds& bounds)
+{
+    return bounds.min.x <= bounds.max.x && bounds.min.y <= bounds.max.y && bounds.min.z <= bounds.max.z;
+}
+
+Bounds transform_bounds(const Bounds& bounds, const glm::mat4& transform)
+{
+    if (!is_valid(bounds))
+    {
+        return bounds;
+    }
+
+    // Transform centre and half extents instead of all 8 corners (Arvo)
+    const glm::vec3 center = (bounds.min + bounds.max) * 0.5f;
+    const glm::vec3 extent = (bounds.max - bounds.min) * 0.5f;
+    const glm::vec3 world_center = glm::vec3(transform * glm::vec4(center, 1.0f));
+
+    glm::vec3 world_extent(0.0f);
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            world_extent[row] += std::abs(transform[column][row]) * extent[column];
+        }
+    }
+
+    Bounds result;
+    result.min = world_center - world_extent;
+    result.max = world_center + world_extent;
+    return result;
+}
@@ -4,4 +4,8 @@
 #include <glm/glm.hpp>
 
 void expand_bounds(Bounds& bounds, const glm::vec3& point);
+void expand_bounds(Bounds& bounds, const Bounds& other);
+bool is_valid(const Bounds& bounds);  // False until at least one point has been added
 
+// AABB of the transformed box (may be looser than the transformed geometry)
+Bounds transform_bounds(const Bounds& bounds, const glm::mat4& transform);
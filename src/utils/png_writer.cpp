@@ -0,0 +1,138 @@
+#include "png_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    constexpr std::size_t MAX_STORED_BLOCK = 65535;  // Largest deflate stored block
+
+    const std::array<std::uint32_t, 256>& crc_table()
+    {
+        static const std::array<std::uint32_t, 256> table = [] {
+            std::array<std::uint32_t, 256> values{};
+            for (std::uint32_t n = 0; n < 256; ++n)
+            {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[n] = c;
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    std::uint32_t update_crc(std::uint32_t crc, const unsigned char* data, std::size_t size)
+    {
+        const auto& table = crc_table();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    void append_u32(std::vector<unsigned char>& out, std::uint32_t value)
+    {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void write_chunk(std::ofstream& file, const char type[4], const std::vector<unsigned char>& data)
+    {
+        std::vector<unsigned char> header;
+        append_u32(header, static_cast<std::uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+        file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        // CRC covers the chunk type and data, not the length
+        std::uint32_t crc = update_crc(0xFFFFFFFFu, header.data() + 4, 4);
+        crc = update_crc(crc, data.data(), data.size()) ^ 0xFFFFFFFFu;
+        std::vector<unsigned char> footer;
+        append_u32(footer, crc);
+        file.write(reinterpret_cast<const char*>(footer.data()), static_cast<std::streamsize>(footer.size()));
+    }
+}
+
+void write_png(const std::filesystem::path& path, int width, int height, const std::vector<unsigned char>& rgba)
+{
+    const std::size_t row_bytes = static_cast<std::size_t>(width) * 4;
+    if (width <= 0 || height <= 0 || rgba.size() < row_bytes * static_cast<std::size_t>(height))
+    {
+        throw std::runtime_error("Invalid image passed to write_png: " + path.string());
+    }
+
+    // Filter type 0 (none) in front of every scanline
+    std::vector<unsigned char> scanlines;
+    scanlines.reserve((row_bytes + 1) * static_cast<std::size_t>(height));
+    for (int row = 0; row < height; ++row)
+    {
+        scanlines.push_back(0);
+        const unsigned char* source = rgba.data() + static_cast<std::size_t>(row) * row_bytes;
+        scanlines.insert(scanlines.end(), source, source + row_bytes);
+    }
+
+    // zlib header, stored deflate blocks, Adler-32 of the uncompressed data
+    std::vector<unsigned char> idat;
+    idat.reserve(scanlines.size() + scanlines.size() / MAX_STORED_BLOCK * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+    std::uint32_t adler_a = 1;
+    std::uint32_t adler_b = 0;
+    std::size_t offset = 0;
+    do
+    {
+        const std::size_t block = std::min(MAX_STORED_BLOCK, scanlines.size() - offset);
+        const bool final_block = offset + block == scanlines.size();
+        idat.push_back(final_block ? 1 : 0);
+        idat.push_back(static_cast<unsigned char>(block & 0xFFu));
+        idat.push_back(static_cast<unsigned char>(block >> 8));
+        idat.push_back(static_cast<unsigned char>(~block & 0xFFu));
+        idat.push_back(static_cast<unsigned char>((~block >> 8) & 0xFFu));
+        idat.insert(idat.end(), scanlines.begin() + static_cast<std::ptrdiff_t>(offset),
+                    scanlines.begin() + static_cast<std::ptrdiff_t>(offset + block));
+        for (std::size_t i = offset; i < offset + block; ++i)
+        {
+            adler_a = (adler_a + scanlines[i]) % 65521u;
+            adler_b = (adler_b + adler_a) % 65521u;
+        }
+        offset += block;
+    } while (offset < scanlines.size());
+    append_u32(idat, (adler_b << 16) | adler_a);
+
+    std::vector<unsigned char> ihdr;
+    append_u32(ihdr, static_cast<std::uint32_t>(width));
+    append_u32(ihdr, static_cast<std::uint32_t>(height));
+    ihdr.push_back(8);  // Bit depth
+    ihdr.push_back(6);  // Colour type: RGBA
+    ihdr.push_back(0);  // Compression: deflate
+    ihdr.push_back(0);  // Filter method
+    ihdr.push_back(0);  // No interlace
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open file for writing: " + path.string());
+    }
+
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+    write_chunk(file, "IHDR", ihdr);
+    write_chunk(file, "IDAT", idat);
+    write_chunk(file, "IEND", {});
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write PNG: " + path.string());
+    }
+}
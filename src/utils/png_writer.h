@@ -0,0 +1,10 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+// Writes 8-bit RGBA pixels (rows top to bottom) as a PNG. The image data is
+// stored uncompressed inside the zlib stream - captures are written at full
+// frame rate, and a few MB per frame is cheaper than deflating on the render thread.
+// Throws std::runtime_error if the file cannot be written.
+void write_png(const std::filesystem::path& path, int width, int height, const std::vector<unsigned char>& rgba);